@@ -2684,17 +2684,21 @@ struct engine_configuration_s {
 	offset 1372 bit 26 */
 	bool invertVvtControlExhaust : 1 {};
 	/**
+	 * Compute timing of each cylinder right before its dwell starts instead of for all cylinders at a fixed rate. Fuel stays periodic.
 	offset 1372 bit 27 */
-	bool unused_1484_bit_27 : 1 {};
+	bool eventSyncFuelSpark : 1 {};
 	/**
+	 * Run the throttle position PID at several kHz from the fast ADC conversion, while pedal target, feed forward and safety checks stay in the regular ETB loop.
 	offset 1372 bit 28 */
-	bool unused_1484_bit_38 : 1 {};
+	bool etbFastInnerLoop : 1 {};
 	/**
+	 * Learn a fuel trim table from the closed loop correction and apply it even before closed loop correction becomes active. Learned trims are kept in backup RAM.
 	offset 1372 bit 29 */
-	bool unused_1484_bit_29 : 1 {};
+	bool enableLongTermFuelTrim : 1 {};
 	/**
+	 * Convert angles to time using crank acceleration measured over the last teeth instead of assuming constant RPM. Helps spark and injection accuracy while cranking and during fast RPM changes.
 	offset 1372 bit 30 */
-	bool unused_1484_bit_30 : 1 {};
+	bool predictiveAngleScheduling : 1 {};
 	/**
 	offset 1372 bit 31 */
 	bool unused_1484_bit_31 : 1 {};
@@ -3981,9 +3985,21 @@ struct engine_configuration_s {
 	 */
 	scaled_channel<uint8_t, 1, 50> maxCamPhaseResolveRpm;
 	/**
+	 * Oversample MAP on the fast ADC: this many conversions are decimated into one sample by a CIC filter, which gives more resolution and less noise at a lower sample rate. 0 or 1 to disable. Takes effect after reboot.
+	ratio
 	 * offset 3121
 	 */
-	int8_t unused4080[11];
+	uint8_t mapAdcDecimation;
+	/**
+	 * Same as MAP ADC decimation, for TPS while it is sampled by the fast ADC for the ETB inner loop. Takes effect after reboot.
+	ratio
+	 * offset 3122
+	 */
+	uint8_t tpsAdcDecimation;
+	/**
+	 * offset 3123
+	 */
+	int8_t unused4080[9];
 	/**
 	lobes/cam
 	 * offset 3132
@@ -442,7 +442,7 @@
 #define cylindersCount_offset 368
 #define dc_io_size 8
 #define DC_PER_STEPPER 2
-#define debug_mode_e_auto_enum 0="DBG_0",10="DBG_10",11="DBG_11",16="DBG_16",2="DBG_2",20="DBG_20",24="DBG_24",26="DBG_26",29="DBG_29",34="DBG_34",35="DBG_35",36="DBG_36",37="DBG_37",38="DBG_38",43="DBG_43",46="DBG_46",7="DBG_7",8="DBG_8",9="DBG_9",21="DBG_ANALOG_INPUTS",32="DBG_ANALOG_INPUTS2",19="DBG_BENCH_TEST",25="DBG_CJ125",40="DBG_COMPOSITE_LOG",33="DBG_DWELL_METRIC",44="DBG_DYNO_VIEW",17="DBG_ELECTRONIC_THROTTLE_PID",4="DBG_EL_ACCEL",39="DBG_ETB_AUTOTUNE",18="DBG_EXECUTOR",22="DBG_INSTANT_RPM",30="DBG_ION",15="DBG_KNOCK",45="DBG_LOGIC_ANALYZER",48="DBG_LUA",27="DBG_MAP",28="DBG_METRICS",13="DBG_SD_CARD",6="DBG_SOFT_SPARK_CUT",14="DBG_SR5_PROTOCOL",3="DBG_STEPPER_IDLE_CONTROL",47="DBG_TCU",31="DBG_TLE8888",1="DBG_TPS_ACCEL",5="DBG_TRIGGER_COUNTERS",12="DBG_UNUSED12",41="DBG_UNUSED41",42="DBG_UNUSED_42",23="UNUSED23"
+#define debug_mode_e_auto_enum 0="DBG_0",10="DBG_10",11="DBG_11",16="DBG_16",2="DBG_2",20="DBG_20",24="DBG_24",26="DBG_26",29="DBG_29",34="DBG_34",35="DBG_35",36="DBG_36",37="DBG_37",38="DBG_38",43="DBG_43",46="DBG_46",7="DBG_7",8="DBG_8",9="DBG_9",21="DBG_ANALOG_INPUTS",32="DBG_ANALOG_INPUTS2",19="DBG_BENCH_TEST",12="DBG_BOOT_TIME",25="DBG_CJ125",40="DBG_COMPOSITE_LOG",33="DBG_DWELL_METRIC",44="DBG_DYNO_VIEW",17="DBG_ELECTRONIC_THROTTLE_PID",4="DBG_EL_ACCEL",39="DBG_ETB_AUTOTUNE",18="DBG_EXECUTOR",22="DBG_INSTANT_RPM",30="DBG_ION",15="DBG_KNOCK",45="DBG_LOGIC_ANALYZER",48="DBG_LUA",27="DBG_MAP",28="DBG_METRICS",13="DBG_SD_CARD",6="DBG_SOFT_SPARK_CUT",14="DBG_SR5_PROTOCOL",3="DBG_STEPPER_IDLE_CONTROL",47="DBG_TCU",31="DBG_TLE8888",1="DBG_TPS_ACCEL",5="DBG_TRIGGER_COUNTERS",41="DBG_UNUSED41",42="DBG_UNUSED_42",23="UNUSED23"
 #define debug_mode_e_DBG_0 0
 #define debug_mode_e_DBG_10 10
 #define debug_mode_e_DBG_11 11
@@ -465,6 +465,7 @@
 #define debug_mode_e_DBG_ANALOG_INPUTS 21
 #define debug_mode_e_DBG_ANALOG_INPUTS2 32
 #define debug_mode_e_DBG_BENCH_TEST 19
+#define debug_mode_e_DBG_BOOT_TIME 12
 #define debug_mode_e_DBG_CJ125 25
 #define debug_mode_e_DBG_COMPOSITE_LOG 40
 #define debug_mode_e_DBG_DWELL_METRIC 33
@@ -488,10 +489,9 @@
 #define debug_mode_e_DBG_TLE8888 31
 #define debug_mode_e_DBG_TPS_ACCEL 1
 #define debug_mode_e_DBG_TRIGGER_COUNTERS 5
-#define debug_mode_e_DBG_UNUSED12 12
 #define debug_mode_e_DBG_UNUSED41 41
 #define debug_mode_e_DBG_UNUSED_42 42
-#define debug_mode_e_enum "INVALID", "TPS acceleration enrichment", "INVALID", "Stepper Idle Control", "Engine Load accl enrich", "Trigger Counters", "Soft Spark Cut", "INVALID", "INVALID", "INVALID", "INVALID", "INVALID", "INVALID", "SD card", "sr5", "Knock", "INVALID", "Electronic Throttle", "Executor", "Bench Test / TS commands", "INVALID", "Analog inputs #1", "INSTANT_RPM", "INVALID", "Status", "CJ125", "INVALID", "MAP", "Metrics", "INVALID", "Ion Sense", "TLE8888", "Analog inputs #2", "Dwell Metric", "INVALID", "INVALID", "Boost Control", "INVALID", "INVALID", "ETB Autotune", "Composite Log", "INVALID", "INVALID", "INVALID", "Dyno_View", "Logic_Analyzer", "INVALID", "TCU", "Lua"
+#define debug_mode_e_enum "INVALID", "TPS acceleration enrichment", "INVALID", "Stepper Idle Control", "Engine Load accl enrich", "Trigger Counters", "Soft Spark Cut", "INVALID", "INVALID", "INVALID", "INVALID", "INVALID", "Boot time", "SD card", "sr5", "Knock", "INVALID", "Electronic Throttle", "Executor", "Bench Test / TS commands", "INVALID", "Analog inputs #1", "INSTANT_RPM", "INVALID", "Status", "CJ125", "INVALID", "MAP", "Metrics", "INVALID", "Ion Sense", "TLE8888", "Analog inputs #2", "Dwell Metric", "INVALID", "INVALID", "Boost Control", "INVALID", "INVALID", "ETB Autotune", "Composite Log", "INVALID", "INVALID", "INVALID", "Dyno_View", "Logic_Analyzer", "INVALID", "TCU", "Lua"
 #define debug_mode_e_UNUSED23 23
 #define debugMapAveraging_offset 856
 #define debugMode_offset 1604
@@ -540,6 +540,7 @@
 #define enableFan2WithAc_offset 120
 #define enableInnovateLC2_offset 960
 #define enableLaunchRetard_offset 960
+#define enableLongTermFuelTrim_offset 1372
 #define enableMapEstimationTableFallback_offset 120
 #define enableSoftwareKnock_offset 960
 #define enableTrailingSparks_offset 120
@@ -700,6 +701,7 @@
 #define etb_use_two_wires_offset 120
 #define etbBiasBins_offset 4016
 #define etbBiasValues_offset 4048
+#define etbFastInnerLoop_offset 1372
 #define etbFreq_offset 1862
 #define etbFunctions1_offset 1200
 #define etbFunctions2_offset 1201
@@ -727,6 +729,7 @@
 #define etbWastegatePid_offset_offset 1876
 #define etbWastegatePid_periodMs_offset 1878
 #define etbWastegatePid_pFactor_offset 1864
+#define eventSyncFuelSpark_offset 1372
 #define failedMapFallback_offset 485
 #define fan1ExtraIdle_offset 1736
 #define fan2ExtraIdle_offset 1746
@@ -1675,6 +1678,7 @@
 #define map_sensor_offset 276
 #define map_sensor_type_offset 284
 #define MAP_WINDOW_SIZE 8
+#define mapAdcDecimation_offset 3121
 #define mapAveragingSchedulingAtIndex_offset 1416
 #define mapCamDetectionAnglePosition_offset 496
 #define mapErrorDetectionTooHigh_offset 1492
@@ -1814,6 +1818,7 @@
 #define pin_output_mode_e_OM_OPENDRAIN_INVERTED 3
 #define postCrankingDurationSec_offset 1792
 #define postCrankingFactor_offset 1788
+#define predictiveAngleScheduling_offset 1372
 #define primeBins_offset 2032
 #define primeValues_offset 2528
 #define primingDelay_offset 1747
@@ -1941,7 +1946,7 @@
 #define show_Frankenso_presets true
 #define show_test_presets true
 #define showHumanReadableWarning_offset 960
-#define SIGNATURE_HASH 2288281700
+#define SIGNATURE_HASH 2388021950
 #define silentTriggerError_offset 1360
 #define skippedWheelOnCam_offset 1360
 #define slowAdcAlpha_offset 1600
@@ -2189,6 +2194,7 @@
 #define tpsAccelFractionDivisor_offset 2500
 #define tpsAccelFractionPeriod_offset 2498
 #define tpsAccelLookback_offset 1572
+#define tpsAdcDecimation_offset 3122
 #define tpsDecelEnleanmentMultiplier_offset 1596
 #define tpsDecelEnleanmentThreshold_offset 1592
 #define tpsErrorDetectionTooHigh_offset 130
@@ -2496,7 +2502,7 @@
 #define ts_show_vbatt true
 #define ts_show_vr_threshold_2 true
 #define ts_show_vr_threshold_all true
-#define TS_SIGNATURE "rusEFI 2022.08.22.cypress.2288281700"
+#define TS_SIGNATURE "rusEFI 2022.08.22.cypress.2388021950"
 #define TS_SINGLE_WRITE_COMMAND 'W'
 #define TS_SINGLE_WRITE_COMMAND_char W
 #define TS_TEST_COMMAND 't'
@@ -2537,13 +2543,9 @@
 #define unused1129_offset 1628
 #define unused1130_offset 1628
 #define unused1740b2_offset 1628
-#define unused4080_offset 3121
+#define unused4080_offset 3123
 #define unused962_offset 1040
-#define unused_1484_bit_27_offset 1372
-#define unused_1484_bit_29_offset 1372
-#define unused_1484_bit_30_offset 1372
 #define unused_1484_bit_31_offset 1372
-#define unused_1484_bit_38_offset 1372
 #define unusedBit_45_31_offset 120
 #define unusedBit_539_10_offset 1628
 #define unusedBit_539_11_offset 1628
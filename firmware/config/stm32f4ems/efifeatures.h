@@ -437,5 +437,19 @@
 #define EFI_STORAGE_EXT_SNOR    FALSE
 #endif
 
+/**
+ * Store configuration in internal flash as a journal of changed pages rather than two full copies
+ */
+#ifndef EFI_CONFIG_JOURNAL
+#define EFI_CONFIG_JOURNAL      TRUE
+#endif
+
+/**
+ * Float copies of VE, lambda and ignition tables for the hot path, see shadow_tables.h
+ */
+#ifndef EFI_SHADOW_TABLES
+#define EFI_SHADOW_TABLES       FALSE
+#endif
+
 // killing joystick for now due to Unable to change broken settings #3227
 #define EFI_JOYSTICK FALSE
@@ -15,6 +15,11 @@
 #ifndef EFI_EMBED_INI_MSD
 #define EFI_EMBED_INI_MSD FALSE
 #endif
+
+// plenty of DTCM for float copies of the main tables
+#ifndef EFI_SHADOW_TABLES
+#define EFI_SHADOW_TABLES TRUE
+#endif
  
 #include "../stm32f4ems/efifeatures.h"
 
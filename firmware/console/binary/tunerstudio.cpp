@@ -75,6 +75,7 @@
 #include "tunerstudio_io.h"
 #include "tooth_logger.h"
 #include "electronic_throttle.h"
+#include "config_write_observer.h"
 
 #include <string.h>
 #include "bench_test.h"
@@ -189,6 +190,7 @@ void TunerStudio::handleWriteChunkCommand(TsChannelBase* tsChannel, ts_response_
 	if (!rebootForPresetPending) {
 		uint8_t * addr = (uint8_t *) (getWorkingPageAddr() + offset);
 		memcpy(addr, content, count);
+		getConfigWriteObservers().onWrite({ offset, count });
 	}
 
 	sendOkResponse(tsChannel, mode);
@@ -239,6 +241,7 @@ void TunerStudio::handleWriteValueCommand(TsChannelBase* tsChannel, ts_response_
 	// Skip the write if a preset was just loaded - we don't want to overwrite it
 	if (!rebootForPresetPending) {
 		getWorkingPageAddr()[offset] = value;
+		getConfigWriteObservers().onWrite({ offset, 1 });
 	}
 }
 
@@ -54,6 +54,7 @@
 #include "buffered_writer.h"
 #include "dynoview.h"
 #include "frequency_sensor.h"
+#include "staged_init.h"
 
 extern bool main_loop_started;
 
@@ -915,6 +916,9 @@ void updateTunerStudioState() {
 		reportLogicAnalyzerToTS();
 #endif /* EFI_LOGIC_ANALYZER */		
 		break;
+	case DBG_BOOT_TIME:
+		postBootPhaseState(tsOutputChannels);
+		break;
 	default:
 		;
 	}
@@ -80,6 +80,7 @@
 #include "dc_motor.h"
 #include "dc_motors.h"
 #include "pid_auto_tune.h"
+#include "adc_inputs.h"
 
 #if defined(HAS_OS_ACCESS)
 #error "Unexpected OS ACCESS HERE"
@@ -97,6 +98,18 @@ static pedal2tps_t pedal2tpsMap;
 
 constexpr float etbPeriodSeconds = 1.0f / ETB_LOOP_FREQUENCY;
 
+#if HAL_USE_ADC
+#ifdef FAST_ADC_SKIP
+#define ETB_FAST_ADC_PERIOD_TICKS (GPT_PERIOD_FAST * FAST_ADC_SKIP)
+#else
+#define ETB_FAST_ADC_PERIOD_TICKS GPT_PERIOD_FAST
+#endif
+constexpr float etbInnerLoopPeriodSeconds = (float)ETB_INNER_LOOP_SAMPLES * ETB_FAST_ADC_PERIOD_TICKS / GPT_FREQ_FAST;
+#else
+// same as the default 10kHz fast ADC
+constexpr float etbInnerLoopPeriodSeconds = ETB_INNER_LOOP_SAMPLES / 10000.0f;
+#endif
+
 static bool startupPositionError = false;
 
 #define STARTUP_NEUTRAL_POSITION_ERROR_THRESHOLD 5
@@ -218,6 +231,12 @@ bool EtbController::init(etb_function_e function, DcMotor *motor, pid_s *pidPara
 	m_pid.initPidClass(pidParameters);
 	m_pedalMap = pedalMap;
 
+#if HAL_USE_ADC && EFI_PROD_CODE
+	m_isInnerLoopAvailable = isTpsOnFastAdc();
+#else
+	m_isInnerLoopAvailable = engineConfiguration->etbFastInnerLoop;
+#endif
+
 	// Ignore 3% position error before complaining
 	m_errorAccumulator.init(3.0f, etbPeriodSeconds);
 
@@ -280,8 +299,8 @@ expected<percent_t> EtbController::getSetpointWastegate() const {
 }
 
 expected<percent_t> EtbController::getSetpointEtb() {
-	// Autotune runs with 50% target position
-	if (m_isAutotune) {
+	// Autotune and identification run with 50% target position
+	if (m_isAutotune || m_sysId.isRunning()) {
 		return 50.0f;
 	}
 
@@ -523,12 +542,28 @@ expected<percent_t> EtbController::getClosedLoop(percent_t target, percent_t obs
 
 		// Allow up to 10 percent-seconds of error
 		if (etbIntegralError > 10.0f) {
+			if (m_isInnerLoopActive) {
+				// nothing else watches a motor driven by the inner loop
+				engine->limpManager.etbProblem();
+			}
 			// TODO: figure out how to handle uncalibrated ETB 
 			//engine->limpManager.etbProblem();
 		}
 
+		if (m_isInnerLoopActive) {
+			// The inner loop closes the loop at a higher rate, only pass the target on
+			m_innerLoopTarget = target;
+			return 0;
+		}
+
 		// Normal case - use PID to compute closed loop part
-		return m_pid.getOutput(target, observation, etbPeriodSeconds);
+		float pidOutput = m_pid.getOutput(target, observation, etbPeriodSeconds);
+
+		if (m_sysId.isRunning()) {
+			return m_sysId.update(observation, pidOutput);
+		}
+
+		return pidOutput;
 	}
 }
 
@@ -547,36 +582,93 @@ void EtbController::setOutput(expected<percent_t> outputValue) {
 		&& outputValue
 		&& !engineConfiguration->pauseEtbControl) {
 		m_motor->enable();
-		m_motor->set(ETB_PERCENT_TO_DUTY(outputValue.Value));
+
+		if (m_isInnerLoopActive) {
+			// Closed loop part is zero, what is left is feed forward
+			m_innerLoop.setCommand(m_innerLoopTarget, outputValue.Value);
+		} else {
+			m_motor->set(ETB_PERCENT_TO_DUTY(outputValue.Value));
+		}
 	} else {
 		// Otherwise disable the motor.
+		m_innerLoop.stop();
+		m_sysId.abort();
 		m_motor->disable();
 	}
 }
 
+bool EtbController::canUseInnerLoop() const {
+	// turning it off applies right away, turning it on takes a reboot
+	return m_isInnerLoopAvailable
+		&& engineConfiguration->etbFastInnerLoop
+		&& (m_function == ETB_Throttle1 || m_function == ETB_Throttle2)
+		&& !m_isAutotune
+		// identification needs every sample of the outer loop
+		&& !m_sysId.isRunning()
+		// the inner loop reads the primary sensor as a plain linear TPS
+		&& !engineConfiguration->useFordRedundantTps
+		&& !engineConfiguration->consumeObdSensors;
+}
+
+// TunerStudio TPS calibration to a sum of ETB_INNER_LOOP_SAMPLES raw fast ADC samples
+static float tpsCalToInnerLoopRaw(int16_t value) {
+	float mcuVolts = value / (float)TPS_TS_CONVERSION / engineConfiguration->analogInputDividerCoefficient;
+	return ETB_INNER_LOOP_SAMPLES * voltsToAdc(mcuVolts);
+}
+
+void EtbController::configureInnerLoop() {
+	bool isSecond = m_function == ETB_Throttle2;
+
+	// refreshed every outer loop so that live tuning applies right away
+	m_innerLoop.configure(engineConfiguration->etb, etbInnerLoopPeriodSeconds,
+		engineConfiguration->etb_iTermMin, engineConfiguration->etb_iTermMax,
+		tpsCalToInnerLoopRaw(isSecond ? engineConfiguration->tps2Min : engineConfiguration->tpsMin),
+		tpsCalToInnerLoopRaw(isSecond ? engineConfiguration->tps2Max : engineConfiguration->tpsMax));
+}
+
+void EtbController::updateInnerLoop(uint32_t tps1Raw, uint32_t tps2Raw) {
+	auto output = m_innerLoop.update(m_function == ETB_Throttle2 ? tps2Raw : tps1Raw);
+
+	if (output && m_motor) {
+		m_motor->set(ETB_PERCENT_TO_DUTY(output.Value));
+	}
+}
+
 void EtbController::update() {
 	// If we didn't get initialized, fail fast
 	if (!m_motor) {
 		return;
 	}
 
+	checkSystemIdentification();
+
 #if EFI_TUNER_STUDIO
 	// Only debug throttle #1
 	if (m_function == ETB_Throttle1) {
 		m_pid.postState(engine->outputChannels.etbStatus);
 		engine->outputChannels.etbStatus.output = directPwmValue;
+
+		if (m_isInnerLoopActive) {
+			const auto& innerPid = m_innerLoop.getPid();
+			engine->outputChannels.etbStatus.error = innerPid.getPreviousError() * (1.0f / ETB_INNER_LOOP_SCALE);
+			engine->outputChannels.etbStatus.iTerm = innerPid.getIntegrator() * (1.0f / ETB_INNER_LOOP_SCALE);
+		}
 	}
 #endif /* EFI_TUNER_STUDIO */
 
 	if (!cisnan(directPwmValue)) {
+		m_innerLoop.stop();
+		m_sysId.abort();
 		m_motor->set(directPwmValue);
 		return;
 	}
 
-	if (engineConfiguration->disableEtbWhenEngineStopped) {
+	// identification was explicitly asked for with the engine stopped
+	if (engineConfiguration->disableEtbWhenEngineStopped && !m_sysId.isRunning()) {
 		if (!engine->triggerCentral.engineMovedRecently()) {
 			// If engine is stopped and so configured, skip the ETB update entirely
 			// This is quieter and pulls less power than leaving it on all the time
+			m_innerLoop.stop();
 			m_motor->disable();
 			return;
 		}
@@ -591,6 +683,24 @@ void EtbController::update() {
 		&& engine->etbAutoTune
 		&& m_function == ETB_Throttle1;
 
+	// Only identify with a stopped engine, and never together with autotune
+	if (Sensor::getOrZero(SensorType::Rpm) > 0 || m_isAutotune) {
+		m_sysId.abort();
+	}
+
+	bool isInnerLoopActive = canUseInnerLoop();
+	if (isInnerLoopActive) {
+		configureInnerLoop();
+	} else {
+		m_innerLoop.stop();
+	}
+
+	if (isInnerLoopActive != m_isInnerLoopActive) {
+		// whichever loop takes over starts with a clean PID
+		m_shouldResetPid = true;
+		m_isInnerLoopActive = isInnerLoopActive;
+	}
+
 	ClosedLoopController::update();
 }
 
@@ -601,6 +711,78 @@ void EtbController::autoCalibrateTps() {
 	}
 }
 
+// Loops each identified gain is shown to TunerStudio for
+#define ETB_SYSID_PUBLISH_LOOPS (ETB_LOOP_FREQUENCY / 2)
+
+void EtbController::startSystemIdentification(SysIdExcitation excitation) {
+	// Wastegate position depends on boost, it can't be held at a test position
+	if (m_function != ETB_Throttle1 && m_function != ETB_Throttle2 && m_function != ETB_IdleValve) {
+		return;
+	}
+
+	SysIdSettings settings;
+	settings.periodSeconds = etbPeriodSeconds;
+	settings.excitation = excitation;
+	settings.tuning = SysIdTuning::Pid;
+	// duty cycle
+	settings.amplitude = 8;
+	settings.settleSeconds = 0.5f;
+	settings.exciteSeconds = 3;
+	settings.stepHoldSeconds = 0.15f;
+	settings.chirpStartHz = 0.5f;
+	settings.chirpEndHz = 20;
+	// throttle position, keeps clear of both stops from 50%
+	settings.maxDeviation = 30;
+	settings.closedLoopSeconds = 0.02f;
+
+	m_sysId.start(settings);
+	m_wasSysIdRunning = true;
+	m_sysIdPublishCounter = 0;
+}
+
+void EtbController::checkSystemIdentification() {
+	if (m_wasSysIdRunning && !m_sysId.isRunning()) {
+		m_sysId.printResult("ETB");
+
+		// whatever the PID did while it was not in charge is meaningless
+		m_shouldResetPid = true;
+
+		if (m_sysId.getState() == SysIdState::Done) {
+			m_sysIdPublishCounter = 3 * ETB_SYSID_PUBLISH_LOOPS;
+		}
+	}
+	m_wasSysIdRunning = m_sysId.isRunning();
+
+#if EFI_TUNER_STUDIO
+	if (m_sysIdPublishCounter == 0) {
+		return;
+	}
+
+	m_sysIdPublishCounter--;
+
+	// Same {mode, value} multiplexing as autotune, Kp first
+	const auto& result = m_sysId.getResult();
+	switch (2 - m_sysIdPublishCounter / ETB_SYSID_PUBLISH_LOOPS) {
+	case 0:
+		engine->outputChannels.calibrationMode = (uint8_t)TsCalMode::EtbKp;
+		engine->outputChannels.calibrationValue = result.pFactor;
+		break;
+	case 1:
+		engine->outputChannels.calibrationMode = (uint8_t)TsCalMode::EtbKi;
+		engine->outputChannels.calibrationValue = result.iFactor;
+		break;
+	default:
+		engine->outputChannels.calibrationMode = (uint8_t)TsCalMode::EtbKd;
+		engine->outputChannels.calibrationValue = result.dFactor;
+		break;
+	}
+
+	if (m_sysIdPublishCounter == 0) {
+		engine->outputChannels.calibrationMode = (uint8_t)TsCalMode::None;
+	}
+#endif // EFI_TUNER_STUDIO
+}
+
 #if !EFI_UNIT_TEST
 /**
  * Things running on a timer (instead of a thread) don't participate it the RTOS's thread priority system,
@@ -628,6 +810,8 @@ struct EtbImpl final : public TBase {
 
 		auto myFunction = TBase::getFunction();
 
+		TBase::stopInnerLoop();
+
 		// First grab open
 		motor->set(0.5f);
 		motor->enable();
@@ -692,15 +876,123 @@ struct EtbThread final : public PeriodicController<512> {
 	EtbThread() : PeriodicController("ETB", PRIO_ETB, ETB_LOOP_FREQUENCY) {}
 
 	void PeriodicTask(efitick_t) override {
+		efitick_t startNt = getTimeNowNt();
+
 		// Simply update all controllers
 		for (int i = 0 ; i < ETB_COUNT; i++) {
 			etbControllers[i]->update();
 		}
+
+		stats.onRun(startNt, getTimeNowNt());
 	}
+
+	EtbLoopStats stats;
 };
 
 static EtbThread etbThread CCM_OPTIONAL;
 
+#if HAL_USE_ADC
+
+/**
+ * Woken from the fast ADC callback once ETB_INNER_LOOP_SAMPLES samples were summed. Runs above
+ * everything else so that the position loop period only depends on the ADC timer.
+ */
+struct EtbInnerThread final : public ThreadController<256> {
+	EtbInnerThread() : ThreadController("ETB inner", PRIO_ETB_INNER) {
+		stats.budgetUs = ETB_INNER_LOOP_BUDGET_US;
+	}
+
+	void start() {
+		chSemObjectInit(&m_wake, 0);
+		ThreadController::start();
+		m_isStarted = true;
+	}
+
+	// fast ADC callback context
+	void onAdc(uint16_t tps1, uint16_t tps2) {
+		// fast ADC runs before and without electronic throttle init
+		if (!m_isStarted) {
+			return;
+		}
+
+		m_sum[0] += tps1;
+		m_sum[1] += tps2;
+
+		if (++m_sampleCount < ETB_INNER_LOOP_SAMPLES) {
+			return;
+		}
+
+		m_sampleCount = 0;
+
+		if (m_isPending) {
+			// previous run did not get to pick its samples up yet, drop these
+			overrunCount++;
+		} else {
+			m_ready[0] = m_sum[0];
+			m_ready[1] = m_sum[1];
+			m_isPending = true;
+
+			syssts_t sts = chSysGetStatusAndLockX();
+			chSemSignalI(&m_wake);
+			if (!port_is_isr_context()) {
+				chSchRescheduleS();
+			}
+			chSysRestoreStatusX(sts);
+		}
+
+		m_sum[0] = 0;
+		m_sum[1] = 0;
+	}
+
+	void ThreadTask() override {
+		while (true) {
+			chSemWait(&m_wake);
+
+			efitick_t startNt = getTimeNowNt();
+
+			uint32_t tps1 = m_ready[0];
+			uint32_t tps2 = m_ready[1];
+			m_isPending = false;
+
+			for (int i = 0 ; i < ETB_COUNT; i++) {
+				etbControllers[i]->updateInnerLoop(tps1, tps2);
+			}
+
+			stats.onRun(startNt, getTimeNowNt());
+		}
+	}
+
+	EtbLoopStats stats;
+	uint32_t overrunCount = 0;
+
+private:
+	semaphore_t m_wake;
+
+	uint32_t m_sum[2] = {};
+	volatile uint32_t m_ready[2] = {};
+	volatile bool m_isPending = false;
+	int m_sampleCount = 0;
+	bool m_isStarted = false;
+};
+
+static EtbInnerThread etbInnerThread CCM_OPTIONAL;
+
+void etbFastAdcCallback(uint16_t tps1, uint16_t tps2) {
+	etbInnerThread.onAdc(tps1, tps2);
+}
+#endif // HAL_USE_ADC
+
+#if EFI_PROD_CODE
+static void showEtbLoopStats(const char* name, const EtbLoopStats& stats, float periodSeconds) {
+	float nominalUs = 1e6f * periodSeconds;
+
+	efiPrintf("%s loop %.0fus: %d runs, period %.1f..%.1fus jitter %.1fus, exec last %.1fus max %.1fus",
+		name, nominalUs, (int)stats.count,
+		stats.minPeriodUs, stats.maxPeriodUs, stats.getJitterUs(nominalUs),
+		stats.lastExecUs, stats.maxExecUs);
+}
+#endif /* EFI_PROD_CODE */
+
 #endif
 
 static void showEthInfo() {
@@ -725,6 +1017,18 @@ static void showEthInfo() {
 		showDcMotorInfo(i);
 	}
 
+	showEtbLoopStats("ETB", etbThread.stats, etbPeriodSeconds);
+	etbThread.stats.reset();
+
+#if HAL_USE_ADC
+	efiPrintf("ETB inner loop %s", boolToString(engineConfiguration->etbFastInnerLoop));
+	showEtbLoopStats("ETB inner", etbInnerThread.stats, etbInnerLoopPeriodSeconds);
+	efiPrintf(" %d over %dus budget, %d overruns",
+		(int)etbInnerThread.stats.overBudgetCount, ETB_INNER_LOOP_BUDGET_US, (int)etbInnerThread.overrunCount);
+	etbInnerThread.stats.reset();
+	etbInnerThread.overrunCount = 0;
+#endif // HAL_USE_ADC
+
 #endif /* EFI_PROD_CODE */
 }
 
@@ -826,6 +1130,16 @@ void etbAutocal(size_t throttleIndex) {
 	}
 }
 
+void etbSystemIdentification(size_t throttleIndex, SysIdExcitation excitation) {
+	if (throttleIndex >= ETB_COUNT) {
+		return;
+	}
+
+	if (auto etb = engine->etbControllers[throttleIndex]) {
+		etb->startSystemIdentification(excitation);
+	}
+}
+
 #endif /* !EFI_UNIT_TEST */
 
 /**
@@ -947,6 +1261,10 @@ void doInitElectronicThrottle() {
 	addConsoleAction("ethinfo", showEthInfo);
 	addConsoleAction("etbreset", etbReset);
 	addConsoleActionI("etb_freq", setEtbFrequency);
+	// etb_sysid <index> <0 step, 1 chirp>
+	addConsoleActionII("etb_sysid", [](int index, int excitation) {
+		etbSystemIdentification(index, excitation ? SysIdExcitation::Chirp : SysIdExcitation::Step);
+	});
 
 	// this command is useful for real hardware test with known cheap hardware
 	addConsoleAction("etb_test_hw", [](){
@@ -1009,6 +1327,9 @@ void doInitElectronicThrottle() {
 
 #if !EFI_UNIT_TEST
 	etbThread.start();
+#if HAL_USE_ADC
+	etbInnerThread.start();
+#endif // HAL_USE_ADC
 #endif
 }
 
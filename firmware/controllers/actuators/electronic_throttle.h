@@ -9,6 +9,7 @@
 
 #include "closed_loop_controller.h"
 #include "rusefi_types.h"
+#include "system_identification.h"
 
 void initElectronicThrottle();
 void doInitElectronicThrottle();
@@ -37,6 +38,10 @@ void unregisterEtbPins();
 void setProteusHitachiEtbDefaults();
 
 void etbAutocal(size_t throttleIndex);
+void etbSystemIdentification(size_t throttleIndex, SysIdExcitation excitation);
+
+// Fast ADC conversion complete, primary TPS samples for 'etbFastInnerLoop'
+void etbFastAdcCallback(uint16_t tps1, uint16_t tps2);
 
 class DcMotor;
 struct pid_s;
@@ -53,6 +58,7 @@ public:
 	virtual void setWastegatePosition(percent_t pos) = 0;
 	virtual void update() = 0;
 	virtual void autoCalibrateTps() = 0;
+	virtual void startSystemIdentification(SysIdExcitation excitation) = 0;
 
 	virtual const pid_state_s* getPidState() const = 0;
 
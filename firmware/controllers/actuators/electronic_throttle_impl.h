@@ -13,6 +13,7 @@
 #include "sensor.h"
 #include "efi_pid.h"
 #include "error_accumulator.h"
+#include "etb_inner_loop.h"
 #include "electronic_throttle_generated.h"
 
 /**
@@ -61,6 +62,13 @@ public:
 	// Use the throttle to automatically calibrate the relevant throttle position sensor(s).
 	void autoCalibrateTps() override;
 
+	// Identify the throttle with the engine stopped and suggest PID gains, see system_identification.h
+	void startSystemIdentification(SysIdExcitation excitation) override;
+
+	const SystemIdentification& getSystemIdentification() const {
+		return m_sysId;
+	}
+
 	// Override if this throttle needs special per-throttle adjustment (bank-to-bank trim, for example)
 	virtual percent_t getThrottleTrim(float /*rpm*/, percent_t /*targetPosition*/) const {
 		return 0;
@@ -70,10 +78,26 @@ public:
 	void setLuaAdjustment(percent_t adjustment) override;
 	float getLuaAdjustment() const;
 
+	// Fast ADC side of 'etbFastInnerLoop', raw values are sums of ETB_INNER_LOOP_SAMPLES samples
+	void updateInnerLoop(uint32_t tps1Raw, uint32_t tps2Raw);
+
+	bool isInnerLoopActive() const {
+		return m_isInnerLoopActive;
+	}
+
+	const EtbInnerLoop& getInnerLoop() const {
+		return m_innerLoop;
+	}
+
 protected:
 	// This is set if an automatic TPS calibration should be run
 	bool m_isAutocal = false;
 
+	// Outer loop side: take the motor back from the inner loop
+	void stopInnerLoop() {
+		m_innerLoop.stop();
+	}
+
 	etb_function_e getFunction() const { return m_function; }
 	DcMotor* getMotor() { return m_motor; }
 
@@ -83,6 +107,16 @@ private:
 	DcMotor *m_motor = nullptr;
 	Pid m_pid;
 	bool m_shouldResetPid = false;
+
+	bool canUseInnerLoop() const;
+	void configureInnerLoop();
+
+	EtbInnerLoop m_innerLoop;
+	// latched by init(), fast ADC only samples TPS if 'etbFastInnerLoop' was set at boot
+	bool m_isInnerLoopAvailable = false;
+	// outer loop only computes target and feed forward
+	bool m_isInnerLoopActive = false;
+	percent_t m_innerLoopTarget = 0;
 	ErrorAccumulator m_errorAccumulator;
 
 	// Pedal -> target map
@@ -108,6 +142,13 @@ private:
 	uint8_t m_autotuneCounter = 0;
 	uint8_t m_autotuneCurrentParam = 0;
 
+	void checkSystemIdentification();
+
+	SystemIdentification m_sysId;
+	bool m_wasSysIdRunning = false;
+	// loops left to hand identified gains to TunerStudio
+	uint16_t m_sysIdPublishCounter = 0;
+
 	Timer m_luaAdjustmentTimer;
 };
 
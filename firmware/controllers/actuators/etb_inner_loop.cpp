@@ -0,0 +1,106 @@
+/**
+ * @file etb_inner_loop.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "etb_inner_loop.h"
+
+void EtbLoopStats::onRun(efitick_t startNt, efitick_t endNt) {
+	if (m_lastStartNt != 0) {
+		float periodUs = NT2USF(startNt - m_lastStartNt);
+
+		if (count == 0 || periodUs < minPeriodUs) {
+			minPeriodUs = periodUs;
+		}
+		if (count == 0 || periodUs > maxPeriodUs) {
+			maxPeriodUs = periodUs;
+		}
+
+		count++;
+	}
+	m_lastStartNt = startNt;
+
+	lastExecUs = NT2USF(endNt - startNt);
+	if (lastExecUs > maxExecUs) {
+		maxExecUs = lastExecUs;
+	}
+
+	if (budgetUs != 0 && lastExecUs > budgetUs) {
+		overBudgetCount++;
+	}
+}
+
+void EtbLoopStats::reset() {
+	// keep the last start so that the next period is still measured
+	count = 0;
+	minPeriodUs = 0;
+	maxPeriodUs = 0;
+	lastExecUs = 0;
+	maxExecUs = 0;
+	overBudgetCount = 0;
+}
+
+float EtbLoopStats::getJitterUs(float nominalPeriodUs) const {
+	if (count == 0) {
+		return 0;
+	}
+
+	return maxF(maxPeriodUs - nominalPeriodUs, nominalPeriodUs - minPeriodUs);
+}
+
+void EtbInnerLoop::configure(const pid_s& parameters, float periodSeconds, float iTermMin, float iTermMax, float closedRaw, float openRaw) {
+	// inner loop thread preempts the outer loop, it must never see half of the 64 bit gains and limits
+	chibios_rt::CriticalSectionLocker csl;
+
+	m_pid.configure(parameters, periodSeconds, ETB_INNER_LOOP_SCALE, iTermMin, iTermMax);
+
+	float span = openRaw - closedRaw;
+	m_closedRaw = closedRaw;
+
+	// same sanity as the TPS sensor configuration, an uncalibrated throttle never runs
+	if (absF(span) < ETB_INNER_LOOP_SAMPLES) {
+		m_positionScale = 0;
+	} else {
+		m_positionScale = 100 * ETB_INNER_LOOP_SCALE * (1 << INTEGER_PID_SHIFT) / span;
+	}
+}
+
+void EtbInnerLoop::setCommand(percent_t target, percent_t feedForward) {
+	int16_t targetScaled = clampF(-100, target, 200) * ETB_INNER_LOOP_SCALE;
+	int16_t feedForwardScaled = clampF(-100, feedForward, 100) * ETB_INNER_LOOP_SCALE;
+
+	m_command = ((uint32_t)(uint16_t)targetScaled << 16) | (uint16_t)feedForwardScaled;
+	m_isRunning = true;
+}
+
+void EtbInnerLoop::stop() {
+	m_isRunning = false;
+}
+
+int32_t EtbInnerLoop::getPosition(uint32_t raw) const {
+	return ((int64_t)((int32_t)raw - m_closedRaw) * m_positionScale) >> INTEGER_PID_SHIFT;
+}
+
+expected<percent_t> EtbInnerLoop::update(uint32_t raw) {
+	if (!m_isRunning || m_positionScale == 0) {
+		m_wasRunning = false;
+		return unexpected;
+	}
+
+	// integrator starts from scratch every time the outer loop hands over the motor
+	if (!m_wasRunning) {
+		m_pid.reset();
+		m_wasRunning = true;
+	}
+
+	uint32_t command = m_command;
+	int32_t target = (int16_t)(command >> 16);
+	int32_t feedForward = (int16_t)(command & 0xFFFF);
+
+	int32_t output = feedForward + m_pid.update(target, getPosition(raw));
+
+	return output * (1.0f / ETB_INNER_LOOP_SCALE);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file etb_inner_loop.h
+ * @brief Fast throttle position loop fed by the fast ADC.
+ *
+ * With 'etbFastInnerLoop' the regular ETB loop still computes the target from the pedal, the feed
+ * forward and all the safety checks, but instead of driving the motor it hands target and feed
+ * forward over to this loop. The inner loop runs once per ETB_INNER_LOOP_SAMPLES fast ADC samples,
+ * 2.5kHz with the default 10kHz fast ADC, on raw primary TPS counts with an IntegerPid and owns the
+ * motor until the outer loop calls stop().
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include "integer_pid.h"
+
+// fast ADC samples summed per inner loop run
+#define ETB_INNER_LOOP_SAMPLES 4
+#define ETB_INNER_LOOP_BUDGET_US 10
+// inner loop position and duty are in hundredths of a percent
+#define ETB_INNER_LOOP_SCALE 100
+
+/**
+ * Start to start period and execution time of a periodic loop
+ */
+struct EtbLoopStats {
+	void onRun(efitick_t startNt, efitick_t endNt);
+	void reset();
+
+	// largest distance from the nominal period
+	float getJitterUs(float nominalPeriodUs) const;
+
+	uint32_t count = 0;
+	float minPeriodUs = 0;
+	float maxPeriodUs = 0;
+	float lastExecUs = 0;
+	float maxExecUs = 0;
+	// runs which took longer than the budget given to onRun
+	uint32_t overBudgetCount = 0;
+
+	uint32_t budgetUs = 0;
+
+private:
+	efitick_t m_lastStartNt = 0;
+};
+
+class EtbInnerLoop {
+public:
+	/**
+	 * Outer loop side, safe to call while the inner loop runs: parameters are replaced within a critical section
+	 * @param periodSeconds how often update() is called
+	 * @param closedRaw primary TPS raw value at closed throttle, as passed to update()
+	 */
+	void configure(const pid_s& parameters, float periodSeconds, float iTermMin, float iTermMax, float closedRaw, float openRaw);
+
+	// Outer loop side: take over the motor, or keep it with a fresh target
+	void setCommand(percent_t target, percent_t feedForward);
+	// Outer loop side: give the motor back
+	void stop();
+
+	bool isRunning() const {
+		return m_isRunning;
+	}
+
+	/**
+	 * Inner loop side
+	 * @param raw sum of ETB_INNER_LOOP_SAMPLES primary TPS ADC samples
+	 * @return output in percent, or unexpected while the outer loop owns the motor
+	 */
+	expected<percent_t> update(uint32_t raw);
+
+	// hundredths of a percent
+	int32_t getPosition(uint32_t raw) const;
+
+	const IntegerPid& getPid() const {
+		return m_pid;
+	}
+
+private:
+	IntegerPid m_pid;
+
+	int32_t m_closedRaw = 0;
+	// Q16 hundredths of a percent per raw count
+	int32_t m_positionScale = 0;
+
+	// target in the upper, feed forward in the lower half so that both change in one store
+	volatile uint32_t m_command = 0;
+	volatile bool m_isRunning = false;
+	bool m_wasRunning = false;
+};
@@ -18,6 +18,7 @@
 
 #include "periodic_task.h"
 #include "dc_motors.h"
+#include "config_change_tracker.h"
 
 #if EFI_TUNER_STUDIO
 #include "stepper.h"
@@ -347,6 +348,21 @@ float IdleController::getIdlePosition() {
 			iacPosition = clampPercentValue(iacPosition);
 		}
 
+		if (m_sysId.isRunning()) {
+			// Only while the closed loop holds the idle, anything else is not the plant being identified
+			if (!isBlipping && useClosedLoop && phase == Phase::Idling) {
+				iacPosition = clampPercentValue(m_sysId.update(rpm, iacPosition));
+			} else {
+				m_sysId.abort();
+			}
+
+			if (!m_sysId.isRunning()) {
+				m_sysId.printResult("Idle");
+				// the PID kept running while the excitation was in charge
+				getIdlePid()->reset();
+			}
+		}
+
 #if EFI_TUNER_STUDIO && (EFI_PROD_CODE || EFI_SIMULATOR)
 		engine->outputChannels.isIdleClosedLoop = phase == Phase::Idling;
 		engine->outputChannels.isIdleCoasting = phase == Phase::Coasting;
@@ -369,6 +385,26 @@ float IdleController::getIdlePosition() {
 
 }
 
+void IdleController::startSystemIdentification(SysIdExcitation excitation) {
+	SysIdSettings settings;
+	settings.periodSeconds = SLOW_CALLBACK_PERIOD_MS * 0.001f;
+	settings.excitation = excitation;
+	// derivative on rpm mostly amplifies combustion noise
+	settings.tuning = SysIdTuning::Pi;
+	// idle position
+	settings.amplitude = 3;
+	settings.settleSeconds = 5;
+	settings.exciteSeconds = 30;
+	settings.stepHoldSeconds = 2;
+	settings.chirpStartHz = 0.05f;
+	settings.chirpEndHz = 1;
+	// rpm
+	settings.maxDeviation = 300;
+	settings.closedLoopSeconds = 1;
+
+	m_sysId.start(settings);
+}
+
 void IdleController::onSlowCallback() {
 	float position = getIdlePosition();
 	applyIACposition(position);
@@ -381,6 +417,14 @@ void IdleController::onConfigurationChange(engine_configuration_s const * previo
 #endif
 }
 
+bool IdleController::isAffectedBy(const ConfigChangeTracker& changes) const {
+	static constexpr ConfigRange dependencies[] = {
+		ENGINE_CONFIG_RANGE(idleRpmPid),
+	};
+
+	return changes.isAnyChanged(dependencies);
+}
+
 void IdleController::init() {
 	shouldResetPid = false;
 	mightResetPid = false;
@@ -12,6 +12,7 @@
 #include "rusefi_types.h"
 #include "periodic_task.h"
 #include "efi_pid.h"
+#include "system_identification.h"
 
 struct IIdleController {
 	enum class Phase : uint8_t {
@@ -59,7 +60,15 @@ public:
 	// CLOSED LOOP CORRECTION
 	float getClosedLoop(IIdleController::Phase phase, float tpsPos, int rpm, int targetRpm) override;
 
+	// Identify the engine at idle and suggest idle PID gains, see system_identification.h
+	void startSystemIdentification(SysIdExcitation excitation);
+
+	const SystemIdentification& getSystemIdentification() const {
+		return m_sysId;
+	}
+
 	void onConfigurationChange(engine_configuration_s const * previousConfig) final;
+	bool isAffectedBy(const ConfigChangeTracker& changes) const final;
 	void onSlowCallback() final;
 
 	// Allow querying state from outside
@@ -95,6 +104,8 @@ private:
 	float m_lastAutomaticPosition = 0;
 
 	Pid m_timingPid;
+
+	SystemIdentification m_sysId;
 };
 
 percent_t getIdlePosition();
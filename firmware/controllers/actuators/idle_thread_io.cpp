@@ -235,6 +235,11 @@ void startIdleThread() {
 	// which would be dedicated to just auto-controller?
 
 	addConsoleAction("idlebench", startIdleBench);
+
+	// idle_sysid <0 step, 1 chirp>, needs automatic idle and a warm idling engine
+	addConsoleActionI("idle_sysid", [](int excitation) {
+		engine->module<IdleController>().unmock().startSystemIdentification(excitation ? SysIdExcitation::Chirp : SysIdExcitation::Step);
+	});
 	applyPidSettings();
 #endif /* EFI_UNIT_TEST */
 }
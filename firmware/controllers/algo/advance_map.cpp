@@ -23,6 +23,7 @@
 #include "advance_map.h"
 #include "idle_thread.h"
 #include "launch_control.h"
+#include "shadow_tables.h"
 
 #if EFI_ENGINE_CONTROL
 
@@ -32,6 +33,22 @@ int minCrankingRpm = 0;
 /**
  * @return ignition timing angle advance before TDC
  */
+angle_t getIgnitionTableAdvance(int rpm, float engineLoad) {
+	if (engineConfiguration->timingMode == TM_FIXED) {
+		return engineConfiguration->fixedTiming;
+	}
+
+#if EFI_SHADOW_TABLES
+	return shadowTables.ignition.getValue(rpm, engineLoad);
+#else
+	return interpolate3d(
+		config->ignitionTable,
+		config->ignitionLoadBins, engineLoad,
+		config->ignitionRpmBins, rpm
+	);
+#endif // EFI_SHADOW_TABLES
+}
+
 static angle_t getRunningAdvance(int rpm, float engineLoad) {
 	if (engineConfiguration->timingMode == TM_FIXED) {
 		return engineConfiguration->fixedTiming;
@@ -44,11 +61,7 @@ static angle_t getRunningAdvance(int rpm, float engineLoad) {
 
 	efiAssert(CUSTOM_ERR_ASSERT, !cisnan(engineLoad), "invalid el", NAN);
 
-	float advanceAngle = interpolate3d(
-		config->ignitionTable,
-		config->ignitionLoadBins, engineLoad,
-		config->ignitionRpmBins, rpm
-	);
+	float advanceAngle = getIgnitionTableAdvance(rpm, engineLoad);
 
 	// get advance from the separate table for Idle
 	if (engineConfiguration->useSeparateAdvanceForIdle &&
@@ -10,6 +10,10 @@
 #pragma once
 
 angle_t getAdvance(int rpm, float engineLoad);
+/**
+ * Running timing straight from the table (or fixed timing), without idle table, launch retard or any correction
+ */
+angle_t getIgnitionTableAdvance(int rpm, float engineLoad);
 angle_t getCylinderIgnitionTrim(size_t cylinderNumber, int rpm, float ignitionLoad);
 float getInitialAdvance(int rpm, float map, float advanceMax);
 
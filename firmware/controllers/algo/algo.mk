@@ -8,11 +8,17 @@ CONTROLLERS_ALGO_SRC_CPP = $(PROJECT_DIR)/controllers/algo/advance_map.cpp \
 	$(PROJECT_DIR)/controllers/algo/accel_enrichment.cpp \
 	$(PROJECT_DIR)/controllers/algo/wall_fuel.cpp \
 	$(PROJECT_DIR)/controllers/algo/launch_control.cpp \
+	$(PROJECT_DIR)/controllers/algo/traction_control.cpp \
 	$(PROJECT_DIR)/controllers/algo/dynoview.cpp \
 	$(PROJECT_DIR)/controllers/algo/runtime_state.cpp \
 	$(PROJECT_DIR)/controllers/algo/engine_configuration.cpp \
+	$(PROJECT_DIR)/controllers/algo/config_change_tracker.cpp \
+	$(PROJECT_DIR)/controllers/algo/config_write_observer.cpp \
+	$(PROJECT_DIR)/controllers/algo/cached_correction.cpp \
+	$(PROJECT_DIR)/controllers/algo/shadow_tables.cpp \
 	$(PROJECT_DIR)/controllers/algo/engine.cpp \
 	$(PROJECT_DIR)/controllers/algo/engine2.cpp \
+	$(PROJECT_DIR)/controllers/algo/cylinder_trims.cpp \
 	$(PROJECT_DIR)/controllers/algo/gear_detector.cpp \
 	$(PROJECT_DIR)/controllers/gauges/lcd_menu_tree.cpp \
 	$(PROJECT_DIR)/controllers/algo/event_registry.cpp \
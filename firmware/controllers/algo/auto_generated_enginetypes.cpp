@@ -86,6 +86,8 @@ case DBG_ANALOG_INPUTS2:
   return "DBG_ANALOG_INPUTS2";
 case DBG_BENCH_TEST:
   return "DBG_BENCH_TEST";
+case DBG_BOOT_TIME:
+  return "DBG_BOOT_TIME";
 case DBG_CJ125:
   return "DBG_CJ125";
 case DBG_COMPOSITE_LOG:
@@ -132,8 +134,6 @@ case DBG_TPS_ACCEL:
   return "DBG_TPS_ACCEL";
 case DBG_TRIGGER_COUNTERS:
   return "DBG_TRIGGER_COUNTERS";
-case DBG_UNUSED12:
-  return "DBG_UNUSED12";
 case DBG_UNUSED41:
   return "DBG_UNUSED41";
 case DBG_UNUSED_42:
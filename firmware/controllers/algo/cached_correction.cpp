@@ -0,0 +1,156 @@
+/**
+ * @file cached_correction.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "cached_correction.h"
+#include "fuel_math.h"
+
+CachedCorrection::CachedCorrection(const char* name, compute_t compute,
+		const CorrectionInput* inputs, size_t inputCount,
+		const ConfigRange* tables, size_t tableCount)
+	: m_name(name)
+	, m_compute(compute)
+	, m_inputCount(inputCount)
+	, m_tableCount(tableCount)
+{
+	for (size_t i = 0; i < inputCount; i++) {
+		m_inputs[i] = inputs[i];
+	}
+
+	for (size_t i = 0; i < tableCount; i++) {
+		m_tables[i] = tables[i];
+	}
+}
+
+bool CachedCorrection::haveInputsMoved() const {
+	for (size_t i = 0; i < m_inputCount; i++) {
+		auto input = Sensor::get(m_inputs[i].type);
+
+		if (input.Valid != m_lastInputValid[i]) {
+			return true;
+		}
+
+		if (input.Valid && absF(input.Value - m_lastInputs[i]) > m_inputs[i].epsilon) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void CachedCorrection::rememberInputs() {
+	for (size_t i = 0; i < m_inputCount; i++) {
+		auto input = Sensor::get(m_inputs[i].type);
+
+		m_lastInputValid[i] = input.Valid;
+		m_lastInputs[i] = input.Value;
+	}
+}
+
+float CachedCorrection::get() {
+	uint32_t generation = m_generation;
+
+	if (m_valueGeneration == generation && !haveInputsMoved()) {
+		m_hits++;
+		return m_value;
+	}
+
+	m_misses++;
+
+	// inputs and generation are remembered before the call, a sensor update or a live edit
+	// in between just means one more miss
+	rememberInputs();
+	m_value = m_compute();
+	m_valueGeneration = generation;
+
+	return m_value;
+}
+
+bool CachedCorrection::dependsOn(ConfigRange range) const {
+	for (size_t i = 0; i < m_tableCount; i++) {
+		const auto& table = m_tables[i];
+
+		if (range.offset < table.offset + table.size && table.offset < range.offset + range.size) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool CachedCorrection::isAffectedBy(const ConfigChangeTracker& changes) const {
+	for (size_t i = 0; i < m_tableCount; i++) {
+		if (changes.isChanged(m_tables[i])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// everything the corrections below read, so that other live edits are not even looked at
+static constexpr ConfigRange slowCorrectionTables[] = {
+	TABLE_CONFIG_RANGE(iatFuelCorrBins),
+	TABLE_CONFIG_RANGE(iatFuelCorr),
+	TABLE_CONFIG_RANGE(cltFuelCorrBins),
+	TABLE_CONFIG_RANGE(cltFuelCorr),
+	TABLE_CONFIG_RANGE(cltTimingBins),
+	TABLE_CONFIG_RANGE(cltTimingExtra),
+	TABLE_CONFIG_RANGE(baroCorrPressureBins),
+	TABLE_CONFIG_RANGE(baroCorrRpmBins),
+	TABLE_CONFIG_RANGE(baroCorrTable),
+};
+
+SlowCorrections::SlowCorrections()
+	: ConfigWriteConsumer(slowCorrectionTables)
+	, iatFuel("IAT fuel", getIatFuelCorrection,
+		{ { SensorType::Iat, 0.1f } },
+		{ TABLE_CONFIG_RANGE(iatFuelCorrBins), TABLE_CONFIG_RANGE(iatFuelCorr) })
+	, cltFuel("CLT fuel", getCltFuelCorrection,
+		{ { SensorType::Clt, 0.1f } },
+		{ TABLE_CONFIG_RANGE(cltFuelCorrBins), TABLE_CONFIG_RANGE(cltFuelCorr) })
+	, cltTiming("CLT timing", getCltTimingCorrection,
+		{ { SensorType::Clt, 0.1f } },
+		{ TABLE_CONFIG_RANGE(cltTimingBins), TABLE_CONFIG_RANGE(cltTimingExtra) })
+	// table has an RPM axis, bins are hundreds of RPM apart so a 50 RPM move hardly changes the result
+	, baro("baro", getBaroCorrection,
+		{ { SensorType::BarometricPressure, 0.05f }, { SensorType::Rpm, 50 } },
+		{ TABLE_CONFIG_RANGE(baroCorrPressureBins), TABLE_CONFIG_RANGE(baroCorrRpmBins), TABLE_CONFIG_RANGE(baroCorrTable) })
+{
+}
+
+void SlowCorrections::onConfigurationChange(const ConfigChangeTracker& changes) {
+	forEach([&changes](CachedCorrection& correction) {
+		if (correction.isAffectedBy(changes)) {
+			correction.invalidate();
+		}
+	});
+}
+
+void SlowCorrections::onConfigurationWrite(ConfigRange range) {
+	forEach([range](CachedCorrection& correction) {
+		if (correction.dependsOn(range)) {
+			correction.invalidate();
+		}
+	});
+}
+
+void SlowCorrections::onConfigWrite(size_t /*region*/, ConfigRange written) {
+	onConfigurationWrite(written);
+}
+
+void SlowCorrections::showInfo() {
+	forEach([](CachedCorrection& correction) {
+		uint32_t hits = correction.getHits();
+		uint32_t total = hits + correction.getMisses();
+
+		efiPrintf("%s correction: %d hits %d misses (%d%%)", correction.getName(),
+			(int)hits, (int)correction.getMisses(), total == 0 ? 0 : (int)(100 * (uint64_t)hits / total));
+
+		correction.resetCounters();
+	});
+}
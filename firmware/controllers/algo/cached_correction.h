@@ -0,0 +1,127 @@
+/**
+ * @file cached_correction.h
+ * @brief Memoized corrections which depend on slow changing inputs only.
+ *
+ * IAT, CLT and baro corrections used to be interpolated on every fast callback even though their
+ * inputs barely move. A CachedCorrection declares the sensors and configuration ranges it depends
+ * on and only calls the underlying function once a sensor moved by more than its epsilon, a sensor
+ * changed validity or a declared range was written.
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include "persistent_configuration.h"
+#include "sensor_type.h"
+#include "config_change_tracker.h"
+#include "config_write_observer.h"
+
+#define CACHED_CORRECTION_MAX_INPUTS 2
+#define CACHED_CORRECTION_MAX_TABLES 3
+
+struct CorrectionInput {
+	SensorType type;
+	// smaller moves than this keep the remembered result
+	float epsilon;
+};
+
+class CachedCorrection {
+public:
+	using compute_t = float (*)();
+
+	template <size_t TInputCount, size_t TTableCount>
+	CachedCorrection(const char* name, compute_t compute,
+			const CorrectionInput (&inputs)[TInputCount],
+			const ConfigRange (&tables)[TTableCount])
+		: CachedCorrection(name, compute, inputs, TInputCount, tables, TTableCount)
+	{
+		static_assert(TInputCount <= CACHED_CORRECTION_MAX_INPUTS, "too many correction inputs");
+		static_assert(TTableCount <= CACHED_CORRECTION_MAX_TABLES, "too many correction tables");
+	}
+
+	float get();
+
+	// may be called while get() is computing on another thread, the result is then not kept
+	void invalidate() {
+		m_generation++;
+	}
+
+	// true if any of the declared configuration ranges overlaps with given one
+	bool dependsOn(ConfigRange range) const;
+	bool isAffectedBy(const ConfigChangeTracker& changes) const;
+
+	const char* getName() const {
+		return m_name;
+	}
+
+	uint32_t getHits() const {
+		return m_hits;
+	}
+
+	uint32_t getMisses() const {
+		return m_misses;
+	}
+
+	void resetCounters() {
+		m_hits = 0;
+		m_misses = 0;
+	}
+
+private:
+	CachedCorrection(const char* name, compute_t compute,
+			const CorrectionInput* inputs, size_t inputCount,
+			const ConfigRange* tables, size_t tableCount);
+
+	bool haveInputsMoved() const;
+	void rememberInputs();
+
+	const char* const m_name;
+	const compute_t m_compute;
+
+	CorrectionInput m_inputs[CACHED_CORRECTION_MAX_INPUTS];
+	size_t m_inputCount = 0;
+	ConfigRange m_tables[CACHED_CORRECTION_MAX_TABLES];
+	size_t m_tableCount = 0;
+
+	float m_lastInputs[CACHED_CORRECTION_MAX_INPUTS] = {};
+	bool m_lastInputValid[CACHED_CORRECTION_MAX_INPUTS] = {};
+
+	float m_value = 0;
+	// bumped by invalidate(), m_value is good while it matches the one it was computed for
+	uint32_t m_generation = 1;
+	uint32_t m_valueGeneration = 0;
+
+	uint32_t m_hits = 0;
+	uint32_t m_misses = 0;
+};
+
+/**
+ * Corrections which periodicFastCallback used to recompute every time
+ */
+class SlowCorrections : public ConfigWriteConsumer {
+public:
+	SlowCorrections();
+
+	// a burn, checked against the declared ranges of every correction
+	void onConfigurationChange(const ConfigChangeTracker& changes);
+	// a live edit from TunerStudio
+	void onConfigurationWrite(ConfigRange range);
+	void onConfigWrite(size_t region, ConfigRange written) override;
+
+	void showInfo();
+
+	CachedCorrection iatFuel;
+	CachedCorrection cltFuel;
+	CachedCorrection cltTiming;
+	CachedCorrection baro;
+
+private:
+	template <typename TFunc>
+	void forEach(TFunc f) {
+		f(iatFuel);
+		f(cltFuel);
+		f(cltTiming);
+		f(baro);
+	}
+};
@@ -0,0 +1,126 @@
+/**
+ * @file config_change_tracker.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "config_change_tracker.h"
+
+static_assert(offsetof(persistent_config_s, engineConfiguration) == 0, "tracker expects engine configuration first");
+static_assert(sizeof(persistent_config_s) <= UINT16_MAX, "ConfigRange offsets are 16 bit");
+
+uint32_t ConfigChangeTracker::getTableBlockCrc(const persistent_config_s& current, size_t block) const {
+	size_t offset = block * CONFIG_CHANGE_TABLE_BLOCK_SIZE;
+	size_t size = minI(CONFIG_CHANGE_TABLE_BLOCK_SIZE, tableSize - offset);
+
+	return crc32(reinterpret_cast<const uint8_t*>(&current) + engineSize + offset, size);
+}
+
+void ConfigChangeTracker::remember(const persistent_config_s& current) {
+	for (size_t i = 0; i < tableBlocks; i++) {
+		m_tableCrcs[i] = getTableBlockCrc(current, i);
+	}
+
+	m_hasBaseline = true;
+}
+
+void ConfigChangeTracker::update(const persistent_config_s& current, const engine_configuration_s& previous) {
+	memset(m_engineChanged, 0, sizeof(m_engineChanged));
+	memset(m_tableChanged, 0, sizeof(m_tableChanged));
+
+	auto now = reinterpret_cast<const uint8_t*>(&current.engineConfiguration);
+	auto before = reinterpret_cast<const uint8_t*>(&previous);
+
+	for (size_t i = 0; i < engineBlocks; i++) {
+		size_t offset = i * CONFIG_CHANGE_BLOCK_SIZE;
+		size_t size = minI(CONFIG_CHANGE_BLOCK_SIZE, engineSize - offset);
+
+		if (memcmp(now + offset, before + offset, size) != 0) {
+			setBit(m_engineChanged, i);
+		}
+	}
+
+	for (size_t i = 0; i < tableBlocks; i++) {
+		if (!m_hasBaseline || getTableBlockCrc(current, i) != m_tableCrcs[i]) {
+			setBit(m_tableChanged, i);
+		}
+	}
+}
+
+void ConfigChangeTracker::markAllChanged() {
+	for (size_t i = 0; i < engineBlocks; i++) {
+		setBit(m_engineChanged, i);
+	}
+
+	for (size_t i = 0; i < tableBlocks; i++) {
+		setBit(m_tableChanged, i);
+	}
+}
+
+bool ConfigChangeTracker::isAnyBitSet(const uint32_t* bits, size_t first, size_t last) const {
+	for (size_t i = first; i <= last; i++) {
+		if (testBit(bits, i)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool ConfigChangeTracker::isChanged(ConfigRange range) const {
+	if (range.size == 0) {
+		return false;
+	}
+
+	size_t start = range.offset;
+	size_t end = start + range.size - 1;
+
+	if (start < engineSize) {
+		size_t engineEnd = minI(end, engineSize - 1);
+
+		if (isAnyBitSet(m_engineChanged, start / CONFIG_CHANGE_BLOCK_SIZE, engineEnd / CONFIG_CHANGE_BLOCK_SIZE)) {
+			return true;
+		}
+	}
+
+	if (end >= engineSize) {
+		size_t tableStart = maxI(start, engineSize) - engineSize;
+		size_t tableEnd = end - engineSize;
+
+		if (isAnyBitSet(m_tableChanged, tableStart / CONFIG_CHANGE_TABLE_BLOCK_SIZE, tableEnd / CONFIG_CHANGE_TABLE_BLOCK_SIZE)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool ConfigChangeTracker::isEngineConfigurationChanged() const {
+	return isAnyBitSet(m_engineChanged, 0, engineBlocks - 1);
+}
+
+bool ConfigChangeTracker::isTableChanged() const {
+	return isAnyBitSet(m_tableChanged, 0, tableBlocks - 1);
+}
+
+size_t ConfigChangeTracker::getChangedBlockCount() const {
+	size_t count = 0;
+
+	for (size_t i = 0; i < engineBlocks; i++) {
+		count += testBit(m_engineChanged, i);
+	}
+
+	for (size_t i = 0; i < tableBlocks; i++) {
+		count += testBit(m_tableChanged, i);
+	}
+
+	return count;
+}
+
+static ConfigChangeTracker configChangeTracker;
+
+ConfigChangeTracker& getConfigChangeTracker() {
+	return configChangeTracker;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file config_change_tracker.h
+ * @brief Which parts of the configuration were changed by a burn.
+ *
+ * Burn used to re-apply everything, even after a single table cell edit. The tracker splits
+ * persistent_config_s in to blocks and marks the ones which differ from what was applied last
+ * time, so that only subsystems depending on changed fields get re-initialized.
+ *
+ * engine_configuration_s is compared byte by byte against activeConfiguration. Tables have no
+ * 'active' copy, for them a CRC of every block is remembered instead.
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/* engine_configuration_s granularity, one bit of RAM per block */
+#ifndef CONFIG_CHANGE_BLOCK_SIZE
+#define CONFIG_CHANGE_BLOCK_SIZE 32
+#endif
+
+/* granularity of everything after engine_configuration_s, 4 bytes of RAM per block */
+#ifndef CONFIG_CHANGE_TABLE_BLOCK_SIZE
+#define CONFIG_CHANGE_TABLE_BLOCK_SIZE 256
+#endif
+
+/**
+ * Byte range within persistent_config_s
+ */
+struct ConfigRange {
+	uint16_t offset;
+	uint16_t size;
+};
+
+#define ENGINE_CONFIG_RANGE(field) ConfigRange{ \
+	(uint16_t)(offsetof(persistent_config_s, engineConfiguration) + offsetof(engine_configuration_s, field)), \
+	(uint16_t)sizeof(static_cast<engine_configuration_s*>(nullptr)->field) }
+
+#define TABLE_CONFIG_RANGE(field) ConfigRange{ \
+	(uint16_t)offsetof(persistent_config_s, field), \
+	(uint16_t)sizeof(static_cast<persistent_config_s*>(nullptr)->field) }
+
+class ConfigChangeTracker {
+public:
+	/**
+	 * Baseline of the table area, call once configuration was applied
+	 */
+	void remember(const persistent_config_s& current);
+
+	/**
+	 * Find blocks which differ from the previously applied configuration
+	 */
+	void update(const persistent_config_s& current, const engine_configuration_s& previous);
+
+	// used when there is nothing reliable to compare against
+	void markAllChanged();
+
+	bool isChanged(ConfigRange range) const;
+
+	template <size_t N>
+	bool isAnyChanged(const ConfigRange (&ranges)[N]) const {
+		for (size_t i = 0; i < N; i++) {
+			if (isChanged(ranges[i])) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool isEngineConfigurationChanged() const;
+	bool isTableChanged() const;
+
+	size_t getChangedBlockCount() const;
+
+private:
+	static constexpr size_t engineSize = sizeof(engine_configuration_s);
+	static constexpr size_t tableSize = sizeof(persistent_config_s) - engineSize;
+
+	static constexpr size_t engineBlocks = (engineSize + CONFIG_CHANGE_BLOCK_SIZE - 1) / CONFIG_CHANGE_BLOCK_SIZE;
+	static constexpr size_t tableBlocks = (tableSize + CONFIG_CHANGE_TABLE_BLOCK_SIZE - 1) / CONFIG_CHANGE_TABLE_BLOCK_SIZE;
+
+	static bool testBit(const uint32_t* bits, size_t index) {
+		return bits[index / 32] & (1u << (index % 32));
+	}
+
+	static void setBit(uint32_t* bits, size_t index) {
+		bits[index / 32] |= 1u << (index % 32);
+	}
+
+	bool isAnyBitSet(const uint32_t* bits, size_t first, size_t last) const;
+
+	uint32_t getTableBlockCrc(const persistent_config_s& current, size_t block) const;
+
+	uint32_t m_engineChanged[(engineBlocks + 31) / 32] = {};
+	uint32_t m_tableChanged[(tableBlocks + 31) / 32] = {};
+
+	uint32_t m_tableCrcs[tableBlocks] = {};
+	// false until remember() was called, all tables count as changed then
+	bool m_hasBaseline = false;
+};
+
+ConfigChangeTracker& getConfigChangeTracker();
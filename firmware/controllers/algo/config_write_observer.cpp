@@ -0,0 +1,95 @@
+/**
+ * @file config_write_observer.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "config_write_observer.h"
+
+static bool getIntersection(ConfigRange a, ConfigRange b, ConfigRange& result) {
+	size_t start = maxI(a.offset, b.offset);
+	size_t end = minI(a.offset + a.size, b.offset + b.size);
+
+	if (start >= end) {
+		return false;
+	}
+
+	result = { (uint16_t)start, (uint16_t)(end - start) };
+	return true;
+}
+
+bool ConfigWriteObservers::add(ConfigWriteConsumer& consumer) {
+	if (m_consumerCount >= CONFIG_WRITE_MAX_CONSUMERS) {
+		firmwareError(OBD_PCM_Processor_Fault, "too many config write consumers");
+		return false;
+	}
+
+	m_consumers[m_consumerCount++] = &consumer;
+
+	for (size_t i = 0; i < consumer.getRegionCount(); i++) {
+		ConfigRange region = consumer.getRegions()[i];
+		if (region.size == 0) {
+			continue;
+		}
+
+		size_t last = minI((region.offset + region.size - 1) / CONFIG_WRITE_BLOCK_SIZE, blockCount - 1);
+		for (size_t block = region.offset / CONFIG_WRITE_BLOCK_SIZE; block <= last; block++) {
+			m_observedBlocks[block / 32] |= 1u << (block % 32);
+		}
+	}
+
+	return true;
+}
+
+void ConfigWriteObservers::clear() {
+	m_consumerCount = 0;
+	memset(m_observedBlocks, 0, sizeof(m_observedBlocks));
+}
+
+bool ConfigWriteObservers::isObserved(ConfigRange range) const {
+	if (range.size == 0) {
+		return false;
+	}
+
+	size_t last = minI((range.offset + range.size - 1) / CONFIG_WRITE_BLOCK_SIZE, blockCount - 1);
+	for (size_t block = range.offset / CONFIG_WRITE_BLOCK_SIZE; block <= last; block++) {
+		if (m_observedBlocks[block / 32] & (1u << (block % 32))) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ConfigWriteObservers::onWrite(ConfigRange written) {
+	m_writeCount++;
+
+	if (!isObserved(written)) {
+		return;
+	}
+
+	for (size_t i = 0; i < m_consumerCount; i++) {
+		ConfigWriteConsumer& consumer = *m_consumers[i];
+
+		for (size_t region = 0; region < consumer.getRegionCount(); region++) {
+			ConfigRange inside;
+			if (getIntersection(written, consumer.getRegions()[region], inside)) {
+				consumer.onConfigWrite(region, inside);
+				m_notificationCount++;
+			}
+		}
+	}
+}
+
+void ConfigWriteObservers::showInfo() const {
+	efiPrintf("config writes: %d consumers, %d writes, %d notifications",
+		(int)m_consumerCount, (int)m_writeCount, (int)m_notificationCount);
+}
+
+static ConfigWriteObservers configWriteObservers;
+
+ConfigWriteObservers& getConfigWriteObservers() {
+	return configWriteObservers;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file config_write_observer.h
+ * @brief Live TunerStudio edits dispatched to whatever derives data from the edited tables.
+ *
+ * Online tuning writes straight in to the working configuration. Instead of every cache being
+ * told about every write, a consumer declares the tables and curves it reads as ranges of the
+ * generated persistent_config_s layout and only hears about writes which land in one of them,
+ * along with which one and the part of the write inside it.
+ *
+ * Writes to parts of the configuration nobody observes are dropped after a single bit test, so
+ * a burst of chunk writes while tuning costs next to nothing.
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include "persistent_configuration.h"
+#include "config_change_tracker.h"
+
+#ifndef CONFIG_WRITE_MAX_CONSUMERS
+#define CONFIG_WRITE_MAX_CONSUMERS 4
+#endif
+
+/* granularity of the 'does anyone care' filter, one bit of RAM per block */
+#ifndef CONFIG_WRITE_BLOCK_SIZE
+#define CONFIG_WRITE_BLOCK_SIZE 64
+#endif
+
+class ConfigWriteConsumer {
+public:
+	template <size_t N>
+	ConfigWriteConsumer(const ConfigRange (&regions)[N])
+		: m_regions(regions)
+		, m_regionCount(N)
+	{
+	}
+
+	/**
+	 * @param region index in to the declared regions
+	 * @param written part of the write which is inside that region
+	 */
+	virtual void onConfigWrite(size_t region, ConfigRange written) = 0;
+
+	const ConfigRange* getRegions() const {
+		return m_regions;
+	}
+
+	size_t getRegionCount() const {
+		return m_regionCount;
+	}
+
+private:
+	const ConfigRange* const m_regions;
+	const size_t m_regionCount;
+};
+
+class ConfigWriteObservers {
+public:
+	bool add(ConfigWriteConsumer& consumer);
+	void clear();
+
+	/**
+	 * A range of the working configuration was just written
+	 */
+	void onWrite(ConfigRange written);
+
+	// true if at least one consumer declared a region overlapping given range
+	bool isObserved(ConfigRange range) const;
+
+	void showInfo() const;
+
+	uint32_t getWriteCount() const {
+		return m_writeCount;
+	}
+
+	uint32_t getNotificationCount() const {
+		return m_notificationCount;
+	}
+
+private:
+	static constexpr size_t blockCount = (sizeof(persistent_config_s) + CONFIG_WRITE_BLOCK_SIZE - 1) / CONFIG_WRITE_BLOCK_SIZE;
+
+	ConfigWriteConsumer* m_consumers[CONFIG_WRITE_MAX_CONSUMERS] = {};
+	size_t m_consumerCount = 0;
+
+	uint32_t m_observedBlocks[(blockCount + 31) / 32] = {};
+
+	uint32_t m_writeCount = 0;
+	uint32_t m_notificationCount = 0;
+};
+
+ConfigWriteObservers& getConfigWriteObservers();
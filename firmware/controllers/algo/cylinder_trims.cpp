@@ -0,0 +1,62 @@
+/**
+ * @file cylinder_trims.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "cylinder_trims.h"
+
+static float linterp(float low, float high, float frac) {
+	return high * frac + low * (1 - frac);
+}
+
+/**
+ * Interpolates the same cell of every cylinder's trim table. Corners are gathered first so that
+ * the math runs over plain arrays.
+ */
+template <typename TLoadBin, typename TRpmBin>
+static void interpolateTrims(float (&out)[MAX_CYLINDER_COUNT], const cyl_trim_s (&tables)[MAX_CYLINDER_COUNT], size_t count,
+		const TLoadBin& loadBins, float load, const TRpmBin& rpmBins, float rpm) {
+	BinFraction row = getBinFraction(load, loadBins);
+	BinFraction col = getBinFraction(rpm, rpmBins);
+
+	float lowerLeft[MAX_CYLINDER_COUNT];
+	float upperLeft[MAX_CYLINDER_COUNT];
+	float lowerRight[MAX_CYLINDER_COUNT];
+	float upperRight[MAX_CYLINDER_COUNT];
+
+	for (size_t i = 0; i < count; i++) {
+		const auto& table = tables[i].table;
+
+		lowerLeft[i] = table[row.idx][col.idx];
+		upperLeft[i] = table[row.idx + 1][col.idx];
+		lowerRight[i] = table[row.idx][col.idx + 1];
+		upperRight[i] = table[row.idx + 1][col.idx + 1];
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		float left = linterp(lowerLeft[i], upperLeft[i], row.frac);
+		float right = linterp(lowerRight[i], upperRight[i], row.frac);
+
+		out[i] = linterp(left, right, col.frac);
+	}
+}
+
+void getCylinderTrims(CylinderTrims& trims, size_t cylinderCount, int rpm, float fuelLoad, float ignitionLoad) {
+	cylinderCount = minI(cylinderCount, MAX_CYLINDER_COUNT);
+
+	interpolateTrims(trims.fuel, config->fuelTrims, cylinderCount,
+		config->fuelTrimLoadBins, fuelLoad,
+		config->fuelTrimRpmBins, rpm);
+
+	// Convert from percent +- to multiplier
+	for (size_t i = 0; i < cylinderCount; i++) {
+		trims.fuel[i] = (100 + trims.fuel[i]) / 100;
+	}
+
+	interpolateTrims(trims.ignition, config->ignTrims, cylinderCount,
+		config->ignTrimLoadBins, ignitionLoad,
+		config->ignTrimRpmBins, rpm);
+}
@@ -0,0 +1,23 @@
+/**
+ * @file cylinder_trims.h
+ * @brief Fuel and ignition trims of all cylinders in one pass.
+ *
+ * All per cylinder trim tables share the same axes, so the bin search and interpolation weights
+ * are computed once and only the four surrounding cells are read from each cylinder's table.
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+struct CylinderTrims {
+	// multiplier, 1.05 means 5% more fuel
+	float fuel[MAX_CYLINDER_COUNT];
+	// degrees added to timing advance
+	angle_t ignition[MAX_CYLINDER_COUNT];
+};
+
+/**
+ * Same results as getCylinderFuelTrim() and getCylinderIgnitionTrim() for the first cylinderCount cylinders
+ */
+void getCylinderTrims(CylinderTrims& trims, size_t cylinderCount, int rpm, float fuelLoad, float ignitionLoad);
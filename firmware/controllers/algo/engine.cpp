@@ -366,6 +366,8 @@ void Engine::resetLua() {
 	ignitionState.luaTimingAdd = 0;
 	ignitionState.luaTimingMult = 1;
 	module<IdleController>().unmock().luaAdd = 0;
+	// sampler channels only exist for the script which added them
+	module<AngleSyncSampler>()->clear();
 }
 
 /**
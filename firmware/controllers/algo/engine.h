@@ -28,6 +28,7 @@
 #include "idle_thread.h"
 #include "injector_model.h"
 #include "launch_control.h"
+#include "traction_control.h"
 #include "trigger_scheduler.h"
 #include "fuel_pump.h"
 #include "main_relay.h"
@@ -41,6 +42,8 @@
 #include "advance_map.h"
 #include "fan_control.h"
 #include "sensor_checker.h"
+#include "angle_sync_sampler.h"
+#include "long_term_fuel_trim.h"
 
 #ifndef EFI_UNIT_TEST
 #error EFI_UNIT_TEST must be defined!
@@ -188,12 +191,14 @@ public:
 		AcController,
 		PrimeController,
 		DfcoController,
+		LongTermFuelTrim,
 		Mockable<WallFuelController>,
 #if EFI_VEHICLE_SPEED
 		GearDetector,
 #endif // EFI_VEHICLE_SPEED
 		KnockController,
 		SensorChecker,
+		AngleSyncSampler,
 		EngineModule // dummy placeholder so the previous entries can all have commas
 		> engineModules;
 
@@ -214,6 +219,7 @@ public:
 #if EFI_LAUNCH_CONTROL
 	LaunchControlBase launchController;
 	SoftSparkLimiter softSparkLimiter;
+	TractionController tractionController;
 #endif // EFI_LAUNCH_CONTROL
 
 #if EFI_BOOST_CONTROL
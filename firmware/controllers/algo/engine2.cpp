@@ -17,6 +17,7 @@
 #include "closed_loop_fuel.h"
 #include "launch_control.h"
 #include "injector_model.h"
+#include "cylinder_trims.h"
 #include "tunerstudio.h"
 
 #if EFI_PROD_CODE
@@ -130,10 +131,9 @@ void EngineState::periodicFastCallback() {
 	sparkDwell = engine->ignitionState.getSparkDwell(rpm);
 	dwellAngle = cisnan(rpm) ? NAN :  sparkDwell / getOneDegreeTimeMs(rpm);
 
-	// todo: move this into slow callback, no reason for IAT corr to be here
-	running.intakeTemperatureCoefficient = getIatFuelCorrection();
-	// todo: move this into slow callback, no reason for CLT corr to be here
-	running.coolantTemperatureCoefficient = getCltFuelCorrection();
+	// these only get recomputed once their sensors or tables changed
+	running.intakeTemperatureCoefficient = slowCorrections.iatFuel.get();
+	running.coolantTemperatureCoefficient = slowCorrections.cltFuel.get();
 
 	engine->module<DfcoController>()->update();
 
@@ -147,9 +147,9 @@ void EngineState::periodicFastCallback() {
 		running.postCrankingFuelCorrection = 1.0f;
 	}
 
-	cltTimingCorrection = getCltTimingCorrection();
+	cltTimingCorrection = slowCorrections.cltTiming.get();
 
-	baroCorrection = getBaroCorrection();
+	baroCorrection = slowCorrections.baro.get();
 
 	auto tps = Sensor::get(SensorType::Tps1);
 	updateTChargeK(rpm, tps.value_or(0));
@@ -163,25 +163,36 @@ void EngineState::periodicFastCallback() {
 	float fuelLoad = getFuelingLoad();
 	injectionOffset = getInjectionOffset(rpm, fuelLoad);
 
-	float ignitionLoad = getIgnitionLoad();
-	float advance = getAdvance(rpm, ignitionLoad) * engine->ignitionState.luaTimingMult + engine->ignitionState.luaTimingAdd;
-
 	// compute per-bank fueling
 	for (size_t i = 0; i < STFT_BANK_COUNT; i++) {
 		float corr = clResult.banks[i];
 		engine->stftCorrection[i] = corr;
 	}
 
+	float ignitionLoad = getIgnitionLoad();
+	float advance = getAdvance(rpm, ignitionLoad) * engine->ignitionState.luaTimingMult + engine->ignitionState.luaTimingAdd;
+	// the part the trigger path interpolates again right before each dwell
+	hasCylinderTimingCorrection = engineConfiguration->eventSyncFuelSpark;
+	angle_t tableAdvance = hasCylinderTimingCorrection ? getIgnitionTableAdvance(rpm, ignitionLoad) : 0;
+
 	// Now apply that to per-cylinder fueling and timing
-	for (size_t i = 0; i < engineConfiguration->specs.cylindersCount; i++) {
+	size_t cylinderCount = engineConfiguration->specs.cylindersCount;
+	CylinderTrims trims;
+	getCylinderTrims(trims, cylinderCount, rpm, fuelLoad, ignitionLoad);
+
+	for (size_t i = 0; i < cylinderCount; i++) {
 		uint8_t bankIndex = engineConfiguration->cylinderBankSelect[i];
-		auto bankTrim =engine->stftCorrection[bankIndex];
-		auto cylinderTrim = getCylinderFuelTrim(i, rpm, fuelLoad);
 
 		// Apply both per-bank and per-cylinder trims
-		engine->injectionMass[i] = injectionMass * bankTrim * cylinderTrim;
-
-		timingAdvance[i] = advance + getCylinderIgnitionTrim(i, rpm, ignitionLoad);
+		engine->injectionMass[i] = injectionMass * engine->stftCorrection[bankIndex] * trims.fuel[i];
+		timingAdvance[i] = advance + trims.ignition[i];
+
+		// getAdvance() wraps in to [0, 720), keep the correction small
+		angle_t correction = timingAdvance[i] - tableAdvance;
+		if (correction > 360) {
+			correction -= 720;
+		}
+		cylinderTimingCorrection[i] = correction;
 	}
 
 	// TODO: calculate me from a table!
@@ -198,6 +209,56 @@ void EngineState::periodicFastCallback() {
 #endif // EFI_ENGINE_CONTROL
 }
 
+bool EngineState::isEventSyncActive() const {
+	// while cranking or stopped the periodic calculation is still in charge
+	return engineConfiguration->eventSyncFuelSpark && engine->rpmCalculator.isRunning();
+}
+
+void EngineState::updateCylinderTiming(size_t cylinderIndex) {
+#if EFI_ENGINE_CONTROL
+	if (!hasCylinderTimingCorrection) {
+		// setting was just enabled, no periodic calculation did split the timing yet
+		return;
+	}
+
+	efitick_t startNt = getTimeNowNt();
+
+	int rpm = Sensor::getOrZero(SensorType::Rpm);
+	// load is as fresh as the last periodic calculation, RPM is current
+	float ignitionLoad = getIgnitionLoad();
+	// no correction (idle PID, IAT, CLT) is stepped from here, those belong to the periodic calculation
+	angle_t advance = getIgnitionTableAdvance(rpm, ignitionLoad) + cylinderTimingCorrection[cylinderIndex];
+
+	// keep the periodic value if anything is off, it has already been through all the checks
+	if (!cisnan(advance)) {
+		timingAdvance[cylinderIndex] = advance;
+	}
+
+	eventSyncStats.onCalculation(getTimeNowNt() - startNt);
+#endif // EFI_ENGINE_CONTROL
+}
+
+void EventSyncCalcStats::onCalculation(efitick_t durationNt) {
+	uint32_t us = NT2US(durationNt);
+
+	count++;
+	lastUs = us;
+	if (us > maxUs) {
+		maxUs = us;
+	}
+
+	if (us > EVENT_SYNC_CALC_BUDGET_US) {
+		overBudgetCount++;
+	}
+}
+
+void EventSyncCalcStats::reset() {
+	count = 0;
+	lastUs = 0;
+	maxUs = 0;
+	overBudgetCount = 0;
+}
+
 void EngineState::updateTChargeK(int rpm, float tps) {
 #if EFI_ENGINE_CONTROL
 	float newTCharge = getTCharge(rpm, tps);
@@ -26,6 +26,8 @@
 #include "speed_density.h"
 #include "advance_map.h"
 #include "flash_main.h"
+#include "config_change_tracker.h"
+#include "shadow_tables.h"
 
 #include "hip9011_logic.h"
 #include "bench_test.h"
@@ -132,6 +134,8 @@ void rememberCurrentConfiguration() {
 #else
 	isActiveConfigurationVoid = false;
 #endif /* EFI_ACTIVE_CONFIGURATION_IN_FLASH */
+
+	getConfigChangeTracker().remember(*config);
 }
 
 static void wipeString(char *string, int size) {
@@ -162,6 +166,9 @@ __attribute__((weak)) void boardOnConfigurationChange(engine_configuration_s* /*
  *
  * this method is NOT currently invoked on ECU start - actual user input has to happen!
  * See preCalculate which is invoked BOTH on start and configuration change
+ *
+ * Only subsystems affected by what was actually changed are re-initialized: a table-only
+ * edit does not touch hardware.
  */
 void incrementGlobalConfigurationVersion() {
 	engine->globalConfigurationVersion++;
@@ -169,38 +176,61 @@ void incrementGlobalConfigurationVersion() {
 	efiPrintf("set globalConfigurationVersion=%d", globalConfigurationVersion);
 #endif /* EFI_DEFAILED_LOGGING */
 
-	applyNewHardwareSettings();
+	ConfigChangeTracker& changes = getConfigChangeTracker();
+	changes.update(*config, activeConfiguration);
+#if EFI_ACTIVE_CONFIGURATION_IN_FLASH
+	if (isActiveConfigurationVoid) {
+		changes.markAllChanged();
+	}
+#endif /* EFI_ACTIVE_CONFIGURATION_IN_FLASH */
+
+	engine->engineState.slowCorrections.onConfigurationChange(changes);
+#if EFI_SHADOW_TABLES
+	shadowTables.onConfigurationChange(changes);
+#endif // EFI_SHADOW_TABLES
 
-	boardOnConfigurationChange(&activeConfiguration);
+	// pins, hardware and all the legacy callbacks below only look at engine_configuration_s
+	bool engineConfigurationChanged = changes.isEngineConfigurationChanged();
+
+	if (engineConfigurationChanged) {
+		applyNewHardwareSettings();
+
+		boardOnConfigurationChange(&activeConfiguration);
+	}
 
 /**
  * All these callbacks could be implemented as listeners, but these days I am saving RAM
  */
 	engine->preCalculate();
+
+	if (engineConfigurationChanged) {
 #if EFI_ALTERNATOR_CONTROL
-	onConfigurationChangeAlternatorCallback(&activeConfiguration);
+		onConfigurationChangeAlternatorCallback(&activeConfiguration);
 #endif /* EFI_ALTERNATOR_CONTROL */
 
 #if EFI_BOOST_CONTROL
-	onConfigurationChangeBoostCallback(&activeConfiguration);
+		onConfigurationChangeBoostCallback(&activeConfiguration);
 #endif
 #if EFI_ELECTRONIC_THROTTLE_BODY
-	onConfigurationChangeElectronicThrottleCallback(&activeConfiguration);
+		onConfigurationChangeElectronicThrottleCallback(&activeConfiguration);
 #endif /* EFI_ELECTRONIC_THROTTLE_BODY */
 
 #if EFI_ENGINE_CONTROL && EFI_PROD_CODE
-	onConfigurationChangeBenchTest();
+		onConfigurationChangeBenchTest();
 #endif
 
 #if EFI_SHAFT_POSITION_INPUT
-	onConfigurationChangeTriggerCallback();
+		onConfigurationChangeTriggerCallback();
 #endif /* EFI_SHAFT_POSITION_INPUT */
 #if EFI_EMULATE_POSITION_SENSORS && ! EFI_UNIT_TEST
-	onConfigurationChangeRpmEmulatorCallback(&activeConfiguration);
+		onConfigurationChangeRpmEmulatorCallback(&activeConfiguration);
 #endif /* EFI_EMULATE_POSITION_SENSORS */
+	}
 
-	engine->engineModules.apply_all([](auto & m) {
-			m.onConfigurationChange(&activeConfiguration);
+	engine->engineModules.apply_all([&changes](auto & m) {
+			if (m.isAffectedBy(changes)) {
+				m.onConfigurationChange(&activeConfiguration);
+			}
 		});
 	rememberCurrentConfiguration();
 }
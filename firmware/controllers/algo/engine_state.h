@@ -12,6 +12,25 @@
 #include "engine_parts.h"
 #include "efi_pid.h"
 #include "engine_state_generated.h"
+#include "cached_correction.h"
+
+/**
+ * Longest timing calculation we are willing to spend on a single trigger event
+ */
+#ifndef EVENT_SYNC_CALC_BUDGET_US
+#define EVENT_SYNC_CALC_BUDGET_US 30
+#endif
+
+struct EventSyncCalcStats {
+	void onCalculation(efitick_t durationNt);
+	void reset();
+
+	uint32_t count = 0;
+	uint32_t lastUs = 0;
+	uint32_t maxUs = 0;
+	// calculations which took longer than EVENT_SYNC_CALC_BUDGET_US
+	uint32_t overBudgetCount = 0;
+};
 
 class EngineState : public engine_state_s {
 public:
@@ -20,6 +39,18 @@ public:
 	void updateSlowSensors();
 	void updateTChargeK(int rpm, float tps);
 
+	/**
+	 * With 'eventSyncFuelSpark' the trigger callback refreshes a cylinder's timing right before its dwell starts.
+	 * Only the ignition table is interpolated again, at the current RPM. Corrections, Lua and cylinder trims
+	 * are stepped by periodicFastCallback only and carried over as cylinderTimingCorrection.
+	 */
+	bool isEventSyncActive() const;
+	void updateCylinderTiming(size_t cylinderIndex);
+
+	EventSyncCalcStats eventSyncStats;
+
+	SlowCorrections slowCorrections;
+
 	FuelConsumptionState fuelConsumption;
 
 	Timer crankingTimer;
@@ -71,4 +102,9 @@ public:
 
 	float targetLambda = 0.0f;
 	float stoichiometricRatio = 0.0f;
+
+private:
+	// everything in timingAdvance[] on top of the ignition table, as of the last periodic calculation
+	angle_t cylinderTimingCorrection[MAX_CYLINDER_COUNT] = {};
+	bool hasCylinderTimingCorrection = false;
 };
@@ -248,7 +248,7 @@ typedef enum __attribute__ ((__packed__)) {
 	DBG_9 = 9,
 	DBG_10 = 10,
 	DBG_11 = 11,
-	DBG_UNUSED12 = 12,
+	DBG_BOOT_TIME = 12,
 	DBG_SD_CARD = 13,
 	DBG_SR5_PROTOCOL = 14,
 	DBG_KNOCK = 15,
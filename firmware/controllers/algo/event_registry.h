@@ -14,6 +14,7 @@
 #include "trigger_structure.h"
 #include "accel_enrichment.h"
 #include "wall_fuel.h"
+#include "tooth_plan.h"
 
 #define MAX_WIRES_COUNT 2
 
@@ -137,6 +138,8 @@ public:
 	 * ignition events, per cylinder
 	 */
 	IgnitionEvent elements[MAX_CYLINDER_COUNT];
+	// which tooth each dwell and spark is on, see initializeIgnitionActions
+	ToothPlan toothPlan;
 	bool isReady = false;
 };
 
@@ -33,6 +33,7 @@
 #include "speed_density.h"
 #include "speed_density_base.h"
 #include "lua_hooks.h"
+#include "shadow_tables.h"
 
 extern fuel_Map3D_t veMap;
 extern lambda_Map3D_t lambdaMap;
@@ -138,9 +139,17 @@ float getRunningFuel(float baseFuel) {
 
 /* DISPLAY_ENDIF */
 
-static SpeedDensityAirmass sdAirmass(veMap, mapEstimationTable);
-static MafAirmass mafAirmass(veMap);
-static AlphaNAirmass alphaNAirmass(veMap);
+#if EFI_SHADOW_TABLES
+static const ValueProvider3D& veTableProvider = shadowTables.ve;
+static const ValueProvider3D& lambdaTableProvider = shadowTables.lambda;
+#else
+static const ValueProvider3D& veTableProvider = veMap;
+static const ValueProvider3D& lambdaTableProvider = lambdaMap;
+#endif // EFI_SHADOW_TABLES
+
+static SpeedDensityAirmass sdAirmass(veTableProvider, mapEstimationTable);
+static MafAirmass mafAirmass(veTableProvider);
+static AlphaNAirmass alphaNAirmass(veTableProvider);
 
 AirmassModelBase* getAirmassModel(engine_load_mode_e mode) {
 	switch (mode) {
@@ -327,7 +336,7 @@ float getInjectionMass(int rpm) {
 #endif
 }
 
-static FuelComputer fuelComputer(lambdaMap);
+static FuelComputer fuelComputer(lambdaTableProvider);
 
 /**
  * @brief	Initialize fuel map data structure
@@ -1,5 +1,7 @@
 #include "pch.h"
 
+#include "config_change_tracker.h"
+
 static constexpr float geometricMean(float x, float y) {
 	return sqrtf(x * y);
 }
@@ -40,6 +42,15 @@ void GearDetector::onConfigurationChange(engine_configuration_s const * /*previo
 	}
 }
 
+bool GearDetector::isAffectedBy(const ConfigChangeTracker& changes) const {
+	static constexpr ConfigRange dependencies[] = {
+		ENGINE_CONFIG_RANGE(totalGearsCount),
+		ENGINE_CONFIG_RANGE(gearRatio),
+	};
+
+	return changes.isAnyChanged(dependencies);
+}
+
 void GearDetector::onSlowCallback() {
 	float ratio = computeGearboxRatio();
 	m_gearboxRatio = ratio;
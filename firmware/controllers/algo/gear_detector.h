@@ -4,6 +4,7 @@ class GearDetector : public EngineModule {
 public:
 	void onSlowCallback() override;
 	void onConfigurationChange(engine_configuration_s const * /*previousConfig*/) override;
+	bool isAffectedBy(const ConfigChangeTracker& changes) const override;
 
 	float getGearboxRatio() const;
 
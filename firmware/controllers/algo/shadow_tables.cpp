@@ -0,0 +1,94 @@
+/**
+ * @file shadow_tables.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "shadow_tables.h"
+
+#if EFI_SHADOW_TABLES || EFI_UNIT_TEST
+ShadowTables shadowTables CCM_OPTIONAL;
+#endif // EFI_SHADOW_TABLES
+
+static constexpr ConfigRange veDependencies[] = {
+	TABLE_CONFIG_RANGE(veTable),
+	TABLE_CONFIG_RANGE(veLoadBins),
+	TABLE_CONFIG_RANGE(veRpmBins),
+};
+
+static constexpr ConfigRange lambdaDependencies[] = {
+	TABLE_CONFIG_RANGE(lambdaTable),
+	TABLE_CONFIG_RANGE(lambdaLoadBins),
+	TABLE_CONFIG_RANGE(lambdaRpmBins),
+};
+
+static constexpr ConfigRange ignitionDependencies[] = {
+	TABLE_CONFIG_RANGE(ignitionTable),
+	TABLE_CONFIG_RANGE(ignitionLoadBins),
+	TABLE_CONFIG_RANGE(ignitionRpmBins),
+};
+
+// table, load bins and RPM bins of each shadow, in member order
+static constexpr ConfigRange shadowRegions[] = {
+	TABLE_CONFIG_RANGE(veTable),
+	TABLE_CONFIG_RANGE(veLoadBins),
+	TABLE_CONFIG_RANGE(veRpmBins),
+	TABLE_CONFIG_RANGE(lambdaTable),
+	TABLE_CONFIG_RANGE(lambdaLoadBins),
+	TABLE_CONFIG_RANGE(lambdaRpmBins),
+	TABLE_CONFIG_RANGE(ignitionTable),
+	TABLE_CONFIG_RANGE(ignitionLoadBins),
+	TABLE_CONFIG_RANGE(ignitionRpmBins),
+};
+
+static_assert(efi::size(shadowRegions) == 3 * 3, "onConfigWrite maps three regions to each shadow");
+
+ShadowTables::ShadowTables()
+	: ConfigWriteConsumer(shadowRegions)
+{
+}
+
+void ShadowTables::init() {
+	ve.init(config->veTable, config->veLoadBins, config->veRpmBins);
+	lambda.init(config->lambdaTable, config->lambdaLoadBins, config->lambdaRpmBins);
+	ignition.init(config->ignitionTable, config->ignitionLoadBins, config->ignitionRpmBins);
+}
+
+void ShadowTables::onConfigurationChange(const ConfigChangeTracker& changes) {
+	if (changes.isAnyChanged(veDependencies)) {
+		ve.rebuild();
+	}
+
+	if (changes.isAnyChanged(lambdaDependencies)) {
+		lambda.rebuild();
+	}
+
+	if (changes.isAnyChanged(ignitionDependencies)) {
+		ignition.rebuild();
+	}
+}
+
+void ShadowTables::onConfigWrite(size_t region, ConfigRange written) {
+	auto start = reinterpret_cast<const uint8_t*>(config) + written.offset;
+
+	switch (region / 3) {
+	case 0:
+		ve.onWrite(start, written.size);
+		break;
+	case 1:
+		lambda.onWrite(start, written.size);
+		break;
+	case 2:
+		ignition.onWrite(start, written.size);
+		break;
+	}
+}
+
+void ShadowTables::showInfo() const {
+	efiPrintf("VE shadow: %d bytes, packed %d bytes", (int)ve_shadow_t::getShadowSize(), (int)ve_shadow_t::getSourceSize());
+	efiPrintf("lambda shadow: %d bytes, packed %d bytes", (int)lambda_shadow_t::getShadowSize(), (int)lambda_shadow_t::getSourceSize());
+	efiPrintf("ignition shadow: %d bytes, packed %d bytes", (int)ignition_shadow_t::getShadowSize(), (int)ignition_shadow_t::getSourceSize());
+	efiPrintf("shadow tables total: %d bytes", (int)getShadowSize());
+}
@@ -0,0 +1,49 @@
+/**
+ * @file shadow_tables.h
+ * @brief Float copies of the tables read on every fuel and spark calculation.
+ *
+ * With EFI_SHADOW_TABLES the VE, lambda and ignition lookups read these instead of the packed
+ * tables. Copies are rebuilt for the tables a burn changed, and online edits only re-convert the
+ * cells that were written. Costs a few kilobytes of RAM, so only enabled on MCUs which have it to
+ * spare, placed in DTCM on F7/H7.
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include "shadow_table.h"
+#include "config_change_tracker.h"
+#include "config_write_observer.h"
+
+typedef ShadowTable<FUEL_RPM_COUNT, FUEL_LOAD_COUNT, scaled_channel<uint16_t, 10, 1>, uint16_t, uint16_t> ve_shadow_t;
+typedef ShadowTable<FUEL_RPM_COUNT, FUEL_LOAD_COUNT, scaled_channel<uint8_t, 147, 1>, uint16_t, uint16_t> lambda_shadow_t;
+typedef ShadowTable<IGN_RPM_COUNT, IGN_LOAD_COUNT, scaled_channel<int16_t, 10, 1>, uint16_t, uint16_t> ignition_shadow_t;
+
+class ShadowTables : public ConfigWriteConsumer {
+public:
+	ShadowTables();
+
+	// Binds to the current configuration and converts everything, call once it has been loaded
+	void init();
+
+	// Burn, rebuilds the tables whose cells or axes changed
+	void onConfigurationChange(const ConfigChangeTracker& changes);
+	// Online edit, re-converts the cells the write covered in the one table it landed in
+	void onConfigWrite(size_t region, ConfigRange written) override;
+
+	// memory budget report
+	void showInfo() const;
+
+	static constexpr size_t getShadowSize() {
+		return ve_shadow_t::getShadowSize() + lambda_shadow_t::getShadowSize() + ignition_shadow_t::getShadowSize();
+	}
+
+	ve_shadow_t ve;
+	lambda_shadow_t lambda;
+	ignition_shadow_t ignition;
+};
+
+#if EFI_SHADOW_TABLES || EFI_UNIT_TEST
+extern ShadowTables shadowTables;
+#endif // EFI_SHADOW_TABLES
@@ -0,0 +1,124 @@
+/**
+ * @file traction_control.cpp
+ */
+
+#include "pch.h"
+
+#if EFI_LAUNCH_CONTROL
+#include "traction_control.h"
+
+// Below this undriven wheel speed slip is meaningless, for instance while the car is stationary
+#define TRACTION_MIN_REFERENCE_SPEED 60
+
+bool RotatingCutPattern::advance(float cutRatio) {
+	m_accumulator += cutRatio;
+
+	if (m_accumulator >= 1) {
+		m_accumulator -= 1;
+		return true;
+	}
+
+	return false;
+}
+
+bool RotatingCutPattern::shouldCut(float cutRatio, size_t firingIndex) {
+	if (cutRatio <= 0) {
+		reset();
+		return false;
+	}
+
+	if (!m_isCutting) {
+		// seeded at 1 - ratio: intervention lands on this very event, not 1 / ratio events later
+		m_isCutting = true;
+		m_accumulator = 0;
+		return true;
+	}
+
+	if (firingIndex == 0) {
+		// burn one slot per engine cycle so that cut events walk around the firing order
+		advance(cutRatio);
+	}
+
+	return advance(cutRatio);
+}
+
+void TractionController::setSlipTargets(float targetSlip, float fullCutSlip) {
+	m_targetSlip = targetSlip;
+	// guard against division by zero in computeCutRatio
+	m_fullCutSlip = maxF(fullCutSlip, targetSlip + 0.01f);
+
+	if (!isEnabled()) {
+		m_slip = 0;
+		m_cutRatio = 0;
+		m_sparkPattern.reset();
+		m_fuelPattern.reset();
+	}
+}
+
+void TractionController::setMaxCutRatio(float maxCutRatio) {
+	m_maxCutRatio = clampF(0, maxCutRatio, 1);
+}
+
+void TractionController::setUseFuelCut(bool useFuelCut) {
+	m_useFuelCut = useFuelCut;
+}
+
+float TractionController::computeCutRatio(float slip) const {
+	if (slip <= m_targetSlip) {
+		return 0;
+	}
+
+	float ratio = m_maxCutRatio * (slip - m_targetSlip) / (m_fullCutSlip - m_targetSlip);
+	return minF(ratio, m_maxCutRatio);
+}
+
+void TractionController::onWheelSpeedEdge(efitick_t nowNt) {
+	if (!isEnabled()) {
+		return;
+	}
+
+	auto driven = Sensor::get(SensorType::AuxSpeed1);
+	auto undriven = Sensor::get(SensorType::AuxSpeed2);
+
+	if (!driven || !undriven || undriven.Value < TRACTION_MIN_REFERENCE_SPEED) {
+		m_slip = 0;
+		m_cutRatio = 0;
+		return;
+	}
+
+	float slip = driven.Value / undriven.Value - 1;
+	float cutRatio = computeCutRatio(slip);
+
+	if (m_cutRatio == 0 && cutRatio > 0) {
+		slipDetectedNt = nowNt;
+	}
+
+	m_slip = slip;
+	m_cutRatio = cutRatio;
+}
+
+bool TractionController::shouldSkipSpark(size_t firingIndex) {
+	if (m_useFuelCut) {
+		return false;
+	}
+
+	bool cut = m_sparkPattern.shouldCut(m_cutRatio, firingIndex);
+	if (cut) {
+		sparkCutCounter++;
+	}
+	return cut;
+}
+
+bool TractionController::shouldSkipFuel(size_t firingIndex) {
+	if (!m_useFuelCut) {
+		return false;
+	}
+
+	bool cut = m_fuelPattern.shouldCut(m_cutRatio, firingIndex);
+	if (cut) {
+		fuelCutCounter++;
+	}
+	return cut;
+}
+
+#endif /* EFI_LAUNCH_CONTROL */
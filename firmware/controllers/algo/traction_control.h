@@ -0,0 +1,91 @@
+/**
+ * @file traction_control.h
+ *
+ * Native traction control: wheel slip is computed on every wheel speed sensor edge and
+ * turned into a deterministic spark (optionally fuel) cut pattern, so the intervention
+ * lands on the very next firing event instead of waiting for a Lua tick.
+ *
+ * Driven wheel speed is read from AuxSpeed1, undriven (reference) wheel speed from AuxSpeed2.
+ * Both sensors are expected to have the same number of teeth per wheel revolution.
+ */
+
+#pragma once
+
+/**
+ * Evenly spreads a cut ratio over consecutive firing events.
+ *
+ * This is a first order sigma-delta: the accumulated ratio is cut whenever it crosses one
+ * event, so at any point in time the number of cut events is within one of ratio * events.
+ * One slot is burned at the start of every engine cycle so that the cut set rotates
+ * around the firing order instead of always hitting the same cylinders.
+ * The first event after cutting starts is always cut, as if the accumulator was seeded at 1 - ratio.
+ */
+class RotatingCutPattern {
+public:
+	/**
+	 * @param firingIndex position of this event within the firing order, 0 starts a new engine cycle
+	 */
+	bool shouldCut(float cutRatio, size_t firingIndex);
+
+	void reset() {
+		m_accumulator = 0;
+		m_isCutting = false;
+	}
+
+private:
+	bool advance(float cutRatio);
+
+	float m_accumulator = 0;
+	bool m_isCutting = false;
+};
+
+class TractionController {
+public:
+	/**
+	 * Invoked from wheel speed sensor edge callbacks, recomputes slip and cut ratio
+	 */
+	void onWheelSpeedEdge(efitick_t nowNt);
+
+	/**
+	 * Slip ratio at which cut starts, full cut slip ratio at which maxCutRatio is reached.
+	 * targetSlip of '0' means 'traction control disabled'
+	 */
+	void setSlipTargets(float targetSlip, float fullCutSlip);
+	void setMaxCutRatio(float maxCutRatio);
+	void setUseFuelCut(bool useFuelCut);
+
+	bool shouldSkipSpark(size_t firingIndex);
+	bool shouldSkipFuel(size_t firingIndex);
+
+	float getSlip() const {
+		return m_slip;
+	}
+
+	float getCutRatio() const {
+		return m_cutRatio;
+	}
+
+	bool isEnabled() const {
+		return m_targetSlip > 0;
+	}
+
+	// Counters for diagnostics
+	uint32_t sparkCutCounter = 0;
+	uint32_t fuelCutCounter = 0;
+	// Timestamp of the wheel edge which last raised the cut ratio from zero
+	efitick_t slipDetectedNt = 0;
+
+private:
+	float computeCutRatio(float slip) const;
+
+	float m_targetSlip = 0;
+	float m_fullCutSlip = 0;
+	float m_maxCutRatio = 1;
+	bool m_useFuelCut = false;
+
+	volatile float m_slip = 0;
+	volatile float m_cutRatio = 0;
+
+	RotatingCutPattern m_sparkPattern;
+	RotatingCutPattern m_fuelPattern;
+};
@@ -0,0 +1,441 @@
+/**
+ * @file    config_journal.cpp
+ *
+ * Bank layout:
+ *   [bank header][record header][payload][record header][payload]...[erased]
+ * every element starts at CONFIG_JOURNAL_ALIGN boundary. Records are applied in order, so the
+ * image is the snapshot written by compaction plus all later changes.
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "config_journal.h"
+
+#define JOURNAL_BANK_MAGIC 0x4A524E4C
+#define JOURNAL_RECORD_MAGIC 0x52454344
+
+struct JournalBankHeader {
+	uint32_t magic;
+	// incremented by every compaction, the newer bank wins
+	uint32_t generation;
+	uint32_t version;
+	uint32_t imageSize;
+	uint32_t crc;
+};
+
+struct JournalRecordHeader {
+	uint32_t magic;
+	uint32_t offset;
+	uint32_t length;
+	// covers the fields above and the payload
+	uint32_t crc;
+};
+
+static constexpr size_t alignUp(size_t size) {
+	return (size + CONFIG_JOURNAL_ALIGN - 1) / CONFIG_JOURNAL_ALIGN * CONFIG_JOURNAL_ALIGN;
+}
+
+static constexpr size_t bankHeaderSlot = alignUp(sizeof(JournalBankHeader));
+static constexpr size_t recordHeaderSlot = alignUp(sizeof(JournalRecordHeader));
+
+static_assert(bankHeaderSlot <= CONFIG_JOURNAL_PAGE_SIZE);
+static_assert(recordHeaderSlot <= CONFIG_JOURNAL_PAGE_SIZE);
+
+static bool isErased(const void* data, size_t size) {
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+
+	for (size_t i = 0; i < size; i++) {
+		if (bytes[i] != 0xFF) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+ConfigJournal::ConfigJournal(JournalFlash& flash, void* image, size_t imageSize, uint32_t* pageCrcs, uint32_t version)
+	: m_flash(flash)
+	, m_image(reinterpret_cast<uint8_t*>(image))
+	, m_imageSize(imageSize)
+	, m_pageCrcs(pageCrcs)
+	, m_pageCount((imageSize + CONFIG_JOURNAL_PAGE_SIZE - 1) / CONFIG_JOURNAL_PAGE_SIZE)
+	, m_version(version)
+{
+}
+
+size_t ConfigJournal::getPageLength(size_t page) const {
+	size_t offset = page * CONFIG_JOURNAL_PAGE_SIZE;
+	return std::min<size_t>(CONFIG_JOURNAL_PAGE_SIZE, m_imageSize - offset);
+}
+
+uint32_t ConfigJournal::getPageCrc(size_t page) const {
+	return crc32(m_image + page * CONFIG_JOURNAL_PAGE_SIZE, getPageLength(page));
+}
+
+bool ConfigJournal::isPageDirty(size_t page) const {
+	return getPageCrc(page) != m_pageCrcs[page];
+}
+
+void ConfigJournal::updatePageCrcs() {
+	for (size_t page = 0; page < m_pageCount; page++) {
+		m_pageCrcs[page] = getPageCrc(page);
+	}
+}
+
+static size_t getRecordLength(size_t imageSize, size_t firstPage, size_t pageCount) {
+	size_t offset = firstPage * CONFIG_JOURNAL_PAGE_SIZE;
+	return std::min<size_t>(pageCount * CONFIG_JOURNAL_PAGE_SIZE, imageSize - offset);
+}
+
+static size_t getSnapshotSize(size_t imageSize) {
+	size_t pageCount = (imageSize + CONFIG_JOURNAL_PAGE_SIZE - 1) / CONFIG_JOURNAL_PAGE_SIZE;
+	size_t size = bankHeaderSlot;
+
+	for (size_t page = 0; page < pageCount; page += CONFIG_JOURNAL_RECORD_PAGES) {
+		size_t count = std::min<size_t>(CONFIG_JOURNAL_RECORD_PAGES, pageCount - page);
+		size += recordHeaderSlot + alignUp(getRecordLength(imageSize, page, count));
+	}
+
+	return size;
+}
+
+size_t ConfigJournal::getSnapshotSize() const {
+	return ::getSnapshotSize(m_imageSize);
+}
+
+bool ConfigJournal::fits() const {
+	return getSnapshotSize() <= m_flash.getBankSize();
+}
+
+size_t ConfigJournal::getFreeBytes() const {
+	if (!m_mounted) {
+		return 0;
+	}
+
+	return m_flash.getBankSize() - m_writeOffset;
+}
+
+bool ConfigJournal::needsCompaction() const {
+	// keep some room so that a burn while running is an append, not a compaction
+	return m_needsCompaction || getFreeBytes() < m_flash.getBankSize() / 8;
+}
+
+bool ConfigJournal::writeAligned(size_t bank, size_t offset, const void* data, size_t size, size_t slot) {
+	memcpy(m_buffer, data, size);
+	memset(m_buffer + size, 0xFF, slot - size);
+
+	if (!m_flash.write(bank, offset, m_buffer, slot)) {
+		return false;
+	}
+
+	m_stats.bytesWritten += slot;
+	m_stats.lastCommitBytes += slot;
+	return true;
+}
+
+bool ConfigJournal::writeRecord(size_t bank, size_t offset, size_t firstPage, size_t pageCount) {
+	JournalRecordHeader header;
+	header.magic = JOURNAL_RECORD_MAGIC;
+	header.offset = firstPage * CONFIG_JOURNAL_PAGE_SIZE;
+	header.length = getRecordLength(m_imageSize, firstPage, pageCount);
+
+	uint32_t crc = crc32(&header, offsetof(JournalRecordHeader, crc));
+	size_t payloadOffset = offset + recordHeaderSlot;
+
+	for (size_t page = firstPage; page < firstPage + pageCount; page++) {
+		size_t length = getPageLength(page);
+		size_t slot = alignUp(length);
+
+		// image may be modified by TS meanwhile, CRC and flash have to see the same bytes
+		memcpy(m_buffer, m_image + page * CONFIG_JOURNAL_PAGE_SIZE, length);
+		memset(m_buffer + length, 0xFF, slot - length);
+
+		crc = crc32inc(m_buffer, crc, length);
+		m_pageCrcs[page] = crc32(m_buffer, length);
+
+		if (!m_flash.write(bank, payloadOffset, m_buffer, slot)) {
+			return false;
+		}
+
+		m_stats.bytesWritten += slot;
+		m_stats.lastCommitBytes += slot;
+		payloadOffset += slot;
+	}
+
+	header.crc = crc;
+
+	// header goes last: a record interrupted before this point is never replayed
+	if (!writeAligned(bank, offset, &header, sizeof(header), recordHeaderSlot)) {
+		return false;
+	}
+
+	m_stats.records++;
+	return true;
+}
+
+bool ConfigJournal::appendRecord(size_t firstPage, size_t pageCount) {
+	size_t size = recordHeaderSlot + alignUp(getRecordLength(m_imageSize, firstPage, pageCount));
+
+	if (size > m_flash.getBankSize() - m_writeOffset) {
+		return false;
+	}
+
+	if (!writeRecord(m_activeBank, m_writeOffset, firstPage, pageCount)) {
+		// partially programmed area can not be reused
+		m_needsCompaction = true;
+		m_stats.failures++;
+		return false;
+	}
+
+	m_writeOffset += size;
+	return true;
+}
+
+bool ConfigJournal::commit() {
+	m_stats.commits++;
+	m_stats.lastCommitBytes = 0;
+
+	if (!m_mounted || m_needsCompaction) {
+		return compact();
+	}
+
+	size_t page = 0;
+	while (page < m_pageCount) {
+		if (!isPageDirty(page)) {
+			page++;
+			continue;
+		}
+
+		// merge adjacent dirty pages into one record
+		size_t first = page;
+		do {
+			page++;
+		} while (page < m_pageCount && page - first < CONFIG_JOURNAL_RECORD_PAGES && isPageDirty(page));
+
+		if (!appendRecord(first, page - first)) {
+			// out of room or write failed, a snapshot covers all pending changes anyway
+			return compact();
+		}
+	}
+
+	return true;
+}
+
+bool ConfigJournal::compact() {
+	if (!fits()) {
+		return false;
+	}
+
+	// with nothing mounted the first bank may still hold a copy written in the legacy format, keep it
+	size_t target = m_mounted ? 1 - m_activeBank : 1;
+
+	m_stats.compactions++;
+	m_stats.erases++;
+
+	bool isSuccess = m_flash.erase(target);
+
+	size_t offset = bankHeaderSlot;
+	for (size_t page = 0; isSuccess && page < m_pageCount; page += CONFIG_JOURNAL_RECORD_PAGES) {
+		size_t count = std::min<size_t>(CONFIG_JOURNAL_RECORD_PAGES, m_pageCount - page);
+
+		isSuccess = writeRecord(target, offset, page, count);
+		offset += recordHeaderSlot + alignUp(getRecordLength(m_imageSize, page, count));
+	}
+
+	if (isSuccess) {
+		JournalBankHeader header;
+		header.magic = JOURNAL_BANK_MAGIC;
+		header.generation = m_generation + 1;
+		header.version = m_version;
+		header.imageSize = m_imageSize;
+		header.crc = crc32(&header, offsetof(JournalBankHeader, crc));
+
+		// until the header is there the previous bank stays the valid one
+		isSuccess = writeAligned(target, 0, &header, sizeof(header), bankHeaderSlot);
+	}
+
+	if (!isSuccess) {
+		// page CRCs already claim the snapshot, make sure next commit retries it
+		m_needsCompaction = true;
+		m_stats.failures++;
+		return false;
+	}
+
+	m_activeBank = target;
+	m_generation++;
+	m_writeOffset = offset;
+	m_mounted = true;
+	m_needsCompaction = false;
+
+	return true;
+}
+
+bool ConfigJournal::readBankHeader(size_t bank, uint32_t& generation, uint32_t& version, uint32_t& imageSize) {
+	JournalBankHeader header;
+
+	if (!m_flash.read(bank, 0, &header, sizeof(header))) {
+		return false;
+	}
+
+	if (header.magic != JOURNAL_BANK_MAGIC || header.crc != crc32(&header, offsetof(JournalBankHeader, crc))) {
+		return false;
+	}
+
+	generation = header.generation;
+	version = header.version;
+	imageSize = header.imageSize;
+	return true;
+}
+
+bool ConfigJournal::checkRecord(size_t bank, size_t offset, const JournalRecordHeader& header) {
+	uint32_t crc = crc32(&header, offsetof(JournalRecordHeader, crc));
+
+	for (size_t done = 0; done < header.length; ) {
+		size_t size = std::min<size_t>(sizeof(m_buffer), header.length - done);
+
+		if (!m_flash.read(bank, offset + done, m_buffer, size)) {
+			return false;
+		}
+
+		crc = crc32inc(m_buffer, crc, size);
+		done += size;
+	}
+
+	return crc == header.crc;
+}
+
+void ConfigJournal::applyRecord(size_t bank, size_t offset, uint32_t imageOffset, uint32_t length) {
+	// records from an image of a different size are clipped
+	if (imageOffset >= m_imageSize) {
+		return;
+	}
+
+	size_t size = std::min<size_t>(length, m_imageSize - imageOffset);
+	m_flash.read(bank, offset, m_image + imageOffset, size);
+}
+
+bool ConfigJournal::isErasedFrom(size_t bank, size_t offset) {
+	size_t bankSize = m_flash.getBankSize();
+
+	while (offset < bankSize) {
+		size_t size = std::min<size_t>(sizeof(m_buffer), bankSize - offset);
+
+		if (!m_flash.read(bank, offset, m_buffer, size) || !isErased(m_buffer, size)) {
+			return false;
+		}
+
+		offset += size;
+	}
+
+	return true;
+}
+
+bool ConfigJournal::replay(size_t bank, size_t imageSize) {
+	size_t bankSize = m_flash.getBankSize();
+	size_t offset = bankHeaderSlot;
+
+	while (offset + recordHeaderSlot <= bankSize) {
+		JournalRecordHeader header;
+		if (!m_flash.read(bank, offset, &header, sizeof(header))) {
+			m_needsCompaction = true;
+			break;
+		}
+
+		if (isErased(&header, sizeof(header))) {
+			// end of journal, anything programmed past this point was interrupted before its header got written
+			m_needsCompaction = !isErasedFrom(bank, offset);
+			break;
+		}
+
+		size_t payloadOffset = offset + recordHeaderSlot;
+		bool isValid = header.magic == JOURNAL_RECORD_MAGIC
+			&& header.length != 0
+			&& header.length <= bankSize - payloadOffset
+			&& alignUp(header.length) <= bankSize - payloadOffset
+			&& checkRecord(bank, payloadOffset, header);
+
+		if (!isValid) {
+			// nothing after a broken record can be trusted, nor appended to
+			m_needsCompaction = true;
+			break;
+		}
+
+		applyRecord(bank, payloadOffset, header.offset, header.length);
+		offset = payloadOffset + alignUp(header.length);
+	}
+
+	m_writeOffset = offset;
+
+	// a broken change record only loses that change, a broken snapshot leaves part of the image unset
+	return offset >= ::getSnapshotSize(imageSize);
+}
+
+JournalState ConfigJournal::mount() {
+	m_mounted = false;
+	m_needsCompaction = false;
+	m_writeOffset = 0;
+
+	if (!fits()) {
+		return JournalState::Blank;
+	}
+
+	uint32_t generation[2];
+	uint32_t version[2];
+	uint32_t imageSize[2];
+	bool isValid[2];
+
+	for (size_t bank = 0; bank < 2; bank++) {
+		isValid[bank] = readBankHeader(bank, generation[bank], version[bank], imageSize[bank]);
+	}
+
+	if (!isValid[0] && !isValid[1]) {
+		return JournalState::Blank;
+	}
+
+	size_t bank;
+	if (isValid[0] && isValid[1]) {
+		// generation counter may wrap around
+		bank = static_cast<int32_t>(generation[1] - generation[0]) > 0 ? 1 : 0;
+	} else {
+		bank = isValid[0] ? 0 : 1;
+	}
+
+	if (!replay(bank, imageSize[bank])) {
+		size_t other = 1 - bank;
+
+		if (!isValid[other] || !replay(other, imageSize[other])) {
+			// next snapshot has to win over the broken bank
+			m_generation = isValid[other] && static_cast<int32_t>(generation[other] - generation[bank]) > 0
+				? generation[other] : generation[bank];
+			return JournalState::Corrupt;
+		}
+
+		// older bank is intact, get rid of the broken one
+		bank = other;
+		m_needsCompaction = true;
+	}
+
+	m_activeBank = bank;
+	m_generation = generation[bank];
+	m_mounted = true;
+	updatePageCrcs();
+
+	if (version[bank] != m_version || imageSize[bank] != m_imageSize) {
+		// new version has to be recorded by a fresh snapshot
+		m_needsCompaction = true;
+		return JournalState::IncompatibleVersion;
+	}
+
+	return JournalState::Ok;
+}
+
+void ConfigJournal::printInfo() const {
+	efiPrintf("Config journal: bank %d generation %lu, %d bytes used %d free, snapshot %d bytes",
+		(int)m_activeBank, m_generation, (int)m_writeOffset, (int)getFreeBytes(), (int)getSnapshotSize());
+	efiPrintf("    %lu commits %lu records %lu compactions %lu erases %lu failures",
+		m_stats.commits, m_stats.records, m_stats.compactions, m_stats.erases, m_stats.failures);
+	efiPrintf("    %lu bytes written, last commit %lu bytes%s",
+		m_stats.bytesWritten, m_stats.lastCommitBytes, needsCompaction() ? ", compaction pending" : "");
+}
@@ -0,0 +1,177 @@
+/**
+ * @file    config_journal.h
+ * @brief Log-structured storage of the configuration image.
+ *
+ * Instead of erasing and rewriting complete copies of the configuration on every burn, two
+ * flash banks are used as a journal. The active bank starts with a full snapshot of the image,
+ * every following burn only appends records with the pages which have changed since the
+ * previous burn. Once the active bank gets full a fresh snapshot is written to the other bank
+ * ("compaction"), which is the only time a sector gets erased.
+ *
+ * Every record is protected by its own CRC and its header is programmed last, so a record
+ * interrupted by a reset is simply never replayed. The bank header is also written last during
+ * compaction, so until a new snapshot is complete the previous bank stays the valid one.
+ *
+ * Flash access is abstracted by JournalFlash so that the very same code runs against a RAM
+ * model in unit tests.
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/* change detection granularity, RAM cost is 4 bytes per page */
+#ifndef CONFIG_JOURNAL_PAGE_SIZE
+#define CONFIG_JOURNAL_PAGE_SIZE 256
+#endif
+
+/* every chunk is programmed exactly once, 32 bytes matches STM32H7 flash word */
+#ifndef CONFIG_JOURNAL_ALIGN
+#define CONFIG_JOURNAL_ALIGN 32
+#endif
+
+/* longest record, in pages */
+#ifndef CONFIG_JOURNAL_RECORD_PAGES
+#define CONFIG_JOURNAL_RECORD_PAGES 16
+#endif
+
+static_assert(CONFIG_JOURNAL_PAGE_SIZE % CONFIG_JOURNAL_ALIGN == 0, "journal page size should be a multiple of alignment");
+
+struct JournalRecordHeader;
+
+class JournalFlash {
+public:
+	// size of each of the two banks
+	virtual size_t getBankSize() const = 0;
+	virtual bool erase(size_t bank) = 0;
+	// target area is expected to be erased
+	virtual bool write(size_t bank, size_t offset, const void* data, size_t size) = 0;
+	virtual bool read(size_t bank, size_t offset, void* data, size_t size) = 0;
+};
+
+enum class JournalState : uint8_t {
+	Ok,
+	// no valid bank, nothing was loaded
+	Blank,
+	// image was loaded but it was written by a different version
+	IncompatibleVersion,
+	// no bank holds a complete snapshot, image may be partially overwritten
+	Corrupt,
+};
+
+struct JournalStats {
+	uint32_t commits;
+	uint32_t records;
+	uint32_t compactions;
+	uint32_t erases;
+	uint32_t bytesWritten;
+	uint32_t lastCommitBytes;
+	uint32_t failures;
+};
+
+class ConfigJournal {
+public:
+	ConfigJournal(JournalFlash& flash, void* image, size_t imageSize, uint32_t* pageCrcs, uint32_t version);
+
+	/**
+	 * Load the image from the newest bank holding a complete snapshot, falls back to the
+	 * older bank if the newer one is damaged.
+	 * Image is left untouched if the result is Blank.
+	 */
+	JournalState mount();
+
+	/**
+	 * Persist pages changed since previous mount or commit. Falls back to compaction
+	 * if nothing is mounted yet or the active bank has no room left.
+	 */
+	bool commit();
+
+	/**
+	 * Write a full snapshot into the other bank and make it the active one.
+	 */
+	bool compact();
+
+	// true once free space runs low, a good time to compact in background
+	bool needsCompaction() const;
+
+	// false if a snapshot does not fit into a bank, journal can not be used at all then
+	bool fits() const;
+
+	size_t getSnapshotSize() const;
+
+	size_t getUsedBytes() const {
+		return m_writeOffset;
+	}
+
+	size_t getFreeBytes() const;
+
+	bool isMounted() const {
+		return m_mounted;
+	}
+
+	size_t getActiveBank() const {
+		return m_activeBank;
+	}
+
+	uint32_t getGeneration() const {
+		return m_generation;
+	}
+
+	const JournalStats& getStats() const {
+		return m_stats;
+	}
+
+	void printInfo() const;
+
+private:
+	size_t getPageLength(size_t page) const;
+	uint32_t getPageCrc(size_t page) const;
+	bool isPageDirty(size_t page) const;
+	void updatePageCrcs();
+
+	bool appendRecord(size_t firstPage, size_t pageCount);
+	bool writeRecord(size_t bank, size_t offset, size_t firstPage, size_t pageCount);
+	bool writeAligned(size_t bank, size_t offset, const void* data, size_t size, size_t slot);
+
+	bool readBankHeader(size_t bank, uint32_t& generation, uint32_t& version, uint32_t& imageSize);
+	// false if any snapshot record is missing or broken
+	bool replay(size_t bank, size_t imageSize);
+	bool checkRecord(size_t bank, size_t offset, const JournalRecordHeader& header);
+	void applyRecord(size_t bank, size_t offset, uint32_t imageOffset, uint32_t length);
+	bool isErasedFrom(size_t bank, size_t offset);
+
+	JournalFlash& m_flash;
+	uint8_t* const m_image;
+	const size_t m_imageSize;
+	// CRC of every page as it was last persisted
+	uint32_t* const m_pageCrcs;
+	const size_t m_pageCount;
+	const uint32_t m_version;
+
+	bool m_mounted = false;
+	// active bank can not be appended to, for instance after an interrupted write
+	bool m_needsCompaction = false;
+	size_t m_activeBank = 0;
+	uint32_t m_generation = 0;
+	// first free byte in the active bank
+	size_t m_writeOffset = 0;
+
+	JournalStats m_stats = {};
+
+	uint8_t m_buffer[CONFIG_JOURNAL_PAGE_SIZE];
+};
+
+template <size_t TImageSize>
+class ConfigJournalBuffer : public ConfigJournal {
+public:
+	ConfigJournalBuffer(JournalFlash& flash, void* image, uint32_t version)
+		: ConfigJournal(flash, image, TImageSize, m_crcs, version)
+	{
+	}
+
+private:
+	uint32_t m_crcs[(TImageSize + CONFIG_JOURNAL_PAGE_SIZE - 1) / CONFIG_JOURNAL_PAGE_SIZE];
+};
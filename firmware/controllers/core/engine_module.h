@@ -1,10 +1,15 @@
 #pragma once
 
+class ConfigChangeTracker;
+
 class EngineModule {
 public:
-	// Called when 'Burn' is invoked
+	// Called when 'Burn' is invoked, if isAffectedBy() says so
 	virtual void onConfigurationChange(engine_configuration_s const * /*previousConfig*/) { }
 
+	// Override to check only the fields this module depends on, by default any burn counts
+	virtual bool isAffectedBy(const ConfigChangeTracker& /*changes*/) const { return true; }
+
 	// Called approx 20Hz
 	virtual void onSlowCallback() { }
 
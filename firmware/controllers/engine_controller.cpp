@@ -37,6 +37,8 @@
 #include "malfunction_central.h"
 #include "malfunction_indicator.h"
 #include "speed_density.h"
+#include "shadow_tables.h"
+#include "config_write_observer.h"
 #include "local_version_holder.h"
 #include "alternator_controller.h"
 #include "fuel_math.h"
@@ -105,9 +107,17 @@ Engine * engine;
 
 
 void initDataStructures() {
+	ConfigWriteObservers& configWriteObservers = getConfigWriteObservers();
+	configWriteObservers.clear();
+	configWriteObservers.add(engine->engineState.slowCorrections);
+
 #if EFI_ENGINE_CONTROL
 	initFuelMap();
 	initSpeedDensity();
+#if EFI_SHADOW_TABLES
+	// bound in commonInitEngineController, until then writes are ignored
+	configWriteObservers.add(shadowTables);
+#endif // EFI_SHADOW_TABLES
 #endif // EFI_ENGINE_CONTROL
 }
 
@@ -447,6 +457,29 @@ static void setFloat(const char *offsetStr, const char *valueStr) {
 	incrementGlobalConfigurationVersion();
 }
 
+static void showSlowCorrections() {
+	engine->engineState.slowCorrections.showInfo();
+}
+
+static void showLongTermFuelTrim() {
+	engine->module<LongTermFuelTrim>()->showInfo();
+}
+
+static void resetLongTermFuelTrim() {
+	engine->module<LongTermFuelTrim>()->reset();
+	efiPrintf("LTFT reset");
+}
+
+static void showConfigWrites() {
+	getConfigWriteObservers().showInfo();
+}
+
+#if EFI_SHADOW_TABLES
+static void showShadowTables() {
+	shadowTables.showInfo();
+}
+#endif // EFI_SHADOW_TABLES
+
 static void initConfigActions() {
 	addConsoleActionSS("set_float", (VoidCharPtrCharPtr) setFloat);
 	addConsoleActionII("set_int", (VoidIntInt) setInt);
@@ -459,6 +492,14 @@ static void initConfigActions() {
 	addConsoleActionI("get_short", getShort);
 	addConsoleActionI("get_byte", getByte);
 	addConsoleActionII("get_bit", getBit);
+
+	addConsoleAction("corrections", showSlowCorrections);
+	addConsoleAction("ltft", showLongTermFuelTrim);
+	addConsoleAction("ltft_reset", resetLongTermFuelTrim);
+	addConsoleAction("config_writes", showConfigWrites);
+#if EFI_SHADOW_TABLES
+	addConsoleAction("shadow_tables", showShadowTables);
+#endif // EFI_SHADOW_TABLES
 }
 #endif /* EFI_UNIT_TEST */
 
@@ -466,6 +507,11 @@ static void initConfigActions() {
 void commonInitEngineController() {
 	initInterpolation();
 
+#if EFI_SHADOW_TABLES || EFI_UNIT_TEST
+	// not in initDataStructures(), that runs before the configuration is loaded
+	shadowTables.init();
+#endif // EFI_SHADOW_TABLES
+
 #if EFI_SIMULATOR
 	printf("commonInitEngineController\n");
 #endif
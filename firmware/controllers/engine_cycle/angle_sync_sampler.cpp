@@ -0,0 +1,190 @@
+/**
+ * @file    angle_sync_sampler.cpp
+ *
+ * Sample angles are resolved into (trigger tooth, angle offset) pairs ahead of time, same as
+ * spark and injection events. On every tooth we walk the configured points and for the ones which
+ * belong to this tooth we schedule a short timer using the angle offset.
+ *
+ * Here we read the most recent conversion of the channel at the scheduled moment: with fast ADC
+ * channels that is at most one fast ADC period old.
+ */
+
+#include "pch.h"
+
+#include "angle_sync_sampler.h"
+#include "adc_math.h"
+
+static float readAdcVoltage(adc_channel_e channel) {
+	return getVoltage("angle sampler", channel);
+}
+
+static void clearCycle(AngleSampleCycle& cycle) {
+	for (size_t slot = 0; slot < ANGLE_SAMPLER_CHANNELS; slot++) {
+		for (size_t cylinderIndex = 0; cylinderIndex < MAX_CYLINDER_COUNT; cylinderIndex++) {
+			setArrayValues(cycle.value[slot][cylinderIndex], NAN);
+		}
+	}
+}
+
+AngleSyncSampler::AngleSyncSampler()
+	: m_reader(readAdcVoltage)
+{
+	for (size_t i = 0; i < ANGLE_SAMPLER_HISTORY; i++) {
+		m_history[i].cycleNumber = 0;
+		clearCycle(m_history[i]);
+	}
+}
+
+int AngleSyncSampler::addChannel(adc_channel_e channel, const angle_t *anglesAfterTdc, size_t pointCount) {
+	if (m_channelCount >= ANGLE_SAMPLER_CHANNELS || pointCount == 0 || pointCount > ANGLE_SAMPLER_POINTS) {
+		return -1;
+	}
+
+	int slot = m_channelCount;
+	Channel& ch = m_channels[slot];
+	ch.channel = channel;
+	ch.pointCount = pointCount;
+	for (size_t cylinderIndex = 0; cylinderIndex < MAX_CYLINDER_COUNT; cylinderIndex++) {
+		for (size_t point = 0; point < pointCount; point++) {
+			ch.points[cylinderIndex][point].angleAfterTdc = anglesAfterTdc[point];
+		}
+	}
+
+	updateChannelPositions(ch);
+	// only now trigger ISR is allowed to see the new channel
+	m_channelCount++;
+
+	return slot;
+}
+
+void AngleSyncSampler::clear() {
+	chibios_rt::CriticalSectionLocker csl;
+	m_channelCount = 0;
+	m_cylinderCount = 0;
+	m_cycleStarted = false;
+}
+
+void AngleSyncSampler::onSlowCallback() {
+	updatePositions();
+}
+
+void AngleSyncSampler::updatePositions() {
+	for (size_t slot = 0; slot < m_channelCount; slot++) {
+		updateChannelPositions(m_channels[slot]);
+	}
+}
+
+void AngleSyncSampler::updateChannelPositions(Channel& ch) {
+	size_t cylinderCount = minI(engineConfiguration->specs.cylindersCount, MAX_CYLINDER_COUNT);
+	angle_t engineCycle = getEngineCycle(engine->getOperationMode());
+
+	// resolved outside of the lock, trigger ISR keeps using the old positions meanwhile
+	event_trigger_position_s positions[MAX_CYLINDER_COUNT][ANGLE_SAMPLER_POINTS];
+
+	// cylinder TDC angles are by firing order, samples are stored by cylinder number
+	for (size_t i = 0; i < cylinderCount; i++) {
+		size_t cylinderNumber = getCylinderId(i) - 1;
+		angle_t tdc = getCylinderAngle(i, cylinderNumber);
+
+		for (size_t point = 0; point < ch.pointCount; point++) {
+			angle_t angle = tdc + ch.points[cylinderNumber][point].angleAfterTdc;
+			wrapAngle2(angle, "angleSampler", CUSTOM_ERR_6553, engineCycle);
+			positions[cylinderNumber][point].setAngle(angle);
+		}
+	}
+
+	// trigger ISR must never see a channel with some of its points moved and some not
+	chibios_rt::CriticalSectionLocker csl;
+
+	for (size_t cylinderIndex = 0; cylinderIndex < cylinderCount; cylinderIndex++) {
+		for (size_t point = 0; point < ch.pointCount; point++) {
+			ch.points[cylinderIndex][point].position = positions[cylinderIndex][point];
+		}
+	}
+
+	m_cylinderCount = cylinderCount;
+}
+
+void AngleSyncSampler::onTriggerTooth(uint32_t trgEventIndex, efitick_t edgeTimestamp) {
+	if (trgEventIndex == 0) {
+		startCycle();
+	}
+
+	for (size_t slot = 0; slot < m_channelCount; slot++) {
+		const Channel& ch = m_channels[slot];
+
+		for (size_t cylinderIndex = 0; cylinderIndex < m_cylinderCount; cylinderIndex++) {
+			for (size_t point = 0; point < ch.pointCount; point++) {
+				const SamplePoint& sp = ch.points[cylinderIndex][point];
+				if (sp.position.triggerEventIndex != trgEventIndex) {
+					continue;
+				}
+
+				PendingSample& pending = m_pending[m_nextPending];
+				m_nextPending = (m_nextPending + 1) % ANGLE_SAMPLER_PENDING;
+
+				if (pending.sched.action) {
+					// more samples in flight than we have slots, this one is lost
+					m_missedSamples++;
+					continue;
+				}
+
+				pending.slot = slot;
+				pending.cylinderIndex = cylinderIndex;
+				pending.point = point;
+
+				scheduleByAngle(&pending.sched, edgeTimestamp, sp.position.angleOffsetFromTriggerEvent,
+						{ onSampleTime, &pending });
+			}
+		}
+	}
+}
+
+void AngleSyncSampler::onSampleTime(PendingSample *pending) {
+	engine->module<AngleSyncSampler>()->takeSample(*pending);
+}
+
+void AngleSyncSampler::takeSample(const PendingSample &pending) {
+	if (pending.slot >= m_channelCount) {
+		// channels were reconfigured while this sample was in flight
+		return;
+	}
+
+	float volts = m_reader(m_channels[pending.slot].channel);
+	m_history[m_writeIndex].value[pending.slot][pending.cylinderIndex][pending.point] = volts;
+}
+
+void AngleSyncSampler::startCycle() {
+	if (m_cycleStarted) {
+		// current record now covers a complete cycle, hand it over to consumers
+		m_history[m_writeIndex].cycleNumber = m_completedCycles + 1;
+		m_writeIndex = (m_writeIndex + 1) % ANGLE_SAMPLER_HISTORY;
+		m_completedCycles++;
+	}
+
+	clearCycle(m_history[m_writeIndex]);
+	m_cycleStarted = true;
+}
+
+const AngleSampleCycle *AngleSyncSampler::getCycle(size_t cyclesAgo) const {
+	// the record being filled is not available, so we keep one less than the ring size
+	if (cyclesAgo >= m_completedCycles || cyclesAgo >= ANGLE_SAMPLER_HISTORY - 1) {
+		return nullptr;
+	}
+
+	size_t index = (m_writeIndex + ANGLE_SAMPLER_HISTORY - 1 - cyclesAgo) % ANGLE_SAMPLER_HISTORY;
+	return &m_history[index];
+}
+
+float AngleSyncSampler::getSample(int slot, size_t cylinderIndex, size_t point, size_t cyclesAgo) const {
+	if (slot < 0 || slot >= m_channelCount || cylinderIndex >= MAX_CYLINDER_COUNT || point >= ANGLE_SAMPLER_POINTS) {
+		return NAN;
+	}
+
+	const AngleSampleCycle *cycle = getCycle(cyclesAgo);
+	if (!cycle) {
+		return NAN;
+	}
+
+	return cycle->value[slot][cylinderIndex][point];
+}
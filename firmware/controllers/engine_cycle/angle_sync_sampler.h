@@ -0,0 +1,136 @@
+/**
+ * @file    angle_sync_sampler.h
+ * @brief   Crank angle synchronous analog sampling
+ *
+ * Samples analog channels (MAP, exhaust back pressure, ion current, knock envelope...) at fixed
+ * angles relative to each cylinder's TDC. Each sample is scheduled off the trigger tooth just before
+ * the requested angle so the tooth-to-sample timing error is limited to a fraction of one tooth gap.
+ *
+ * Results are kept per cylinder per sample point in a small ring of complete engine cycles.
+ * A cycle record starts at trigger index 0, so a sample which is configured past the end of the
+ * engine cycle lands in the next record under its own cylinder index.
+ */
+
+#pragma once
+
+#include "engine_module.h"
+#include "trigger_structure.h"
+#include "scheduler.h"
+
+#ifndef ANGLE_SAMPLER_CHANNELS
+#define ANGLE_SAMPLER_CHANNELS 2
+#endif
+
+// sample points per cylinder per channel
+#ifndef ANGLE_SAMPLER_POINTS
+#define ANGLE_SAMPLER_POINTS 4
+#endif
+
+// number of complete engine cycles kept for consumers
+#ifndef ANGLE_SAMPLER_HISTORY
+#define ANGLE_SAMPLER_HISTORY 4
+#endif
+
+// samples which are scheduled but not yet taken, these only live between two teeth
+#define ANGLE_SAMPLER_PENDING 16
+
+struct AngleSampleCycle {
+	// value of AngleSyncSampler::getCompletedCycles() once this record is complete
+	uint32_t cycleNumber;
+	// volts, NAN where no sample was taken
+	float value[ANGLE_SAMPLER_CHANNELS][MAX_CYLINDER_COUNT][ANGLE_SAMPLER_POINTS];
+};
+
+using angle_sample_reader_t = float (*)(adc_channel_e channel);
+
+class AngleSyncSampler : public EngineModule {
+public:
+	AngleSyncSampler();
+
+	void onSlowCallback() override;
+
+	/**
+	 * @param anglesAfterTdc sample angles relative to each cylinder TDC, negative for before TDC
+	 * @return sampler slot or -1 if there are no free slots
+	 */
+	int addChannel(adc_channel_e channel, const angle_t *anglesAfterTdc, size_t pointCount);
+	void clear();
+
+	/**
+	 * Should be invoked on every synchronized trigger tooth while the engine is running
+	 */
+	void onTriggerTooth(uint32_t trgEventIndex, efitick_t edgeTimestamp);
+
+	/**
+	 * Re-resolve sample angles into trigger tooth positions, trigger shape, firing order and TDC
+	 * position all affect the result.
+	 */
+	void updatePositions();
+
+	/**
+	 * @param cyclesAgo zero for the most recent complete cycle
+	 * @return nullptr if the history does not go back that far
+	 */
+	const AngleSampleCycle *getCycle(size_t cyclesAgo = 0) const;
+
+	/**
+	 * @return sample in volts from the most recent complete cycle, NAN if not available
+	 */
+	float getSample(int slot, size_t cylinderIndex, size_t point, size_t cyclesAgo = 0) const;
+
+	uint32_t getCompletedCycles() const {
+		return m_completedCycles;
+	}
+
+	uint32_t getMissedSampleCount() const {
+		return m_missedSamples;
+	}
+
+	/**
+	 * Unit tests have no ADC so they are able to substitute the source of samples
+	 */
+	void setReader(angle_sample_reader_t reader) {
+		m_reader = reader;
+	}
+
+private:
+	struct SamplePoint {
+		event_trigger_position_s position;
+		angle_t angleAfterTdc;
+	};
+
+	struct Channel {
+		adc_channel_e channel;
+		uint8_t pointCount;
+		SamplePoint points[MAX_CYLINDER_COUNT][ANGLE_SAMPLER_POINTS];
+	};
+
+	struct PendingSample {
+		scheduling_s sched;
+		uint8_t slot;
+		uint8_t cylinderIndex;
+		uint8_t point;
+	};
+
+	void updateChannelPositions(Channel& ch);
+	static void onSampleTime(PendingSample *pending);
+	void takeSample(const PendingSample &pending);
+	void startCycle();
+
+	Channel m_channels[ANGLE_SAMPLER_CHANNELS];
+	uint8_t m_channelCount = 0;
+	uint8_t m_cylinderCount = 0;
+
+	PendingSample m_pending[ANGLE_SAMPLER_PENDING];
+	uint8_t m_nextPending = 0;
+
+	AngleSampleCycle m_history[ANGLE_SAMPLER_HISTORY];
+	// record currently being filled
+	volatile uint8_t m_writeIndex = 0;
+	volatile uint32_t m_completedCycles = 0;
+	// until the first trigger index 0 the current record does not cover a full cycle
+	bool m_cycleStarted = false;
+	uint32_t m_missedSamples = 0;
+
+	angle_sample_reader_t m_reader;
+};
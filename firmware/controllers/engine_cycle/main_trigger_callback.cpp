@@ -183,6 +183,14 @@ void InjectionEvent::onTriggerTooth(int rpm, efitick_t nowNt, float currentPhase
 		return;
 	}
 
+#if EFI_LAUNCH_CONTROL
+	if (engine->tractionController.shouldSkipFuel(ownIndex)) {
+		// nothing is injected but the film keeps evaporating, keep wall wetting in step for when fuel resumes
+		wallFuel.adjust(0);
+		return;
+	}
+#endif // EFI_LAUNCH_CONTROL
+
 	// Select fuel mass from the correct cylinder
 	auto injectionMassGrams = engine->injectionMass[this->cylinderNumber];
 
@@ -432,6 +440,8 @@ void mainTriggerCallback(uint32_t trgEventIndex, efitick_t edgeTimestamp, float
 	engine->module<TriggerScheduler>()->scheduleEventsUntilNextTriggerTooth(
 		rpm, trgEventIndex, edgeTimestamp);
 
+	engine->module<AngleSyncSampler>()->onTriggerTooth(trgEventIndex, edgeTimestamp);
+
 	/**
 	 * For spark we schedule both start of coil charge and actual spark based on trigger angle
 	 */
@@ -547,6 +557,12 @@ static void showMainInfo(Engine *engine) {
 	float el = getFuelingLoad();
 	efiPrintf("rpm %d engine_load %.2f", rpm, el);
 	efiPrintf("fuel %.2fms timing %.2f", engine->injectionDuration, engine->engineState.timingAdvance[0]);
+
+	auto& sync = engine->engineState.eventSyncStats;
+	efiPrintf("event sync calc %s: count %d last %dus max %dus, %d over %dus budget",
+		boolToString(engineConfiguration->eventSyncFuelSpark),
+		(int)sync.count, (int)sync.lastUs, (int)sync.maxUs, (int)sync.overBudgetCount, EVENT_SYNC_CALC_BUDGET_US);
+	sync.reset();
 #endif /* EFI_PROD_CODE */
 }
 
@@ -188,6 +188,8 @@ void RpmCalculator::onSlowCallback() {
 void RpmCalculator::setStopped() {
 	revolutionCounterSinceStart = 0;
 
+	toothSpeed.reset();
+
 	rpmRate = 0;
 
 	if (cachedRpmValue != 0) {
@@ -288,6 +290,10 @@ void rpmShaftPositionCallback(trigger_event_e ckpSignalType,
 		engine->triggerCentral.triggerShape, &engine->triggerCentral.triggerFormDetails,
 		index, nowNt);
 
+	rpmState->toothSpeed.onToothEvent(
+		engine->triggerCentral.triggerFormDetails.eventAngles[index],
+		getEngineCycle(engine->getOperationMode()), nowNt);
+
 	float instantRpm = engine->triggerCentral.triggerState.getInstantRpm();
 	if (alwaysInstantRpm) {
 		rpmState->setRpmValue(instantRpm);
@@ -373,11 +379,21 @@ void initRpmCalculator() {
  * Schedules a callback 'angle' degree of crankshaft from now.
  * The callback would be executed once after the duration of time which
  * it takes the crankshaft to rotate to the specified angle.
+ *
+ * By default the conversion uses 'oneDegreeUs' which assumes constant RPM, with 'predictiveAngleScheduling'
+ * we account for crank acceleration as seen by the last few teeth.
  */
 efitick_t scheduleByAngle(scheduling_s *timer, efitick_t edgeTimestamp, angle_t angle,
 		action_s action) {
 	float delayUs = engine->rpmCalculator.oneDegreeUs * angle;
 
+	if (engineConfiguration->predictiveAngleScheduling) {
+		floatus_t predictedUs = engine->rpmCalculator.toothSpeed.getAngleDelayUs(edgeTimestamp, angle);
+		if (!cisnan(predictedUs)) {
+			delayUs = predictedUs;
+		}
+	}
+
     // 'delayNt' is below 10 seconds here so we use 32 bit type for performance reasons
 	int32_t delayNt = USF2NT(delayUs);
 	efitime_t delayedTime = edgeTimestamp + delayNt;
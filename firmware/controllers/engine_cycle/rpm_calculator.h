@@ -12,6 +12,7 @@
 #include "scheduler.h"
 #include "stored_value_sensor.h"
 #include "timer.h"
+#include "tooth_speed_estimator.h"
 
 // we use this value in case of noise on trigger input lines
 #define NOISY_RPM -1
@@ -116,6 +117,11 @@ public:
 	 */
 	volatile floatus_t oneDegreeUs = NAN;
 
+	/**
+	 * Per-tooth angular velocity model, see scheduleByAngle()
+	 */
+	ToothSpeedEstimator toothSpeed;
+
 	Timer lastTdcTimer;
 
 	// RPM rate of change, in RPM per second
@@ -67,19 +67,23 @@ static void fireSparkBySettingPinLow(IgnitionEvent *event, IgnitionOutputPin *ou
 		} \
 }
 
-static void prepareCylinderIgnitionSchedule(angle_t dwellAngleDuration, floatms_t sparkDwell, IgnitionEvent *event) {
-	// todo: clean up this implementation? does not look too nice as is.
-
-	// let's save planned duration so that we can later compare it with reality
-	event->sparkDwell = sparkDwell;
-
-	const angle_t sparkAngle =
+static angle_t getSparkAngle(const IgnitionEvent *event) {
+	return
 		// Negate because timing *before* TDC, and we schedule *after* TDC
 		- engine->engineState.timingAdvance[event->cylinderNumber]
 		// Offset by this cylinder's position in the cycle
 		+ getCylinderAngle(event->cylinderIndex, event->cylinderNumber)
 		// Pull any extra timing for knock retard
 		+ engine->module<KnockController>()->getKnockRetard();
+}
+
+static void prepareCylinderIgnitionSchedule(angle_t dwellAngleDuration, floatms_t sparkDwell, IgnitionEvent *event) {
+	// todo: clean up this implementation? does not look too nice as is.
+
+	// let's save planned duration so that we can later compare it with reality
+	event->sparkDwell = sparkDwell;
+
+	const angle_t sparkAngle = getSparkAngle(event);
 
 	efiAssertVoid(CUSTOM_SPARK_ANGLE_1, !cisnan(sparkAngle), "sparkAngle#1");
 	const int index = engine->ignitionPin[event->cylinderIndex];
@@ -113,7 +117,7 @@ static void prepareCylinderIgnitionSchedule(angle_t dwellAngleDuration, floatms_
 	angle_t dwellStartAngle = sparkAngle - dwellAngleDuration;
 	efiAssertVoid(CUSTOM_ERR_6590, !cisnan(dwellStartAngle), "findAngle#5");
 	assertAngleRange(dwellStartAngle, "findAngle#a6", CUSTOM_ERR_6550);
-	event->dwellPosition.setAngle(dwellStartAngle);
+	engine->ignitionEvents.toothPlan.place(event->cylinderIndex, ToothAction::Dwell, dwellStartAngle, event->dwellPosition);
 
 #if FUEL_MATH_EXTREME_LOGGING
 	if (printFuelDebug) {
@@ -285,6 +289,17 @@ void turnSparkPinHigh(IgnitionEvent *event) {
 	}
 }
 
+/**
+ * Dwell of this event is about to start, spark angle was planned a whole cycle ago.
+ * Dwell start stays where it is, only the spark moves to the current timing.
+ */
+static void refreshSparkAngle(IgnitionEvent *event) {
+	ScopePerf perf(PE::PrepareIgnitionSchedule);
+
+	engine->engineState.updateCylinderTiming(event->cylinderNumber);
+	event->sparkAngle = getSparkAngle(event);
+}
+
 static void scheduleSparkEvent(bool limitedSpark, uint32_t trgEventIndex, IgnitionEvent *event,
 		int rpm, efitick_t edgeTimestamp) {
 
@@ -343,8 +358,10 @@ static void scheduleSparkEvent(bool limitedSpark, uint32_t trgEventIndex, Igniti
 	efiAssertVoid(CUSTOM_ERR_6591, !cisnan(sparkAngle), "findAngle#4");
 	assertAngleRange(sparkAngle, "findAngle#a5", CUSTOM_ERR_6549);
 
+	engine->ignitionEvents.toothPlan.place(event->cylinderIndex, ToothAction::Spark, sparkAngle, event->sparkEvent.position);
+
 	bool scheduled = engine->module<TriggerScheduler>()->scheduleOrQueue(
-		&event->sparkEvent, trgEventIndex, edgeTimestamp, sparkAngle,
+		&event->sparkEvent, trgEventIndex, edgeTimestamp,
 		{ fireSparkAndPrepareNextSchedule, event });
 
 	if (scheduled) {
@@ -384,6 +401,9 @@ void initializeIgnitionActions() {
 	}
 	efiAssertVoid(CUSTOM_ERR_6592, engineConfiguration->specs.cylindersCount > 0, "cylindersCount");
 
+	// trigger shape or cylinder count might have changed, every cylinder is placed again below
+	list->toothPlan.reset();
+
 	for (size_t cylinderIndex = 0; cylinderIndex < engineConfiguration->specs.cylindersCount; cylinderIndex++) {
 		list->elements[cylinderIndex].cylinderIndex = cylinderIndex;
 		prepareCylinderIgnitionSchedule(dwellAngle, sparkDwell, &list->elements[cylinderIndex]);
@@ -443,10 +463,15 @@ void onTriggerEventSparkLogic(bool limitedSpark, uint32_t trgEventIndex, int rpm
 
 //	scheduleSimpleMsg(&logger, "eventId spark ", eventIndex);
 	if (engine->ignitionEvents.isReady) {
-		for (size_t i = 0; i < engineConfiguration->specs.cylindersCount; i++) {
-			IgnitionEvent *event = &engine->ignitionEvents.elements[i];
-			if (event->dwellPosition.triggerEventIndex != trgEventIndex)
+		// only cylinders whose dwell starts on this tooth
+		uint16_t cylinders = engine->ignitionEvents.toothPlan.getDwellCylinders(trgEventIndex);
+
+		for (size_t i = 0; cylinders != 0 && i < engineConfiguration->specs.cylindersCount; i++, cylinders >>= 1) {
+			if (!(cylinders & 1)) {
 				continue;
+			}
+
+			IgnitionEvent *event = &engine->ignitionEvents.elements[i];
 
 			if (i == 0 && engineConfiguration->artificialTestMisfire && (getRevolutionCounter() % ((int)engineConfiguration->scriptSetting[5]) == 0)) {
 				// artificial misfire on cylinder #1 for testing purposes
@@ -459,8 +484,15 @@ void onTriggerEventSparkLogic(bool limitedSpark, uint32_t trgEventIndex, int rpm
 			if (engine->softSparkLimiter.shouldSkip()) {
 				continue;
 			}
+			if (engine->tractionController.shouldSkipSpark(i)) {
+				continue;
+			}
 #endif // EFI_LAUNCH_CONTROL
 
+			if (engine->engineState.isEventSyncActive()) {
+				refreshSparkAngle(event);
+			}
+
 			scheduleSparkEvent(limitedSpark, trgEventIndex, event, rpm, edgeTimestamp);
 		}
 	}
@@ -0,0 +1,100 @@
+/**
+ * @file tooth_plan.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "tooth_plan.h"
+
+#if EFI_ENGINE_CONTROL
+
+void ToothPlan::reset() {
+	memset(m_placements, 0, sizeof(m_placements));
+	memset(m_hasDwellTooth, 0, sizeof(m_hasDwellTooth));
+	memset(m_dwellCylinders, 0, sizeof(m_dwellCylinders));
+}
+
+static angle_t getToothSpan(size_t tooth) {
+	TriggerWaveform& shape = engine->triggerCentral.triggerShape;
+	const angle_t* eventAngles = engine->triggerCentral.triggerFormDetails.eventAngles;
+
+	if (tooth + 1 < shape.getLength()) {
+		return eventAngles[tooth + 1] - eventAngles[tooth];
+	}
+
+	// last tooth, the next one is the first of the next cycle
+	return getEngineCycle(shape.getOperationMode()) + eventAngles[0] - eventAngles[tooth];
+}
+
+void ToothPlan::lookup(Placement& placement, angle_t angle, event_trigger_position_s& position) {
+	m_lookupCount++;
+
+	position.setAngle(angle);
+
+	placement.angle = angle;
+	placement.offset = position.angleOffsetFromTriggerEvent;
+	placement.tooth = position.triggerEventIndex;
+	placement.toothSpan = getToothSpan(placement.tooth);
+	placement.isValid = true;
+}
+
+void ToothPlan::place(size_t cylinderIndex, ToothAction action, angle_t angle, event_trigger_position_s& position) {
+	efiAssertVoid(CUSTOM_ERR_ASSERT, cylinderIndex < MAX_CYLINDER_COUNT, "tooth plan cylinder");
+
+	angle_t triggerOffset = engine->triggerCentral.triggerShape.tdcPosition + engineConfiguration->globalTriggerAngleOffset;
+	if (triggerOffset != m_triggerOffset) {
+		// every angle is on a different tooth now, dwell masks get fixed as cylinders are placed again
+		m_triggerOffset = triggerOffset;
+		for (auto& cylinder : m_placements) {
+			for (auto& placement : cylinder) {
+				placement.isValid = false;
+			}
+		}
+	}
+
+	Placement& placement = m_placements[cylinderIndex][(size_t)action];
+
+	angle_t drift = angle - placement.angle;
+	angle_t offset = placement.offset + drift;
+
+	if (placement.isValid && absF(drift) <= TOOTH_PLAN_REPLAN_ANGLE && offset >= 0 && offset < placement.toothSpan) {
+		// same tooth, a single float write does not need the lock findTriggerPosition takes
+		m_reuseCount++;
+		position.triggerEventIndex = placement.tooth;
+		position.angleOffsetFromTriggerEvent = offset;
+	} else {
+		lookup(placement, angle, position);
+	}
+
+	if (action == ToothAction::Dwell) {
+		moveDwell(cylinderIndex, position.triggerEventIndex);
+	}
+}
+
+void ToothPlan::moveDwell(size_t cylinderIndex, size_t tooth) {
+	if (m_hasDwellTooth[cylinderIndex] && m_dwellTeeth[cylinderIndex] == tooth) {
+		return;
+	}
+
+	if (tooth >= TOOTH_PLAN_MAX_TEETH) {
+		warning(CUSTOM_ERR_ASSERT, "tooth plan: tooth %d out of range", (int)tooth);
+		return;
+	}
+
+	uint16_t mask = 1 << cylinderIndex;
+
+	// trigger handler must never see the cylinder on both teeth, or on neither of them
+	chibios_rt::CriticalSectionLocker csl;
+
+	if (m_hasDwellTooth[cylinderIndex]) {
+		m_dwellCylinders[m_dwellTeeth[cylinderIndex]] &= ~mask;
+	}
+
+	m_dwellCylinders[tooth] |= mask;
+	m_dwellTeeth[cylinderIndex] = tooth;
+	m_hasDwellTooth[cylinderIndex] = true;
+}
+
+#endif // EFI_ENGINE_CONTROL
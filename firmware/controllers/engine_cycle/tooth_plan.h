@@ -0,0 +1,88 @@
+/**
+ * @file tooth_plan.h
+ * @brief Trigger tooth and residual angle of every dwell and spark, kept between engine cycles.
+ *
+ * Every spark used to look up the tooth of its angle twice, once for the spark and once for the
+ * next dwell, and every trigger tooth checked every cylinder to find dwells starting on it.
+ * The plan remembers where each angle landed. As long as the angle drifts by less than
+ * TOOTH_PLAN_REPLAN_ANGLE and stays before the next tooth only the residual angle is moved,
+ * and a per tooth cylinder mask makes the trigger handler look at just the cylinders due on it.
+ *
+ * Injection is scheduled by comparing phases without a tooth lookup, so it is not part of the plan.
+ */
+
+#pragma once
+
+#include "rusefi_types.h"
+#include "trigger_structure.h"
+
+/* degrees of drift from the last full lookup before the tooth is searched again */
+#ifndef TOOTH_PLAN_REPLAN_ANGLE
+#define TOOTH_PLAN_REPLAN_ANGLE 5
+#endif
+
+// same bound as TriggerFormDetails::eventAngles
+#define TOOTH_PLAN_MAX_TEETH (2 * PWM_PHASE_MAX_COUNT)
+
+enum class ToothAction : uint8_t {
+	Dwell,
+	Spark,
+	Count,
+};
+
+class ToothPlan {
+public:
+	/**
+	 * Forget everything, including which teeth have dwells on them.
+	 * Only for when every cylinder is about to be placed again.
+	 */
+	void reset();
+
+	/**
+	 * Sets 'position' to the trigger tooth and the residual angle of 'angle', engine cycle angle
+	 * of given cylinder's action
+	 */
+	void place(size_t cylinderIndex, ToothAction action, angle_t angle, event_trigger_position_s& position);
+
+	/**
+	 * @return cylinders whose dwell starts on this tooth, bit per cylinder index
+	 */
+	uint16_t getDwellCylinders(size_t toothIndex) const {
+		return toothIndex < TOOTH_PLAN_MAX_TEETH ? m_dwellCylinders[toothIndex] : 0;
+	}
+
+	uint32_t getLookupCount() const {
+		return m_lookupCount;
+	}
+
+	uint32_t getReuseCount() const {
+		return m_reuseCount;
+	}
+
+private:
+	struct Placement {
+		// angle of the last full lookup, drift is measured from here
+		angle_t angle;
+		angle_t offset;
+		// the residual angle may grow up to this without moving to the next tooth
+		angle_t toothSpan;
+		uint16_t tooth;
+		bool isValid;
+	};
+
+	static_assert(MAX_CYLINDER_COUNT <= 16, "cylinder mask is 16 bit");
+
+	void lookup(Placement& placement, angle_t angle, event_trigger_position_s& position);
+	void moveDwell(size_t cylinderIndex, size_t tooth);
+
+	Placement m_placements[MAX_CYLINDER_COUNT][(size_t)ToothAction::Count] = {};
+	uint16_t m_dwellTeeth[MAX_CYLINDER_COUNT] = {};
+	bool m_hasDwellTooth[MAX_CYLINDER_COUNT] = {};
+	uint16_t m_dwellCylinders[TOOTH_PLAN_MAX_TEETH] = {};
+
+	// tdcPosition plus globalTriggerAngleOffset the placements were looked up with
+	angle_t m_triggerOffset = 0;
+
+	uint32_t m_lookupCount = 0;
+	uint32_t m_reuseCount = 0;
+};
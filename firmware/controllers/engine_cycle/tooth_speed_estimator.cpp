@@ -0,0 +1,106 @@
+/**
+ * @file    tooth_speed_estimator.cpp
+ *
+ * Each tooth gives us one measurement: average angular velocity over the gap since the previous tooth,
+ * which is the velocity at the middle of that gap. Alpha-beta filter propagates velocity and acceleration
+ * between gap midpoints and blends in the measurement.
+ */
+
+#include "pch.h"
+
+#include "tooth_speed_estimator.h"
+
+// once the engine is this slow the previous estimate is worthless, start over
+#define TOOTH_ESTIMATOR_MAX_GAP_US 500000
+
+/**
+ * Acceleration seen by the last few teeth is mostly one compression or combustion stroke, it does not
+ * last for a whole engine cycle. Past this many degrees we assume the speed reached at that point.
+ */
+#define TOOTH_ESTIMATOR_ACCELERATION_HORIZON 90
+// and even within the horizon a noisy acceleration estimate may not change speed by more than this ratio
+#define TOOTH_ESTIMATOR_MAX_SPEED_CHANGE 0.5f
+
+void ToothSpeedEstimator::reset() {
+	m_lastToothNt = 0;
+	m_degPerUs = 0;
+	m_degPerUs2 = 0;
+	m_updateCount = 0;
+}
+
+void ToothSpeedEstimator::onToothEvent(angle_t toothAngle, angle_t engineCycle, efitick_t nowNt) {
+	if (m_lastToothNt == 0) {
+		m_lastToothAngle = toothAngle;
+		m_lastToothNt = nowNt;
+		return;
+	}
+
+	angle_t angleDelta = toothAngle - m_lastToothAngle;
+	if (angleDelta < 0) {
+		angleDelta += engineCycle;
+	}
+	if (angleDelta == 0) {
+		// second channel edge at the same angle does not tell us anything new
+		return;
+	}
+
+	floatus_t gapUs = NT2USF(nowNt - m_lastToothNt);
+	m_lastToothAngle = toothAngle;
+	m_lastToothNt = nowNt;
+
+	if (gapUs <= 0 || gapUs > TOOTH_ESTIMATOR_MAX_GAP_US) {
+		m_updateCount = 0;
+		return;
+	}
+
+	float measuredDegPerUs = angleDelta / gapUs;
+	efitick_t measurementNt = nowNt - US2NT(gapUs / 2);
+
+	if (m_updateCount == 0) {
+		m_degPerUs = measuredDegPerUs;
+		m_degPerUs2 = 0;
+	} else {
+		floatus_t dtUs = NT2USF(measurementNt - m_estimateNt);
+		if (dtUs <= 0) {
+			return;
+		}
+		float predicted = m_degPerUs + m_degPerUs2 * dtUs;
+		float residual = measuredDegPerUs - predicted;
+
+		m_degPerUs = predicted + alpha * residual;
+		m_degPerUs2 += beta * residual / dtUs;
+	}
+
+	m_estimateNt = measurementNt;
+	m_updateCount++;
+}
+
+bool ToothSpeedEstimator::isValid() const {
+	return m_updateCount >= 3 && m_degPerUs > 0;
+}
+
+floatus_t ToothSpeedEstimator::getAngleDelayUs(efitick_t fromNt, angle_t angle) const {
+	if (!isValid()) {
+		return NAN;
+	}
+
+	float velocity = m_degPerUs + m_degPerUs2 * NT2USF(fromNt - m_estimateNt);
+	if (velocity <= 0) {
+		return NAN;
+	}
+
+	angle_t acceleratedAngle = minF(angle, TOOTH_ESTIMATOR_ACCELERATION_HORIZON);
+
+	/**
+	 * angle = velocity * t + acceleration * t^2 / 2
+	 * written in the form which does not blow up when acceleration is (close to) zero
+	 */
+	float discriminant = velocity * velocity + 2 * m_degPerUs2 * acceleratedAngle;
+
+	float minVelocity = velocity * (1 - TOOTH_ESTIMATOR_MAX_SPEED_CHANGE);
+	float maxVelocity = velocity * (1 + TOOTH_ESTIMATOR_MAX_SPEED_CHANGE);
+	float finalVelocity = sqrtf(clampF(minVelocity * minVelocity, discriminant, maxVelocity * maxVelocity));
+
+	floatus_t acceleratedUs = 2 * acceleratedAngle / (velocity + finalVelocity);
+	return acceleratedUs + (angle - acceleratedAngle) / finalVelocity;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file    tooth_speed_estimator.h
+ * @brief   Tooth-resolution crankshaft angular velocity/acceleration estimator
+ *
+ * oneDegreeUs is refreshed once per engine cycle (or from a 90 degree window with alwaysInstantRpm) so
+ * it lags badly while cranking and during hard acceleration. This is a small alpha-beta filter fed with
+ * every trigger tooth which tracks angular velocity and acceleration, and predicts when the crank
+ * will have turned by a given angle.
+ */
+
+#pragma once
+
+#include "rusefi_types.h"
+
+class ToothSpeedEstimator {
+public:
+	void reset();
+
+	/**
+	 * Should be invoked on every synchronized trigger tooth.
+	 * @param toothAngle angle of this tooth from the trigger sync point
+	 * @param engineCycle length of the cycle toothAngle wraps around
+	 */
+	void onToothEvent(angle_t toothAngle, angle_t engineCycle, efitick_t nowNt);
+
+	/**
+	 * Prediction needs a couple of teeth worth of history
+	 */
+	bool isValid() const;
+
+	/**
+	 * @return how long it would take the crank to turn by 'angle' degrees starting at 'fromNt', or NAN if we do not know
+	 */
+	floatus_t getAngleDelayUs(efitick_t fromNt, angle_t angle) const;
+
+	/**
+	 * @return current angular velocity estimate, degrees per microsecond
+	 */
+	float getDegreesPerUs() const {
+		return m_degPerUs;
+	}
+
+	/**
+	 * @return current angular acceleration estimate, degrees per microsecond squared
+	 */
+	float getDegreesPerUs2() const {
+		return m_degPerUs2;
+	}
+
+	angle_t getLastToothAngle() const {
+		return m_lastToothAngle;
+	}
+
+	efitick_t getLastToothNt() const {
+		return m_lastToothNt;
+	}
+
+	uint32_t getUpdateCount() const {
+		return m_updateCount;
+	}
+
+	// filter gains, tuned against real cranking captures in test_predictive_rpm.cpp
+	float alpha = 0.5f;
+	float beta = 0.1f;
+
+private:
+	angle_t m_lastToothAngle = 0;
+	efitick_t m_lastToothNt = 0;
+	// time of the middle of the last measured tooth gap, this is where m_degPerUs/m_degPerUs2 are estimated
+	efitick_t m_estimateNt = 0;
+	float m_degPerUs = 0;
+	float m_degPerUs2 = 0;
+	uint32_t m_updateCount = 0;
+};
@@ -27,6 +27,14 @@
 
 #include "runtime_state.h"
 
+#if EFI_CONFIG_JOURNAL
+#include "config_journal.h"
+
+#if EFI_ACTIVE_CONFIGURATION_IN_FLASH
+#error "EFI_ACTIVE_CONFIGURATION_IN_FLASH needs a full configuration copy in flash, it does not work with EFI_CONFIG_JOURNAL"
+#endif
+#endif
+
 static bool needToWriteConfiguration = false;
 
 /* if we store settings externally */
@@ -75,6 +83,75 @@ static uint32_t flashStateCrc(const persistent_config_container_s& state) {
 	return crc32(&state.persistentConfiguration, sizeof(persistent_config_s));
 }
 
+#if EFI_STORAGE_INT_FLASH == TRUE && EFI_CONFIG_JOURNAL
+/**
+ * Both configuration copy areas are used as journal banks, so a burn is an append of the
+ * changed pages and sectors are only erased when the journal gets compacted.
+ */
+class IntFlashJournal : public JournalFlash {
+public:
+	size_t getBankSize() const override {
+		auto first = getFlashAddrFirstCopy();
+		auto second = getFlashAddrSecondCopy();
+
+		// no room for a second copy on this device
+		if (!first || !second) {
+			return 0;
+		}
+
+		return first > second ? first - second : second - first;
+	}
+
+	bool erase(size_t bank) override {
+		return intFlashErase(getBankAddress(bank), getBankSize()) == FLASH_RETURN_SUCCESS;
+	}
+
+	bool write(size_t bank, size_t offset, const void* data, size_t size) override {
+		return intFlashWrite(getBankAddress(bank) + offset, reinterpret_cast<const char*>(data), size) == FLASH_RETURN_SUCCESS;
+	}
+
+	bool read(size_t bank, size_t offset, void* data, size_t size) override {
+		return intFlashRead(getBankAddress(bank) + offset, reinterpret_cast<char*>(data), size) == FLASH_RETURN_SUCCESS;
+	}
+
+private:
+	static flashaddr_t getBankAddress(size_t bank) {
+		return bank == 0 ? getFlashAddrFirstCopy() : getFlashAddrSecondCopy();
+	}
+};
+
+static IntFlashJournal intFlashJournal;
+static ConfigJournalBuffer<sizeof(persistent_config_s)> configJournal(intFlashJournal, &persistentState.persistentConfiguration, FLASH_DATA_VERSION);
+
+static bool useConfigJournal() {
+	return configJournal.fits();
+}
+
+// time of the last burn, compaction excluded
+static efitick_t lastBurnNt = 0;
+
+static void compactConfigJournalIfNeeded() {
+	if (!useConfigJournal() || !configJournal.needsCompaction()) {
+		return;
+	}
+
+	efiPrintf("Compacting configuration journal...");
+	if (!configJournal.compact()) {
+		efiPrintf("Configuration journal compaction failed");
+	}
+}
+
+static void printConfigJournalInfo() {
+	if (!useConfigJournal()) {
+		efiPrintf("Config journal: does not fit, using full copies");
+		return;
+	}
+
+	configJournal.printInfo();
+	efiPrintf("    last burn took %d us", (int)NT2US(lastBurnNt));
+}
+#endif // EFI_STORAGE_INT_FLASH && EFI_CONFIG_JOURNAL
+
 #if EFI_FLASH_WRITE_THREAD
 chibios_rt::BinarySemaphore flashWriteSemaphore(/*taken =*/ true);
 
@@ -93,6 +170,11 @@ static void flashWriteThread(void*) {
 
 		// Do the actual flash write operation
 		writeToFlashNow();
+
+#if EFI_STORAGE_INT_FLASH == TRUE && EFI_CONFIG_JOURNAL
+		// make room for the next burn while nobody is waiting for us
+		compactConfigJournalIfNeeded();
+#endif
 	}
 }
 #endif // EFI_FLASH_WRITE_THREAD
@@ -125,6 +207,11 @@ void writeToFlashIfPending() {
 	// Prevent sensor timeouts while flashing
 	Sensor::inhibitTimeouts(true);
 	writeToFlashNow();
+
+#if EFI_STORAGE_INT_FLASH == TRUE && EFI_CONFIG_JOURNAL
+	// engine is stopped anyway
+	compactConfigJournalIfNeeded();
+#endif
 }
 
 // Erase and write a copy of the configuration at the specified address
@@ -180,12 +267,21 @@ void writeToFlashNow(void) {
 #endif
 
 #if EFI_STORAGE_INT_FLASH == TRUE
-	// Flash two copies
-	int result1 = eraseAndFlashCopy(getFlashAddrFirstCopy(), persistentState);
-	int result2 = eraseAndFlashCopy(getFlashAddrSecondCopy(), persistentState);
+#if EFI_CONFIG_JOURNAL
+	if (useConfigJournal()) {
+		efitick_t startNt = getTimeNowNt();
+		isSuccess = configJournal.commit();
+		lastBurnNt = getTimeNowNt() - startNt;
+	} else
+#endif
+	{
+		// Flash two copies
+		int result1 = eraseAndFlashCopy(getFlashAddrFirstCopy(), persistentState);
+		int result2 = eraseAndFlashCopy(getFlashAddrSecondCopy(), persistentState);
 
-	// handle success/failure
-	isSuccess = (result1 == FLASH_RETURN_SUCCESS) && (result2 == FLASH_RETURN_SUCCESS);
+		// handle success/failure
+		isSuccess = (result1 == FLASH_RETURN_SUCCESS) && (result2 == FLASH_RETURN_SUCCESS);
+	}
 #endif
 
 	if (isSuccess) {
@@ -263,6 +359,28 @@ static FlashState readConfiguration() {
 #endif
 
 #if EFI_STORAGE_INT_FLASH == TRUE
+#if EFI_CONFIG_JOURNAL
+	if (useConfigJournal()) {
+		switch (configJournal.mount()) {
+			case JournalState::Ok:
+				// every replayed record passed its own CRC check and the snapshot is complete,
+				// keep the container consistent with what a full copy would have looked like
+				persistentState.size = sizeof(persistentState);
+				persistentState.version = FLASH_DATA_VERSION;
+				persistentState.value = flashStateCrc(persistentState);
+				return FlashState::Ok;
+			case JournalState::IncompatibleVersion:
+				return FlashState::IncompatibleVersion;
+			case JournalState::Corrupt:
+				// legacy copies are older than the journal, better defaults than a stale tune
+				return FlashState::CrcFailed;
+			case JournalState::Blank:
+				// first boot after an update, tune is still stored as full copies
+				break;
+		}
+	}
+#endif
+
 	auto firstCopyAddr = getFlashAddrFirstCopy();
 	auto secondyCopyAddr = getFlashAddrSecondCopy();
 
@@ -362,6 +480,9 @@ void initFlash() {
 #endif
 	addConsoleAction("resetconfig", doResetConfiguration);
 	addConsoleAction("rewriteconfig", rewriteConfig);
+#if EFI_STORAGE_INT_FLASH == TRUE && EFI_CONFIG_JOURNAL
+	addConsoleAction("journalinfo", printConfigJournalInfo);
+#endif
 
 #if EFI_FLASH_WRITE_THREAD
 	if (allowFlashWhileRunning()) {
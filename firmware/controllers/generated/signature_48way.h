@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 2671992875
-#define TS_SIGNATURE "rusEFI 2022.08.22.48way.2671992875"
+#define SIGNATURE_HASH 2306067906
+#define TS_SIGNATURE "rusEFI 2022.08.22.48way.2306067906"
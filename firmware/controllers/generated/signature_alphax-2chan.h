@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 3128358152
-#define TS_SIGNATURE "rusEFI 2022.08.22.alphax-2chan.3128358152"
+#define SIGNATURE_HASH 1459143187
+#define TS_SIGNATURE "rusEFI 2022.08.22.alphax-2chan.1459143187"
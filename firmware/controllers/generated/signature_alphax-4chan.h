@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 58239979
-#define TS_SIGNATURE "rusEFI 2022.08.22.alphax-4chan.58239979"
+#define SIGNATURE_HASH 385323332
+#define TS_SIGNATURE "rusEFI 2022.08.22.alphax-4chan.385323332"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 2494471491
-#define TS_SIGNATURE "rusEFI 2022.08.22.atlas.2494471491"
+#define SIGNATURE_HASH 3532667651
+#define TS_SIGNATURE "rusEFI 2022.08.22.atlas.3532667651"
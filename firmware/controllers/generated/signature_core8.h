@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 2122856861
-#define TS_SIGNATURE "rusEFI 2022.08.22.core8.2122856861"
+#define SIGNATURE_HASH 1696016394
+#define TS_SIGNATURE "rusEFI 2022.08.22.core8.1696016394"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on hellen_cypress_gen_config.bat null
 //
 
-#define SIGNATURE_HASH 2288281700
-#define TS_SIGNATURE "rusEFI 2022.08.22.cypress.2288281700"
+#define SIGNATURE_HASH 2388021950
+#define TS_SIGNATURE "rusEFI 2022.08.22.cypress.2388021950"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 3389559968
-#define TS_SIGNATURE "rusEFI 2022.08.22.frankenso_na6.3389559968"
+#define SIGNATURE_HASH 3925235828
+#define TS_SIGNATURE "rusEFI 2022.08.22.frankenso_na6.3925235828"
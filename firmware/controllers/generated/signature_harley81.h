@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 2023320907
-#define TS_SIGNATURE "rusEFI 2022.08.22.harley81.2023320907"
+#define SIGNATURE_HASH 4196238981
+#define TS_SIGNATURE "rusEFI 2022.08.22.harley81.4196238981"
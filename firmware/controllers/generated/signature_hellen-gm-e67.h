@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 1006890450
-#define TS_SIGNATURE "rusEFI 2022.08.22.hellen-gm-e67.1006890450"
+#define SIGNATURE_HASH 3577633778
+#define TS_SIGNATURE "rusEFI 2022.08.22.hellen-gm-e67.3577633778"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 1374640552
-#define TS_SIGNATURE "rusEFI 2022.08.22.hellen-nb1.1374640552"
+#define SIGNATURE_HASH 1861587650
+#define TS_SIGNATURE "rusEFI 2022.08.22.hellen-nb1.1861587650"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 12243086
-#define TS_SIGNATURE "rusEFI 2022.08.22.hellen121nissan.12243086"
+#define SIGNATURE_HASH 146170988
+#define TS_SIGNATURE "rusEFI 2022.08.22.hellen121nissan.146170988"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 4165315358
-#define TS_SIGNATURE "rusEFI 2022.08.22.hellen121vag.4165315358"
+#define SIGNATURE_HASH 1313561017
+#define TS_SIGNATURE "rusEFI 2022.08.22.hellen121vag.1313561017"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 1989825882
-#define TS_SIGNATURE "rusEFI 2022.08.22.hellen128.1989825882"
+#define SIGNATURE_HASH 2311317449
+#define TS_SIGNATURE "rusEFI 2022.08.22.hellen128.2311317449"
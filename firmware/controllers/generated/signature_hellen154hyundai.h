@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 271260384
-#define TS_SIGNATURE "rusEFI 2022.08.22.hellen154hyundai.271260384"
+#define SIGNATURE_HASH 2633475591
+#define TS_SIGNATURE "rusEFI 2022.08.22.hellen154hyundai.2633475591"
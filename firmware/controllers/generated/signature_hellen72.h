@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 2052800864
-#define TS_SIGNATURE "rusEFI 2022.08.22.hellen72.2052800864"
+#define SIGNATURE_HASH 1674277391
+#define TS_SIGNATURE "rusEFI 2022.08.22.hellen72.1674277391"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 2865868910
-#define TS_SIGNATURE "rusEFI 2022.08.22.hellen81.2865868910"
+#define SIGNATURE_HASH 1590198729
+#define TS_SIGNATURE "rusEFI 2022.08.22.hellen81.1590198729"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 2643557288
-#define TS_SIGNATURE "rusEFI 2022.08.22.hellen88bmw.2643557288"
+#define SIGNATURE_HASH 3906645979
+#define TS_SIGNATURE "rusEFI 2022.08.22.hellen88bmw.3906645979"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 183474436
-#define TS_SIGNATURE "rusEFI 2022.08.22.hellenNA6.183474436"
+#define SIGNATURE_HASH 1679896530
+#define TS_SIGNATURE "rusEFI 2022.08.22.hellenNA6.1679896530"
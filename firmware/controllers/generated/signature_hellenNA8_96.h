@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 678287756
-#define TS_SIGNATURE "rusEFI 2022.08.22.hellenNA8_96.678287756"
+#define SIGNATURE_HASH 1298404377
+#define TS_SIGNATURE "rusEFI 2022.08.22.hellenNA8_96.1298404377"
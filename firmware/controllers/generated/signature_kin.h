@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on kinetis_gen_config.bat null
 //
 
-#define SIGNATURE_HASH 3769879208
-#define TS_SIGNATURE "rusEFI 2022.08.22.kin.3769879208"
+#define SIGNATURE_HASH 2019986005
+#define TS_SIGNATURE "rusEFI 2022.08.22.kin.2019986005"
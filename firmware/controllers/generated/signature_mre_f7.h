@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 1202906258
-#define TS_SIGNATURE "rusEFI 2022.08.22.mre_f7.1202906258"
+#define SIGNATURE_HASH 2166832264
+#define TS_SIGNATURE "rusEFI 2022.08.22.mre_f7.2166832264"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 3633230210
-#define TS_SIGNATURE "rusEFI 2022.08.22.prometheus_405.3633230210"
+#define SIGNATURE_HASH 564499953
+#define TS_SIGNATURE "rusEFI 2022.08.22.prometheus_405.564499953"
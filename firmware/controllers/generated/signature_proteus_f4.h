@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 766095122
-#define TS_SIGNATURE "rusEFI 2022.08.22.proteus_f4.766095122"
+#define SIGNATURE_HASH 119910694
+#define TS_SIGNATURE "rusEFI 2022.08.22.proteus_f4.119910694"
@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on config/boards/subaru_eg33/config/gen_subaru_config.sh null
 //
 
-#define SIGNATURE_HASH 3327778780
-#define TS_SIGNATURE "rusEFI 2022.08.22.subaru_eg33_f7.3327778780"
+#define SIGNATURE_HASH 3663406565
+#define TS_SIGNATURE "rusEFI 2022.08.22.subaru_eg33_f7.3663406565"
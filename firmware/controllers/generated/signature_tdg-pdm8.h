@@ -2,5 +2,5 @@
 // was generated automatically by rusEFI tool ConfigDefinition.jar based on gen_config.sh null
 //
 
-#define SIGNATURE_HASH 577545776
-#define TS_SIGNATURE "rusEFI 2022.08.22.tdg-pdm8.577545776"
+#define SIGNATURE_HASH 3826172949
+#define TS_SIGNATURE "rusEFI 2022.08.22.tdg-pdm8.3826172949"
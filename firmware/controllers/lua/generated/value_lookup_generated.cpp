@@ -838,6 +838,10 @@ float getConfigValueByName(const char *name) {
 		return engineConfiguration->mc33_t_hold_tot;
 	if (strEqualCaseInsensitive(name, "maxCamPhaseResolveRpm"))
 		return engineConfiguration->maxCamPhaseResolveRpm;
+	if (strEqualCaseInsensitive(name, "mapAdcDecimation"))
+		return engineConfiguration->mapAdcDecimation;
+	if (strEqualCaseInsensitive(name, "tpsAdcDecimation"))
+		return engineConfiguration->tpsAdcDecimation;
 	if (strEqualCaseInsensitive(name, "hpfpCamLobes"))
 		return engineConfiguration->hpfpCamLobes;
 	if (strEqualCaseInsensitive(name, "hpfpPeakPos"))
@@ -2560,6 +2564,16 @@ void setConfigValueByName(const char *name, float value) {
 		engineConfiguration->maxCamPhaseResolveRpm = (int)value;
 		return;
 	}
+	if (strEqualCaseInsensitive(name, "mapAdcDecimation"))
+	{
+		engineConfiguration->mapAdcDecimation = (int)value;
+		return;
+	}
+	if (strEqualCaseInsensitive(name, "tpsAdcDecimation"))
+	{
+		engineConfiguration->tpsAdcDecimation = (int)value;
+		return;
+	}
 	if (strEqualCaseInsensitive(name, "hpfpCamLobes"))
 	{
 		engineConfiguration->hpfpCamLobes = (int)value;
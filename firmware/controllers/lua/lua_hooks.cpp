@@ -100,6 +100,63 @@ static int lua_hasSensor(lua_State* l) {
 	return 1;
 }
 
+static int lua_enableSensorHistory(lua_State* l) {
+	auto zeroBasedSensorIndex = luaL_checkinteger(l, 1);
+
+	lua_pushboolean(l, Sensor::enableHistory(static_cast<SensorType>(zeroBasedSensorIndex)));
+	return 1;
+}
+
+static int pushHistoryResult(lua_State* l, expected<float> result) {
+	if (result) {
+		lua_pushnumber(l, result.Value);
+	} else {
+		lua_pushnil(l);
+	}
+
+	return 1;
+}
+
+/**
+ * Common part of sensor history queries: sensor index and a time span in seconds
+ * @return nullptr if this sensor has no history
+ */
+static const SensorHistory* getSensorHistoryArgs(lua_State* l, efitick_t& spanNt) {
+	auto zeroBasedSensorIndex = luaL_checkinteger(l, 1);
+	auto seconds = luaL_checknumber(l, 2);
+
+	spanNt = USF2NT(seconds * 1e6);
+	return Sensor::getHistory(static_cast<SensorType>(zeroBasedSensorIndex));
+}
+
+static int lua_getSensorHistoryAt(lua_State* l) {
+	efitick_t secondsAgoNt;
+	auto history = getSensorHistoryArgs(l, secondsAgoNt);
+
+	return pushHistoryResult(l, history ? history->getValueAt(getTimeNowNt() - secondsAgoNt) : unexpected);
+}
+
+static int lua_getSensorRate(lua_State* l) {
+	efitick_t windowNt;
+	auto history = getSensorHistoryArgs(l, windowNt);
+
+	return pushHistoryResult(l, history ? history->getRateOfChange(windowNt) : unexpected);
+}
+
+static int lua_getSensorMin(lua_State* l) {
+	efitick_t windowNt;
+	auto history = getSensorHistoryArgs(l, windowNt);
+
+	return pushHistoryResult(l, history ? history->getMin(windowNt, getTimeNowNt()) : unexpected);
+}
+
+static int lua_getSensorMax(lua_State* l) {
+	efitick_t windowNt;
+	auto history = getSensorHistoryArgs(l, windowNt);
+
+	return pushHistoryResult(l, history ? history->getMax(windowNt, getTimeNowNt()) : unexpected);
+}
+
 /**
  * @return number of elements
  */
@@ -584,6 +641,11 @@ void configureRusefiLuaHooks(lua_State* l) {
 	lua_register(l, "getSensor", lua_getSensorByName);
 	lua_register(l, "getSensorRaw", lua_getSensorRaw);
 	lua_register(l, "hasSensor", lua_hasSensor);
+	lua_register(l, "enableSensorHistory", lua_enableSensorHistory);
+	lua_register(l, "getSensorHistoryAt", lua_getSensorHistoryAt);
+	lua_register(l, "getSensorRate", lua_getSensorRate);
+	lua_register(l, "getSensorMin", lua_getSensorMin);
+	lua_register(l, "getSensorMax", lua_getSensorMax);
 	lua_register(l, "table3d", [](lua_State* l) {
 		auto humanTableIdx = luaL_checkinteger(l, 1);
 		auto x = luaL_checknumber(l, 2);
@@ -657,8 +719,67 @@ void configureRusefiLuaHooks(lua_State* l) {
 		engine->softSparkLimiter.setTargetSkipRatio(targetSkipRatio);
 		return 1;
 	});
+
+	lua_register(l, "setTractionControlSlip", [](lua_State* l) {
+		auto targetSlip = luaL_checknumber(l, 1);
+		auto fullCutSlip = luaL_checknumber(l, 2);
+		engine->tractionController.setSlipTargets(targetSlip, fullCutSlip);
+		return 0;
+	});
+
+	lua_register(l, "setTractionControlMaxCut", [](lua_State* l) {
+		auto maxCutRatio = luaL_checknumber(l, 1);
+		engine->tractionController.setMaxCutRatio(maxCutRatio);
+		return 0;
+	});
+
+	lua_register(l, "setTractionControlFuelCut", [](lua_State* l) {
+		engine->tractionController.setUseFuelCut(lua_toboolean(l, 1));
+		return 0;
+	});
+
+	lua_register(l, "getTractionControlSlip", [](lua_State* l) {
+		lua_pushnumber(l, engine->tractionController.getSlip());
+		return 1;
+	});
 #endif // EFI_LAUNCH_CONTROL
 
+	/**
+	 * addAngleSampler(adcChannel, angleAfterTdc, ...) samples given ADC channel at up to ANGLE_SAMPLER_POINTS
+	 * angles after each cylinder's TDC, adcChannel is the value as stored in configuration
+	 * @return sampler slot for getAngleSample, nil if all slots are taken
+	 */
+	lua_register(l, "addAngleSampler", [](lua_State* l) {
+		auto channel = static_cast<adc_channel_e>(luaL_checkinteger(l, 1));
+		angle_t angles[ANGLE_SAMPLER_POINTS];
+		size_t pointCount = minI(lua_gettop(l) - 1, ANGLE_SAMPLER_POINTS);
+		for (size_t i = 0; i < pointCount; i++) {
+			angles[i] = luaL_checknumber(l, i + 2);
+		}
+
+		int slot = engine->module<AngleSyncSampler>()->addChannel(channel, angles, pointCount);
+		if (slot < 0) {
+			lua_pushnil(l);
+		} else {
+			lua_pushinteger(l, slot);
+		}
+		return 1;
+	});
+
+	lua_register(l, "getAngleSample", [](lua_State* l) {
+		auto slot = luaL_checkinteger(l, 1);
+		auto zeroBasedCylinderIndex = luaL_checkinteger(l, 2);
+		auto point = luaL_checkinteger(l, 3);
+
+		float volts = engine->module<AngleSyncSampler>()->getSample(slot, zeroBasedCylinderIndex, point);
+		if (cisnan(volts)) {
+			lua_pushnil(l);
+		} else {
+			lua_pushnumber(l, volts);
+		}
+		return 1;
+	});
+
 	lua_register(l, "enableCanTx", [](lua_State* l) {
 		engine->allowCanTx = lua_toboolean(l, 1);
 		return 0;
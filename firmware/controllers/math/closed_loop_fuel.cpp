@@ -96,32 +96,55 @@ bool shouldUpdateCorrection(SensorType sensor) {
 	return true;
 }
 
+static bool shouldApplyLongTermTrim() {
+#if EFI_SHAFT_POSITION_INPUT
+	return engineConfiguration->enableLongTermFuelTrim && engine->rpmCalculator.isRunning();
+#else
+	return false;
+#endif // EFI_SHAFT_POSITION_INPUT
+}
+
 ClosedLoopFuelResult fuelClosedLoopCorrection() {
-	if (!shouldCorrect()) {
-		return {};
-	}
+	ClosedLoopFuelResult result;
+
+	float rpm = Sensor::getOrZero(SensorType::Rpm);
+	float load = getFuelingLoad();
 
-	size_t binIdx = computeStftBin(Sensor::getOrZero(SensorType::Rpm), getFuelingLoad(), engineConfiguration->stft);
+	bool useLongTermTrim = shouldApplyLongTermTrim();
+	auto& ltft = engine->module<LongTermFuelTrim>();
+
+	if (shouldCorrect()) {
+		size_t binIdx = computeStftBin(rpm, load, engineConfiguration->stft);
 
 #if EFI_TUNER_STUDIO
-	engine->outputChannels.fuelClosedLoopBinIdx = binIdx;
+		engine->outputChannels.fuelClosedLoopBinIdx = binIdx;
 #endif // EFI_TUNER_STUDIO
 
-	ClosedLoopFuelResult result;
+		for (int i = 0; i < STFT_BANK_COUNT; i++) {
+			auto& cell = banks[i].cells[binIdx];
 
-	for (int i = 0; i < STFT_BANK_COUNT; i++) {
-		auto& cell = banks[i].cells[binIdx];
+			SensorType sensor = getSensorForBankIndex(i);
 
-		SensorType sensor = getSensorForBankIndex(i);
+			// todo: push configuration at startup
+			cell.configure(&engineConfiguration->stft.cellCfgs[binIdx], sensor);
 
-		// todo: push configuration at startup
-		cell.configure(&engineConfiguration->stft.cellCfgs[binIdx], sensor);
+			if (shouldUpdateCorrection(sensor)) {
+				cell.update(engineConfiguration->stft.deadband * 0.01f, engineConfiguration->stftIgnoreErrorMagnitude);
 
-		if (shouldUpdateCorrection(sensor)) {
-			cell.update(engineConfiguration->stft.deadband * 0.01f, engineConfiguration->stftIgnoreErrorMagnitude);
+				if (useLongTermTrim) {
+					ltft->learn(i, rpm, load, cell.getAdjustment() - 1, FAST_CALLBACK_PERIOD_MS * 0.001f);
+				}
+			}
+
+			result.banks[i] = cell.getAdjustment();
 		}
+	}
 
-		result.banks[i] = cell.getAdjustment();
+	// learned trims also apply while short term correction is waiting for warmup
+	if (useLongTermTrim) {
+		for (int i = 0; i < STFT_BANK_COUNT; i++) {
+			result.banks[i] *= ltft->getTrim(i, rpm, load);
+		}
 	}
 
 	return result;
@@ -0,0 +1,211 @@
+/**
+ * @file long_term_fuel_trim.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "long_term_fuel_trim.h"
+#include "config_change_tracker.h"
+
+#if EFI_PROD_CODE
+#include "backup_ram.h"
+#endif // EFI_PROD_CODE
+
+// while learning, backup RAM is refreshed at most this often
+#define LTFT_SAVE_PERIOD_SEC 1
+
+uint32_t getLtftAxesCrc() {
+	uint32_t crc = crc32(config->veLoadBins, sizeof(config->veLoadBins));
+	return crc32inc(config->veRpmBins, crc, sizeof(config->veRpmBins));
+}
+
+/**
+ * Four cells around the operating point and their bilinear weights, which add up to one
+ */
+struct LtftCorners {
+	size_t row;
+	size_t col;
+	float weights[2][2];
+};
+
+static LtftCorners getCorners(float rpm, float load) {
+	BinFraction row = getBinFraction(load, config->veLoadBins);
+	BinFraction col = getBinFraction(rpm, config->veRpmBins);
+
+	return { row.idx, col.idx, {
+		{ (1 - row.frac) * (1 - col.frac), (1 - row.frac) * col.frac },
+		{ row.frac * (1 - col.frac), row.frac * col.frac },
+	} };
+}
+
+float LongTermFuelTrim::getTrim(size_t bank, float rpm, float load) const {
+	LtftCorners corners = getCorners(rpm, load);
+	const auto& trims = m_table.trims[bank];
+
+	float trim = 0;
+	for (size_t i = 0; i < 2; i++) {
+		for (size_t j = 0; j < 2; j++) {
+			trim += corners.weights[i][j] * trims[corners.row + i][corners.col + j];
+		}
+	}
+
+	return 1 + trim;
+}
+
+void LongTermFuelTrim::learn(size_t bank, float rpm, float load, float stftAdjustment, float dt) {
+	LtftCorners corners = getCorners(rpm, load);
+	auto& trims = m_table.trims[bank];
+
+	float step = stftAdjustment * dt / LTFT_TIME_CONSTANT;
+
+	for (size_t i = 0; i < 2; i++) {
+		for (size_t j = 0; j < 2; j++) {
+			float& cell = trims[corners.row + i][corners.col + j];
+			cell = clampF(-LTFT_MAX_TRIM, cell + step * corners.weights[i][j], LTFT_MAX_TRIM);
+		}
+	}
+
+	m_dirty = true;
+}
+
+void LongTermFuelTrim::reset() {
+	m_table = {};
+	m_axesCrc = getLtftAxesCrc();
+	m_dirty = true;
+}
+
+static uint32_t getStorageCrc(const LtftStorage& storage) {
+	return crc32(&storage, offsetof(LtftStorage, crc));
+}
+
+/**
+ * A CRC match on random backup RAM content is unlikely but not impossible, the trims
+ * also have to be something learn() could have produced
+ */
+static bool isPlausible(const LtftTable& table) {
+	for (const auto& bank : table.trims) {
+		for (const auto& row : bank) {
+			for (float trim : row) {
+				if (cisnan(trim) || trim < -LTFT_MAX_TRIM || trim > LTFT_MAX_TRIM) {
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+bool LongTermFuelTrim::load(const LtftStorage& storage) {
+	bool isValid = storage.version == LTFT_STORAGE_VERSION
+		&& storage.axesCrc == getLtftAxesCrc()
+		&& storage.crc == getStorageCrc(storage)
+		&& isPlausible(storage.table);
+
+	if (!isValid) {
+		// backup domain lost power or got corrupted, nothing in there can be trusted
+		reset();
+		return false;
+	}
+
+	m_table = storage.table;
+	m_axesCrc = storage.axesCrc;
+	m_dirty = false;
+	return true;
+}
+
+void LongTermFuelTrim::save(LtftStorage& storage) {
+	storage.version = LTFT_STORAGE_VERSION;
+	storage.axesCrc = m_axesCrc;
+	storage.table = m_table;
+	storage.crc = getStorageCrc(storage);
+
+	m_dirty = false;
+}
+
+static LtftStorage* getStorage() {
+#if EFI_PROD_CODE
+	auto sram = getBackupSram();
+	// not every port has backup RAM
+	return sram ? &sram->Ltft : nullptr;
+#else
+	return nullptr;
+#endif // EFI_PROD_CODE
+}
+
+void LongTermFuelTrim::saveToBackupRam() {
+	auto storage = getStorage();
+	if (storage) {
+		save(*storage);
+	}
+
+	m_sinceSave.reset();
+}
+
+void LongTermFuelTrim::onConfigurationChange(engine_configuration_s const * /*previousConfig*/) {
+	// new axes move every cell somewhere else, start over
+	if (getLtftAxesCrc() != m_axesCrc) {
+		reset();
+	}
+}
+
+bool LongTermFuelTrim::isAffectedBy(const ConfigChangeTracker& changes) const {
+	static constexpr ConfigRange dependencies[] = {
+		TABLE_CONFIG_RANGE(veLoadBins),
+		TABLE_CONFIG_RANGE(veRpmBins),
+	};
+
+	return changes.isAnyChanged(dependencies);
+}
+
+void LongTermFuelTrim::onSlowCallback() {
+	if (!m_isLoaded) {
+		m_isLoaded = true;
+
+		auto storage = getStorage();
+		if (storage && !load(*storage)) {
+			efiPrintf("LTFT: no valid table in backup RAM for the current VE axes, starting from zero");
+		}
+	}
+
+	// a couple of kilobytes copied and checksummed, cheap enough to not need a thread of its own
+	if (m_dirty && m_sinceSave.hasElapsedSec(LTFT_SAVE_PERIOD_SEC)) {
+		saveToBackupRam();
+	}
+}
+
+void LongTermFuelTrim::onIgnitionStateChanged(bool ignitionOn) {
+	// supply might be about to go away, do not wait for the next period
+	if (!ignitionOn && m_dirty) {
+		saveToBackupRam();
+	}
+}
+
+void LongTermFuelTrim::showInfo() const {
+	for (int bank = 0; bank < STFT_BANK_COUNT; bank++) {
+		const auto& trims = m_table.trims[bank];
+
+		int learned = 0;
+		float minTrim = 0;
+		float maxTrim = 0;
+
+		for (size_t row = 0; row < FUEL_LOAD_COUNT; row++) {
+			for (size_t col = 0; col < FUEL_RPM_COUNT; col++) {
+				float trim = trims[row][col];
+
+				if (trim != 0) {
+					learned++;
+				}
+
+				minTrim = minF(minTrim, trim);
+				maxTrim = maxF(maxTrim, trim);
+			}
+		}
+
+		efiPrintf("LTFT bank %d: %d cells learned, %.1f%% to %.1f%%", bank + 1, learned, 100 * minTrim, 100 * maxTrim);
+	}
+
+	efiPrintf("LTFT: %s", m_dirty ? "not saved yet" : "saved");
+}
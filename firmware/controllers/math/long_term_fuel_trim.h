@@ -0,0 +1,99 @@
+/**
+ * @file long_term_fuel_trim.h
+ * @brief Fuel trim table learned from the short term closed loop correction
+ *
+ * Short term trims only cover a few regions and start from zero on every boot. Whatever they
+ * keep correcting is slowly moved in to a per bank table on the VE table axes, so that the short
+ * term trim drifts back towards zero. The learned table is applied on top of the short term trim,
+ * also while closed loop correction is not allowed to run yet, for example on a cold engine.
+ *
+ * The table is copied to backup RAM in the background, a plain memory copy from the slow callback,
+ * and is only taken back if its CRC is good, every cell is within limits and it was learned on the
+ * same axes. Anything else is treated as untrusted and learning starts over from zero.
+ *
+ * The table is not written to flash: both config flash banks belong to the config journal. Without
+ * VBAT, learned trims are lost on power cycle.
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+// seconds for the table to take over a constant short term trim
+#ifndef LTFT_TIME_CONSTANT
+#define LTFT_TIME_CONSTANT 30
+#endif
+
+// same limit as each short term cell
+#define LTFT_MAX_TRIM 0.25f
+
+// bump whenever LtftStorage changes
+#define LTFT_STORAGE_VERSION 1
+
+struct LtftTable {
+	// 0.05 means 5% more fuel than the VE table asks for
+	float trims[STFT_BANK_COUNT][FUEL_LOAD_COUNT][FUEL_RPM_COUNT];
+};
+
+/**
+ * Backup RAM image of the table
+ */
+struct LtftStorage {
+	uint32_t version;
+	// trims only mean something on the axes they were learned on
+	uint32_t axesCrc;
+	LtftTable table;
+	uint32_t crc;
+};
+
+uint32_t getLtftAxesCrc();
+
+class LongTermFuelTrim : public EngineModule {
+public:
+	void onConfigurationChange(engine_configuration_s const * previousConfig) override;
+	bool isAffectedBy(const ConfigChangeTracker& changes) const override;
+	void onSlowCallback() override;
+	void onIgnitionStateChanged(bool ignitionOn) override;
+
+	/**
+	 * @return fuel multiplier for the bank at this operating point
+	 */
+	float getTrim(size_t bank, float rpm, float load) const;
+
+	/**
+	 * Moves the cells around the operating point towards the short term trim, each by its
+	 * interpolation weight
+	 * @param stftAdjustment 0.05 means the short term trim adds 5%
+	 * @param dt seconds since the previous call
+	 */
+	void learn(size_t bank, float rpm, float load, float stftAdjustment, float dt);
+
+	void reset();
+
+	/**
+	 * @return false if there was no valid table for the current axes, the table is reset then
+	 */
+	bool load(const LtftStorage& storage);
+	void save(LtftStorage& storage);
+
+	// changed since the last save
+	bool isDirty() const {
+		return m_dirty;
+	}
+
+	const LtftTable& getTable() const {
+		return m_table;
+	}
+
+	void showInfo() const;
+
+private:
+	void saveToBackupRam();
+
+	LtftTable m_table = {};
+	uint32_t m_axesCrc = 0;
+
+	bool m_dirty = false;
+	bool m_isLoaded = false;
+	Timer m_sinceSave;
+};
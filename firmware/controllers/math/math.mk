@@ -1,7 +1,9 @@
 
 CONTROLLERS_MATH_SRC_CPP = $(PROJECT_DIR)/controllers/math/engine_math.cpp \
 	$(PROJECT_DIR)/controllers/math/pid_auto_tune.cpp \
+	$(PROJECT_DIR)/controllers/math/system_identification.cpp \
 	$(PROJECT_DIR)/controllers/math/speed_density.cpp \
 	$(PROJECT_DIR)/controllers/math/closed_loop_fuel.cpp \
 	$(PROJECT_DIR)/controllers/math/closed_loop_fuel_cell.cpp \
+	$(PROJECT_DIR)/controllers/math/long_term_fuel_trim.cpp \
 
@@ -0,0 +1,334 @@
+/**
+ * @file system_identification.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "system_identification.h"
+
+// about 500 samples of memory, plenty for the short runs here while still forgiving a bad start
+#define SYSID_FORGETTING 0.998f
+#define SYSID_INITIAL_COVARIANCE 1000.0f
+// no more covariance growth than this while the excitation does not tell anything new
+#define SYSID_MAX_COVARIANCE_TRACE 1e5f
+
+const char* getSysIdFailureName(SysIdFailure failure) {
+	switch (failure) {
+		case SysIdFailure::None: return "none";
+		case SysIdFailure::Aborted: return "aborted";
+		case SysIdFailure::Deviation: return "deviation";
+		case SysIdFailure::PoorFit: return "poor fit";
+		case SysIdFailure::Unstable: return "unstable";
+		case SysIdFailure::WrongSign: return "wrong sign";
+	}
+
+	return "unknown";
+}
+
+void RecursiveLeastSquares::reset(float initialCovariance) {
+	for (int i = 0; i < Size; i++) {
+		m_theta[i] = 0;
+
+		for (int j = 0; j < Size; j++) {
+			m_p[i][j] = i == j ? initialCovariance : 0;
+		}
+	}
+}
+
+float RecursiveLeastSquares::update(const float (&regressor)[Size], float measurement, float forgetting) {
+	return update(regressor, regressor, measurement, forgetting);
+}
+
+float RecursiveLeastSquares::update(const float (&regressor)[Size], const float (&instrument)[Size], float measurement, float forgetting) {
+	float prediction = 0;
+	// P * z and phi' * P, the same for plain least squares where P stays symmetric
+	float pZ[Size];
+	float phiP[Size];
+	float denominator = forgetting;
+
+	for (int i = 0; i < Size; i++) {
+		prediction += regressor[i] * m_theta[i];
+
+		pZ[i] = 0;
+		phiP[i] = 0;
+		for (int j = 0; j < Size; j++) {
+			pZ[i] += m_p[i][j] * instrument[j];
+			phiP[i] += regressor[j] * m_p[j][i];
+		}
+	}
+
+	for (int i = 0; i < Size; i++) {
+		denominator += regressor[i] * pZ[i];
+	}
+
+	float error = measurement - prediction;
+
+	float trace = 0;
+	for (int i = 0; i < Size; i++) {
+		float k = pZ[i] / denominator;
+		m_theta[i] += k * error;
+
+		for (int j = 0; j < Size; j++) {
+			m_p[i][j] -= k * phiP[j];
+		}
+
+		trace += m_p[i][i];
+	}
+
+	// forget only while that does not wind the covariance up
+	if (trace < SYSID_MAX_COVARIANCE_TRACE * forgetting) {
+		for (int i = 0; i < Size; i++) {
+			for (int j = 0; j < Size; j++) {
+				m_p[i][j] *= 1 / forgetting;
+			}
+		}
+	}
+
+	return error;
+}
+
+static int toSamples(float seconds, float periodSeconds) {
+	return maxI(1, seconds / periodSeconds + 0.5f);
+}
+
+void SystemIdentification::start(const SysIdSettings& settings) {
+	m_settings = settings;
+	m_result = {};
+
+	m_settleSamples = toSamples(settings.settleSeconds, settings.periodSeconds);
+	m_exciteSamples = toSamples(settings.exciteSeconds, settings.periodSeconds);
+	m_warmupSamples = m_exciteSamples / 5;
+
+	m_sample = 0;
+	m_ySum = 0;
+	m_uSum = 0;
+	m_operatingSamples = 0;
+
+	m_state = SysIdState::Settle;
+}
+
+void SystemIdentification::abort() {
+	if (isRunning()) {
+		fail(SysIdFailure::Aborted);
+	}
+}
+
+void SystemIdentification::fail(SysIdFailure failure) {
+	m_result.failure = failure;
+	m_state = SysIdState::Failed;
+}
+
+float SystemIdentification::getExcitation(int sample) const {
+	float t = sample * m_settings.periodSeconds;
+
+	switch (m_settings.excitation) {
+		case SysIdExcitation::Chirp: {
+			// instantaneous frequency goes linearly from start to end over the excitation
+			float sweep = (m_settings.chirpEndHz - m_settings.chirpStartHz) / m_settings.exciteSeconds;
+			float phase = 2 * CONST_PI * t * (m_settings.chirpStartHz + 0.5f * sweep * t);
+			return m_settings.amplitude * sinf(phase);
+		}
+		case SysIdExcitation::Step:
+		default: {
+			int level = t / m_settings.stepHoldSeconds;
+			return (level % 2 == 0) ? m_settings.amplitude : -m_settings.amplitude;
+		}
+	}
+}
+
+void SystemIdentification::beginExcitation() {
+	m_y0 = m_ySum / m_operatingSamples;
+	m_u0 = m_uSum / m_operatingSamples;
+
+	for (int d = 0; d < SYSID_MAX_DELAY; d++) {
+		m_fit[d].reset(SYSID_INITIAL_COVARIANCE);
+		m_errorSum[d] = 0;
+		m_simulated[d] = 0;
+		// output has been sitting at the operating point
+		m_history[d] = 0;
+	}
+
+	m_statSum = 0;
+	m_statSumSq = 0;
+	m_statCount = 0;
+
+	m_sample = 0;
+	m_state = SysIdState::Excite;
+}
+
+float SystemIdentification::update(float observation, float baseOutput) {
+	if (m_state == SysIdState::Settle) {
+		m_sample++;
+
+		// the first half is the closed loop getting there
+		if (m_sample > m_settleSamples / 2) {
+			m_ySum += observation;
+			m_uSum += baseOutput;
+			m_operatingSamples++;
+		}
+
+		if (m_sample >= m_settleSamples) {
+			beginExcitation();
+			m_previousY = observation - m_y0;
+		}
+
+		return baseOutput;
+	}
+
+	if (m_state != SysIdState::Excite) {
+		return baseOutput;
+	}
+
+	float y = observation - m_y0;
+
+	if (absF(y) > m_settings.maxDeviation) {
+		fail(SysIdFailure::Deviation);
+		return baseOutput;
+	}
+
+	bool isWarm = m_sample >= m_warmupSamples;
+
+	for (int d = 0; d < SYSID_MAX_DELAY; d++) {
+		auto& fit = m_fit[d];
+
+		float previousSimulated = m_simulated[d];
+
+		if (isWarm) {
+			// the model run on the excitation alone, free of measurement noise
+			float simulated = fit.getParameter(0) * previousSimulated + fit.getParameter(1) * m_history[d] + fit.getParameter(2);
+			// a diverging candidate only needs to lose
+			m_simulated[d] = clampF(-2 * m_settings.maxDeviation, simulated, 2 * m_settings.maxDeviation);
+
+			float simulationError = y - m_simulated[d];
+			m_errorSum[d] += simulationError * simulationError;
+		} else {
+			// parameters are still converging, follow the observation until they have
+			m_simulated[d] = y;
+		}
+
+		float regressor[RecursiveLeastSquares::Size] = { m_previousY, m_history[d], 1 };
+		// noise in the previous observation would bias a plain least squares fit
+		float instrument[RecursiveLeastSquares::Size] = { previousSimulated, m_history[d], 1 };
+		fit.update(regressor, instrument, y, SYSID_FORGETTING);
+	}
+
+	if (isWarm) {
+		m_statSum += y;
+		m_statSumSq += y * y;
+		m_statCount++;
+	}
+
+	m_previousY = y;
+
+	if (m_sample >= m_exciteSamples) {
+		finish();
+		return baseOutput;
+	}
+
+	float excitation = getExcitation(m_sample);
+	m_sample++;
+
+	for (int d = SYSID_MAX_DELAY - 1; d > 0; d--) {
+		m_history[d] = m_history[d - 1];
+	}
+	m_history[0] = excitation;
+
+	// the regular loop is frozen at the operating point, feedback would hide the plant
+	return m_u0 + excitation;
+}
+
+void SystemIdentification::finish() {
+	int best = 0;
+	for (int d = 1; d < SYSID_MAX_DELAY; d++) {
+		if (m_errorSum[d] < m_errorSum[best]) {
+			best = d;
+		}
+	}
+
+	const auto& fit = m_fit[best];
+	m_result.a = fit.getParameter(0);
+	m_result.b = fit.getParameter(1);
+	m_result.c = fit.getParameter(2);
+	m_result.delaySamples = best;
+
+	float mean = m_statSum / m_statCount;
+	float variance = m_statSumSq / m_statCount - mean * mean;
+	float errorVariance = m_errorSum[best] / m_statCount;
+	m_result.fit = variance > 0 ? 1 - errorVariance / variance : 0;
+
+	if (m_result.fit < SYSID_MIN_FIT) {
+		fail(SysIdFailure::PoorFit);
+		return;
+	}
+
+	if (m_result.a <= 0 || m_result.a >= 1) {
+		fail(SysIdFailure::Unstable);
+		return;
+	}
+
+	float period = m_settings.periodSeconds;
+
+	m_result.gain = m_result.b / (1 - m_result.a);
+	if (m_result.gain <= 0) {
+		fail(SysIdFailure::WrongSign);
+		return;
+	}
+
+	m_result.timeConstant = -period / logf(m_result.a);
+	// zero order hold adds half a period
+	m_result.deadTime = (best + 0.5f) * period;
+
+	computeGains();
+
+	m_state = SysIdState::Done;
+}
+
+void SystemIdentification::computeGains() {
+	float k = m_result.gain;
+	float tau = m_result.timeConstant;
+	float theta = m_result.deadTime;
+	float lambda = maxF(m_settings.closedLoopSeconds, theta);
+
+	if (m_settings.tuning == SysIdTuning::Pi) {
+		// Skogestad, "Simple analytic rules for model reduction and PID controller tuning", 2003
+		float kc = tau / (k * (lambda + theta));
+		float ti = minF(tau, 4 * (lambda + theta));
+
+		m_result.pFactor = kc;
+		m_result.iFactor = kc / ti;
+		m_result.dFactor = 0;
+	} else {
+		// Rivera, Morari, Skogestad, "Internal model control: PID controller design", 1986
+		float kc = (2 * tau + theta) / (k * (2 * lambda + theta));
+		float ti = tau + 0.5f * theta;
+		float td = tau * theta / (2 * tau + theta);
+
+		m_result.pFactor = kc;
+		m_result.iFactor = kc / ti;
+		m_result.dFactor = kc * td;
+	}
+}
+
+void SystemIdentification::printResult(const char* name) const {
+	switch (m_state) {
+		case SysIdState::Idle:
+			efiPrintf("%s identification: not started", name);
+			return;
+		case SysIdState::Settle:
+		case SysIdState::Excite:
+			efiPrintf("%s identification: running", name);
+			return;
+		case SysIdState::Failed:
+			efiPrintf("%s identification failed: %s, fit %.2f", name, getSysIdFailureName(m_result.failure), m_result.fit);
+			return;
+		case SysIdState::Done:
+			break;
+	}
+
+	efiPrintf("%s model: gain %.3f time constant %.3fs dead time %.3fs fit %.2f",
+		name, m_result.gain, m_result.timeConstant, m_result.deadTime, m_result.fit);
+	efiPrintf("%s suggested P %.5f I %.5f D %.5f",
+		name, m_result.pFactor, m_result.iFactor, m_result.dFactor);
+}
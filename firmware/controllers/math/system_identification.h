@@ -0,0 +1,219 @@
+/**
+ * @file system_identification.h
+ * @brief Online plant identification and PID tuning
+ *
+ * The regular closed loop first holds the plant at an operating point. Its output is then frozen
+ * at the average it needed there and a step or chirp excitation is added on top. A first order
+ * plus dead time model
+ *
+ *   y[k] = a * y[k-1] + b * u[k-1-d] + c
+ *
+ * is fitted with instrumental variable recursive least squares, one fit per candidate dead time d,
+ * all fed the same samples. The candidate whose model, driven by the excitation alone, best follows
+ * the observation wins and is turned into PI or PID gains. No samples are logged, memory and per
+ * sample work are fixed.
+ *
+ * See also pid_auto_tune.h for the relay method
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include "rusefi_types.h"
+
+// dead time candidates, 0 to SYSID_MAX_DELAY - 1 loop periods
+#define SYSID_MAX_DELAY 8
+// the simulated model has to explain this fraction of the observation variance
+#define SYSID_MIN_FIT 0.7f
+
+enum class SysIdExcitation : uint8_t {
+	// square wave, each level held for stepHoldSeconds
+	Step = 0,
+	// sine sweeping linearly from chirpStartHz to chirpEndHz
+	Chirp = 1,
+};
+
+enum class SysIdTuning : uint8_t {
+	// SIMC rules, no derivative
+	Pi,
+	// IMC rules for a first order plus dead time plant
+	Pid,
+};
+
+enum class SysIdState : uint8_t {
+	Idle,
+	// closed loop still in charge, operating point is being measured
+	Settle,
+	Excite,
+	Done,
+	Failed,
+};
+
+enum class SysIdFailure : uint8_t {
+	None,
+	Aborted,
+	// observation left the operating point by more than maxDeviation
+	Deviation,
+	PoorFit,
+	// model is integrating, or faster than the loop can see
+	Unstable,
+	// more output gives less observation
+	WrongSign,
+};
+
+const char* getSysIdFailureName(SysIdFailure failure);
+
+struct SysIdSettings {
+	// how often update() is called
+	float periodSeconds = 0;
+
+	SysIdExcitation excitation = SysIdExcitation::Step;
+	SysIdTuning tuning = SysIdTuning::Pid;
+
+	// excitation amplitude, output units
+	float amplitude = 0;
+
+	float settleSeconds = 0;
+	float exciteSeconds = 0;
+
+	float stepHoldSeconds = 0;
+	float chirpStartHz = 0;
+	float chirpEndHz = 0;
+
+	// observation units
+	float maxDeviation = 0;
+
+	// desired closed loop time constant, never less than the identified dead time
+	float closedLoopSeconds = 0;
+};
+
+struct SysIdResult {
+	SysIdFailure failure = SysIdFailure::None;
+
+	// discrete model, deviations from the operating point
+	float a = 0;
+	float b = 0;
+	float c = 0;
+	uint8_t delaySamples = 0;
+
+	// same model in observation units per output unit, and seconds
+	float gain = 0;
+	float timeConstant = 0;
+	float deadTime = 0;
+
+	// fraction of the observation variance explained by the model
+	float fit = 0;
+
+	float pFactor = 0;
+	float iFactor = 0;
+	float dFactor = 0;
+};
+
+/**
+ * Three parameter recursive least squares with exponential forgetting
+ */
+class RecursiveLeastSquares {
+public:
+	static constexpr int Size = 3;
+
+	void reset(float initialCovariance);
+
+	/**
+	 * @return prediction error before the update
+	 */
+	float update(const float (&regressor)[Size], float measurement, float forgetting);
+
+	/**
+	 * Instrumental variable flavor, for a regressor with noise in it
+	 * @param instrument correlated with the regressor, but not with its noise
+	 */
+	float update(const float (&regressor)[Size], const float (&instrument)[Size], float measurement, float forgetting);
+
+	float getParameter(int index) const {
+		return m_theta[index];
+	}
+
+private:
+	float m_theta[Size];
+	float m_p[Size][Size];
+};
+
+class SystemIdentification {
+public:
+	void start(const SysIdSettings& settings);
+	// Owner side, for anything the identification itself does not watch
+	void abort();
+
+	/**
+	 * Called once per loop period
+	 * @param baseOutput output of the regular loop
+	 * @return output to apply instead
+	 */
+	float update(float observation, float baseOutput);
+
+	bool isRunning() const {
+		return m_state == SysIdState::Settle || m_state == SysIdState::Excite;
+	}
+
+	SysIdState getState() const {
+		return m_state;
+	}
+
+	const SysIdResult& getResult() const {
+		return m_result;
+	}
+
+	void printResult(const char* name) const;
+
+	// excitation part of the output, sample counted from the start of the excitation
+	float getExcitation(int sample) const;
+
+	// Operating point the excitation runs around
+	float getOperatingObservation() const {
+		return m_y0;
+	}
+
+	float getOperatingOutput() const {
+		return m_u0;
+	}
+
+private:
+	void beginExcitation();
+	void finish();
+	void fail(SysIdFailure failure);
+	void computeGains();
+
+	SysIdSettings m_settings;
+	SysIdState m_state = SysIdState::Idle;
+	SysIdResult m_result;
+
+	int m_sample = 0;
+	int m_settleSamples = 0;
+	int m_exciteSamples = 0;
+	// prediction errors of the first samples are the fit converging, not the model
+	int m_warmupSamples = 0;
+
+	// operating point
+	float m_y0 = 0;
+	float m_u0 = 0;
+	float m_ySum = 0;
+	float m_uSum = 0;
+	int m_operatingSamples = 0;
+
+	float m_previousY = 0;
+	// m_history[i] is the excitation from i + 1 samples ago
+	float m_history[SYSID_MAX_DELAY];
+
+	// one fit per dead time candidate
+	RecursiveLeastSquares m_fit[SYSID_MAX_DELAY];
+	// fitted model driven by the excitation only
+	float m_simulated[SYSID_MAX_DELAY];
+	// sum of squared simulation errors after warmup
+	float m_errorSum[SYSID_MAX_DELAY];
+
+	// observation statistics after warmup
+	float m_statSum = 0;
+	float m_statSumSq = 0;
+	int m_statCount = 0;
+};
@@ -8,7 +8,23 @@ public:
 
 	void configure(float in1, float out1, float in2, float out2, float minOutput, float maxOutput);
 
-	SensorResult convert(float inputValue) const override;
+	// inline so that TypedFunctionalSensor can fold it in to postRawValue
+	SensorResult convert(float inputValue) const override {
+		float result = m_a * inputValue + m_b;
+
+		// Bounds checks
+		// Flipped error codes in case of m_a < 0 so that they indicate whether the input
+		// voltage is high/low, instead of the output high/low
+		if (result > m_maxOutput) {
+			return m_a > 0 ? UnexpectedCode::High : UnexpectedCode::Low;
+		}
+
+		if (result < m_minOutput) {
+			return m_a > 0 ? UnexpectedCode::Low : UnexpectedCode::High;
+		}
+
+		return result;
+	}
 
 	void showInfo(float testRawValue) const override;
 
@@ -59,4 +59,8 @@ void FrequencySensor::onEdge(efitick_t nowNt) {
 	frequency = m_filter.filter(frequency);
 
 	postRawValue(frequency, nowNt);
+
+	if (m_edgeListener) {
+		m_edgeListener(nowNt);
+	}
 }
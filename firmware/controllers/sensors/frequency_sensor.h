@@ -16,8 +16,17 @@ public:
 
 	void onEdge(efitick_t nowNt);
 
+	using edge_listener_t = void (*)(efitick_t nowNt);
+
+	// Optional listener invoked on every edge once the new value has been posted
+	void setEdgeListener(edge_listener_t listener) {
+		m_edgeListener = listener;
+	}
+
 	int eventCounter = 0;
 private:
+	edge_listener_t m_edgeListener = nullptr;
+
 	Timer m_edgeTimer;
 	brain_pin_e m_pin = Gpio::Unassigned;
 
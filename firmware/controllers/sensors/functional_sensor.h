@@ -11,6 +11,7 @@
 #include "stored_value_sensor.h"
 
 #include <type_traits>
+#include <utility>
 
 /**
  * @brief Class for sensors that convert from some raw floating point
@@ -22,6 +23,8 @@
  *
  * Register an instance of the new class with an interface
  * that provides and posts raw values so the sensor can update.
+ *
+ * If the conversion is known at compile time, prefer TypedFunctionalSensor.
  */
 class FunctionalSensor : public StoredValueSensor {
 public:
@@ -46,3 +49,65 @@ private:
 
 	float m_rawValue = 0;
 };
+
+// prints the raw and converted value, shared by all TypedFunctionalSensor instantiations
+void showTypedSensorInfo(const char* sensorName, float rawValue, SensorResult value);
+
+/**
+ * @brief Functional sensor which owns its conversion function.
+ *
+ * The converter type (a single converter or a whole FuncChain) is known at compile
+ * time, so postRawValue is not virtual and the conversion is called directly and
+ * can be inlined in to it, instead of going through a SensorConverter pointer on
+ * every sample. Post to it through the concrete type.
+ */
+template <typename TFunc>
+class TypedFunctionalSensor final : public StoredValueSensor {
+	static_assert(std::is_base_of_v<SensorConverter, TFunc>, "Template parameter must inherit from SensorConverter");
+
+public:
+	template <typename... TArgs>
+	TypedFunctionalSensor(SensorType type, efitick_t timeoutPeriod, TArgs&&... funcArgs)
+		: StoredValueSensor(type, timeoutPeriod)
+		, m_function(std::forward<TArgs>(funcArgs)...)
+	{
+	}
+
+	void postRawValue(float inputValue, efitick_t timestamp) {
+		m_rawValue = inputValue;
+
+		// qualified call: no virtual dispatch even if TFunc is not final
+		auto r = m_function.TFunc::convert(inputValue);
+
+		// This has to happen so that we set the valid bit after
+		// the value is stored, to prevent the data race of reading
+		// an old invalid value
+		if (r.Valid) {
+			setValidValue(r.Value, timestamp);
+		} else {
+			invalidate(r.Code);
+		}
+	}
+
+	TFunc& getFunction() {
+		return m_function;
+	}
+
+	const TFunc& getFunction() const {
+		return m_function;
+	}
+
+	float getRaw() const override final {
+		return m_rawValue;
+	}
+
+	void showInfo(const char* sensorName) const override {
+		showTypedSensorInfo(sensorName, m_rawValue, get());
+		m_function.showInfo(m_rawValue);
+	}
+
+private:
+	TFunc m_function;
+
+	float m_rawValue = 0;
+};
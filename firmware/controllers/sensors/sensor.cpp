@@ -24,9 +24,18 @@ public:
 
 	void reset() {
 		m_sensor = nullptr;
+		m_history = nullptr;
 		resetMock();
 	}
 
+	void setHistory(SensorHistory* history) {
+		m_history = history;
+	}
+
+	SensorHistory* getHistory() const {
+		return m_history;
+	}
+
 	bool Register(Sensor* sensor) {
 		// If there's somebody already here - a consumer tried to double-register a sensor
 		if (m_sensor && m_sensor != sensor) {
@@ -114,6 +123,7 @@ private:
 	bool m_mockRedundant = false;
 	float m_mockValue;
 	Sensor* m_sensor = nullptr;
+	SensorHistory* m_history = nullptr;
 };
 
 static SensorRegistryEntry s_sensorRegistry[static_cast<size_t>(SensorType::PlaceholderLast)] = {};
@@ -133,6 +143,8 @@ void Sensor::unregister() {
 
 		entry.reset();
 	}
+
+	resetSensorHistoryPool();
 }
 
 /*static*/ SensorRegistryEntry *Sensor::getEntryForType(SensorType type) {
@@ -227,6 +239,67 @@ void Sensor::unregister() {
 	Sensor::s_inhibitSensorTimeouts = inhibit;
 }
 
+/*static*/ void Sensor::enableHistory(SensorType type, SensorHistory* history) {
+	auto entry = getEntryForType(type);
+
+	if (entry) {
+		entry->setHistory(history);
+	}
+}
+
+/*static*/ bool Sensor::enableHistory(SensorType type) {
+	auto entry = getEntryForType(type);
+
+	if (!entry) {
+		return false;
+	}
+
+	if (entry->getHistory()) {
+		// already recording
+		return true;
+	}
+
+	auto history = allocateSensorHistory();
+	if (!history) {
+		return false;
+	}
+
+	entry->setHistory(history);
+	return true;
+}
+
+/*static*/ const SensorHistory* Sensor::getHistory(SensorType type) {
+	auto entry = getEntryForType(type);
+
+	return entry ? entry->getHistory() : nullptr;
+}
+
+void Sensor::recordHistory(float value, efitick_t timestamp) {
+	auto history = s_sensorRegistry[getIndex()].getHistory();
+
+	if (history) {
+		history->append(value, timestamp);
+	}
+}
+
+/*static*/ void Sensor::showHistoryReport() {
+	size_t totalBytes = 0;
+
+	for (size_t i = 1; i < efi::size(s_sensorRegistry); i++) {
+		auto history = s_sensorRegistry[i].getHistory();
+
+		if (history) {
+			efiPrintf("Sensor \"%s\" history %d/%d samples %d bytes", getSensorType((SensorType)i),
+				history->getCount(), history->getCapacity(), history->getMemoryUsage());
+			totalBytes += history->getMemoryUsage();
+		}
+	}
+
+	efiPrintf("Sensor history: %d bytes attached, pool %d/%d used, %d bytes reserved", totalBytes,
+		getSensorHistoryPoolUsed(), SENSOR_HISTORY_POOL_COUNT,
+		SENSOR_HISTORY_POOL_COUNT * SENSOR_HISTORY_POOL_DEPTH * sizeof(SensorHistorySample));
+}
+
 // Print information about all sensors
 /*static*/ void Sensor::showAllSensorInfo() {
 	for (size_t i = 1; i < efi::size(s_sensorRegistry); i++) {
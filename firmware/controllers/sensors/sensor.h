@@ -48,6 +48,7 @@
 #pragma once
 
 #include "sensor_type.h"
+#include "sensor_history.h"
 #include "expected.h"
 
 #include <cstddef>
@@ -134,6 +135,25 @@ public:
 	 */
 	static void inhibitTimeouts(bool inhibit);
 
+	/*
+	 * Record every valid reading of a sensor type into the given history, nullptr stops recording.
+	 */
+	static void enableHistory(SensorType type, SensorHistory* history);
+
+	/*
+	 * Record every valid reading of a sensor type into a history taken from the shared pool.
+	 * Returns false if the pool is exhausted.
+	 */
+	static bool enableHistory(SensorType type);
+
+	/*
+	 * Get the history of a sensor type, nullptr if recording is not enabled.
+	 */
+	static const SensorHistory* getHistory(SensorType type);
+
+	// Print memory used by sensor histories
+	static void showHistoryReport();
+
 	/*
 	 * Get a friendly name for the sensor.
 	 * For example, CLT, IAT, Throttle Position 2, etc.
@@ -181,6 +201,9 @@ protected:
 
 	static bool s_inhibitSensorTimeouts;
 
+	// Append a new valid reading to this sensor type's history, if any
+	void recordHistory(float value, efitick_t timestamp);
+
 private:
 	const SensorType m_type;
 
@@ -0,0 +1,145 @@
+/**
+ * @file    sensor_history.cpp
+ *
+ * Writers are sensor update paths (ADC callbacks, CAN RX, Lua) while readers are controllers
+ * on other threads, so both sides take a short critical section. Queries walk at most one
+ * buffer worth of samples.
+ */
+
+#include "pch.h"
+
+#include "sensor_history.h"
+
+void SensorHistory::append(float value, efitick_t timestamp) {
+	chibios_rt::CriticalSectionLocker csl;
+
+	m_storage[m_head] = { value, timestamp };
+	m_head = (m_head + 1) % m_capacity;
+
+	if (m_count < m_capacity) {
+		m_count++;
+	}
+}
+
+void SensorHistory::clear() {
+	chibios_rt::CriticalSectionLocker csl;
+
+	m_head = 0;
+	m_count = 0;
+}
+
+expected<float> SensorHistory::getValueAt(efitick_t timestamp) const {
+	chibios_rt::CriticalSectionLocker csl;
+
+	return getValueAtUnlocked(timestamp);
+}
+
+expected<float> SensorHistory::getValueAtUnlocked(efitick_t timestamp) const {
+	if (m_count == 0) {
+		return unexpected;
+	}
+
+	const auto& newest = at(m_count - 1);
+	if (timestamp >= newest.timestamp) {
+		return newest.value;
+	}
+
+	if (timestamp < at(0).timestamp) {
+		// that's before our time
+		return unexpected;
+	}
+
+	// binary search for the last sample not after 'timestamp'
+	size_t low = 0;
+	size_t high = m_count - 1;
+	while (high - low > 1) {
+		size_t mid = (low + high) / 2;
+		if (at(mid).timestamp <= timestamp) {
+			low = mid;
+		} else {
+			high = mid;
+		}
+	}
+
+	const auto& before = at(low);
+	const auto& after = at(high);
+
+	efitick_t span = after.timestamp - before.timestamp;
+	if (span <= 0) {
+		return after.value;
+	}
+
+	float fraction = (float)(timestamp - before.timestamp) / span;
+	return before.value + fraction * (after.value - before.value);
+}
+
+expected<float> SensorHistory::getRateOfChange(efitick_t windowNt) const {
+	if (windowNt <= 0) {
+		return unexpected;
+	}
+
+	chibios_rt::CriticalSectionLocker csl;
+
+	if (m_count < 2) {
+		return unexpected;
+	}
+
+	const auto& newest = at(m_count - 1);
+	auto start = getValueAtUnlocked(newest.timestamp - windowNt);
+	if (!start) {
+		return unexpected;
+	}
+
+	return (newest.value - start.Value) / (NT2USF(windowNt) * 1e-6f);
+}
+
+template <typename TCompare>
+expected<float> SensorHistory::findExtreme(efitick_t windowNt, efitick_t nowNt, TCompare isBetter) const {
+	chibios_rt::CriticalSectionLocker csl;
+
+	efitick_t since = nowNt - windowNt;
+	expected<float> result = unexpected;
+
+	// walk from newest to oldest, stop at the first sample outside of the window
+	for (size_t i = m_count; i > 0; i--) {
+		const auto& sample = at(i - 1);
+		if (sample.timestamp < since) {
+			break;
+		}
+
+		if (!result || isBetter(sample.value, result.Value)) {
+			result = sample.value;
+		}
+	}
+
+	return result;
+}
+
+expected<float> SensorHistory::getMin(efitick_t windowNt, efitick_t nowNt) const {
+	return findExtreme(windowNt, nowNt, [](float a, float b) { return a < b; });
+}
+
+expected<float> SensorHistory::getMax(efitick_t windowNt, efitick_t nowNt) const {
+	return findExtreme(windowNt, nowNt, [](float a, float b) { return a > b; });
+}
+
+static SensorHistoryBuffer<SENSOR_HISTORY_POOL_DEPTH> historyPool[SENSOR_HISTORY_POOL_COUNT];
+static size_t historyPoolUsed = 0;
+
+SensorHistory* allocateSensorHistory() {
+	if (historyPoolUsed >= SENSOR_HISTORY_POOL_COUNT) {
+		return nullptr;
+	}
+
+	SensorHistory* history = &historyPool[historyPoolUsed++];
+	history->clear();
+	return history;
+}
+
+void resetSensorHistoryPool() {
+	historyPoolUsed = 0;
+}
+
+size_t getSensorHistoryPoolUsed() {
+	return historyPoolUsed;
+}
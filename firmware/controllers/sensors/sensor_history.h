@@ -0,0 +1,109 @@
+/**
+ * @file    sensor_history.h
+ * @brief Optional time-stamped history of sensor readings.
+ *
+ * A sensor only knows its latest value. Consumers which need derivatives, windowed min/max or the
+ * value a little while ago can instead attach a history to the sensor type through
+ * Sensor::enableHistory(): every valid reading stored by a StoredValueSensor is then also
+ * appended here together with its timestamp.
+ *
+ * Sensors which compute their value on get() (function pointer, redundant, proxy sensors) have no
+ * moment of update so they are not recorded.
+ *
+ * @date October 19, 2026
+ */
+
+#pragma once
+
+#include "expected.h"
+#include "rusefi_types.h"
+
+#include <cstddef>
+
+struct SensorHistorySample {
+	float value;
+	efitick_t timestamp;
+};
+
+class SensorHistory {
+public:
+	SensorHistory(SensorHistorySample* storage, size_t capacity)
+		: m_storage(storage)
+		, m_capacity(capacity)
+	{
+	}
+
+	// O(1), oldest sample is overwritten once the buffer is full
+	void append(float value, efitick_t timestamp);
+	void clear();
+
+	size_t getCount() const {
+		return m_count;
+	}
+
+	size_t getCapacity() const {
+		return m_capacity;
+	}
+
+	size_t getMemoryUsage() const {
+		return m_capacity * sizeof(SensorHistorySample);
+	}
+
+	/**
+	 * Linear interpolation between the two samples around 'timestamp'.
+	 * Timestamps after the newest sample get the newest value, timestamps before the oldest sample are unexpected.
+	 */
+	expected<float> getValueAt(efitick_t timestamp) const;
+
+	/**
+	 * Units per second between the newest sample and the interpolated value 'windowNt' before it
+	 */
+	expected<float> getRateOfChange(efitick_t windowNt) const;
+
+	// extremes of samples not older than 'windowNt' before 'nowNt'
+	expected<float> getMin(efitick_t windowNt, efitick_t nowNt) const;
+	expected<float> getMax(efitick_t windowNt, efitick_t nowNt) const;
+
+private:
+	// 0 is the oldest sample
+	const SensorHistorySample& at(size_t index) const {
+		size_t oldest = m_head + m_capacity - m_count;
+		return m_storage[(oldest + index) % m_capacity];
+	}
+
+	expected<float> getValueAtUnlocked(efitick_t timestamp) const;
+
+	template <typename TCompare>
+	expected<float> findExtreme(efitick_t windowNt, efitick_t nowNt, TCompare isBetter) const;
+
+	SensorHistorySample* const m_storage;
+	const size_t m_capacity;
+	// next slot to write
+	size_t m_head = 0;
+	size_t m_count = 0;
+};
+
+template <size_t TSize>
+class SensorHistoryBuffer : public SensorHistory {
+public:
+	SensorHistoryBuffer() : SensorHistory(m_samples, TSize) { }
+
+private:
+	SensorHistorySample m_samples[TSize];
+};
+
+#ifndef SENSOR_HISTORY_POOL_COUNT
+#define SENSOR_HISTORY_POOL_COUNT 4
+#endif
+
+#ifndef SENSOR_HISTORY_POOL_DEPTH
+#define SENSOR_HISTORY_POOL_DEPTH 32
+#endif
+
+/**
+ * Histories for sensors enabled at runtime (console, Lua) are taken from this fixed pool.
+ * @return nullptr once the pool is exhausted
+ */
+SensorHistory* allocateSensorHistory();
+void resetSensorHistoryPool();
+size_t getSensorHistoryPoolUsed();
@@ -24,6 +24,10 @@ void FunctionalSensor::showInfo(const char* sensorName) const {
 	}
 }
 
+void showTypedSensorInfo(const char* sensorName, float rawValue, SensorResult value) {
+	efiPrintf("Sensor \"%s\": Raw value: %.2f Valid: %s Converted value %.2f", sensorName, rawValue, boolToString(value.Valid), value.Value);
+}
+
 #if EFI_CAN_SUPPORT || EFI_UNIT_TEST
 #include "can_sensor.h"
 
@@ -7,6 +7,7 @@ CONTROLLERS_SENSORS_SRC_CPP = 	$(PROJECT_DIR)/controllers/sensors/thermistors.cp
 	$(PROJECT_DIR)/controllers/sensors/tps.cpp \
 	$(PROJECT_DIR)/controllers/sensors/ego.cpp \
 	$(PROJECT_DIR)/controllers/sensors/sensor.cpp \
+	$(PROJECT_DIR)/controllers/sensors/sensor_history.cpp \
 	$(PROJECT_DIR)/controllers/sensors/sensor_info_printing.cpp \
 	$(PROJECT_DIR)/controllers/sensors/sensor_checker.cpp \
 	$(PROJECT_DIR)/controllers/sensors/functional_sensor.cpp \
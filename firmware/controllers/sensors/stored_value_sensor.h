@@ -73,6 +73,8 @@ public:
 		// Set value before valid - so we don't briefly have the valid bit set on an invalid value
 		m_result = value;
 		m_lastUpdate = timestamp;
+
+		recordHistory(value, timestamp);
 	}
 
 	void showInfo(const char*) const override { }
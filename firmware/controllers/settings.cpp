@@ -17,6 +17,7 @@
 #include "alternator_controller.h"
 #include "trigger_emulator_algo.h"
 #include "value_lookup.h"
+#include "shadow_tables.h"
 
 #if EFI_PROD_CODE
 #include "rtc_helper.h"
@@ -396,6 +397,9 @@ static void setWholePhaseMapCmd(float value) {
 static void setWholeTimingMapCmd(float value) {
 	efiPrintf("Setting whole timing advance map to %.2f", value);
 	setWholeTimingMap(value);
+#if EFI_SHADOW_TABLES
+	shadowTables.ignition.rebuild();
+#endif // EFI_SHADOW_TABLES
 	engine->resetEngineSnifferIfInTestMode();
 }
 
@@ -405,6 +409,9 @@ static void setWholeVeCmd(float value) {
 		efiPrintf("WARNING: setting VE map not in SD mode is pointless");
 	}
 	setTable(config->veTable, value);
+#if EFI_SHADOW_TABLES
+	shadowTables.ve.rebuild();
+#endif // EFI_SHADOW_TABLES
 	engine->resetEngineSnifferIfInTestMode();
 }
 
@@ -0,0 +1,154 @@
+/**
+ * @file staged_init.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "staged_init.h"
+#include "thread_controller.h"
+
+struct DeferredInitTask {
+	const char* name;
+	DeferredInitFunc func;
+	uint32_t durationUs;
+};
+
+static uint32_t bootPhaseUs[static_cast<size_t>(BootPhase::Count)];
+
+static DeferredInitTask deferredTasks[DEFERRED_INIT_MAX];
+static size_t deferredCount = 0;
+// queue is closed once deferred init was run, later tasks are executed in line
+static bool deferredInitDone = false;
+
+static const char* const bootPhaseNames[] = {
+	"start",
+	"config loaded",
+	"hardware ready",
+	"engine ready",
+	"main loop",
+	"deferred done",
+};
+
+static_assert(efi::size(bootPhaseNames) == static_cast<size_t>(BootPhase::Count));
+
+void markBootPhase(BootPhase phase) {
+	// avoid 0 which stands for 'not reached'
+	bootPhaseUs[static_cast<size_t>(phase)] = maxI(1, (int)getTimeNowUs());
+}
+
+uint32_t getBootPhaseUs(BootPhase phase) {
+	return bootPhaseUs[static_cast<size_t>(phase)];
+}
+
+const char* getBootPhaseName(BootPhase phase) {
+	return bootPhaseNames[static_cast<size_t>(phase)];
+}
+
+static void runTask(DeferredInitTask& task) {
+	efitimeus_t startUs = getTimeNowUs();
+	task.func();
+	task.durationUs = getTimeNowUs() - startUs;
+}
+
+void deferInit(const char* name, DeferredInitFunc func) {
+	if (deferredInitDone || deferredCount >= DEFERRED_INIT_MAX) {
+		DeferredInitTask task = { name, func, 0 };
+		runTask(task);
+		return;
+	}
+
+	deferredTasks[deferredCount++] = { name, func, 0 };
+}
+
+void runDeferredInit() {
+	deferredInitDone = true;
+
+	for (size_t i = 0; i < deferredCount; i++) {
+		runTask(deferredTasks[i]);
+	}
+
+	markBootPhase(BootPhase::DeferredDone);
+}
+
+size_t getDeferredInitCount() {
+	return deferredCount;
+}
+
+uint32_t getSlowestDeferredInitUs() {
+	uint32_t slowest = 0;
+
+	for (size_t i = 0; i < deferredCount; i++) {
+		if (deferredTasks[i].durationUs > slowest) {
+			slowest = deferredTasks[i].durationUs;
+		}
+	}
+
+	return slowest;
+}
+
+void printBootPhases() {
+	for (size_t i = 0; i < static_cast<size_t>(BootPhase::Count); i++) {
+		auto phase = static_cast<BootPhase>(i);
+		uint32_t us = getBootPhaseUs(phase);
+
+		if (us == 0) {
+			efiPrintf("boot %s: not reached", getBootPhaseName(phase));
+		} else {
+			efiPrintf("boot %s: %.1f ms", getBootPhaseName(phase), us / 1000.0f);
+		}
+	}
+
+	for (size_t i = 0; i < deferredCount; i++) {
+		efiPrintf("deferred %s: %.1f ms", deferredTasks[i].name, deferredTasks[i].durationUs / 1000.0f);
+	}
+}
+
+void resetStagedInit() {
+	setArrayValues(bootPhaseUs, 0);
+	deferredCount = 0;
+	deferredInitDone = false;
+}
+
+#if EFI_TUNER_STUDIO
+static float bootPhaseMs(BootPhase phase) {
+	return getBootPhaseUs(phase) / 1000.0f;
+}
+
+void postBootPhaseState(TunerStudioOutputChannels *tsOutputChannels) {
+	tsOutputChannels->debugFloatField1 = bootPhaseMs(BootPhase::ConfigLoaded);
+	tsOutputChannels->debugFloatField2 = bootPhaseMs(BootPhase::HardwareReady);
+	tsOutputChannels->debugFloatField3 = bootPhaseMs(BootPhase::EngineReady);
+	tsOutputChannels->debugFloatField4 = bootPhaseMs(BootPhase::MainLoop);
+	tsOutputChannels->debugFloatField5 = bootPhaseMs(BootPhase::DeferredDone);
+	tsOutputChannels->debugFloatField6 = getSlowestDeferredInitUs() / 1000.0f;
+	tsOutputChannels->debugIntField1 = deferredCount;
+	tsOutputChannels->debugIntField2 = deferredInitDone;
+}
+#endif // EFI_TUNER_STUDIO
+
+#if !EFI_UNIT_TEST
+class DeferredInitThread : public ThreadController<DEFERRED_INIT_STACK_SIZE> {
+public:
+	DeferredInitThread() : ThreadController("deferred init", PRIO_DEFERRED_INIT) { }
+
+protected:
+	void ThreadTask() override {
+		runDeferredInit();
+		efiPrintf("Deferred init done in %.1f ms", getBootPhaseUs(BootPhase::DeferredDone) / 1000.0f);
+	}
+};
+
+static DeferredInitThread deferredInitThread;
+
+void startDeferredInit() {
+	if (deferredCount == 0) {
+		// nothing queued, no reason to spend a thread on it
+		runDeferredInit();
+		return;
+	}
+
+	deferredInitThread.start();
+}
+#endif // EFI_UNIT_TEST
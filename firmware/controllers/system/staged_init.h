@@ -0,0 +1,71 @@
+/**
+ * @file staged_init.h
+ * @brief Boot phase timestamps and deferred init of non critical subsystems.
+ *
+ * Init which is not needed to start the engine may be queued with deferInit() and is then run by a
+ * low priority thread once the main loop is running. Only queue work which actually blocks: SD card,
+ * Lua and USB mass storage already do their slow part on their own threads and stay in line.
+ * Deferred tasks must not register console actions, the console thread is already running by then.
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include "rusefi_types.h"
+
+enum class BootPhase : uint8_t {
+	// runRusEfi() entry, everything before that is ChibiOS and HAL init
+	Start,
+	ConfigLoaded,
+	HardwareReady,
+	// trigger, injectors, ignition and core sensors are up
+	EngineReady,
+	MainLoop,
+	// everything queued by deferInit() is done
+	DeferredDone,
+	Count,
+};
+
+#ifndef DEFERRED_INIT_MAX
+#define DEFERRED_INIT_MAX 8
+#endif
+
+/* deferred tasks run with float printf for the duration report */
+#ifndef DEFERRED_INIT_STACK_SIZE
+#define DEFERRED_INIT_STACK_SIZE 2048
+#endif
+
+typedef void (*DeferredInitFunc)();
+
+void markBootPhase(BootPhase phase);
+/**
+ * @return microseconds since power on, 0 if the phase was not reached yet
+ */
+uint32_t getBootPhaseUs(BootPhase phase);
+const char* getBootPhaseName(BootPhase phase);
+
+/**
+ * Queue init which is not needed to start the engine. Tasks run in order of registration.
+ * Once deferred init has been run, or if the queue is full, the task is executed right away.
+ */
+void deferInit(const char* name, DeferredInitFunc func);
+/**
+ * Runs all queued tasks on the calling thread
+ */
+void runDeferredInit();
+/**
+ * Runs all queued tasks on a low priority thread
+ */
+void startDeferredInit();
+
+size_t getDeferredInitCount();
+// duration of the slowest deferred task
+uint32_t getSlowestDeferredInitUs();
+
+void printBootPhases();
+void resetStagedInit();
+
+#if EFI_TUNER_STUDIO
+void postBootPhaseState(TunerStudioOutputChannels *tsOutputChannels);
+#endif
@@ -2,6 +2,7 @@
 SYSTEMSRC_CPP =	\
 	$(PROJECT_DIR)/controllers/system/efi_gpio.cpp \
 	$(PROJECT_DIR)/controllers/system/periodic_task.cpp \
+	$(PROJECT_DIR)/controllers/system/staged_init.cpp \
 	$(PROJECT_DIR)/controllers/system/dc_motor.cpp \
 	$(PROJECT_DIR)/controllers/system/timer/scheduler.cpp \
 	$(PROJECT_DIR)/controllers/system/timer/trigger_scheduler.cpp \
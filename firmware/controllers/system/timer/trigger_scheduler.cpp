@@ -24,6 +24,13 @@ bool TriggerScheduler::scheduleOrQueue(AngleBasedEvent *event,
 		action_s action) {
 	event->position.setAngle(angle);
 
+	return scheduleOrQueue(event, trgEventIndex, edgeTimestamp, action);
+}
+
+bool TriggerScheduler::scheduleOrQueue(AngleBasedEvent *event,
+		uint32_t trgEventIndex,
+		efitick_t edgeTimestamp,
+		action_s action) {
 	/**
 	 * Here's the status as of Jan 2020:
 	 * Once we hit the last trigger tooth prior to needed event, schedule it by time.  We use
@@ -10,6 +10,12 @@ public:
 			     angle_t angle,
 			     action_s action);
 
+	// same, for an event whose position was already set
+	bool scheduleOrQueue(AngleBasedEvent *event,
+			     uint32_t trgEventIndex,
+			     efitick_t edgeTimestamp,
+			     action_s action);
+
 	void scheduleEventsUntilNextTriggerTooth(int rpm,
 						 uint32_t trgEventIndex,
 						 efitick_t edgeTimestamp);
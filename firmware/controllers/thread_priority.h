@@ -9,11 +9,15 @@
 #pragma once
 
 // ADC and ETB get highest priority - not much else actually runs the engine
+// ETB inner position loop is short and paced by the fast ADC, it goes above everything else
+#define PRIO_ETB_INNER (NORMALPRIO + 11)
 #define PRIO_ADC (NORMALPRIO + 10)
 #define PRIO_ETB (NORMALPRIO + 9)
 
 // GPIO chips should be fast and go right back to sleep, plus can be timing sensitive
 #define PRIO_GPIOCHIP (NORMALPRIO + 8)
+// Same as chips so that all chips woken together queue their transfers before the bus thread runs
+#define PRIO_SPI_BATCH PRIO_GPIOCHIP
 
 // TX higher priority than RX because the ECU is generally the one transmitting the highest priority messages
 #define PRIO_CAN_TX (NORMALPRIO + 7)
@@ -32,12 +36,17 @@
 
 // Less important things
 #define PRIO_MMC (NORMALPRIO - 1)
+// SD card writes may stall for 100+ ms, keep that below the logger which captures records
+#define PRIO_MMC_WRITER (NORMALPRIO - 2)
 
 // These can get starved without too much adverse effect
 #define PRIO_AUX_SERIAL NORMALPRIO
 #define PRIO_KNOCK_PROCESS (NORMALPRIO - 10)
 #define PRIO_HIP9011 (NORMALPRIO - 10)
 
+// Non critical init once boot is done, must not delay anything which runs the engine
+#define PRIO_DEFERRED_INIT (NORMALPRIO - 11)
+
 // These are intentionally low priority so they can't get in the way of anything else
 #define PRIO_FLASH_WRITE LOWPRIO + 20
 
@@ -19,6 +19,11 @@
 #define TRIGGER_GAP_DEVIATION_LOW (1.0f - TRIGGER_GAP_DEVIATION)
 #define TRIGGER_GAP_DEVIATION_HIGH (1.0f + TRIGGER_GAP_DEVIATION)
 
+/**
+ * Gap signature is only computed for shapes with up to this many teeth considered for sync
+ */
+#define GAP_SIGNATURE_MAX_LENGTH 64
+
 #if EFI_ENABLE_ASSERTS
 #define assertAngleRange(angle, msg, code) if (angle > 10000000 || angle < -10000000) { firmwareError(code, "angle range %s %.2f", msg, angle);angle = 0;}
 #else
@@ -63,6 +68,29 @@ class TriggerDecoderBase;
 class TriggerFormDetails;
 class TriggerConfiguration;
 
+/**
+ * Gap ratio, decoder index and event counts of every tooth considered for sync over one cycle,
+ * see TriggerWaveform::calculateGapSignature()
+ */
+struct TriggerGapSignature {
+	/**
+	 * Gap ratio (this tooth duration / previous tooth duration) of every tooth considered for sync,
+	 * in decoder order starting with the tooth after the synchronization point.
+	 */
+	float ratio[GAP_SIGNATURE_MAX_LENGTH];
+	/**
+	 * Decoder index reported for each signature tooth
+	 */
+	uint16_t index[GAP_SIGNATURE_MAX_LENGTH];
+	/**
+	 * Per-channel event counts since synchronization point, including each signature tooth
+	 */
+	uint16_t eventCount[GAP_SIGNATURE_MAX_LENGTH][PWM_PHASE_MAX_WAVE_PER_PWM];
+	/**
+	 * zero if gap signature is not available for this shape
+	 */
+	size_t length = 0;
+};
 
 /**
  * @brief Trigger shape has all the fields needed to describe and decode trigger signal.
@@ -264,7 +292,29 @@ public:
 
 	uint16_t findAngleIndex(TriggerFormDetails *details, angle_t angle) const;
 
+	/**
+	 * Storage for the gap signature, only the primary trigger shape has one, see TriggerCentral.
+	 * Null means gap signature sync is not available for this shape.
+	 */
+	TriggerGapSignature* gapSignature = nullptr;
+
+	size_t getGapSignatureLength() const {
+		return gapSignature ? gapSignature->length : 0;
+	}
+
+	/**
+	 * Slides observed tooth history over the whole gap signature.
+	 * @param toothDurations most recent tooth duration first
+	 * @return signature position uniquely matching the history, -1 if none or ambiguous
+	 */
+	int matchGapSignature(const uint32_t *toothDurations, size_t durationCount) const;
+
 private:
+	void calculateGapSignature(
+			TriggerDecoderBase& state,
+			const TriggerConfiguration& triggerConfiguration
+		);
+
 	/**
 	 * These angles are in trigger DESCRIPTION coordinates - i.e. the way you add events while declaring trigger shape
 	 */
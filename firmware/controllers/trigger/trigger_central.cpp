@@ -47,6 +47,7 @@ TriggerCentral::TriggerCentral() :
 		triggerState("TRG")
 {
 	memset(&hwEventCounters, 0, sizeof(hwEventCounters));
+	triggerShape.gapSignature = &triggerShapeGapSignature;
 	triggerState.resetTriggerState();
 	noiseFilter.resetAccumSignalData();
 }
@@ -970,6 +971,10 @@ void initTriggerCentral() {
 	addConsoleAction(CMD_TRIGGERINFO, triggerInfo);
 	addConsoleAction("trigger_shape_info", triggerShapeInfo);
 	addConsoleAction("reset_trigger", resetRunningTriggerCounters);
+	addConsoleActionI("set_trigger_gap_signature_sync", [](int value) {
+		engine->primaryTriggerConfiguration.UseGapSignatureSync = value;
+		efiPrintf("gap signature sync %s", boolToString(value));
+	});
 #endif // EFI_PROD_CODE || EFI_SIMULATOR
 
 }
@@ -112,6 +112,8 @@ public:
 #endif //EFI_SHAFT_POSITION_INPUT
 
 	TriggerWaveform triggerShape;
+	// only the primary shape is synchronized by gap signature, VVT shapes do without
+	TriggerGapSignature triggerShapeGapSignature;
 
 	VvtTriggerDecoder vvtState[BANKS_COUNT][CAMS_PER_BANK] = {
 		{
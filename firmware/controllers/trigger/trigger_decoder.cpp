@@ -33,6 +33,7 @@
 #include "cyclic_buffer.h"
 #include "trigger_central.h"
 #include "trigger_simulator.h"
+#include "trigger_emulator_algo.h"
 
 #if EFI_SENSOR_CHART
 #include "sensor_chart.h"
@@ -70,6 +71,8 @@ void TriggerDecoderBase::resetTriggerState() {
 	totalRevolutionCounter = 0;
 	totalTriggerErrorCounter = 0;
 	orderingErrorCounter = 0;
+	gapSignatureSyncCounter = 0;
+	gapSignatureHistoryCount = 0;
 	m_timeSinceDecodeError.init();
 
 	prevSignal = SHAFT_PRIMARY_FALLING;
@@ -110,7 +113,108 @@ float actualSynchGap;
 
 void TriggerWaveform::initializeSyncPoint(TriggerDecoderBase& state,
 			const TriggerConfiguration& triggerConfiguration) {
+	// signature of the previous shape must not be used while we look for the sync point
+	if (gapSignature) {
+		gapSignature->length = 0;
+	}
+
 	triggerShapeSynchPointIndex = state.findTriggerZeroEventIndex(*this, triggerConfiguration);
+
+	calculateGapSignature(state, triggerConfiguration);
+}
+
+/**
+ * Records gap ratio, decoder index and event counts of each tooth over one simulated cycle
+ * following the synchronization point.
+ */
+void TriggerWaveform::calculateGapSignature(TriggerDecoderBase& state,
+			const TriggerConfiguration& triggerConfiguration) {
+	if (!gapSignature || shapeDefinitionError || !isSynchronizationNeeded || triggerShapeSynchPointIndex == EFI_ERROR_CODE) {
+		return;
+	}
+
+	state.resetTriggerState();
+
+	TriggerStimulatorHelper helper;
+	uint32_t syncIndex = helper.findTriggerSyncPoint(*this, triggerConfiguration, state);
+	if (syncIndex == EFI_ERROR_CODE) {
+		return;
+	}
+
+	size_t length = 0;
+	for (uint32_t i = syncIndex + 1; i <= syncIndex + getSize(); i++) {
+		int stateIndex = i % getSize();
+		if (needEvent(stateIndex, wave, 0) && needEvent(stateIndex, wave, 1)) {
+			// simultaneous edges on both channels would make tooth order ambiguous, not supported
+			state.resetTriggerState();
+			return;
+		}
+
+		efitick_t previousToothTime = state.toothed_previous_time;
+
+		helper.feedSimulatedEvent(triggerConfiguration, state, *this, i);
+
+		if (state.toothed_previous_time == previousToothTime) {
+			// this event is not considered for gap detection
+			continue;
+		}
+
+		if (length >= GAP_SIGNATURE_MAX_LENGTH) {
+			// too many teeth, signature sync is not available for this shape
+			state.resetTriggerState();
+			return;
+		}
+
+		gapSignature->ratio[length] = state.triggerSyncGapRatio;
+		gapSignature->index[length] = state.getCurrentIndex();
+		for (int channel = 0; channel < PWM_PHASE_MAX_WAVE_PER_PWM; channel++) {
+			gapSignature->eventCount[length][channel] = state.currentCycle.eventCount[channel];
+		}
+		length++;
+	}
+
+	gapSignature->length = length;
+	state.resetTriggerState();
+}
+
+int TriggerWaveform::matchGapSignature(const uint32_t *toothDurations, size_t durationCount) const {
+	const int length = getGapSignatureLength();
+	if (length == 0) {
+		return -1;
+	}
+
+	// one bit per signature position still matching observed history
+	uint64_t candidates = length == 64 ? ~0ULL : (1ULL << length) - 1;
+
+	for (size_t gapIndex = 0; gapIndex + 1 < durationCount; gapIndex++) {
+		float observed = (float)toothDurations[gapIndex] / toothDurations[gapIndex + 1];
+
+		uint64_t remaining = candidates;
+		while (remaining) {
+			int position = __builtin_ctzll(remaining);
+			remaining &= remaining - 1;
+
+			// gap 'gapIndex' teeth ago for a history ending at 'position'
+			int signatureIndex = (position - (int)gapIndex % length + length) % length;
+			float expected = gapSignature->ratio[signatureIndex];
+
+			if (observed < expected * TRIGGER_GAP_DEVIATION_LOW || observed > expected * TRIGGER_GAP_DEVIATION_HIGH) {
+				candidates &= ~(1ULL << position);
+			}
+		}
+
+		if (candidates == 0) {
+			// history does not fit anywhere: noise or wrong trigger type
+			return -1;
+		}
+
+		if ((candidates & (candidates - 1)) == 0) {
+			return __builtin_ctzll(candidates);
+		}
+	}
+
+	// still ambiguous, need more teeth
+	return -1;
 }
 
 /**
@@ -415,7 +519,10 @@ bool TriggerDecoderBase::validateEventCounters(const TriggerWaveform& triggerSha
 	}
 
 #if EFI_UNIT_TEST
-	printf("validateEventCounters: isDecodingError=%d\n", isDecodingError);
+	// guarded so that decoder benchmarks do not measure printf
+	if (printTriggerDebug) {
+		printf("validateEventCounters: isDecodingError=%d\n", isDecodingError);
+	}
 	if (isDecodingError) {
 		for (int i = 0;i < PWM_PHASE_MAX_WAVE_PER_PWM;i++) {
 			printf("count: cur=%d exp=%d\n", currentCycle.eventCount[i],  triggerShape.getExpectedEventCount(i));
@@ -474,6 +581,7 @@ expected<TriggerDecodeResult> TriggerDecoderBase::decodeTriggerEvent(
 		 * That means we have lost synchronization since the engine is not running :)
 		 */
 		setShaftSynchronized(false);
+		gapSignatureHistoryCount = 0;
 		if (triggerStateListener) {
 			triggerStateListener->OnTriggerSynchronizationLost();
 		}
@@ -535,6 +643,13 @@ expected<TriggerDecodeResult> TriggerDecoderBase::decodeTriggerEvent(
 		}
 #endif
 
+		if (getShaftSynchronized()) {
+			// start over once sync is lost, teeth from before that are stale
+			gapSignatureHistoryCount = 0;
+		} else if (!isFirstEvent && triggerConfiguration.UseGapSignatureSync) {
+			recordGapSignatureHistory(triggerShape);
+		}
+
 		isFirstEvent = false;
 		bool isSynchronizationPoint;
 		bool wasSynchronized = getShaftSynchronized();
@@ -674,6 +789,10 @@ expected<TriggerDecodeResult> TriggerDecoderBase::decodeTriggerEvent(
 			onShaftSynchronization(wasSynchronized, nowNt, triggerShape);
 		} else {	/* if (!isSynchronizationPoint) */
 			nextTriggerEvent();
+
+			if (!wasSynchronized && triggerConfiguration.UseGapSignatureSync && triggerShape.isSynchronizationNeeded) {
+				syncByGapSignature(triggerShape, triggerStateListener, nowNt);
+			}
 		}
 
 		for (int i = triggerShape.gapTrackingLength; i > 0; i--) {
@@ -766,6 +885,61 @@ bool TriggerDecoderBase::isSyncPoint(const TriggerWaveform& triggerShape, trigge
 	return true;
 }
 
+/**
+ * Adds current tooth duration to the history, which is kept as long as one full signature cycle
+ * plus the tooth before it so that every gap ratio of the cycle can be compared.
+ */
+void TriggerDecoderBase::recordGapSignatureHistory(const TriggerWaveform& triggerShape) {
+	size_t historyLength = triggerShape.getGapSignatureLength() + 1;
+	if (historyLength < 2) {
+		return;
+	}
+
+	size_t count = gapSignatureHistoryCount < historyLength ? gapSignatureHistoryCount + 1 : historyLength;
+	for (size_t i = count - 1; i > 0; i--) {
+		gapSignatureHistory[i] = gapSignatureHistory[i - 1];
+	}
+	gapSignatureHistory[0] = toothDurations[0];
+	gapSignatureHistoryCount = count;
+}
+
+/**
+ * Jumps straight into synchronized state in the middle of the cycle once the recent tooth history
+ * matches exactly one position of the trigger gap signature.
+ */
+bool TriggerDecoderBase::syncByGapSignature(const TriggerWaveform& triggerShape, TriggerStateListener* triggerStateListener, efitick_t nowNt) {
+	int position = triggerShape.matchGapSignature(gapSignatureHistory, gapSignatureHistoryCount);
+	// the synchronization point itself is left to isSyncPoint which also starts a new cycle
+	if (position < 0 || triggerShape.gapSignature->index[position] == 0) {
+		return false;
+	}
+
+	if (triggerStateListener) {
+		triggerStateListener->OnTriggerSyncronization(/*wasSynchronized*/false, /*isDecodingError*/false);
+	}
+
+	setShaftSynchronized(true);
+
+	// same revolution and event counter bookkeeping as a regular first sync point...
+	onShaftSynchronization(/*wasSynchronized*/false, nowNt, triggerShape);
+
+	// ...except that we are already part way into the cycle
+	currentCycle.current_index = triggerShape.gapSignature->index[position];
+	for (int channel = 0; channel < PWM_PHASE_MAX_WAVE_PER_PWM; channel++) {
+		currentCycle.eventCount[channel] = triggerShape.gapSignature->eventCount[position][channel];
+	}
+
+	gapSignatureSyncCounter++;
+
+#if EFI_UNIT_TEST
+	if (printTriggerDebug) {
+		printf("syncByGapSignature position=%d index=%d\r\n", position, currentCycle.current_index);
+	}
+#endif /* EFI_UNIT_TEST */
+
+	return true;
+}
+
 /**
  * Trigger shape is defined in a way which is convenient for trigger shape definition
  * On the other hand, trigger decoder indexing begins from synchronization event.
@@ -32,6 +32,11 @@ public:
 	bool UseOnlyRisingEdgeForTrigger;
 	bool VerboseTriggerSynchDetails;
 	trigger_config_s TriggerType;
+	/**
+	 * Runtime-only: while not synchronized, match tooth history against the full gap signature
+	 * of the shape so that sync happens as soon as position is unambiguous, see matchGapSignature()
+	 */
+	bool UseGapSignatureSync = false;
 
 protected:
 	virtual bool isUseOnlyRisingEdgeForTrigger() const = 0;
@@ -104,6 +109,15 @@ public:
 	 * current duration at index zero and previous durations are following
 	 */
 	uint32_t toothDurations[GAP_TRACKING_LENGTH + 1];
+	/**
+	 * Tooth durations for gap signature sync, most recent first. Long enough to cover the whole
+	 * signature cycle, only recorded while not synchronized.
+	 */
+	uint32_t gapSignatureHistory[GAP_SIGNATURE_MAX_LENGTH + 1];
+	/**
+	 * number of valid entries in gapSignatureHistory
+	 */
+	size_t gapSignatureHistoryCount;
 
 	efitick_t toothed_previous_time;
 
@@ -115,6 +129,10 @@ public:
 	 */
 	uint32_t totalTriggerErrorCounter;
 	uint32_t orderingErrorCounter;
+	/**
+	 * how many times we have synchronized by gap signature rather than at synchronization point
+	 */
+	uint32_t gapSignatureSyncCounter;
 
 	virtual void resetTriggerState();
 	void setShaftSynchronized(bool value);
@@ -145,6 +163,7 @@ protected:
 private:
 	void resetCurrentCycleState();
 	bool isSyncPoint(const TriggerWaveform& triggerShape, trigger_type_e triggerType) const;
+	bool syncByGapSignature(const TriggerWaveform& triggerShape, TriggerStateListener* triggerStateListener, efitick_t nowNt);
 
 	bool validateEventCounters(const TriggerWaveform& triggerShape) const;
 
@@ -153,6 +172,8 @@ private:
 
 	bool isFirstEvent;
 
+	void recordGapSignatureHistory(const TriggerWaveform& triggerShape);
+
 	Timer m_timeSinceDecodeError;
 };
 
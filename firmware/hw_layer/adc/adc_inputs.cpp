@@ -29,6 +29,7 @@
 #include "mpu_util.h"
 #include "periodic_thread_controller.h"
 #include "protected_gpio.h"
+#include "cic_decimator.h"
 
 /* Depth of the conversion buffer, channels are sampled X times each.*/
 #ifndef ADC_BUF_DEPTH_FAST
@@ -40,6 +41,19 @@ static NO_CACHE adcsample_t fastAdcSampleBuf[ADC_BUF_DEPTH_FAST * ADC_MAX_CHANNE
 
 static adc_channel_mode_e adcHwChannelEnabled[HW_MAX_ADC_INDEX];
 
+#if EFI_USE_FAST_ADC
+/**
+ * Optional per-channel oversampling of the fast ADC: every DMA block of ADC_BUF_DEPTH_FAST conversions is pushed
+ * through a CIC decimator, readers get the latest decimated sample with fractional ADC counts instead of
+ * a boxcar average of the last block.
+ * Indexed by hardware channel, internal fast ADC positions move around as channels are enabled.
+ */
+static CicDecimator fastAdcDecimators[HW_MAX_ADC_INDEX];
+static volatile float fastAdcDecimatedValue[HW_MAX_ADC_INDEX];
+
+static bool isFastAdcDecimated(adc_channel_e hwChannel);
+#endif // EFI_USE_FAST_ADC
+
 // Board voltage, with divider coefficient accounted for
 float getVoltageDivided(const char *msg, adc_channel_e hwChannel) {
 	return getVoltage(msg, hwChannel) * engineConfiguration->analogInputDividerCoefficient;
@@ -47,6 +61,12 @@ float getVoltageDivided(const char *msg, adc_channel_e hwChannel) {
 
 // voltage in MCU universe, from zero to VDD
 float getVoltage(const char *msg, adc_channel_e hwChannel) {
+#if EFI_USE_FAST_ADC
+	if (isFastAdcDecimated(hwChannel)) {
+		// keep the extra resolution
+		return adcToVolts(fastAdcDecimatedValue[hwChannel]);
+	}
+#endif // EFI_USE_FAST_ADC
 	return adcToVolts(getAdcValue(msg, hwChannel));
 }
 
@@ -95,9 +115,44 @@ static adcsample_t getAvgAdcValue(int index, adcsample_t *samples, int bufDepth,
 #define ADC_SAMPLING_FAST ADC_SAMPLE_28
 
 #if EFI_USE_FAST_ADC
+extern AdcDevice fastAdc;
+
+static bool isFastAdcDecimated(adc_channel_e hwChannel) {
+	if (!isAdcChannelValid(hwChannel) || adcHwChannelEnabled[hwChannel] != ADC_FAST) {
+		return false;
+	}
+	const CicDecimator &decimator = fastAdcDecimators[hwChannel];
+	// plain block average until the first decimated sample is out
+	return decimator.getDecimation() > 1 && decimator.getOutputCount() > 0;
+}
+
+static void decimateFastAdcSamples(const adcsample_t *samples) {
+	int channelCount = fastAdc.size();
+
+	for (int channel = 0; channel < channelCount; channel++) {
+		adc_channel_e hwChannel = fastAdc.getAdcHardwareIndexByInternalIndex(channel);
+		if (!isAdcChannelValid(hwChannel)) {
+			continue;
+		}
+
+		CicDecimator &decimator = fastAdcDecimators[hwChannel];
+		if (decimator.getDecimation() <= 1) {
+			continue;
+		}
+
+		// DMA buffer is interleaved: all channels of the first conversion, then all channels of the second one...
+		for (int i = 0; i < ADC_BUF_DEPTH_FAST; i++) {
+			if (decimator.feed(samples[channel + i * channelCount])) {
+				fastAdcDecimatedValue[hwChannel] = decimator.get();
+			}
+		}
+	}
+}
+
 static void adc_callback_fast(ADCDriver *adcp) {
 	// State may not be complete if we get a callback for "half done"
 	if (adcp->state == ADC_COMPLETE) {
+		decimateFastAdcSamples(adcp->samples);
 		onFastAdcComplete(adcp->samples);
 	}
 }
@@ -195,6 +250,10 @@ int getInternalAdcValue(const char *msg, adc_channel_e hwChannel) {
 #endif // USE_ADC3_VBATT_HACK
 
 #if EFI_USE_FAST_ADC
+	if (isFastAdcDecimated(hwChannel)) {
+		return efiRound(fastAdcDecimatedValue[hwChannel], 1);
+	}
+
 	if (adcHwChannelEnabled[hwChannel] == ADC_FAST) {
 		int internalIndex = fastAdc.internalAdcIndexByHardwareIndex[hwChannel];
 // todo if ADC_BUF_DEPTH_FAST EQ 1
@@ -293,6 +352,31 @@ adc_channel_e AdcDevice::getAdcHardwareIndexByInternalIndex(int index) const {
 
 #endif // EFI_USE_FAST_ADC
 
+#if EFI_USE_FAST_ADC
+/**
+ * Fast ADC runs at GPT_FREQ_FAST / GPT_PERIOD_FAST with ADC_BUF_DEPTH_FAST conversions each time,
+ * decimated channel output rate is that divided by 'decimation'
+ */
+static bool configureFastAdcDecimation(adc_channel_e channel, int decimation) {
+	if (!isAdcChannelValid(channel) || adcHwChannelEnabled[channel] != ADC_FAST) {
+		return false;
+	}
+
+	chibios_rt::CriticalSectionLocker csl;
+	fastAdcDecimators[channel].configure(decimation);
+	return true;
+}
+
+/**
+ * Runtime override for any fast channel, mapAdcDecimation and tpsAdcDecimation are applied again on reboot
+ */
+static void setFastAdcDecimation(int hwChannel, int decimation) {
+	if (!configureFastAdcDecimation((adc_channel_e)hwChannel, decimation)) {
+		efiPrintf("ADC channel %d is not a fast channel", hwChannel);
+	}
+}
+#endif // EFI_USE_FAST_ADC
+
 static void printAdcValue(int channel) {
 	int value = getAdcValue("print", (adc_channel_e)channel);
 	float volts = adcToVoltsDivided(value);
@@ -317,6 +401,12 @@ void printFullAdcReport(void) {
 			/* Human index starts from 1 */
 			efiPrintf(" F ch[%2d] @ %s%d ADC%d 12bit=%4d %.2fV",
 				internalIndex, portname(port), pin, hwIndex - EFI_ADC_0 + 1, adcValue, volts);
+			const CicDecimator &decimator = fastAdcDecimators[hwIndex];
+			if (decimator.getDecimation() > 1) {
+				float decimated = fastAdcDecimatedValue[hwIndex];
+				efiPrintf("   decimation %d: %.2f %.4fV %d samples", decimator.getDecimation(),
+					decimated, adcToVolts(decimated), decimator.getOutputCount());
+			}
 		}
 	}
 #endif // EFI_USE_FAST_ADC
@@ -426,6 +516,12 @@ void removeChannel(const char *name, adc_channel_e setting) {
 // Weak link a stub so that every board doesn't have to implement this function
 __attribute__((weak)) void setAdcChannelOverrides() { }
 
+static bool tpsOnFastAdc = false;
+
+bool isTpsOnFastAdc() {
+	return tpsOnFastAdc;
+}
+
 static void configureInputs() {
 	memset(adcHwChannelEnabled, 0, sizeof(adcHwChannelEnabled));
 
@@ -443,6 +539,14 @@ static void configureInputs() {
 
 	addChannel("AUXF#1", engineConfiguration->auxFastSensor1_adcChannel, ADC_FAST);
 
+	if (engineConfiguration->etbFastInnerLoop) {
+		// slow sensors keep working, they read fast channels through getAdcValue
+		addChannel("TPS1", engineConfiguration->tps1_1AdcChannel, ADC_FAST);
+		addChannel("TPS2", engineConfiguration->tps2_1AdcChannel, ADC_FAST);
+		// channel groups are fixed once ADC is running, a later toggle needs a reboot
+		tpsOnFastAdc = isAdcChannelValid(engineConfiguration->tps1_1AdcChannel);
+	}
+
 	setAdcChannelOverrides();
 }
 
@@ -465,11 +569,20 @@ void initAdcInputs() {
 #if EFI_USE_FAST_ADC
 	fastAdc.init();
 
+	configureFastAdcDecimation(engineConfiguration->map.sensor.hwChannel, engineConfiguration->mapAdcDecimation);
+	if (tpsOnFastAdc) {
+		configureFastAdcDecimation(engineConfiguration->tps1_1AdcChannel, engineConfiguration->tpsAdcDecimation);
+		configureFastAdcDecimation(engineConfiguration->tps2_1AdcChannel, engineConfiguration->tpsAdcDecimation);
+	}
+
 	gptStart(EFI_INTERNAL_FAST_ADC_GPT, &fast_adc_config);
 	gptStartContinuous(EFI_INTERNAL_FAST_ADC_GPT, GPT_PERIOD_FAST);
 #endif // EFI_USE_FAST_ADC
 
 	addConsoleActionI("adc", (VoidInt) printAdcValue);
+#if EFI_USE_FAST_ADC
+	addConsoleActionII("set_fast_adc_decimation", setFastAdcDecimation);
+#endif // EFI_USE_FAST_ADC
 #else
 	efiPrintf("ADC disabled");
 #endif
@@ -78,9 +78,14 @@ void onFastAdcComplete(adcsample_t* samples);
 
 
 using FastAdcToken = size_t;
+// channel is not part of the fast ADC group, getFastAdc() returns 0 for it
+static constexpr FastAdcToken invalidFastAdcToken = (FastAdcToken)(-1);
 
 FastAdcToken enableFastAdcChannel(const char* msg, adc_channel_e channel);
 adcsample_t getFastAdc(FastAdcToken token);
+
+// TPS only joins the fast ADC group if 'etbFastInnerLoop' was set at boot
+bool isTpsOnFastAdc();
 #endif // HAL_USE_ADC
 
 void printFullAdcReport(void);
@@ -4,18 +4,26 @@
 
 #include "biquad.h"
 
+/*static*/ void AdcSubscription::SubscribeSensor(FunctionalSensor &sensor,
+									  adc_channel_e channel,
+									  float lowpassCutoff,
+									  float voltsPerAdcVolt /*= 0.0f*/) {
+	subscribe(sensor, nullptr, channel, lowpassCutoff, voltsPerAdcVolt);
+}
+
 #if EFI_UNIT_TEST
 
-/*static*/ void AdcSubscription::SubscribeSensor(FunctionalSensor&, adc_channel_e, float, float) {
+/*static*/ void AdcSubscription::subscribe(StoredValueSensor&, PostRawValue, adc_channel_e, float, float) {
 }
 
-/*static*/ void AdcSubscription::UnsubscribeSensor(FunctionalSensor&) {
+/*static*/ void AdcSubscription::UnsubscribeSensor(StoredValueSensor&) {
 }
 
 #else
 
 struct AdcSubscriptionEntry {
-	FunctionalSensor *Sensor;
+	StoredValueSensor *Sensor;
+	AdcSubscription::PostRawValue Post;
 	float VoltsPerAdcVolt;
 	Biquad Filter;
 	adc_channel_e Channel;
@@ -24,7 +32,7 @@ struct AdcSubscriptionEntry {
 
 static AdcSubscriptionEntry s_entries[16];
 
-static AdcSubscriptionEntry* findEntry(FunctionalSensor* sensor) {
+static AdcSubscriptionEntry* findEntry(StoredValueSensor* sensor) {
 	for (size_t i = 0; i < efi::size(s_entries); i++) {
 		if (s_entries[i].Sensor == sensor) {
 			return &s_entries[i];
@@ -39,10 +47,11 @@ static AdcSubscriptionEntry* findEntry() {
 	return findEntry(nullptr);
 }
 
-/*static*/ void AdcSubscription::SubscribeSensor(FunctionalSensor &sensor,
+/*static*/ void AdcSubscription::subscribe(StoredValueSensor &sensor,
+									  PostRawValue post,
 									  adc_channel_e channel,
 									  float lowpassCutoff,
-									  float voltsPerAdcVolt /*= 0.0f*/) {
+									  float voltsPerAdcVolt) {
 	// Don't subscribe null channels
 	if (!isAdcChannelValid(channel)) {
 		return;
@@ -73,6 +82,7 @@ static AdcSubscriptionEntry* findEntry() {
 	}
 
 	// Populate the entry
+	entry->Post = post;
 	entry->VoltsPerAdcVolt = voltsPerAdcVolt;
 	entry->Channel = channel;
 	entry->Filter.configureLowpass(SLOW_ADC_RATE, lowpassCutoff);
@@ -82,7 +92,7 @@ static AdcSubscriptionEntry* findEntry() {
 	entry->Sensor = &sensor;
 }
 
-/*static*/ void AdcSubscription::UnsubscribeSensor(FunctionalSensor& sensor) {
+/*static*/ void AdcSubscription::UnsubscribeSensor(StoredValueSensor& sensor) {
 	auto entry = findEntry(&sensor);
 
 	if (!entry) {
@@ -98,6 +108,7 @@ static AdcSubscriptionEntry* findEntry() {
 	// clear the sensor first to mark this entry not in use
 	entry->Sensor = nullptr;
 
+	entry->Post = nullptr;
 	entry->VoltsPerAdcVolt = 0;
 	entry->Channel = EFI_ADC_NONE;
 }
@@ -126,7 +137,11 @@ void AdcSubscription::UpdateSubscribers(efitick_t nowNt) {
 
 		float filtered = entry.Filter.filter(sensorVolts);
 
-		entry.Sensor->postRawValue(filtered, nowNt);
+		if (entry.Post) {
+			entry.Post(*entry.Sensor, filtered, nowNt);
+		} else {
+			static_cast<FunctionalSensor*>(entry.Sensor)->postRawValue(filtered, nowNt);
+		}
 	}
 }
 
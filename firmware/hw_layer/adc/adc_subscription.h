@@ -9,7 +9,28 @@
 
 class AdcSubscription {
 public:
+	// posts a raw value to a sensor whose concrete type is only known to the subscriber
+	using PostRawValue = void (*)(StoredValueSensor& sensor, float inputValue, efitick_t timestamp);
+
 	static void SubscribeSensor(FunctionalSensor &sensor, adc_channel_e channel, float lowpassCutoff, float voltsPerAdcVolt = 0.0f);
-	static void UnsubscribeSensor(FunctionalSensor& sensor);
+
+	template <typename TFunc>
+	static void SubscribeSensor(TypedFunctionalSensor<TFunc> &sensor, adc_channel_e channel, float lowpassCutoff, float voltsPerAdcVolt = 0.0f) {
+		subscribe(sensor, &postTyped<TFunc>, channel, lowpassCutoff, voltsPerAdcVolt);
+	}
+
+	static void UnsubscribeSensor(StoredValueSensor& sensor);
 	static void UpdateSubscribers(efitick_t nowNt);
+
+private:
+	/**
+	 * @param post nullptr for a plain FunctionalSensor
+	 */
+	static void subscribe(StoredValueSensor &sensor, PostRawValue post, adc_channel_e channel, float lowpassCutoff, float voltsPerAdcVolt);
+
+	template <typename TFunc>
+	static void postTyped(StoredValueSensor& sensor, float inputValue, efitick_t timestamp) {
+		// the typed postRawValue is not virtual, the conversion is inlined right here
+		static_cast<TypedFunctionalSensor<TFunc>&>(sensor).postRawValue(inputValue, timestamp);
+	}
 };
@@ -11,6 +11,7 @@
 #include "efi_gpio.h"
 
 #include "error_handling.h"
+#include "long_term_fuel_trim.h"
 
 typedef enum {
 	/**
@@ -68,6 +69,9 @@ struct BackupSramData {
 
 	uint32_t BootCount;
 	uint32_t BootCountCookie;
+
+	// see LongTermFuelTrim
+	LtftStorage Ltft;
 };
 
 BackupSramData* getBackupSram();
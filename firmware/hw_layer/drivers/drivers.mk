@@ -20,6 +20,7 @@ HW_LAYER_DRIVERS =
 HW_LAYER_DRIVERS_CPP = \
 	$(DRIVERS_DIR)/can/can_hw.cpp \
 	$(DRIVERS_DIR)/serial/serial_hw.cpp \
+	$(DRIVERS_DIR)/gpio/spi_batch.cpp \
 	$(DRIVERS_DIR)/gpio/tle6240.cpp \
 	$(DRIVERS_DIR)/gpio/tle8888.cpp \
 	$(DRIVERS_DIR)/gpio/mc33972.cpp \
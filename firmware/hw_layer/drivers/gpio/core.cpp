@@ -40,23 +40,66 @@ struct gpiochip {
 
 static gpiochip chips[BOARD_EXT_GPIOCHIPS];
 
+#define EXT_PINS_COUNT		(static_cast<int>(BRAIN_PIN_LAST) - static_cast<int>(BRAIN_PIN_ONCHIP_LAST))
+
+/* Every external pin knows its chip, so we do not scan chips[] for each
+ * injector/coil toggle routed through a smart driver.
+ * Rebuilt on chip registration changes. */
+struct pin_lookup_entry {
+	/* index in chips[] + 1, 0 - pin does not belong to any chip */
+	uint8_t				chip;
+	/* last value written + 1, 0 - unknown or write in progress */
+	uint8_t				last_value;
+	/* incremented by every write reaching the driver */
+	uint8_t				write_seq;
+};
+
+static pin_lookup_entry pin_lookup[EXT_PINS_COUNT];
+
 /*==========================================================================*/
 /* Local functions.															*/
 /*==========================================================================*/
 
+static pin_lookup_entry *pin_lookup_get(brain_pin_e pin)
+{
+	int index = static_cast<int>(pin) - static_cast<int>(BRAIN_PIN_ONCHIP_LAST) - 1;
+
+	if ((index < 0) || (index >= EXT_PINS_COUNT))
+		return nullptr;
+
+	return &pin_lookup[index];
+}
+
+static void pin_lookup_rebuild()
+{
+	memset(pin_lookup, 0, sizeof(pin_lookup));
+
+	for (int i = 0; i < BOARD_EXT_GPIOCHIPS; i++) {
+		gpiochip *chip = &chips[i];
+
+		if (chip->base == Gpio::Unassigned)
+			continue;
+
+		for (size_t offset = 0; offset < chip->size; offset++) {
+			pin_lookup_entry *entry = pin_lookup_get((brain_pin_e)(chip->base + offset));
+
+			if (entry)
+				entry->chip = i + 1;
+		}
+	}
+}
+
 /**
  * @return pointer to GPIO device for specified pin
  */
 static gpiochip *gpiochip_find(brain_pin_e pin)
 {
-	for (int i = 0; i < BOARD_EXT_GPIOCHIPS; i++) {
-		gpiochip *chip = &chips[i];
+	pin_lookup_entry *entry = pin_lookup_get(pin);
 
-		if ((pin >= chip->base) && (pin < (chip->base + chip->size)))
-			return chip;
-	}
+	if ((!entry) || (!entry->chip))
+		return nullptr;
 
-	return nullptr;
+	return &chips[entry->chip - 1];
 }
 
 /*==========================================================================*/
@@ -164,6 +207,8 @@ int gpiochip_register(brain_pin_e base, const char *name, GpioChip& gpioChip, si
 	chip->size = size;
 	chip->gpio_names = nullptr;
 
+	pin_lookup_rebuild();
+
 	// TODO: this cast seems wrong?
 	return (int)base;
 }
@@ -193,6 +238,8 @@ int gpiochip_unregister(brain_pin_e base)
 	chip->size = 0;
 	chip->gpio_names = nullptr;
 
+	pin_lookup_rebuild();
+
 	return 0;
 }
 
@@ -239,6 +286,9 @@ int gpiochips_init(void)
 		}
 	}
 
+	/* failed chips are gone */
+	pin_lookup_rebuild();
+
 	return pins_added;
 }
 
@@ -257,6 +307,15 @@ int gpiochips_setPadMode(brain_pin_e pin, iomode_t mode)
 	if (!chip)
 		return -1;
 
+	/* mode change may also change output state */
+	{
+		chibios_rt::CriticalSectionLocker csl;
+
+		pin_lookup_entry *entry = pin_lookup_get(pin);
+		entry->last_value = 0;
+		entry->write_seq++;
+	}
+
 	return chip->chip->setPadMode(pin - chip->base, mode);
 }
 
@@ -266,17 +325,48 @@ int gpiochips_setPadMode(brain_pin_e pin, iomode_t mode)
  * for smart switch inactive supposed to be closed switch (no current flows)
  * returns -1 in case of pin not belong to any gpio chip
  * returns -1 in case of chip does not support seting output value (input only)
+ * returns 0 without calling driver if pin already has this value
  * else return value from gpiochip driver;
  */
 
 int gpiochips_writePad(brain_pin_e pin, int value)
 {
-	gpiochip *chip = gpiochip_find(pin);
+	pin_lookup_entry *entry = pin_lookup_get(pin);
 
-	if (!chip)
+	if ((!entry) || (!entry->chip))
 		return -1;
 
-	return chip->chip->writePad(pin - chip->base, value);
+	gpiochip *chip = &chips[entry->chip - 1];
+	uint8_t last_value = value ? 2 : 1;
+	uint8_t seq;
+
+	{
+		chibios_rt::CriticalSectionLocker csl;
+
+		/* coalesce repeated writes of the same value, drivers would wake
+		 * their thread and do SPI transfer for nothing */
+		if (entry->last_value == last_value)
+			return 0;
+
+		/* unknown until the driver has it */
+		entry->last_value = 0;
+		seq = ++entry->write_seq;
+	}
+
+	/* drivers wake their thread, can not be called from critical section */
+	int ret = chip->chip->writePad(pin - chip->base, value);
+
+	{
+		chibios_rt::CriticalSectionLocker csl;
+
+		/* another write reached the driver meanwhile, its value may have landed
+		 * before ours - leave the cache unknown so the next write is not dropped.
+		 * On error we do not know what driver did. */
+		if ((ret >= 0) && (entry->write_seq == seq))
+			entry->last_value = last_value;
+	}
+
+	return ret;
 }
 
 /**
@@ -365,6 +455,13 @@ int gpiochip_register(brain_pin_e base, const char *name, GpioChip&, size_t size
 	return 0;
 }
 
+int gpiochip_unregister(brain_pin_e base)
+{
+	(void)base;
+
+	return 0;
+}
+
 int gpiochips_setPinNames(brain_pin_e pin, const char **names)
 {
 	(void)pin; (void)names;
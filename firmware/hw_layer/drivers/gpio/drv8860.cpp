@@ -16,6 +16,7 @@
 
 #include "gpio/gpio_ext.h"
 #include "gpio/drv8860.h"
+#include "gpio/spi_batch.h"
 
 #if (BOARD_DRV8860_COUNT > 0)
 
@@ -89,20 +90,8 @@ static const char* drv8860_pin_names[DRV8860_OUTPUTS] = {
  */
 
 void Drv8860::spi_send(uint16_t tx) {
-	SPIDriver *spi = cfg->spi_bus;
-	
-	/* Acquire ownership of the bus. */
-	spiAcquireBus(spi);
-	/* Setup transfer parameters. */
-	spiStart(spi, &cfg->spi_config);
-	/* Slave Select assertion. */
-	spiSelect(spi);
-	/* Atomic transfer operations. */
-	spiPolledExchange(spi, tx);
-	/* Slave Select de-assertion. */
-	spiUnselect(spi);
-	/* Ownership release. */
-	spiReleaseBus(spi);
+	/* transfer is shared with other chips on this bus */
+	spiBatchExchange(cfg->spi_bus, &cfg->spi_config, &tx, NULL, 1, true);
 }
 
 /**
@@ -167,6 +156,10 @@ static THD_FUNCTION(drv8860_driver_thread, p) {
 		/* should we care about msg == MSG_TIMEOUT? */
 		(void)msg;
 
+		/* pin changes signaled while we were busy are covered by this
+		 * single update, do not run one SPI update per change */
+		chSemReset(&drv8860_wake, 0);
+
 		for (i = 0; i < BOARD_DRV8860_COUNT; i++) {
 			auto chip = &chips[i];
 			if ((chip->cfg == NULL) ||
@@ -36,6 +36,7 @@
 #include "persistent_configuration.h"
 #include "hardware.h"
 #include "gpio/gpio_ext.h"
+#include "gpio/spi_batch.h"
 /*
  * TODO list:
  *  - just write code
@@ -45,6 +46,9 @@
 /*==========================================================================*/
 #define DRIVER_NAME					"l9779"
 
+/* words per batched SPI request */
+#define L9779_SPI_CHUNK				16
+
 #define DIAG_PERIOD_MS				(7)
 
 typedef enum {
@@ -251,95 +255,56 @@ int L9779::spi_validate(uint16_t rx)
  */
 int L9779::spi_rw(uint16_t tx, uint16_t *rx_ptr)
 {
-	int ret;
-	uint16_t rx;
-	SPIDriver *spi = cfg->spi_bus;
-
 	/* set parity */
 	tx |= !spi_parity_odd(tx);
 
-	/* Acquire ownership of the bus. */
-	spiAcquireBus(spi);
-	/* Setup transfer parameters. */
-	spiStart(spi, &cfg->spi_config);
-	/* Slave Select assertion. */
-	spiSelect(spi);
-	/* Atomic transfer operations. */
-	rx = spiPolledExchange(spi, tx);
-	/* Slave Select de-assertion. */
-	spiUnselect(spi);
-	/* Ownership release. */
-	spiReleaseBus(spi);
-
-	/* statisctic and debug */
-	this->tx = tx;
-	this->rx = rx;
-	this->spi_cnt++;
-
-	if (rx_ptr)
-		*rx_ptr = rx;
-
-	/* validate reply */
-	ret = spi_validate(rx);
-	/* save last accessed register */
-	last_addr = MSG_GET_ADDR(this->tx);
-	if (last_addr == MSG_READ_ADDR)
-		last_subaddr = MSG_GET_SUBADDR(this->tx);
-	else
-		last_subaddr = REG_INVALID;
-
-	return ret;
+	return spi_rw_array(&tx, rx_ptr, 1);
 }
 /**
  * @return -1 in case of communication error
  */
 int L9779::spi_rw_array(const uint16_t *tx, uint16_t *rx, int n)
 {
-	int ret;
-	uint16_t rxdata;
-	SPIDriver *spi = cfg->spi_bus;
+	int ret = 0;
+	uint16_t rxbuf[L9779_SPI_CHUNK];
 
 	if (n <= 0) {
 		return -2;
 	}
 
-	/* Acquire ownership of the bus. */
-	spiAcquireBus(spi);
-	/* Setup transfer parameters. */
-	spiStart(spi, &cfg->spi_config);
-
-	for (int i = 0; i < n; i++) {
-		/* Slave Select assertion. */
-		spiSelect(spi);
-		/* data transfer */
-		rxdata = spiPolledExchange(spi, tx[i]);
-
-		if (rx)
-			rx[i] = rxdata;
-		/* Slave Select de-assertion. */
-		spiUnselect(spi);
-
-		/* statistic and debug */
-		this->tx = tx[i];
-		this->rx = rxdata;
-		this->spi_cnt++;
-
-		/* validate reply  */
-		ret = spi_validate(rxdata);
-		/* save last accessed register */
-		last_addr = MSG_GET_ADDR(this->tx);
-		if (last_addr == MSG_READ_ADDR)
-			last_subaddr = MSG_GET_SUBADDR(this->tx);
-		else
-			last_subaddr = REG_INVALID;
+	for (int offset = 0; offset < n; offset += L9779_SPI_CHUNK) {
+		int count = minI(n - offset, L9779_SPI_CHUNK);
 
+		/* CS is toggled for each word, transfer is shared with other chips on this bus */
+		ret = spiBatchExchange(cfg->spi_bus, &cfg->spi_config, tx + offset, rxbuf, count, true);
 		if (ret < 0)
-			break;
+			return ret;
+
+		for (int i = 0; i < count; i++) {
+			uint16_t rxdata = rxbuf[i];
+
+			if (rx)
+				rx[offset + i] = rxdata;
+
+			/* statistic and debug */
+			this->tx = tx[offset + i];
+			this->rx = rxdata;
+			this->spi_cnt++;
+
+			/* validate reply  */
+			ret = spi_validate(rxdata);
+			/* save last accessed register */
+			last_addr = MSG_GET_ADDR(this->tx);
+			if (last_addr == MSG_READ_ADDR)
+				last_subaddr = MSG_GET_SUBADDR(this->tx);
+			else
+				last_subaddr = REG_INVALID;
+
+			if (ret < 0)
+				return ret;
+		}
 	}
-	/* Ownership release. */
-	spiReleaseBus(spi);
 
-	/* no errors for now */
 	return ret;
 }
 
@@ -479,6 +444,10 @@ static THD_FUNCTION(l9779_driver_thread, p) {
 		/* should we care about msg == MSG_TIMEOUT? */
 		(void)msg;
 
+		/* pin changes signaled while we were busy are covered by this
+		 * single update, do not run one SPI update per change */
+		chSemReset(&chip->wake, 0);
+
 		/* default polling interval */
 		poll_interval = TIME_MS2I(DIAG_PERIOD_MS);
 
@@ -16,6 +16,7 @@
 #include "pch.h"
 #include "gpio/gpio_ext.h"
 #include "gpio/mc33810.h"
+#include "gpio/spi_batch.h"
 
 #if (BOARD_MC33810_COUNT > 0)
 
@@ -148,23 +149,13 @@ static const char* mc33810_pin_names[MC33810_OUTPUTS] = {
 
 int Mc33810::spi_rw(uint16_t tx, uint16_t *rx)
 {
-	uint16_t rxb;
-	SPIDriver *spi = cfg->spi_bus;
-
-	/* Acquire ownership of the bus. */
-	spiAcquireBus(spi);
-	/* Setup transfer parameters. */
-	spiStart(spi, &cfg->spi_config);
-	/* Slave Select assertion. */
-	spiSelect(spi);
-	/* Atomic transfer operations. */
-	/* TODO: check why spiExchange transfers invalid data on STM32F7xx, DMA issue? */
-	//spiExchange(spi, 2, &tx, &rxb);
-	rxb = spiPolledExchange(spi, tx);
-	/* Slave Select de-assertion. */
-	spiUnselect(spi);
-	/* Ownership release. */
-	spiReleaseBus(spi);
+	uint16_t rxb = 0;
+
+	/* TODO: check why spiExchange transfers invalid data on STM32F7xx, DMA issue?
+	 * one word per CS so this stays polled, transfer is shared with other chips on this bus */
+	int ret = spiBatchExchange(cfg->spi_bus, &cfg->spi_config, &tx, &rxb, 1, true);
+	if (ret < 0)
+		return ret;
 
 	if (rx)
 		*rx = rxb;
@@ -415,6 +406,10 @@ static THD_FUNCTION(mc33810_driver_thread, p)
 		/* should we care about msg == MSG_TIMEOUT? */
 		(void)msg;
 
+		/* pin changes signaled while we were busy are covered by this
+		 * single update, do not run one SPI update per change */
+		chSemReset(&mc33810_wake, 0);
+
 		for (i = 0; i < BOARD_MC33810_COUNT; i++) {
 			auto chip = &chips[i];
 
@@ -17,6 +17,7 @@
 #include "global.h"
 #include "gpio/gpio_ext.h"
 #include "gpio/mc33972.h"
+#include "gpio/spi_batch.h"
 
 #if (BOARD_MC33972_COUNT > 0)
 
@@ -133,27 +134,17 @@ static Mc33972 chips[BOARD_MC33972_COUNT];
 
 int Mc33972::spi_w(uint32_t tx)
 {
-	int i;
-	uint8_t rxb[3];
-	uint8_t txb[3];
-	SPIDriver *spi = cfg->spi_bus;
+	int ret;
+	uint16_t rxb[3] = {0, 0, 0};
+	uint16_t txb[3];
 
 	txb[0] = (tx >> 16) & 0xff;
 	txb[1] = (tx >>  8) & 0xff;
 	txb[2] = (tx >>  0) & 0xff;
-	/* Acquire ownership of the bus. */
-	spiAcquireBus(spi);
-	/* Setup transfer parameters. */
-	spiStart(spi, &cfg->spi_config);
-	/* Slave Select assertion. */
-	spiSelect(spi);
-	/* Atomic transfer operations. */
-	for (i = 0; i < 3; i++)
-		rxb[i] = spiPolledExchange(spi, txb[i]);
-	/* Slave Select de-assertion. */
-	spiUnselect(spi);
-	/* Ownership release. */
-	spiReleaseBus(spi);
+	/* 3 bytes within one CS, transfer is shared with other chips on this bus */
+	ret = spiBatchExchange(cfg->spi_bus, &cfg->spi_config, txb, rxb, 3, false);
+	if (ret < 0)
+		return ret;
 
 	/* save received data */
 	i_state = (rxb[0] << 16) | (rxb[1] << 8) | (rxb[2] << 0);
@@ -0,0 +1,272 @@
+/*
+ * @file spi_batch.cpp
+ *
+ * One thread per SPI bus owns all smart GPIO chip transfers on that bus.
+ * It runs at the same priority as chip driver threads, so chips woken at the same
+ * time all get their requests queued before the bus thread gets to run and the
+ * whole lot is transferred within one bus acquisition.
+ *
+ * Most supported chips latch data on chip select edge for every 16 bit word. MC33972
+ * is the exception, it needs chip select held over its 3 byte frame. Either way frames
+ * are a few words long and MC33810/TLE6240 have known SPI+DMA problems on STM32F7,
+ * so every frame is polled.
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "gpio/spi_batch.h"
+#include "thread_controller.h"
+
+#if HAL_USE_SPI
+
+struct SpiBatchRequest {
+	const SPIConfig *cfg;
+	const uint16_t *tx;
+	uint16_t *rx;
+	size_t n;
+	bool csPerWord;
+	/* set by the bus thread before signaling 'done' */
+	int result = -1;
+
+	efitick_t queuedNt = 0;
+	SpiBatchRequest *next = nullptr;
+	chibios_rt::BinarySemaphore done{true};
+};
+
+class SpiBatchBus : public ThreadController<256> {
+public:
+	SpiBatchBus() : ThreadController("spi batch", PRIO_SPI_BATCH) { }
+
+	void setBus(SPIDriver *spi, size_t index) {
+		m_spi = spi;
+		m_index = index;
+		m_windowStartNt = getTimeNowNt();
+	}
+
+	SPIDriver *getSpi() const {
+		return m_spi;
+	}
+
+	int exchange(SpiBatchRequest& req) {
+		req.queuedNt = getTimeNowNt();
+
+		{
+			chibios_rt::CriticalSectionLocker csl;
+
+			if (m_tail) {
+				m_tail->next = &req;
+			} else {
+				m_head = &req;
+			}
+			m_tail = &req;
+		}
+
+		m_wakeup.signal();
+		req.done.wait();
+
+		return req.result;
+	}
+
+	void printStats();
+
+protected:
+	void ThreadTask() override {
+		while (true) {
+			m_wakeup.wait();
+
+			SpiBatchRequest *batch;
+			{
+				chibios_rt::CriticalSectionLocker csl;
+
+				batch = m_head;
+				m_head = m_tail = nullptr;
+			}
+
+			if (batch) {
+				runBatch(batch);
+			}
+		}
+	}
+
+private:
+	void runBatch(SpiBatchRequest *batch);
+	void transfer(SpiBatchRequest& req);
+
+	SPIDriver *m_spi = nullptr;
+	size_t m_index = 0;
+
+	SpiBatchRequest *m_head = nullptr;
+	SpiBatchRequest *m_tail = nullptr;
+	chibios_rt::BinarySemaphore m_wakeup{true};
+
+	/* statistics */
+	uint32_t m_batches = 0;
+	uint32_t m_requests = 0;
+	uint32_t m_words = 0;
+	uint32_t m_maxRequestsPerBatch = 0;
+	uint32_t m_lastLatencyUs = 0;
+	uint32_t m_maxLatencyUs = 0;
+	/* time the bus was owned by us since m_windowStartNt */
+	efitick_t m_busyNt = 0;
+	efitick_t m_windowStartNt = 0;
+};
+
+void SpiBatchBus::transfer(SpiBatchRequest& req) {
+	SPIDriver *spi = m_spi;
+
+	if (req.csPerWord) {
+		for (size_t i = 0; i < req.n; i++) {
+			spiSelect(spi);
+			uint16_t rx = spiPolledExchange(spi, req.tx[i]);
+			spiUnselect(spi);
+
+			if (req.rx)
+				req.rx[i] = rx;
+		}
+	} else {
+		spiSelect(spi);
+		for (size_t i = 0; i < req.n; i++) {
+			uint16_t rx = spiPolledExchange(spi, req.tx[i]);
+
+			if (req.rx)
+				req.rx[i] = rx;
+		}
+		spiUnselect(spi);
+	}
+}
+
+void SpiBatchBus::runBatch(SpiBatchRequest *batch) {
+	uint32_t requests = 0;
+	uint32_t words = 0;
+	const SPIConfig *started = nullptr;
+
+	efitick_t startNt = getTimeNowNt();
+
+	/* Acquire ownership of the bus, other (not batched) users may share it */
+	spiAcquireBus(m_spi);
+
+	for (SpiBatchRequest *req = batch; req; req = req->next) {
+		/* previous owner could have started the bus with its own config */
+		if ((req->cfg) && (req->cfg != started)) {
+			spiStart(m_spi, req->cfg);
+			started = req->cfg;
+		}
+
+		/* request without config or the driver refused it: nothing was transferred */
+		if ((!req->cfg) || (m_spi->state != SPI_READY)) {
+			req->result = -1;
+			continue;
+		}
+
+		transfer(*req);
+		req->result = 0;
+
+		requests++;
+		words += req->n;
+	}
+
+	/* Ownership release. */
+	spiReleaseBus(m_spi);
+
+	efitick_t endNt = getTimeNowNt();
+
+	m_batches++;
+	m_requests += requests;
+	m_words += words;
+	m_busyNt += endNt - startNt;
+	if (requests > m_maxRequestsPerBatch)
+		m_maxRequestsPerBatch = requests;
+
+	/* requests live on waiters stack, do not touch them once signaled */
+	SpiBatchRequest *req = batch;
+	while (req) {
+		SpiBatchRequest *next = req->next;
+
+		uint32_t latencyUs = NT2US(endNt - req->queuedNt);
+		m_lastLatencyUs = latencyUs;
+		if (latencyUs > m_maxLatencyUs)
+			m_maxLatencyUs = latencyUs;
+
+		req->done.signal();
+		req = next;
+	}
+}
+
+void SpiBatchBus::printStats() {
+	efitick_t nowNt = getTimeNowNt();
+	efitick_t windowNt = nowNt - m_windowStartNt;
+	float utilisation = windowNt > 0 ? 100.0f * m_busyNt / windowNt : 0;
+
+	efiPrintf("SPI batch bus %d: %lu batches %lu requests %lu words, max %lu requests/batch",
+		m_index, m_batches, m_requests, m_words, m_maxRequestsPerBatch);
+	efiPrintf("    utilisation %.2f%% over %d ms, latency last %lu us max %lu us",
+		utilisation, (int)NT2US(windowNt) / 1000, m_lastLatencyUs, m_maxLatencyUs);
+
+	/* utilisation and max latency are since previous report */
+	m_busyNt = 0;
+	m_windowStartNt = nowNt;
+	m_maxLatencyUs = 0;
+}
+
+static SpiBatchBus buses[SPI_BATCH_MAX_BUSES];
+
+static SpiBatchBus *getBus(SPIDriver *spi) {
+	SpiBatchBus *toStart = nullptr;
+
+	{
+		chibios_rt::CriticalSectionLocker csl;
+
+		for (size_t i = 0; i < SPI_BATCH_MAX_BUSES; i++) {
+			if (buses[i].getSpi() == spi) {
+				return &buses[i];
+			}
+		}
+
+		for (size_t i = 0; i < SPI_BATCH_MAX_BUSES; i++) {
+			if (!buses[i].getSpi()) {
+				buses[i].setBus(spi, i);
+				toStart = &buses[i];
+				break;
+			}
+		}
+	}
+
+	/* requests queued before the thread gets to run are kept */
+	if (toStart) {
+		toStart->start();
+	}
+
+	return toStart;
+}
+
+int spiBatchExchange(SPIDriver *spi, const SPIConfig *cfg,
+		const uint16_t *tx, uint16_t *rx, size_t n, bool csPerWord)
+{
+	if ((!spi) || (n == 0))
+		return -1;
+
+	SpiBatchBus *bus = getBus(spi);
+	if (!bus)
+		return -1;
+
+	SpiBatchRequest req;
+	req.cfg = cfg;
+	req.tx = tx;
+	req.rx = rx;
+	req.n = n;
+	req.csPerWord = csPerWord;
+
+	return bus->exchange(req);
+}
+
+void printSpiBatchStats() {
+	for (size_t i = 0; i < SPI_BATCH_MAX_BUSES; i++) {
+		if (buses[i].getSpi()) {
+			buses[i].printStats();
+		}
+	}
+}
+
+#endif /* HAL_USE_SPI */
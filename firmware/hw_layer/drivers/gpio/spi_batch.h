@@ -0,0 +1,39 @@
+/*
+ * @file spi_batch.h
+ *
+ * Shared per SPI bus transaction queue for smart GPIO chips.
+ *
+ * Every chip driver used to acquire the bus, start SPI and release it again for every
+ * 16 bit register access. With batching, drivers hand their whole register sequence to the
+ * bus thread and sleep until it has been transferred. The bus thread collects everything
+ * queued by all chips on the bus and runs it within a single bus ownership.
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include "global.h"
+
+#include <hal.h>
+
+#if HAL_USE_SPI
+
+#ifndef SPI_BATCH_MAX_BUSES
+#define SPI_BATCH_MAX_BUSES			3
+#endif
+
+/**
+ * @brief Queue an SPI exchange and wait until the bus thread is done with it.
+ * @param csPerWord toggle chip select around every word (most smart drivers latch
+ * 16 bit words on CS edge), otherwise chip select is held for the whole sequence.
+ * @param rx may be NULL
+ * @return 0 when transferred, negative if the bus could not be started
+ * @details Must not be called from ISR.
+ */
+int spiBatchExchange(SPIDriver *spi, const SPIConfig *cfg,
+		const uint16_t *tx, uint16_t *rx, size_t n, bool csPerWord);
+
+void printSpiBatchStats();
+
+#endif /* HAL_USE_SPI */
@@ -24,6 +24,7 @@
 
 #include "gpio/gpio_ext.h"
 #include "gpio/tle6240.h"
+#include "gpio/spi_batch.h"
 
 #if (BOARD_TLE6240_COUNT > 0)
 
@@ -90,6 +91,7 @@ struct Tle6240 : public GpioChip {
 
 	// internal functions
 	int spi_rw(uint16_t tx, uint16_t *rx);
+	int spi_rw_array(const uint16_t *tx, uint16_t *rx, int n);
 	int update_output_and_diag();
 	int chip_init();
 
@@ -131,27 +133,19 @@ static const char* tle6240_pin_names[TLE6240_OUTPUTS] = {
 
 int Tle6240::spi_rw(uint16_t tx, uint16_t *rx)
 {
-	uint16_t rxb;
-	SPIDriver *spi = cfg->spi_bus;
-
-	/* Acquire ownership of the bus. */
-	spiAcquireBus(spi);
-	/* Setup transfer parameters. */
-	spiStart(spi, &cfg->spi_config);
-	/* Slave Select assertion. */
-	spiSelect(spi);
-	/* Atomic transfer operations. */
-	rxb = spiPolledExchange(spi, tx);
-	/* Slave Select de-assertion. */
-	spiUnselect(spi);
-	/* Ownership release. */
-	spiReleaseBus(spi);
-
-	if (rx)
-		*rx = rxb;
+	return spi_rw_array(&tx, rx, 1);
+}
 
+/**
+ * @brief TLE6240 send and receive several words.
+ * @details CS is toggled around each word, all words go out within one
+ * bus transaction shared with other chips on this bus.
+ */
+
+int Tle6240::spi_rw_array(const uint16_t *tx, uint16_t *rx, int n)
+{
 	/* no errors for now */
-	return 0;
+	return spiBatchExchange(cfg->spi_bus, &cfg->spi_config, tx, rx, n, true);
 }
 
 /**
@@ -167,15 +161,23 @@ int Tle6240::update_output_and_diag()
 	/* atomic */
 	/* set value only for non-direct driven pins */
 	out_data = o_state & (~o_direct_mask);
+	const uint16_t tx[] = {
+		CMD_OR_DIAG(0, (out_data >> 0) & 0xff),
+		CMD_OR_DIAG(8, (out_data >> 8) & 0xff),
+		/* send same one more time to receive OUT8..15 diagnostic */
+		CMD_OR_DIAG(8, (out_data >> 8) & 0xff)
+	};
+	uint16_t rx[3] = {0, 0, 0};
+
 	if (diag_8_reguested) {
 		/* diagnostic for OUT8..15 was requested on prev access */
-		ret  = spi_rw(CMD_OR_DIAG(0, (out_data >> 0) & 0xff), &diag[1]);
-		ret |= spi_rw(CMD_OR_DIAG(8, (out_data >> 8) & 0xff), &diag[0]);
+		ret = spi_rw_array(tx, rx, 2);
+		diag[1] = rx[0];
+		diag[0] = rx[1];
 	} else {
-		ret  = spi_rw(CMD_OR_DIAG(0, (out_data >> 0) & 0xff), NULL);
-		ret |= spi_rw(CMD_OR_DIAG(8, (out_data >> 8) & 0xff), &diag[0]);
-		/* send same one more time to receive OUT8..15 diagnostic */
-		ret |= spi_rw(CMD_OR_DIAG(8, (out_data >> 8) & 0xff), &diag[1]);
+		ret = spi_rw_array(tx, rx, 3);
+		diag[0] = rx[1];
+		diag[1] = rx[2];
 	}
 
 	diag_8_reguested = false;
@@ -344,6 +346,10 @@ static THD_FUNCTION(tle6240_driver_thread, p)
 		/* should we care about msg == MSG_TIMEOUT? */
 		(void)msg;
 
+		/* pin changes signaled while we were busy are covered by this
+		 * single update, do not run one SPI update per change */
+		chSemReset(&tle6240_wake, 0);
+
 		for (i = 0; i < BOARD_TLE6240_COUNT; i++) {
 			int ret;
 			Tle6240& chip = chips[i];
@@ -38,6 +38,7 @@
 #include "persistent_configuration.h"
 #include "hardware.h"
 #include "gpio/gpio_ext.h"
+#include "gpio/spi_batch.h"
 
 static Timer diagResponse;
 
@@ -51,6 +52,9 @@ static Timer diagResponse;
 
 #define DRIVER_NAME				"tle8888"
 
+/* words per batched SPI request */
+#define TLE8888_SPI_CHUNK		16
+
 typedef enum {
 	TLE8888_DISABLED = 0,
 	TLE8888_WAIT_INIT,
@@ -349,45 +353,7 @@ int Tle8888::spi_validate(uint16_t rx)
  */
 int Tle8888::spi_rw(uint16_t tx, uint16_t *rx_ptr)
 {
-	int ret;
-	uint16_t rx;
-	SPIDriver *spi = cfg->spi_bus;
-
-	/**
-	 * 15.1 SPI Protocol
-	 *
-	 * after a read or write command: the address and content of the selected register
-	 * is transmitted with the next SPI transmission (for not existing addresses or
-	 * wrong access mode the data is always 0)
-	 */
-
-	/* Acquire ownership of the bus. */
-	spiAcquireBus(spi);
-	/* Setup transfer parameters. */
-	spiStart(spi, &cfg->spi_config);
-	/* Slave Select assertion. */
-	spiSelect(spi);
-	/* Atomic transfer operations. */
-	rx = spiPolledExchange(spi, tx);
-	/* Slave Select de-assertion. */
-	spiUnselect(spi);
-	/* Ownership release. */
-	spiReleaseBus(spi);
-
-	/* statisctic and debug */
-	this->tx = tx;
-	this->rx = rx;
-	this->spi_cnt++;
-
-	if (rx_ptr)
-		*rx_ptr = rx;
-
-	/* validate reply and save last accessed register */
-	ret = spi_validate(rx);
-	last_reg = getRegisterFromResponse(tx);
-
-	/* no errors for now */
-	return ret;
+	return spi_rw_array(&tx, rx_ptr, 1);
 }
 
 /**
@@ -395,9 +361,8 @@ int Tle8888::spi_rw(uint16_t tx, uint16_t *rx_ptr)
  */
 int Tle8888::spi_rw_array(const uint16_t *tx, uint16_t *rx, int n)
 {
-	int ret;
-	uint16_t rxdata;
-	SPIDriver *spi = cfg->spi_bus;
+	int ret = 0;
+	uint16_t rxbuf[TLE8888_SPI_CHUNK];
 
 	if (n <= 0) {
 		return -2;
@@ -411,38 +376,34 @@ int Tle8888::spi_rw_array(const uint16_t *tx, uint16_t *rx, int n)
 	 * wrong access mode the data is always 0)
 	 */
 
-	/* Acquire ownership of the bus. */
-	spiAcquireBus(spi);
-	/* Setup transfer parameters. */
-	spiStart(spi, &cfg->spi_config);
+	for (int offset = 0; offset < n; offset += TLE8888_SPI_CHUNK) {
+		int count = minI(n - offset, TLE8888_SPI_CHUNK);
 
-	for (int i = 0; i < n; i++) {
-		/* Slave Select assertion. */
-		spiSelect(spi);
-		/* data transfer */
-		rxdata = spiPolledExchange(spi, tx[i]);
+		/* CS is toggled for each word, transfer is shared with other chips on this bus */
+		ret = spiBatchExchange(cfg->spi_bus, &cfg->spi_config, tx + offset, rxbuf, count, true);
+		if (ret < 0)
+			return ret;
 
-		if (rx)
-			rx[i] = rxdata;
-		/* Slave Select de-assertion. */
-		spiUnselect(spi);
+		for (int i = 0; i < count; i++) {
+			uint16_t rxdata = rxbuf[i];
 
-		/* statistic and debug */
-		this->tx = tx[i];
-		this->rx = rxdata;
-		this->spi_cnt++;
+			if (rx)
+				rx[offset + i] = rxdata;
 
-		/* validate reply and save last accessed register */
-		ret = spi_validate(rxdata);
-		last_reg = getRegisterFromResponse(tx[i]);
+			/* statistic and debug */
+			this->tx = tx[offset + i];
+			this->rx = rxdata;
+			this->spi_cnt++;
 
-		if (ret < 0)
-			break;
+			/* validate reply and save last accessed register */
+			ret = spi_validate(rxdata);
+			last_reg = getRegisterFromResponse(tx[offset + i]);
+
+			if (ret < 0)
+				return ret;
+		}
 	}
-	/* Ownership release. */
-	spiReleaseBus(spi);
 
-	/* no errors for now */
 	return ret;
 }
 
@@ -839,6 +800,10 @@ static THD_FUNCTION(tle8888_driver_thread, p) {
 		/* should we care about msg == MSG_TIMEOUT? */
 		(void)msg;
 
+		/* pin changes signaled while we were busy are covered by this
+		 * single update, do not run one SPI update per change */
+		chSemReset(&chip->wake, 0);
+
 		/* default polling interval */
 		poll_interval = TIME_MS2I(DIAG_PERIOD_MS);
 
@@ -58,6 +58,10 @@
 #include "map_averaging.h"
 #endif
 
+#if EFI_ELECTRONIC_THROTTLE_BODY
+#include "electronic_throttle.h"
+#endif
+
 #if EFI_INTERNAL_FLASH
 #include "flash_main.h"
 #endif
@@ -142,6 +146,11 @@ SPIDriver * getSpiDevice(spi_device_e spiDevice) {
 static FastAdcToken fastMapSampleIndex;
 static FastAdcToken hipSampleIndex;
 
+#if EFI_ELECTRONIC_THROTTLE_BODY
+static FastAdcToken tps1SampleIndex = invalidFastAdcToken;
+static FastAdcToken tps2SampleIndex = invalidFastAdcToken;
+#endif // EFI_ELECTRONIC_THROTTLE_BODY
+
 #if HAL_TRIGGER_USE_ADC
 static FastAdcToken triggerSampleIndex;
 #endif
@@ -195,6 +204,11 @@ void onFastAdcComplete(adcsample_t*) {
 		hipAdcCallback(getFastAdc(hipSampleIndex));
 	}
 #endif /* EFI_HIP_9011 */
+#if EFI_ELECTRONIC_THROTTLE_BODY
+	if (tps1SampleIndex != invalidFastAdcToken) {
+		etbFastAdcCallback(getFastAdc(tps1SampleIndex), getFastAdc(tps2SampleIndex));
+	}
+#endif /* EFI_ELECTRONIC_THROTTLE_BODY */
 }
 #endif /* HAL_USE_ADC */
 
@@ -202,6 +216,12 @@ static void calcFastAdcIndexes() {
 #if HAL_USE_ADC
 	fastMapSampleIndex = enableFastAdcChannel("Fast MAP", engineConfiguration->map.sensor.hwChannel);
 	hipSampleIndex = enableFastAdcChannel("HIP9011", engineConfiguration->hipOutputChannel);
+#if EFI_ELECTRONIC_THROTTLE_BODY
+	// not the live 'etbFastInnerLoop', TPS channels are only sampled fast if it was set at boot
+	bool isTpsFast = isTpsOnFastAdc();
+	tps1SampleIndex = isTpsFast ? enableFastAdcChannel("TPS1", engineConfiguration->tps1_1AdcChannel) : invalidFastAdcToken;
+	tps2SampleIndex = isTpsFast ? enableFastAdcChannel("TPS2", engineConfiguration->tps2_1AdcChannel) : invalidFastAdcToken;
+#endif /* EFI_ELECTRONIC_THROTTLE_BODY */
 #if HAL_TRIGGER_USE_ADC
 	triggerSampleIndex = enableFastAdcChannel("Trigger ADC", getAdcChannelForTrigger());
 #endif /* HAL_TRIGGER_USE_ADC */
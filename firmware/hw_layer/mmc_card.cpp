@@ -17,13 +17,13 @@
 #if EFI_FILE_LOGGING
 
 #include "buffered_writer.h"
+#include "log_ring_buffer.h"
 #include "status_loop.h"
 
 static bool fs_ready = false;
 
 int totalLoggedBytes = 0;
 static int fileCreatedCounter = 0;
-static int writeCounter = 0;
 static int totalWritesCounter = 0;
 static int totalSyncCounter = 0;
 
@@ -50,8 +50,25 @@ static int totalSyncCounter = 0;
 // todo: shall we migrate to enum with enum2string for consistency? maybe not until we start reading sdStatus?
 static const char *sdStatus = SD_STATE_INIT;
 
-// at about 20Hz we write about 2Kb per second, looks like we flush once every ~2 seconds
-#define F_SYNC_FREQUENCY 10
+/**
+ * f_sync writes directory entry and FAT, bounding how much data is lost on power cut. Use 'sdbench' console
+ * command to see what it costs on given card, 'set_sd_sync_policy' to tune.
+ */
+static int logSyncPeriodMs = 2000;
+static int logSyncKb = 64;
+
+/**
+ * Log file is allocated ahead of the data in steps of this size, contiguous clusters for the first step,
+ * so that regular writes do not need to allocate clusters one by one. On close the file is truncated to
+ * the actual data size. In case of a power cut the log has at most one step of stale data at the end,
+ * which log viewers ignore as it does not parse into valid records.
+ */
+#ifndef EFI_SD_LOG_PREALLOCATE_STEP
+#define EFI_SD_LOG_PREALLOCATE_STEP (256 * 1024)
+#endif
+// file size may be ahead of the data, truncate on close
+static bool logFilePreallocated = false;
+static bool logFileGrowFailed = false;
 
 /**
  * on't re-read SD card spi device after boot - it could change mid transaction (TS thread could preempt),
@@ -202,17 +219,50 @@ static void createLogFile() {
 		return;
 	}
 
-	err = f_lseek(&FDLogFile, f_size(&FDLogFile)); // Move to end of the file to append data
-	if (err) {
-		sdStatus = SD_STATE_SEEK_FAILED;
-		warning(CUSTOM_ERR_SD_SEEK_FAILED, "SD: seek failed");
-		printError("Seek error", err);
-		return;
+	logFilePreallocated = false;
+	logFileGrowFailed = false;
+	if (f_size(&FDLogFile) == 0) {
+		// brand new file: reserve contiguous space, write pointer stays at the beginning
+		logFilePreallocated = f_expand(&FDLogFile, EFI_SD_LOG_PREALLOCATE_STEP, 1) == FR_OK;
+		if (!logFilePreallocated) {
+			efiPrintf("SD: could not preallocate %d bytes", EFI_SD_LOG_PREALLOCATE_STEP);
+		}
+	} else {
+		err = f_lseek(&FDLogFile, f_size(&FDLogFile)); // Move to end of the file to append data
+		if (err) {
+			sdStatus = SD_STATE_SEEK_FAILED;
+			warning(CUSTOM_ERR_SD_SEEK_FAILED, "SD: seek failed");
+			printError("Seek error", err);
+			return;
+		}
 	}
 	f_sync(&FDLogFile);
 	setSdCardReady(true);						// everything Ok
 }
 
+/**
+ * Allocates the next step once a write would go past the end of the preallocated space
+ */
+static void growLogFile(size_t count) {
+	FSIZE_t position = f_tell(&FDLogFile);
+	if (!logFilePreallocated || logFileGrowFailed || position + count <= f_size(&FDLogFile)) {
+		return;
+	}
+
+	// seeking past the end in write mode allocates the whole step in one go
+	FRESULT err = f_lseek(&FDLogFile, f_size(&FDLogFile) + EFI_SD_LOG_PREALLOCATE_STEP);
+	if (err == FR_OK) {
+		err = f_lseek(&FDLogFile, position);
+	}
+
+	if (err != FR_OK || f_tell(&FDLogFile) != position) {
+		// keep logging, FatFS allocates clusters as we go
+		printError("log file grow", err);
+		logFileGrowFailed = true;
+		f_lseek(&FDLogFile, position);
+	}
+}
+
 static void removeFile(const char *pathx) {
 	if (!isSdCardAlive()) {
 		efiPrintf("Error: No File system is mounted");
@@ -287,6 +337,9 @@ static void mmcUnMount() {
 		efiPrintf("Error: No File system is mounted. \"mountsd\" first");
 		return;
 	}
+	if (logFilePreallocated) {
+		f_truncate(&FDLogFile);					// drop unused preallocated space
+	}
 	f_close(&FDLogFile);						// close file
 	f_sync(&FDLogFile);							// sync ALL
 
@@ -433,39 +486,64 @@ static bool mountMmc() {
 	}
 }
 
-struct SdLogBufferWriter final : public BufferedWriter<512> {
+struct SdLogFileWriter final : public Writer {
 	bool failed = false;
 
-	size_t writeInternal(const char* buffer, size_t count) override {
+	size_t write(const char* buffer, size_t count) override {
 		size_t bytesWritten;
 
 		totalLoggedBytes += count;
 
+		growLogFile(count);
 		FRESULT err = f_write(&FDLogFile, buffer, count, &bytesWritten);
 
 		if (bytesWritten != count) {
 			printError("write error or disk full", err);
 
-			// Close file and unmount volume
-			mmcUnMount();
+			// writer thread closes the file and unmounts the volume once it stops
 			failed = true;
 			return 0;
 		} else {
-			writeCounter++;
 			totalWritesCounter++;
-			if (writeCounter >= F_SYNC_FREQUENCY) {
-				/**
-				 * Performance optimization: not f_sync after each line, f_sync is probably a heavy operation
-				 * todo: one day someone should actually measure the relative cost of f_sync
-				 */
+			m_bytesSinceSync += count;
+			if (m_bytesSinceSync >= logSyncKb * 1024 || m_syncTimer.hasElapsedMs(logSyncPeriodMs)) {
+				efitick_t startNt = getTimeNowNt();
 				f_sync(&FDLogFile);
+				lastSyncLatencyUs = NT2US(getTimeNowNt() - startNt);
+				maxSyncLatencyUs = maxI(maxSyncLatencyUs, lastSyncLatencyUs);
+
 				totalSyncCounter++;
-				writeCounter = 0;
+				m_bytesSinceSync = 0;
+				m_syncTimer.reset();
 			}
 		}
 
 		return bytesWritten;
 	}
+
+	uint32_t lastSyncLatencyUs = 0;
+	uint32_t maxSyncLatencyUs = 0;
+
+	size_t flush() override {
+		return 0;
+	}
+
+	size_t getPosition() const {
+		return f_tell(&FDLogFile);
+	}
+
+	/**
+	 * FatFS transfers whole sectors directly from our buffer, without going through the sector
+	 * buffer of the file object, as long as the write starts at a sector boundary. Writes which
+	 * do not cross a cluster boundary end up as a single multi-block command.
+	 */
+	size_t getClusterSize() const {
+		return MMC_FS.csize * FF_MIN_SS;
+	}
+
+private:
+	size_t m_bytesSinceSync = 0;
+	Timer m_syncTimer;
 };
 
 #else // not EFI_PROD_CODE (simulator)
@@ -477,30 +555,315 @@ bool mountMmc() {
 	return true;
 }
 
-class SdLogBufferWriter final : public BufferedWriter<512> {
+class SdLogFileWriter final : public Writer {
 public:
 	bool failed = false;
 
-	SdLogBufferWriter()
+	SdLogFileWriter()
 		: m_stream("rusefi_simulator_log.mlg", std::ios::binary | std::ios::trunc)
 	{
 		fs_ready = true;
 	}
 
-	size_t writeInternal(const char* buffer, size_t count) override {
+	size_t write(const char* buffer, size_t count) override {
 		m_stream.write(buffer, count);
 		m_stream.flush();
+		totalLoggedBytes += count;
+		totalWritesCounter++;
 		return count;
 	}
 
+	size_t flush() override {
+		return 0;
+	}
+
+	size_t getPosition() const {
+		return totalLoggedBytes;
+	}
+
+	size_t getClusterSize() const {
+		return 4096;
+	}
+
 private:
 	std::ofstream m_stream;
 };
 
 #endif // EFI_PROD_CODE
 
-static NO_CACHE SdLogBufferWriter logBuffer;
+/**
+ * Log records are captured at a fixed rate into this RAM ring by the logger thread, while a separate
+ * writer thread drains it to the card. A card stall now only fills the ring instead of delaying capture,
+ * and records are only lost once the ring is full.
+ */
+#ifndef EFI_SD_LOG_RING_SIZE
+#define EFI_SD_LOG_RING_SIZE 8192
+#endif
+
+// Data sitting in the ring is flushed to the card even if it does not make a whole chunk after this long
+#define SD_LOG_MAX_WRITE_DELAY_MS 500
+
+static NO_CACHE LogRingBuffer<EFI_SD_LOG_RING_SIZE> logRing;
+static SdLogFileWriter logFile;
+static chibios_rt::BinarySemaphore logDataReady(/* taken =*/ true);
+static size_t logWriteChunkSize = 512;
+
+/**
+ * 'umountsd' stops capture first, then the writer drains whatever is left in the ring and unmounts:
+ * nothing but the writer thread ever touches the log file.
+ */
+static volatile bool logStopRequested = false;
+static volatile bool logCaptureStopped = false;
+
+static uint32_t logWriteLastLatencyUs = 0;
+static uint32_t logWriteMaxLatencyUs = 0;
+static float logWriteThroughputKbs = 0;
+static uint32_t logThroughputBytes = 0;
+static Timer logThroughputTimer;
+
+/**
+ * Header has to make it to the file in one piece: wait for the writer instead of dropping it.
+ * Same for records when logging without a period, these go as fast as the card takes them.
+ */
+struct BlockingLogRingWriter final : public Writer {
+	size_t write(const char* buffer, size_t count) override {
+		while (logRing.getFree() < count && !logFile.failed && !logStopRequested) {
+			logDataReady.signal();
+			chThdSleepMilliseconds(1);
+		}
+		return logRing.write(buffer, count);
+	}
+
+	size_t flush() override {
+		return 0;
+	}
+};
 
+static void onLogWriteDone(size_t bytes, efitick_t startNt) {
+	logWriteLastLatencyUs = NT2US(getTimeNowNt() - startNt);
+	logWriteMaxLatencyUs = maxI(logWriteMaxLatencyUs, logWriteLastLatencyUs);
+
+	logThroughputBytes += bytes;
+	if (logThroughputTimer.hasElapsedSec(1)) {
+		logWriteThroughputKbs = logThroughputBytes / 1024.0f / logThroughputTimer.getElapsedSeconds();
+		logThroughputBytes = 0;
+		logThroughputTimer.reset();
+	}
+}
+
+/**
+ * Writes whole chunks aligned to chunk size within the file, so each f_write is a multi-block write
+ * from the ring straight to the card. A partial chunk is only written if 'flushPartial' is set.
+ */
+static void drainLogRing(bool flushPartial) {
+	while (!logFile.failed) {
+		size_t used = logRing.getUsed();
+		if (used == 0) {
+			return;
+		}
+
+		// after a partial write, the next write brings us back to a chunk boundary
+		size_t toWrite = logWriteChunkSize - logFile.getPosition() % logWriteChunkSize;
+		if (used < toWrite) {
+			if (!flushPartial) {
+				return;
+			}
+			toWrite = used;
+		}
+
+		const char* data;
+		size_t contiguous = logRing.getReadable(&data);
+		if (contiguous < toWrite) {
+			toWrite = contiguous;
+		}
+
+		efitick_t startNt = getTimeNowNt();
+		logFile.write(data, toWrite);
+		onLogWriteDone(toWrite, startNt);
+
+		logRing.consume(toWrite);
+	}
+}
+
+#if EFI_PROD_CODE
+#define SD_BENCH_FILENAME "sdbench.bin"
+#define SD_BENCH_WRITES 256
+#define SD_BENCH_WRITES_PER_SYNC 8
+
+static volatile bool sdBenchmarkRequested = false;
+static NO_CACHE FIL benchFile;
+
+struct LatencyHistogram {
+	static constexpr size_t bucketCount = 8;
+	static constexpr uint32_t bucketsMs[bucketCount] = { 1, 2, 5, 10, 20, 50, 100, 200 };
+
+	// last one counts everything above the last bucket
+	uint32_t counts[bucketCount + 1] = {};
+	uint32_t count = 0;
+	uint32_t minUs = UINT32_MAX;
+	uint32_t maxUs = 0;
+	uint64_t totalUs = 0;
+
+	void add(uint32_t us) {
+		size_t bucket = 0;
+		while (bucket < bucketCount && us >= bucketsMs[bucket] * 1000) {
+			bucket++;
+		}
+		counts[bucket]++;
+		count++;
+		if (us < minUs) {
+			minUs = us;
+		}
+		if (us > maxUs) {
+			maxUs = us;
+		}
+		totalUs += us;
+	}
+
+	void print(const char* name) const {
+		if (count == 0) {
+			return;
+		}
+		efiPrintf("%s: %d samples, min %d avg %d max %d us", name, count, minUs, (int)(totalUs / count), maxUs);
+		for (size_t i = 0; i <= bucketCount; i++) {
+			if (i < bucketCount) {
+				efiPrintf("  <%3d ms: %d", bucketsMs[i], counts[i]);
+			} else {
+				efiPrintf(" >=%3d ms: %d", bucketsMs[i - 1], counts[i]);
+			}
+		}
+	}
+};
+
+/**
+ * Measures write and sync latency of the inserted card using the same chunk size as logging.
+ * Runs on the writer thread since FatFS is not reentrant; logging keeps capturing into the ring meanwhile.
+ */
+static void runSdBenchmark() {
+	LatencyHistogram writes;
+	LatencyHistogram syncs;
+
+	FRESULT err = f_open(&benchFile, SD_BENCH_FILENAME, FA_CREATE_ALWAYS | FA_WRITE);
+	if (err != FR_OK) {
+		printError("bench open", err);
+		return;
+	}
+
+	Timer elapsed;
+	elapsed.reset();
+	size_t totalBytes = 0;
+
+	for (int i = 0; i < SD_BENCH_WRITES; i++) {
+		size_t bytesWritten;
+		efitick_t startNt = getTimeNowNt();
+		// content does not matter, use ring storage to avoid another large buffer
+		err = f_write(&benchFile, logRing.getStorage(), logWriteChunkSize, &bytesWritten);
+		writes.add(NT2US(getTimeNowNt() - startNt));
+		if (err != FR_OK || bytesWritten != logWriteChunkSize) {
+			printError("bench write", err);
+			break;
+		}
+		totalBytes += bytesWritten;
+
+		if (i % SD_BENCH_WRITES_PER_SYNC == SD_BENCH_WRITES_PER_SYNC - 1) {
+			startNt = getTimeNowNt();
+			f_sync(&benchFile);
+			syncs.add(NT2US(getTimeNowNt() - startNt));
+		}
+	}
+
+	float seconds = elapsed.getElapsedSeconds();
+	f_close(&benchFile);
+	f_unlink(SD_BENCH_FILENAME);
+
+	efiPrintf("SD bench: %d bytes in %d byte writes, %.2f kB/s", totalBytes, logWriteChunkSize, totalBytes / 1024.0f / seconds);
+	writes.print("write");
+	syncs.print("sync");
+}
+
+static void requestSdBenchmark() {
+	if (!isSdCardAlive()) {
+		efiPrintf("Error: No File system is mounted");
+		return;
+	}
+	efiPrintf("SD bench: starting");
+	sdBenchmarkRequested = true;
+	logDataReady.signal();
+}
+
+static void requestSdUnmount() {
+	if (!isSdCardAlive()) {
+		efiPrintf("Error: No File system is mounted");
+		return;
+	}
+	efiPrintf("SD: unmounting once the log is written");
+	logStopRequested = true;
+	logDataReady.signal();
+}
+
+static void setSdSyncPolicy(int periodMs, int kb) {
+	logSyncPeriodMs = periodMs;
+	logSyncKb = kb;
+	efiPrintf("SD sync every %d ms or %d kB", logSyncPeriodMs, logSyncKb);
+}
+#endif // EFI_PROD_CODE
+
+static THD_WORKING_AREA(mmcWriterThreadStack, 3 * UTILITY_THREAD_STACK_SIZE);
+static THD_FUNCTION(MMCWriterThread, arg) {
+	(void)arg;
+	chRegSetThreadName("MMC Card Writer");
+
+	while (!logFile.failed && !logStopRequested) {
+		msg_t msg = MSG_OK;
+		if (logRing.getUsed() < logWriteChunkSize) {
+			msg = logDataReady.wait(TIME_MS2I(SD_LOG_MAX_WRITE_DELAY_MS));
+		}
+
+#if EFI_PROD_CODE
+		if (sdBenchmarkRequested) {
+			runSdBenchmark();
+			sdBenchmarkRequested = false;
+		}
+#endif // EFI_PROD_CODE
+
+		drainLogRing(/* flushPartial */ msg == MSG_TIMEOUT);
+	}
+
+	// the last record may still be on its way in to the ring
+	while (!logCaptureStopped) {
+		chThdSleepMilliseconds(1);
+	}
+	drainLogRing(/* flushPartial */ true);
+
+#if EFI_PROD_CODE
+	mmcUnMount();
+#endif // EFI_PROD_CODE
+}
+
+static void sdLogStatistics() {
+	efiPrintf("SD log ring %d/%d bytes used, high watermark %d", logRing.getUsed(), logRing.getSize(), logRing.getHighWatermark());
+	efiPrintf("SD log overflows %d dropped %d bytes", logRing.getOverflowCount(), logRing.getDroppedBytes());
+	efiPrintf("SD log chunk %d bytes, throughput %.2f kB/s, write latency last %d max %d us", logWriteChunkSize,
+			logWriteThroughputKbs, logWriteLastLatencyUs, logWriteMaxLatencyUs);
+#if EFI_PROD_CODE
+	efiPrintf("SD log sync every %d ms or %d kB, latency last %d max %d us, preallocated %s", logSyncPeriodMs, logSyncKb,
+			logFile.lastSyncLatencyUs, logFile.maxSyncLatencyUs, boolToString(logFilePreallocated));
+#endif // EFI_PROD_CODE
+}
+
+static void updateSdCardDebug() {
+	engine->outputChannels.debugIntField1 = totalLoggedBytes;
+	engine->outputChannels.debugIntField2 = totalWritesCounter;
+	engine->outputChannels.debugIntField3 = totalSyncCounter;
+	engine->outputChannels.debugIntField4 = fileCreatedCounter;
+	engine->outputChannels.debugIntField5 = logRing.getOverflowCount();
+	engine->outputChannels.debugFloatField1 = 100.0f * logRing.getUsed() / logRing.getSize();
+	engine->outputChannels.debugFloatField2 = 100.0f * logRing.getHighWatermark() / logRing.getSize();
+	engine->outputChannels.debugFloatField3 = logWriteThroughputKbs;
+	engine->outputChannels.debugFloatField4 = logWriteLastLatencyUs / 1000.0f;
+	engine->outputChannels.debugFloatField5 = logWriteMaxLatencyUs / 1000.0f;
+	engine->outputChannels.debugFloatField6 = logRing.getDroppedBytes();
+}
 
 static THD_WORKING_AREA(mmcThreadStack, 3 * UTILITY_THREAD_STACK_SIZE);		// MMC monitor thread
 static THD_FUNCTION(MMCmonThread, arg) {
@@ -516,34 +879,60 @@ static THD_FUNCTION(MMCmonThread, arg) {
 		engine->outputChannels.sd_logging_internal = true;
 	#endif
 
-	while (true) {
+	// largest chunk which keeps writes within one cluster and leaves the other half of the ring for capture
+	logWriteChunkSize = minI(logFile.getClusterSize(), logRing.getSize() / 2);
+	chThdCreateStatic(mmcWriterThreadStack, sizeof(mmcWriterThreadStack), PRIO_MMC_WRITER, (tfunc_t)(void*) MMCWriterThread, NULL);
+
+	BlockingLogRingWriter blockingWriter;
+	bool headerWritten = false;
+
+	systime_t before = chVTGetSystemTime();
+	while (!logStopRequested) {
 		// if the SPI device got un-picked somehow, cancel SD card
 		// Don't do this check at all if using SDMMC interface instead of SPI
 #if EFI_PROD_CODE && !defined(EFI_SDC_DEVICE)
 		if (engineConfiguration->sdCardSpiDevice == SPI_NONE) {
-			return;
+			logStopRequested = true;
+			break;
 		}
 #endif
 
 		if (engineConfiguration->debugMode == DBG_SD_CARD) {
-			engine->outputChannels.debugIntField1 = totalLoggedBytes;
-			engine->outputChannels.debugIntField2 = totalWritesCounter;
-			engine->outputChannels.debugIntField3 = totalSyncCounter;
-			engine->outputChannels.debugIntField4 = fileCreatedCounter;
+			updateSdCardDebug();
 		}
 
-		writeLogLine(logBuffer);
+		auto period = engineConfiguration->sdCardPeriodMs;
+
+		if (headerWritten && period > 0) {
+			writeLogLine(logRing);
+		} else {
+			// zero period means back to back records, as fast as the card takes them
+			writeLogLine(blockingWriter);
+			// nothing is written until the main loop is started
+			headerWritten = logRing.getUsed() > 0 || totalLoggedBytes > 0;
+		}
 
 		// Something went wrong (already handled), so cancel further writes
-		if (logBuffer.failed) {
-			return;
+		if (logFile.failed) {
+			break;
+		}
+
+		if (logRing.getUsed() >= logWriteChunkSize) {
+			logDataReady.signal();
 		}
 
-		auto period = engineConfiguration->sdCardPeriodMs;
 		if (period > 0) {
-			chThdSleepMilliseconds(period);
+			// fixed capture rate regardless of how long the card takes to write
+			systime_t next = before + TIME_MS2I(period);
+			chThdSleepUntilWindowed(before, next);
+			before = next;
+		} else {
+			before = chVTGetSystemTime();
 		}
 	}
+
+	logCaptureStopped = true;
+	logDataReady.signal();
 }
 
 bool isSdCardAlive(void) {
@@ -559,7 +948,11 @@ void initEarlyMmcCard() {
 	addConsoleActionS("ls", listDirectory);
 	addConsoleActionS("del", removeFile);
 	addConsoleAction("incfilename", incLogFileName);
+	addConsoleAction("sdbench", requestSdBenchmark);
+	addConsoleAction("umountsd", requestSdUnmount);
+	addConsoleActionII("set_sd_sync_policy", setSdSyncPolicy);
 #endif // EFI_PROD_CODE
+	addConsoleAction("sdlogstats", sdLogStatistics);
 }
 
 void initMmcCard() {
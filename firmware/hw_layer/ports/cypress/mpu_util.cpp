@@ -274,19 +274,17 @@ bool readSlowAnalogInputs(adcsample_t* convertedSamples) {
 	return true;
 }
 
-static constexpr FastAdcToken invalidToken = (FastAdcToken)(-1);
-
 FastAdcToken enableFastAdcChannel(const char*, adc_channel_e channel) {
 	if (!isAdcChannelValid(channel)) {
-		return invalidToken;
+		return invalidFastAdcToken;
 	}
 
 	// TODO: implement me!
-	return invalidToken;
+	return invalidFastAdcToken;
 }
 
 adcsample_t getFastAdc(FastAdcToken token) {
-	if (token == invalidToken) {
+	if (token == invalidFastAdcToken) {
 		return 0;
 	}
 
@@ -5,6 +5,7 @@
  * @date Sep 9, 2020
  */
 
+#include "pch.h"
 #include "backup_ram.h"
 
 uint32_t backupRamLoad(backup_ram_e idx) {
@@ -4,6 +4,7 @@
  * @date Dec 19, 2017
  */
 
+#include "pch.h"
 #include "backup_ram.h"
 
 uint32_t backupRamLoad(backup_ram_e idx) {
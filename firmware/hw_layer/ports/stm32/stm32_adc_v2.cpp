@@ -203,18 +203,22 @@ bool readSlowAnalogInputs(adcsample_t* convertedSamples) {
 
 extern AdcDevice fastAdc;
 
-static constexpr FastAdcToken invalidToken = (FastAdcToken)(-1);
-
 FastAdcToken enableFastAdcChannel(const char*, adc_channel_e channel) {
 	if (!isAdcChannelValid(channel)) {
-		return invalidToken;
+		return invalidFastAdcToken;
+	}
+
+	uint8_t index = fastAdc.internalAdcIndexByHardwareIndex[static_cast<size_t>(channel)];
+	// 0xFF: channel was not added to the fast group at init
+	if (index == 0xFF) {
+		return invalidFastAdcToken;
 	}
 
-	return fastAdc.internalAdcIndexByHardwareIndex[static_cast<size_t>(channel)];
+	return index;
 }
 
 adcsample_t getFastAdc(FastAdcToken token) {
-	if (token == invalidToken) {
+	if (token == invalidFastAdcToken) {
 		return 0;
 	}
 
@@ -167,11 +167,9 @@ bool readSlowAnalogInputs(adcsample_t* convertedSamples) {
 	return true;
 }
 
-static constexpr FastAdcToken invalidToken = (FastAdcToken)(-1);
-
 FastAdcToken enableFastAdcChannel(const char*, adc_channel_e channel) {
 	if (!isAdcChannelValid(channel)) {
-		return invalidToken;
+		return invalidFastAdcToken;
 	}
 
 	// H7 always samples all fast channels, nothing to do here but compute index
@@ -179,7 +177,7 @@ FastAdcToken enableFastAdcChannel(const char*, adc_channel_e channel) {
 }
 
 adcsample_t getFastAdc(FastAdcToken token) {
-	if (token == invalidToken) {
+	if (token == invalidFastAdcToken) {
 		return 0;
 	}
 
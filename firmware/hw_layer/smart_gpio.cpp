@@ -19,6 +19,7 @@
 #include "drivers/gpio/drv8860.h"
 #include "drivers/gpio/l9779.h"
 #include "drivers/gpio/tle9104.h"
+#include "drivers/gpio/spi_batch.h"
 
 #if (BOARD_TLE6240_COUNT > 0)
 // todo: migrate to TS or board config
@@ -290,6 +291,10 @@ void initSmartGpio() {
 
 	/* external chip init */
 	gpiochips_init();
+
+#if HAL_USE_SPI
+	addConsoleAction("spibatchinfo", printSpiBatchStats);
+#endif /* HAL_USE_SPI */
 }
 
 void tle8888startup() {
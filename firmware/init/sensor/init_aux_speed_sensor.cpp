@@ -22,9 +22,21 @@ public:
 } converter;
 
 
+#if EFI_LAUNCH_CONTROL
+// aux speed sensors double as driven/undriven wheel speed for traction control
+static void onWheelSpeedEdge(efitick_t nowNt) {
+	engine->tractionController.onWheelSpeedEdge(nowNt);
+}
+#endif // EFI_LAUNCH_CONTROL
+
 void initAuxSpeedSensors() {
 	auxSpeed1.initIfValid(engineConfiguration->auxSpeedSensorInputPin[0], converter, 0.05f);
 	auxSpeed2.initIfValid(engineConfiguration->auxSpeedSensorInputPin[1], converter, 0.05f);
+
+#if EFI_LAUNCH_CONTROL
+	auxSpeed1.setEdgeListener(onWheelSpeedEdge);
+	auxSpeed2.setEdgeListener(onWheelSpeedEdge);
+#endif // EFI_LAUNCH_CONTROL
 }
 
 void deinitAuxSpeedSensors() {
@@ -7,13 +7,11 @@
 #include "function_pointer_sensor.h"
 #include "identity_func.h"
 
-static LinearFunc baroConverter;
-static FunctionalSensor baroSensor(SensorType::BarometricPressure, MS2NT(50));
+static TypedFunctionalSensor<LinearFunc> baroSensor(SensorType::BarometricPressure, MS2NT(50));
 
 // This converter is shared between both fast and slow: the only difference is
 // how the *voltage* is determined, not how its converted to a pressure.
-static LinearFunc mapConverter;
-static FunctionalSensor slowMapSensor(SensorType::MapSlow, MS2NT(50));
+static TypedFunctionalSensor<LinearFunc> slowMapSensor(SensorType::MapSlow, MS2NT(50));
 
 // lowest reasonable idle is maybe 600 rpm
 // one sample per cycle (1 cylinder, or "sample one cyl" mode) gives a period of 100ms
@@ -27,7 +25,7 @@ void onMapAveraged(float mapKpa, efitick_t nowNt) {
 }
 
 SensorResult convertMap(float volts) {
-	return mapConverter.convert(volts);
+	return slowMapSensor.getFunction().convert(volts);
 }
 
 // Combine MAP sensors: prefer fast sensor, but use slow if fast is unavailable.
@@ -103,9 +101,8 @@ void initMap() {
 	auto mapChannel = engineConfiguration->map.sensor.hwChannel;
 	if (isAdcChannelValid(mapChannel)) {
 		// Set up the conversion function
-		configureMapFunction(mapConverter, engineConfiguration->map.sensor.type);
+		configureMapFunction(slowMapSensor.getFunction(), engineConfiguration->map.sensor.type);
 
-		slowMapSensor.setFunction(mapConverter);
 		fastMapSensor.setFunction(identityFunction);
 
 		slowMapSensor.Register();
@@ -118,9 +115,8 @@ void initMap() {
 
 	auto baroChannel = engineConfiguration->baroSensor.hwChannel;
 	if (isAdcChannelValid(baroChannel)) {
-		configureMapFunction(baroConverter, engineConfiguration->baroSensor.type);
+		configureMapFunction(baroSensor.getFunction(), engineConfiguration->baroSensor.type);
 
-		baroSensor.setFunction(baroConverter);
 		baroSensor.Register();
 
 		AdcSubscription::SubscribeSensor(baroSensor, baroChannel, 10);
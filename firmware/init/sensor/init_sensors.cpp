@@ -113,4 +113,11 @@ static void initSensorCli() {
 		[](int idx) {
 			Sensor::showInfo(static_cast<SensorType>(idx));
 		});
+	addConsoleActionI("enable_sensor_history",
+		[](int idx) {
+			if (!Sensor::enableHistory(static_cast<SensorType>(idx))) {
+				efiPrintf("No sensor history available for %d", idx);
+			}
+		});
+	addConsoleAction("sensor_history", Sensor::showHistoryReport);
 }
@@ -5,12 +5,10 @@
 #include "functional_sensor.h"
 #include "linear_func.h"
 
-static LinearFunc vbattFunc;
-static FunctionalSensor vbattSensor(SensorType::BatteryVoltage, /* timeout = */ MS2NT(100));
+static TypedFunctionalSensor<LinearFunc> vbattSensor(SensorType::BatteryVoltage, /* timeout = */ MS2NT(100));
 
 void initVbatt() {
-	vbattFunc.configure(0, 0, 1, engineConfiguration->vbattDividerCoeff, 0, 50);
-	vbattSensor.setFunction(vbattFunc);
+	vbattSensor.getFunction().configure(0, 0, 1, engineConfiguration->vbattDividerCoeff, 0, 50);
 
 	if (!isAdcChannelValid(engineConfiguration->vbattAdcChannel)) {
 		return;
@@ -134,6 +134,7 @@
 #include "mass_storage_init.h"
 #include "trigger_emulator_algo.h"
 #include "rusefi_lua.h"
+#include "staged_init.h"
 
 #include <setjmp.h>
 
@@ -173,6 +174,8 @@ void runRusEfiWithConfig();
 __NO_RETURN void runMainLoop();
 
 void runRusEfi() {
+	markBootPhase(BootPhase::Start);
+
 	engine->setConfig();
 
 #if EFI_TEXT_LOGGING
@@ -196,6 +199,7 @@ void runRusEfi() {
 
 	addConsoleAction(CMD_REBOOT, scheduleReboot);
 	addConsoleAction(CMD_REBOOT_DFU, jump_to_bootloader);
+	addConsoleAction("bootinfo", printBootPhases);
 
 	/**
 	 * we need to initialize table objects before default configuration can set values
@@ -226,6 +230,7 @@ void runRusEfi() {
 
 	// Read configuration from flash memory
 	loadConfiguration();
+	markBootPhase(BootPhase::ConfigLoaded);
 
 #if EFI_TUNER_STUDIO
 	startTunerStudioConnectivity();
@@ -239,6 +244,9 @@ void runRusEfi() {
 	// periodic events need to be initialized after fuel&spark pins to avoid a warning
 	initPeriodicEvents();
 
+	// everything the engine needs is up, run whatever was queued with deferInit()
+	startDeferredInit();
+
 	runMainLoop();
 }
 
@@ -258,6 +266,7 @@ void runRusEfiWithConfig() {
 	 * Initialize hardware drivers
 	 */
 	initHardware();
+	markBootPhase(BootPhase::HardwareReady);
 
 #if EFI_FILE_LOGGING
 	initMmcCard();
@@ -287,6 +296,7 @@ void runRusEfiWithConfig() {
 		 * todo: should we initialize some? most? controllers before hardware?
 		 */
 		initEngineContoller();
+		markBootPhase(BootPhase::EngineReady);
 
 	#if EFI_ENGINE_EMULATOR
 		initEngineEmulator();
@@ -305,6 +315,7 @@ void runRusEfiWithConfig() {
 
 void runMainLoop() {
 	efiPrintf("Running main loop");
+	markBootPhase(BootPhase::MainLoop);
 	main_loop_started = true;
 	/**
 	 * This loop is the closes we have to 'main loop' - but here we only publish the status. The main logic of engine
@@ -53,12 +53,25 @@ static void doAddAction(const char *token, action_type_e type, Void callback, vo
 		}
 	}
 
-	efiAssertVoid(CUSTOM_CONSOLE_TOO_MANY, consoleActionCount < CONSOLE_MAX_ACTIONS, "Too many console actions");
-	TokenCallback *current = &consoleActions[consoleActionCount++];
-	current->token = token;
-	current->parameterType = type;
-	current->callback = callback;
-	current->param = param;
+
+	bool isAdded = false;
+	{
+		// deferred init registers actions while console and TS threads may be looking them up,
+		// an entry becomes visible only once it is complete
+		chibios_rt::CriticalSectionLocker csl;
+
+		if (consoleActionCount < CONSOLE_MAX_ACTIONS) {
+			TokenCallback *current = &consoleActions[consoleActionCount];
+			current->token = token;
+			current->parameterType = type;
+			current->callback = callback;
+			current->param = param;
+			consoleActionCount++;
+			isAdded = true;
+		}
+	}
+
+	efiAssertVoid(CUSTOM_CONSOLE_TOO_MANY, isAdded, "Too many console actions");
 #endif /* EFI_DISABLE_CONSOLE_ACTIONS */
 }
 
@@ -0,0 +1,111 @@
+/**
+ * @file log_ring_buffer.h
+ *
+ * Single producer / single consumer byte ring used to decouple log capture from storage writes.
+ * Producer pushes whole records, a record which does not fit is dropped rather than split so the
+ * reader never sees half a record. Consumer drains contiguous spans in place, no extra copy.
+ *
+ * Both indexes only ever grow and are only written by their owner side, so no lock is needed
+ * as long as there is exactly one producer thread and one consumer thread.
+ */
+
+#pragma once
+
+#include "buffered_writer.h"
+
+template <size_t TSize>
+class LogRingBuffer : public Writer {
+	static_assert((TSize & (TSize - 1)) == 0, "ring size must be power of two");
+
+public:
+	// Producer side: all-or-nothing copy of a record
+	size_t write(const char* buffer, size_t count) override {
+		if (count > getFree()) {
+			m_overflowCount++;
+			m_droppedBytes += count;
+			return 0;
+		}
+
+		size_t head = m_head;
+		size_t offset = head & (TSize - 1);
+		size_t firstPart = TSize - offset;
+		if (firstPart > count) {
+			firstPart = count;
+		}
+		memcpy(m_buffer + offset, buffer, firstPart);
+		memcpy(m_buffer, buffer + firstPart, count - firstPart);
+
+		// publish only once the data is in place
+		m_head = head + count;
+
+		size_t used = getUsed();
+		if (used > m_highWatermark) {
+			m_highWatermark = used;
+		}
+
+		return count;
+	}
+
+	// Nothing is buffered outside of the ring
+	size_t flush() override {
+		return 0;
+	}
+
+	// Consumer side: longest contiguous span available for reading
+	size_t getReadable(const char** ptr) const {
+		size_t tail = m_tail;
+		size_t offset = tail & (TSize - 1);
+		size_t available = m_head - tail;
+		size_t untilWrap = TSize - offset;
+
+		*ptr = m_buffer + offset;
+		return available < untilWrap ? available : untilWrap;
+	}
+
+	void consume(size_t count) {
+		m_tail = m_tail + count;
+	}
+
+	void clear() {
+		m_tail = m_head;
+	}
+
+	size_t getUsed() const {
+		return m_head - m_tail;
+	}
+
+	size_t getFree() const {
+		return TSize - getUsed();
+	}
+
+	// Raw storage, regardless of what part of it holds unread data
+	const char* getStorage() const {
+		return m_buffer;
+	}
+
+	static constexpr size_t getSize() {
+		return TSize;
+	}
+
+	size_t getHighWatermark() const {
+		return m_highWatermark;
+	}
+
+	uint32_t getOverflowCount() const {
+		return m_overflowCount;
+	}
+
+	uint32_t getDroppedBytes() const {
+		return m_droppedBytes;
+	}
+
+private:
+	char m_buffer[TSize];
+
+	volatile size_t m_head = 0;
+	volatile size_t m_tail = 0;
+
+	size_t m_highWatermark = 0;
+	uint32_t m_overflowCount = 0;
+	uint32_t m_droppedBytes = 0;
+};
@@ -0,0 +1,135 @@
+/**
+ * @file shadow_table.h
+ * @brief Float copy of a packed configuration table
+ *
+ * Tables are stored in the integer formats TunerStudio edits, so every Map3D lookup scales the
+ * cells and axis values it touches. A shadow table unpacks the whole table and both axes once in
+ * to contiguous row major float arrays, lookups then only search and interpolate.
+ *
+ * Whoever owns the shadow has to tell it about every change of the source, see shadow_tables.h
+ *
+ * @date Oct 19, 2026
+ */
+
+#pragma once
+
+#include "table_helper.h"
+
+template<int TColNum, int TRowNum, typename TValue, typename TRow, typename TColumn>
+class ShadowTable : public ValueProvider3D {
+public:
+	void init(const TValue (&table)[TRowNum][TColNum],
+			const TRow (&rowBins)[TRowNum], const TColumn (&columnBins)[TColNum]) {
+		m_source = &table;
+		m_rowSource = &rowBins;
+		m_columnSource = &columnBins;
+
+		rebuild();
+	}
+
+	void rebuild() {
+		if (!m_source) {
+			return;
+		}
+
+		refreshCells(0, TRowNum * TColNum);
+		refreshBins();
+	}
+
+	/**
+	 * Refreshes only what the written bytes overlap, a single cell edit converts a single cell
+	 * @return true if the write touched this table or its axes
+	 */
+	bool onWrite(const void* start, size_t size) {
+		if (!m_source) {
+			return false;
+		}
+
+		auto first = reinterpret_cast<const uint8_t*>(start);
+		auto last = first + size;
+		bool isAffected = false;
+
+		auto table = reinterpret_cast<const uint8_t*>(m_source);
+		auto tableEnd = table + sizeof(*m_source);
+		if (first < tableEnd && last > table) {
+			size_t firstCell = (maxPtr(first, table) - table) / sizeof(TValue);
+			size_t lastCell = (minPtr(last, tableEnd) - table - 1) / sizeof(TValue);
+
+			refreshCells(firstCell, lastCell + 1);
+			isAffected = true;
+		}
+
+		if (overlaps(first, last, m_rowSource) || overlaps(first, last, m_columnSource)) {
+			refreshBins();
+			isAffected = true;
+		}
+
+		return isAffected;
+	}
+
+	float getValue(float xColumn, float yRow) const final {
+		if (!m_source) {
+			// not initialized, same as Map3D
+			return 0;
+		}
+
+		return interpolate3d(m_values, m_rowBins, yRow, m_columnBins, xColumn);
+	}
+
+	float getCell(size_t row, size_t column) const {
+		return m_values[row][column];
+	}
+
+	// RAM taken by the float copy
+	static constexpr size_t getShadowSize() {
+		return sizeof(float) * (TRowNum * TColNum + TRowNum + TColNum);
+	}
+
+	// size of the packed source, table and axes
+	static constexpr size_t getSourceSize() {
+		return sizeof(TValue) * TRowNum * TColNum + sizeof(TRow) * TRowNum + sizeof(TColumn) * TColNum;
+	}
+
+private:
+	static const uint8_t* minPtr(const uint8_t* a, const uint8_t* b) {
+		return a < b ? a : b;
+	}
+
+	static const uint8_t* maxPtr(const uint8_t* a, const uint8_t* b) {
+		return a > b ? a : b;
+	}
+
+	template <typename TArray>
+	static bool overlaps(const uint8_t* first, const uint8_t* last, const TArray* array) {
+		auto start = reinterpret_cast<const uint8_t*>(array);
+		return first < start + sizeof(*array) && last > start;
+	}
+
+	void refreshCells(size_t first, size_t last) {
+		for (size_t i = first; i < last; i++) {
+			size_t row = i / TColNum;
+			size_t column = i % TColNum;
+
+			m_values[row][column] = (*m_source)[row][column];
+		}
+	}
+
+	void refreshBins() {
+		for (size_t i = 0; i < TRowNum; i++) {
+			m_rowBins[i] = (*m_rowSource)[i];
+		}
+
+		for (size_t i = 0; i < TColNum; i++) {
+			m_columnBins[i] = (*m_columnSource)[i];
+		}
+	}
+
+	// whole rows on 32 byte cache lines, same layout as the source
+	alignas(32) float m_values[TRowNum][TColNum];
+	float m_rowBins[TRowNum];
+	float m_columnBins[TColNum];
+
+	const TValue (*m_source)[TRowNum][TColNum] = nullptr;
+	const TRow (*m_rowSource)[TRowNum] = nullptr;
+	const TColumn (*m_columnSource)[TColNum] = nullptr;
+};
@@ -0,0 +1,75 @@
+/*
+ * @file cic_decimator.cpp
+ */
+
+#include "pch.h"
+
+#include "cic_decimator.h"
+
+/**
+ * Compensator is [-A, 1 + 2A, -A]: unity at DC with a rising response which offsets the sinc^3 droop.
+ * With A = 0.15 third order CIC response stays within 1% up to an eighth of the output rate, about 5% low at a quarter.
+ */
+#define CIC_COMPENSATION_A 0.15f
+
+void CicDecimator::configure(int decimation) {
+	m_decimation = maxI(1, minI(decimation, CIC_MAX_DECIMATION));
+
+	float gain = 1;
+	for (int i = 0; i < CIC_ORDER; i++) {
+		gain *= m_decimation;
+	}
+	m_gainInverse = 1 / gain;
+
+	reset();
+}
+
+void CicDecimator::reset() {
+	memset(m_integrator, 0, sizeof(m_integrator));
+	memset(m_combDelay, 0, sizeof(m_combDelay));
+	m_phase = 0;
+	m_outputCount = 0;
+}
+
+bool CicDecimator::feed(uint16_t sample) {
+	if (m_decimation <= 1) {
+		m_output = sample;
+		m_outputCount++;
+		return true;
+	}
+
+	// integrators wrap around, combs undo that as long as the true output fits 32 bits
+	uint32_t value = sample;
+	for (int i = 0; i < CIC_ORDER; i++) {
+		m_integrator[i] += value;
+		value = m_integrator[i];
+	}
+
+	if (++m_phase < m_decimation) {
+		return false;
+	}
+	m_phase = 0;
+
+	for (int i = 0; i < CIC_ORDER; i++) {
+		uint32_t delayed = m_combDelay[i];
+		m_combDelay[i] = value;
+		value -= delayed;
+	}
+
+	// comb delay lines start empty, the first CIC_ORDER outputs are not valid yet
+	if (m_outputCount < CIC_ORDER) {
+		m_outputCount++;
+		m_previous[0] = m_previous[1] = m_output = value * m_gainInverse;
+		return false;
+	}
+
+	float current = value * m_gainInverse;
+	m_output = -CIC_COMPENSATION_A * current
+			+ (1 + 2 * CIC_COMPENSATION_A) * m_previous[0]
+			- CIC_COMPENSATION_A * m_previous[1];
+	m_previous[1] = m_previous[0];
+	m_previous[0] = current;
+
+	m_outputCount++;
+	return true;
+}
@@ -0,0 +1,56 @@
+/*
+ * @file cic_decimator.h
+ *
+ * Cascaded integrator-comb decimator for oversampled ADC channels. Per input sample it costs three
+ * integer additions, which is what makes it affordable inside of the ADC DMA callback. A 3-tap FIR at
+ * the output rate compensates most of the CIC passband droop.
+ *
+ * Output is in input units with the extra resolution gained from averaging kept as a fraction.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#define CIC_ORDER 3
+// 12 bit samples times CIC gain (decimation ^ CIC_ORDER) has to fit 32 bit integrators
+#define CIC_MAX_DECIMATION 64
+
+class CicDecimator {
+public:
+	/**
+	 * @param decimation number of input samples per output sample, 1 means pass-through
+	 */
+	void configure(int decimation);
+	void reset();
+
+	/**
+	 * @return true once a new output sample is ready
+	 */
+	bool feed(uint16_t sample);
+
+	float get() const {
+		return m_output;
+	}
+
+	int getDecimation() const {
+		return m_decimation;
+	}
+
+	uint32_t getOutputCount() const {
+		return m_outputCount;
+	}
+
+private:
+	uint32_t m_integrator[CIC_ORDER];
+	uint32_t m_combDelay[CIC_ORDER];
+
+	int m_decimation = 1;
+	int m_phase = 0;
+	float m_gainInverse = 1;
+
+	// compensator input history
+	float m_previous[2];
+	float m_output = 0;
+	uint32_t m_outputCount = 0;
+};
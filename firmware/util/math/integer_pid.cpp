@@ -0,0 +1,59 @@
+/*
+ * @file integer_pid.cpp
+ */
+
+#include "pch.h"
+
+#include "integer_pid.h"
+
+// rounded, small I gains at a high loop rate are only a few counts
+static int32_t toQ16(float value) {
+	float scaled = clampF(-2e9f, value * (1 << INTEGER_PID_SHIFT), 2e9f);
+	return (int32_t)(scaled + (scaled < 0 ? -0.5f : 0.5f));
+}
+
+static int64_t toQ16Wide(float value) {
+	return (int64_t)(value * (1 << INTEGER_PID_SHIFT));
+}
+
+template <typename T>
+static T clampWide(T min, T value, T max) {
+	return value < min ? min : (value > max ? max : value);
+}
+
+void IntegerPid::configure(const pid_s& parameters, float periodSeconds, int32_t scale, float iTermMin, float iTermMax) {
+	// input and output share the scale, so gains do not change
+	m_kp = toQ16(parameters.pFactor);
+	m_ki = toQ16(parameters.iFactor * periodSeconds);
+	m_kd = toQ16(parameters.dFactor / periodSeconds);
+
+	m_offset = toQ16Wide(parameters.offset * scale);
+
+	// see Pid::updateITerm
+	float iTermLimit = parameters.maxValue * 100;
+	m_iTermMin = toQ16Wide(maxF(iTermMin, -iTermLimit) * scale);
+	m_iTermMax = toQ16Wide(minF(iTermMax, iTermLimit) * scale);
+
+	m_minOutput = parameters.minValue * scale;
+	m_maxOutput = parameters.maxValue * scale;
+}
+
+void IntegerPid::reset() {
+	m_integrator = 0;
+	m_previousError = 0;
+}
+
+int32_t IntegerPid::update(int32_t target, int32_t input) {
+	int32_t error = target - input;
+
+	m_integrator = clampWide(m_iTermMin, m_integrator + (int64_t)m_ki * error, m_iTermMax);
+
+	int64_t output = (int64_t)m_kp * error
+		+ m_integrator
+		+ (int64_t)m_kd * (error - m_previousError)
+		+ m_offset;
+
+	m_previousError = error;
+
+	return clampWide<int64_t>(m_minOutput, output >> INTEGER_PID_SHIFT, m_maxOutput);
+}
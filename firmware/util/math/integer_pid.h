@@ -0,0 +1,55 @@
+/*
+ * @file integer_pid.h
+ *
+ * Fixed point PID for loops which run too often for the float Pid. Input and output are integers
+ * in caller chosen units, for example hundredths of a percent. Gains are Q16 with the loop period
+ * folded in by configure(), so that update() is three multiplies, a few additions and two clamps.
+ *
+ * Same math as Pid::getOutput: derivative on error, integrator limited the same way.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#define INTEGER_PID_SHIFT 16
+
+struct pid_s;
+
+class IntegerPid {
+public:
+	/**
+	 * @param periodSeconds how often update() is called
+	 * @param scale integer units per unit of the float PID, applies to both input and output
+	 */
+	void configure(const pid_s& parameters, float periodSeconds, int32_t scale, float iTermMin, float iTermMax);
+	void reset();
+
+	int32_t update(int32_t target, int32_t input);
+
+	// in output units
+	int32_t getIntegrator() const {
+		return m_integrator >> INTEGER_PID_SHIFT;
+	}
+
+	int32_t getPreviousError() const {
+		return m_previousError;
+	}
+
+private:
+	// Q16
+	int32_t m_kp = 0;
+	int32_t m_ki = 0;
+	int32_t m_kd = 0;
+	int64_t m_offset = 0;
+	int64_t m_iTermMin = 0;
+	int64_t m_iTermMax = 0;
+
+	// output units
+	int32_t m_minOutput = 0;
+	int32_t m_maxOutput = 0;
+
+	// Q16
+	int64_t m_integrator = 0;
+	int32_t m_previousError = 0;
+};
@@ -119,4 +119,36 @@ void setCurveValue(const kType bins[], VType values[], int size, float key, floa
 	values[index] = value;
 }
 
+/**
+ * Lower bin and position between it and the next one, 0 to 1. Out of range values are clamped
+ * the same way interpolate3d does: below the axis is the first bin, above is the end of the last one.
+ */
+struct BinFraction {
+	size_t idx;
+	float frac;
+};
+
+template <typename TBin, size_t TSize>
+BinFraction getBinFraction(float value, const TBin (&bins)[TSize]) {
+	static_assert(TSize >= 2, "need at least two bins");
+
+	if (cisnan(value) || value <= bins[0]) {
+		return { 0, 0 };
+	}
+
+	if (value >= bins[TSize - 1]) {
+		return { TSize - 2, 1 };
+	}
+
+	size_t idx = 0;
+	while (idx < TSize - 2 && bins[idx + 1] <= value) {
+		idx++;
+	}
+
+	float low = bins[idx];
+	float high = bins[idx + 1];
+
+	return { idx, (value - low) / (high - low) };
+}
+
 void initInterpolation();
@@ -8,8 +8,10 @@ UTILSRC_CPP = \
 	$(UTIL_DIR)/containers/listener_array.cpp \
 	$(UTIL_DIR)/containers/local_version_holder.cpp \
 	$(UTIL_DIR)/math/biquad.cpp \
+	$(UTIL_DIR)/math/cic_decimator.cpp \
 	$(UTIL_DIR)/math/error_accumulator.cpp \
 	$(UTIL_DIR)/math/efi_pid.cpp \
+	$(UTIL_DIR)/math/integer_pid.cpp \
 	$(UTIL_DIR)/math/interpolation.cpp \
 	$(PROJECT_DIR)/util/datalogging.cpp \
 	$(PROJECT_DIR)/util/loggingcentral.cpp \
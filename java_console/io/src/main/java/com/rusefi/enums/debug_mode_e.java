@@ -16,7 +16,7 @@ public enum debug_mode_e {
 	DBG_9,
 	DBG_10,
 	DBG_11,
-	DBG_UNUSED12,
+	DBG_BOOT_TIME,
 	DBG_SD_CARD,
 	DBG_SR5_PROTOCOL,
 	DBG_KNOCK,
@@ -456,6 +456,7 @@ public class Fields {
 	public static final int debug_mode_e_DBG_ANALOG_INPUTS = 21;
 	public static final int debug_mode_e_DBG_ANALOG_INPUTS2 = 32;
 	public static final int debug_mode_e_DBG_BENCH_TEST = 19;
+	public static final int debug_mode_e_DBG_BOOT_TIME = 12;
 	public static final int debug_mode_e_DBG_CJ125 = 25;
 	public static final int debug_mode_e_DBG_COMPOSITE_LOG = 40;
 	public static final int debug_mode_e_DBG_DWELL_METRIC = 33;
@@ -479,7 +480,6 @@ public class Fields {
 	public static final int debug_mode_e_DBG_TLE8888 = 31;
 	public static final int debug_mode_e_DBG_TPS_ACCEL = 1;
 	public static final int debug_mode_e_DBG_TRIGGER_COUNTERS = 5;
-	public static final int debug_mode_e_DBG_UNUSED12 = 12;
 	public static final int debug_mode_e_DBG_UNUSED41 = 41;
 	public static final int debug_mode_e_DBG_UNUSED_42 = 42;
 	public static final int debug_mode_e_UNUSED23 = 23;
@@ -527,6 +527,7 @@ public class Fields {
 	public static final int enableFan2WithAc_offset = 120;
 	public static final int enableInnovateLC2_offset = 960;
 	public static final int enableLaunchRetard_offset = 960;
+	public static final int enableLongTermFuelTrim_offset = 1372;
 	public static final int enableMapEstimationTableFallback_offset = 120;
 	public static final int enableSoftwareKnock_offset = 960;
 	public static final int enableTrailingSparks_offset = 120;
@@ -683,6 +684,7 @@ public class Fields {
 	public static final int etb_use_two_wires_offset = 120;
 	public static final int etbBiasBins_offset = 4016;
 	public static final int etbBiasValues_offset = 4048;
+	public static final int etbFastInnerLoop_offset = 1372;
 	public static final int etbFreq_offset = 1862;
 	public static final int etbFunctions1_offset = 1200;
 	public static final int etbFunctions2_offset = 1201;
@@ -710,6 +712,7 @@ public class Fields {
 	public static final int etbWastegatePid_offset_offset = 1876;
 	public static final int etbWastegatePid_periodMs_offset = 1878;
 	public static final int etbWastegatePid_pFactor_offset = 1864;
+	public static final int eventSyncFuelSpark_offset = 1372;
 	public static final int failedMapFallback_offset = 485;
 	public static final int fan1ExtraIdle_offset = 1736;
 	public static final int fan2ExtraIdle_offset = 1746;
@@ -1636,6 +1639,7 @@ public class Fields {
 	public static final int map_sensor_offset = 276;
 	public static final int map_sensor_type_offset = 284;
 	public static final int MAP_WINDOW_SIZE = 8;
+	public static final int mapAdcDecimation_offset = 3121;
 	public static final int mapAveragingSchedulingAtIndex_offset = 1416;
 	public static final int mapCamDetectionAnglePosition_offset = 496;
 	public static final int mapErrorDetectionTooHigh_offset = 1492;
@@ -1766,6 +1770,7 @@ public class Fields {
 	public static final int pin_output_mode_e_OM_OPENDRAIN_INVERTED = 3;
 	public static final int postCrankingDurationSec_offset = 1792;
 	public static final int postCrankingFactor_offset = 1788;
+	public static final int predictiveAngleScheduling_offset = 1372;
 	public static final int primeBins_offset = 2032;
 	public static final int primeValues_offset = 2528;
 	public static final int primingDelay_offset = 1747;
@@ -2128,6 +2133,7 @@ public class Fields {
 	public static final int tpsAccelFractionDivisor_offset = 2500;
 	public static final int tpsAccelFractionPeriod_offset = 2498;
 	public static final int tpsAccelLookback_offset = 1572;
+	public static final int tpsAdcDecimation_offset = 3122;
 	public static final int tpsDecelEnleanmentMultiplier_offset = 1596;
 	public static final int tpsDecelEnleanmentThreshold_offset = 1592;
 	public static final int tpsErrorDetectionTooHigh_offset = 130;
@@ -2378,7 +2384,7 @@ public class Fields {
 	public static final int TS_RESPONSE_UNDERRUN = 0x80;
 	public static final int TS_RESPONSE_UNRECOGNIZED_COMMAND = 0x83;
 	public static final char TS_SET_LOGGER_SWITCH = 'l';
-	public static final String TS_SIGNATURE = "rusEFI 2022.08.22.all.2288281700";
+	public static final String TS_SIGNATURE = "rusEFI 2022.08.22.all.2388021950";
 	public static final char TS_SINGLE_WRITE_COMMAND = 'W';
 	public static final char TS_TEST_COMMAND = 't';
 	public static final int TS_TOTAL_OUTPUT_SIZE = 1208;
@@ -2416,13 +2422,9 @@ public class Fields {
 	public static final int unused1129_offset = 1628;
 	public static final int unused1130_offset = 1628;
 	public static final int unused1740b2_offset = 1628;
-	public static final int unused4080_offset = 3121;
+	public static final int unused4080_offset = 3123;
 	public static final int unused962_offset = 1040;
-	public static final int unused_1484_bit_27_offset = 1372;
-	public static final int unused_1484_bit_29_offset = 1372;
-	public static final int unused_1484_bit_30_offset = 1372;
 	public static final int unused_1484_bit_31_offset = 1372;
-	public static final int unused_1484_bit_38_offset = 1372;
 	public static final int unusedBit_45_31_offset = 120;
 	public static final int unusedBit_539_10_offset = 1628;
 	public static final int unusedBit_539_11_offset = 1628;
@@ -3190,10 +3192,10 @@ public class Fields {
 	public static final Field FORCEO2HEATING = Field.create("FORCEO2HEATING", 1372, FieldType.BIT, 24);
 	public static final Field INVERTVVTCONTROLINTAKE = Field.create("INVERTVVTCONTROLINTAKE", 1372, FieldType.BIT, 25);
 	public static final Field INVERTVVTCONTROLEXHAUST = Field.create("INVERTVVTCONTROLEXHAUST", 1372, FieldType.BIT, 26);
-	public static final Field UNUSED_1484_BIT_27 = Field.create("UNUSED_1484_BIT_27", 1372, FieldType.BIT, 27);
-	public static final Field UNUSED_1484_BIT_38 = Field.create("UNUSED_1484_BIT_38", 1372, FieldType.BIT, 28);
-	public static final Field UNUSED_1484_BIT_29 = Field.create("UNUSED_1484_BIT_29", 1372, FieldType.BIT, 29);
-	public static final Field UNUSED_1484_BIT_30 = Field.create("UNUSED_1484_BIT_30", 1372, FieldType.BIT, 30);
+	public static final Field EVENTSYNCFUELSPARK = Field.create("EVENTSYNCFUELSPARK", 1372, FieldType.BIT, 27);
+	public static final Field ETBFASTINNERLOOP = Field.create("ETBFASTINNERLOOP", 1372, FieldType.BIT, 28);
+	public static final Field ENABLELONGTERMFUELTRIM = Field.create("ENABLELONGTERMFUELTRIM", 1372, FieldType.BIT, 29);
+	public static final Field PREDICTIVEANGLESCHEDULING = Field.create("PREDICTIVEANGLESCHEDULING", 1372, FieldType.BIT, 30);
 	public static final Field UNUSED_1484_BIT_31 = Field.create("UNUSED_1484_BIT_31", 1372, FieldType.BIT, 31);
 	public static final Field ENGINECHARTSIZE = Field.create("ENGINECHARTSIZE", 1376, FieldType.INT).setScale(1.0);
 	public static final Field TURBOSPEEDSENSORMULTIPLIER = Field.create("TURBOSPEEDSENSORMULTIPLIER", 1380, FieldType.FLOAT);
@@ -3283,7 +3285,7 @@ public class Fields {
 	public static final Field TPSDECELENLEANMENTTHRESHOLD = Field.create("TPSDECELENLEANMENTTHRESHOLD", 1592, FieldType.FLOAT);
 	public static final Field TPSDECELENLEANMENTMULTIPLIER = Field.create("TPSDECELENLEANMENTMULTIPLIER", 1596, FieldType.FLOAT);
 	public static final Field SLOWADCALPHA = Field.create("SLOWADCALPHA", 1600, FieldType.FLOAT);
-	public static final String[] debug_mode_e = {"INVALID", "TPS acceleration enrichment", "INVALID", "Stepper Idle Control", "Engine Load accl enrich", "Trigger Counters", "Soft Spark Cut", "INVALID", "INVALID", "INVALID", "INVALID", "INVALID", "INVALID", "SD card", "sr5", "Knock", "INVALID", "Electronic Throttle", "Executor", "Bench Test / TS commands", "INVALID", "Analog inputs #1", "INSTANT_RPM", "INVALID", "Status", "CJ125", "INVALID", "MAP", "Metrics", "INVALID", "Ion Sense", "TLE8888", "Analog inputs #2", "Dwell Metric", "INVALID", "INVALID", "Boost Control", "INVALID", "INVALID", "ETB Autotune", "Composite Log", "INVALID", "INVALID", "INVALID", "Dyno_View", "Logic_Analyzer", "INVALID", "TCU", "Lua"};
+	public static final String[] debug_mode_e = {"INVALID", "TPS acceleration enrichment", "INVALID", "Stepper Idle Control", "Engine Load accl enrich", "Trigger Counters", "Soft Spark Cut", "INVALID", "INVALID", "INVALID", "INVALID", "INVALID", "Boot time", "SD card", "sr5", "Knock", "INVALID", "Electronic Throttle", "Executor", "Bench Test / TS commands", "INVALID", "Analog inputs #1", "INSTANT_RPM", "INVALID", "Status", "CJ125", "INVALID", "MAP", "Metrics", "INVALID", "Ion Sense", "TLE8888", "Analog inputs #2", "Dwell Metric", "INVALID", "INVALID", "Boost Control", "INVALID", "INVALID", "ETB Autotune", "Composite Log", "INVALID", "INVALID", "INVALID", "Dyno_View", "Logic_Analyzer", "INVALID", "TCU", "Lua"};
 	public static final Field DEBUGMODE = Field.create("DEBUGMODE", 1604, FieldType.INT8, debug_mode_e).setScale(1.0);
 	public static final Field ALIGNMENTFILL_AT_1605 = Field.create("ALIGNMENTFILL_AT_1605", 1605, FieldType.INT8).setScale(1.0);
 	public static final Field AUXSERIALSPEED = Field.create("AUXSERIALSPEED", 1608, FieldType.INT).setScale(1.0);
@@ -3711,7 +3713,9 @@ public class Fields {
 	public static final Field TRIGGERGAPOVERRIDETO17 = Field.create("TRIGGERGAPOVERRIDETO17", 3112, FieldType.FLOAT);
 	public static final Field TRIGGERGAPOVERRIDETO18 = Field.create("TRIGGERGAPOVERRIDETO18", 3116, FieldType.FLOAT);
 	public static final Field MAXCAMPHASERESOLVERPM = Field.create("MAXCAMPHASERESOLVERPM", 3120, FieldType.INT8).setScale(50.0);
-	public static final Field UNUSED4080 = Field.create("UNUSED4080", 3121, FieldType.INT8).setScale(1.0);
+	public static final Field MAPADCDECIMATION = Field.create("MAPADCDECIMATION", 3121, FieldType.INT8).setScale(1.0);
+	public static final Field TPSADCDECIMATION = Field.create("TPSADCDECIMATION", 3122, FieldType.INT8).setScale(1.0);
+	public static final Field UNUSED4080 = Field.create("UNUSED4080", 3123, FieldType.INT8).setScale(1.0);
 	public static final Field HPFPCAMLOBES = Field.create("HPFPCAMLOBES", 3132, FieldType.INT8).setScale(1.0);
 	public static final String[] hpfp_cam_e = {"NONE", "Intake 1", "Exhaust 1", "Intake 2", "Exhaust 2"};
 	public static final Field HPFPCAM = Field.create("HPFPCAM", 3133, FieldType.INT8, hpfp_cam_e).setScale(1.0);
@@ -4555,10 +4559,10 @@ public class Fields {
 	FORCEO2HEATING,
 	INVERTVVTCONTROLINTAKE,
 	INVERTVVTCONTROLEXHAUST,
-	UNUSED_1484_BIT_27,
-	UNUSED_1484_BIT_38,
-	UNUSED_1484_BIT_29,
-	UNUSED_1484_BIT_30,
+	EVENTSYNCFUELSPARK,
+	ETBFASTINNERLOOP,
+	ENABLELONGTERMFUELTRIM,
+	PREDICTIVEANGLESCHEDULING,
 	UNUSED_1484_BIT_31,
 	ENGINECHARTSIZE,
 	TURBOSPEEDSENSORMULTIPLIER,
@@ -5067,6 +5071,8 @@ public class Fields {
 	TRIGGERGAPOVERRIDETO17,
 	TRIGGERGAPOVERRIDETO18,
 	MAXCAMPHASERESOLVERPM,
+	MAPADCDECIMATION,
+	TPSADCDECIMATION,
 	UNUSED4080,
 	HPFPCAMLOBES,
 	HPFPCAM,
@@ -0,0 +1,239 @@
+/*
+ * @file logicdata_binary.cpp
+ */
+
+#include "pch.h"
+#include "logicdata_csv_reader.h"
+#include "logicdata_binary.h"
+
+#include <cmath>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CAPTURE_USE_MMAP TRUE
+#else
+#define CAPTURE_USE_MMAP FALSE
+#endif
+
+static void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+	while (value >= 0x80) {
+		out.push_back((uint8_t)(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back((uint8_t)value);
+}
+
+int64_t convertCsvToBinaryCapture(const char *csvFileName, const char *binaryFileName,
+		size_t triggerCount, size_t vvtCount, const int *columnIndeces, double timestampOffset) {
+	if (triggerCount + vvtCount > CAPTURE_MAX_CHANNELS || triggerCount > TRIGGER_INPUT_PIN_COUNT || vvtCount > CAM_INPUTS_COUNT) {
+		return -1;
+	}
+
+	CsvReader reader(triggerCount, vvtCount, timestampOffset);
+	reader.open(csvFileName, columnIndeces);
+
+	capture_header_s header{};
+	header.magic = CAPTURE_MAGIC;
+	header.version = CAPTURE_VERSION;
+	header.triggerCount = triggerCount;
+	header.vvtCount = vvtCount;
+
+	std::vector<uint8_t> records;
+	uint32_t state = 0;
+	int64_t previousNs = 0;
+	bool isFirstLine = true;
+
+	while (reader.haveMore()) {
+		double timeStamp;
+		bool newState[TRIGGER_INPUT_PIN_COUNT] = {};
+		bool newVvtState[CAM_INPUTS_COUNT] = {};
+
+		if (!reader.parseLine(&timeStamp, newState, newVvtState)) {
+			break;
+		}
+
+		uint32_t lineState = 0;
+		for (size_t i = 0; i < triggerCount; i++) {
+			lineState |= (newState[i] ? 1 : 0) << i;
+		}
+		for (size_t i = 0; i < vvtCount; i++) {
+			lineState |= (newVvtState[i] ? 1 : 0) << (triggerCount + i);
+		}
+
+		int64_t nowNs = std::llround(timeStamp * 1e9);
+
+		if (!isFirstLine && nowNs < previousNs) {
+			// deltas are unsigned, a step back in time would replay as a huge gap
+			printf("convertCsvToBinaryCapture: time goes backwards at line %d\r\n", reader.lineIndex());
+			return -1;
+		}
+
+		if (isFirstLine) {
+			// CsvReader starts from all-low state, keep that so replay produces identical edges
+			isFirstLine = false;
+			header.startTimeNs = nowNs;
+			previousNs = nowNs;
+		}
+
+		uint32_t changed = lineState ^ state;
+		for (size_t channel = 0; channel < triggerCount + vvtCount; channel++) {
+			if (!(changed & (1 << channel))) {
+				continue;
+			}
+
+			// several channels toggling on the same line get zero deltas after the first one
+			writeVarint(records, ((uint64_t)(nowNs - previousNs) << CAPTURE_CHANNEL_BITS) | channel);
+			previousNs = nowNs;
+			header.edgeCount++;
+		}
+		state = lineState;
+	}
+
+	FILE *fp = fopen(binaryFileName, "wb");
+	if (!fp) {
+		return -1;
+	}
+	fwrite(&header, sizeof(header), 1, fp);
+	fwrite(records.data(), 1, records.size(), fp);
+	fclose(fp);
+
+	return header.edgeCount;
+}
+
+BinaryCaptureReader::~BinaryCaptureReader() {
+	close();
+}
+
+void BinaryCaptureReader::close() {
+#if CAPTURE_USE_MMAP
+	if (m_ownsMapping && m_data) {
+		munmap(const_cast<uint8_t*>(m_data), m_size);
+	}
+#endif // CAPTURE_USE_MMAP
+	m_ownsMapping = false;
+	m_data = nullptr;
+	m_size = 0;
+}
+
+bool BinaryCaptureReader::open(const char *fileName) {
+	printf("Reading binary capture from %s\r\n", fileName);
+	close();
+
+#if CAPTURE_USE_MMAP
+	int fd = ::open(fileName, O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(capture_header_s)) {
+		::close(fd);
+		return false;
+	}
+
+	void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// the mapping stays valid after the descriptor is closed
+	::close(fd);
+	if (mapping == MAP_FAILED) {
+		return false;
+	}
+	madvise(mapping, st.st_size, MADV_SEQUENTIAL);
+
+	if (!open(reinterpret_cast<const uint8_t*>(mapping), st.st_size)) {
+		munmap(mapping, st.st_size);
+		return false;
+	}
+	m_ownsMapping = true;
+	return true;
+#else
+	FILE *fp = fopen(fileName, "rb");
+	if (!fp) {
+		return false;
+	}
+	fseek(fp, 0, SEEK_END);
+	long size = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	m_fallbackBuffer.resize(size);
+	size_t read = fread(m_fallbackBuffer.data(), 1, size, fp);
+	fclose(fp);
+	if (read != (size_t)size) {
+		return false;
+	}
+	return open(m_fallbackBuffer.data(), m_fallbackBuffer.size());
+#endif // CAPTURE_USE_MMAP
+}
+
+bool BinaryCaptureReader::open(const uint8_t *data, size_t size) {
+	if (size < sizeof(capture_header_s)) {
+		return false;
+	}
+
+	memcpy(&m_header, data, sizeof(m_header));
+	if (m_header.magic != CAPTURE_MAGIC || m_header.version != CAPTURE_VERSION
+			|| m_header.triggerCount + m_header.vvtCount > CAPTURE_MAX_CHANNELS) {
+		return false;
+	}
+
+	m_data = data;
+	m_size = size;
+	m_position = sizeof(capture_header_s);
+	m_edgeIndex = 0;
+	m_timeNs = m_header.startTimeNs;
+	m_state = m_header.initialState;
+	return true;
+}
+
+bool BinaryCaptureReader::readEdge(CaptureEdge *edge) {
+	if (!haveMore()) {
+		return false;
+	}
+
+	uint64_t value = 0;
+	int shift = 0;
+	while (true) {
+		if (m_position >= m_size || shift > 63) {
+			// truncated capture
+			m_edgeIndex = m_header.edgeCount;
+			return false;
+		}
+		uint8_t b = m_data[m_position++];
+		value |= (uint64_t)(b & 0x7F) << shift;
+		if (!(b & 0x80)) {
+			break;
+		}
+		shift += 7;
+	}
+
+	uint8_t channel = value & (CAPTURE_MAX_CHANNELS - 1);
+	m_timeNs += value >> CAPTURE_CHANNEL_BITS;
+	m_state ^= 1 << channel;
+	m_edgeIndex++;
+
+	edge->timeNs = m_timeNs;
+	edge->channel = channel;
+	edge->state = m_state & (1 << channel);
+	return true;
+}
+
+void BinaryCaptureReader::processEdge(EngineTestHelper *eth) {
+	CaptureEdge edge;
+	if (!readEdge(&edge)) {
+		firmwareError(OBD_PCM_Processor_Fault, "End of capture");
+		return;
+	}
+
+	eth->setTimeAndInvokeEventsUs(edge.timeNs / 1000);
+	efitick_t nowNt = getTimeNowNt();
+
+	if (edge.channel < m_header.triggerCount) {
+		hwHandleShaftSignal(edge.channel, edge.state, nowNt);
+	} else {
+		trigger_value_e event = edge.state ^ engineConfiguration->invertCamVVTSignal ? TV_RISE : TV_FALL;
+		int bankIndex = edge.channel - m_header.triggerCount;
+		int camIndex = 0;
+		hwHandleVvtCamSignal(event, nowNt, bankIndex * 2 + camIndex);
+	}
+}
@@ -0,0 +1,96 @@
+/*
+ * @file logicdata_binary.h
+ *
+ * Compact binary format for logic analyzer trigger captures, replayed much faster than CSV.
+ *
+ * Layout: fixed header followed by one record per edge. Each record is a LEB128 varint of
+ * (deltaNs << CAPTURE_CHANNEL_BITS) | channel, where deltaNs is the time since the previous edge
+ * on any channel and the edge toggles the state of 'channel'. Trigger channels come first,
+ * VVT channels follow.
+ */
+
+#pragma once
+
+#include <vector>
+
+#define CAPTURE_MAGIC 0x42435252 /* 'RRCB' */
+#define CAPTURE_VERSION 1
+#define CAPTURE_CHANNEL_BITS 3
+#define CAPTURE_MAX_CHANNELS (1 << CAPTURE_CHANNEL_BITS)
+
+struct capture_header_s {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t triggerCount;
+	uint32_t vvtCount;
+	// bit per channel
+	uint32_t initialState;
+	uint32_t reserved;
+	uint64_t edgeCount;
+	// absolute time of the first record delta base
+	int64_t startTimeNs;
+};
+
+static_assert(sizeof(capture_header_s) == 32);
+
+struct CaptureEdge {
+	int64_t timeNs;
+	uint8_t channel;
+	bool state;
+};
+
+/**
+ * Converts a CSV capture as consumed by CsvReader into the binary format
+ * @return number of edges written, or -1 on error including timestamps which go backwards
+ */
+int64_t convertCsvToBinaryCapture(const char *csvFileName, const char *binaryFileName,
+		size_t triggerCount, size_t vvtCount, const int *columnIndeces, double timestampOffset = 0);
+
+class BinaryCaptureReader {
+public:
+	~BinaryCaptureReader();
+
+	bool open(const char *fileName);
+	/**
+	 * Uses an in-memory capture instead of a file, buffer has to outlive the reader
+	 */
+	bool open(const uint8_t *data, size_t size);
+
+	bool haveMore() const {
+		return m_edgeIndex < m_header.edgeCount;
+	}
+
+	/**
+	 * Decodes next edge without feeding it anywhere
+	 */
+	bool readEdge(CaptureEdge *edge);
+
+	/**
+	 * Decodes next edge and feeds it into the engine, same semantics as CsvReader::processLine
+	 */
+	void processEdge(EngineTestHelper *eth);
+
+	const capture_header_s& header() const {
+		return m_header;
+	}
+
+	uint64_t edgeIndex() const {
+		return m_edgeIndex;
+	}
+
+private:
+	void close();
+
+	capture_header_s m_header{};
+
+	const uint8_t *m_data = nullptr;
+	size_t m_size = 0;
+	size_t m_position = 0;
+
+	bool m_ownsMapping = false;
+	std::vector<uint8_t> m_fallbackBuffer;
+
+	uint64_t m_edgeIndex = 0;
+	int64_t m_timeNs = 0;
+	uint32_t m_state = 0;
+};
@@ -54,15 +54,10 @@ double CsvReader::readTimestampAndValues(double *v) {
 	return timeStamp;
 }
 
-void CsvReader::processLine(EngineTestHelper *eth) {
-	Engine *engine = &eth->engine;
-
+bool CsvReader::parseLine(double *timeStamp, bool *newState, bool *newVvtState) {
 	const char s[2] = ",";
 	char *timeStampstr = trim(strtok(buffer, s));
 
-	bool newState[TRIGGER_INPUT_PIN_COUNT];
-	bool newVvtState[CAM_INPUTS_COUNT];
-
 	for (size_t i = 0;i<m_triggerCount;i++) {
 		char * triggerToken = trim(strtok(nullptr, s));
 		newState[columnIndeces[i]] = triggerToken[0] == '1';
@@ -74,13 +69,22 @@ void CsvReader::processLine(EngineTestHelper *eth) {
 	}
 
 	if (timeStampstr == nullptr) {
-		firmwareError(OBD_PCM_Processor_Fault, "End of File");
-		return;
+		return false;
 	}
 
-	double timeStamp = std::stod(timeStampstr);
+	*timeStamp = std::stod(timeStampstr) + m_timestampOffset;
+	return true;
+}
+
+void CsvReader::processLine(EngineTestHelper *eth) {
+	bool newState[TRIGGER_INPUT_PIN_COUNT];
+	bool newVvtState[CAM_INPUTS_COUNT];
+	double timeStamp;
 
-	timeStamp += m_timestampOffset;
+	if (!parseLine(&timeStamp, newState, newVvtState)) {
+		firmwareError(OBD_PCM_Processor_Fault, "End of File");
+		return;
+	}
 
 	eth->setTimeAndInvokeEventsUs(1'000'000 * timeStamp);
 	for (size_t index = 0; index < m_triggerCount; index++) {
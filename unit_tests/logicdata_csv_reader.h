@@ -18,6 +18,11 @@ public:
 	void open(const char *fileName, const int* columnIndeces);
 	bool haveMore();
 	void processLine(EngineTestHelper *eth);
+	/**
+	 * Parses current line without feeding it anywhere
+	 * @return false on malformed line
+	 */
+	bool parseLine(double *timeStamp, bool *newState, bool *newVvtState);
 	void readLine(EngineTestHelper *eth);
 	double readTimestampAndValues(double *v);
 
@@ -25,6 +30,14 @@ public:
 		return m_lineIndex;
 	}
 
+	size_t triggerCount() const {
+		return m_triggerCount;
+	}
+
+	size_t vvtCount() const {
+		return m_vvtCount;
+	}
+
 private:
 	const size_t m_triggerCount;
 	const size_t m_vvtCount;
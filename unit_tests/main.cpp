@@ -7,6 +7,7 @@
 
 
 #include "pch.h"
+#include "trigger_benchmark.h"
 #include <stdlib.h>
 
 bool hasInitGtest = false;
@@ -14,6 +15,23 @@ bool hasInitGtest = false;
 GTEST_API_ int main(int argc, char **argv) {
 	hasInitGtest = true;
 
+	if (argc > 1 && strcmp(argv[1], "--trigger-benchmark") == 0) {
+		TriggerBenchmarkConfig config;
+		printTriggerBenchmarkReport(config);
+
+		config.jitter = 0.05;
+		config.noiseProbability = 0.01;
+		config.seed = 1;
+		printTriggerBenchmarkReport(config);
+		return 0;
+	}
+
+	if (argc > 1 && strcmp(argv[1], "--trigger-fuzz") == 0) {
+		int iterations = argc > 2 ? atoi(argv[2]) : 1000;
+		uint32_t seed = argc > 3 ? atoi(argv[3]) : 0;
+		return runTriggerFuzz(iterations, seed);
+	}
+
 	testing::InitGoogleTest(&argc, argv);
 	// uncomment if you only want to run selected tests
 	/**
@@ -24,6 +24,7 @@ public:
 	MOCK_METHOD(void, setIdlePosition, (percent_t pos), (override));
 	MOCK_METHOD(void, setWastegatePosition, (percent_t pos), (override));
 	MOCK_METHOD(void, autoCalibrateTps, (), (override));
+	MOCK_METHOD(void, startSystemIdentification, (SysIdExcitation excitation), (override));
 	MOCK_METHOD(const pid_state_s*, getPidState, (), (const, override));
 	MOCK_METHOD(void, setLuaAdjustment, (percent_t adjustment), (override));
 
@@ -1,6 +1,8 @@
 FRAMEWORK_SRC_CPP = unit_test_framework.cpp \
 	engine_test_helper.cpp \
 	logicdata_csv_reader.cpp \
+	logicdata_binary.cpp \
+	trigger_benchmark.cpp \
 	boards.cpp \
 	global_execution_queue.cpp \
 	test_basic_math/test_find_index.cpp \
@@ -15,6 +15,7 @@
 
 using ::testing::_;
 using ::testing::Ne;
+using ::testing::NiceMock;
 using ::testing::StrictMock;
 
 TEST(etb, initializationNoPedal) {
@@ -778,3 +779,98 @@ TEST(etb, openLoopNonThrottle) {
 	EXPECT_EQ(0, etb.getOpenLoop(75).value_or(-1));
 	EXPECT_EQ(0, etb.getOpenLoop(100).value_or(-1));
 }
+
+TEST(etb, systemIdentification) {
+	EngineTestHelper eth(TEST_ENGINE);
+	NiceMock<MockMotor> motor;
+
+	float duty = 0;
+	ON_CALL(motor, set(_)).WillByDefault([&](float value) {
+		duty = value;
+		return true;
+	});
+
+	// identification asks for the motor with the engine stopped anyway
+	engineConfiguration->disableEtbWhenEngineStopped = true;
+	engineConfiguration->etb.pFactor = 2;
+	engineConfiguration->etb.iFactor = 40;
+	engineConfiguration->etb.dFactor = 0;
+	engineConfiguration->etb.minValue = -90;
+	engineConfiguration->etb.maxValue = 90;
+
+	// Must have TPS & PPS initialized for ETB setup
+	Sensor::setMockValue(SensorType::Tps1Primary, 0);
+	Sensor::setMockValue(SensorType::Tps1, 10.0f, true);
+	Sensor::setMockValue(SensorType::AcceleratorPedal, 0.0f, true);
+
+	EtbController etb;
+	etb.init(ETB_Throttle1, &motor, &engineConfiguration->etb, nullptr, true);
+	engine->etbAutoTune = false;
+
+	etb.startSystemIdentification(SysIdExcitation::Step);
+
+	// Throttle: 1.5% position per % duty, 10% with no duty, 40ms time constant, two loops of dead time
+	constexpr float a = 0.951229f; // exp(-2ms / 40ms)
+	float delayed[2] = {};
+	float position = 10;
+
+	for (int i = 0; i < 4 * ETB_LOOP_FREQUENCY && etb.getSystemIdentification().isRunning(); i++) {
+		Sensor::setMockValue(SensorType::Tps1, position, true);
+		etb.update();
+
+		position = a * position + (1 - a) * (10 + 1.5f * delayed[1]);
+		delayed[1] = delayed[0];
+		delayed[0] = 100 * duty;
+	}
+
+	const auto& sysId = etb.getSystemIdentification();
+	ASSERT_EQ(SysIdState::Done, sysId.getState()) << getSysIdFailureName(sysId.getResult().failure);
+
+	// held at 50% before the excitation
+	EXPECT_NEAR(50, sysId.getOperatingObservation(), 1);
+
+	const auto& result = sysId.getResult();
+	EXPECT_NEAR(1.5f, result.gain, 0.1f);
+	EXPECT_NEAR(0.04f, result.timeConstant, 0.004f);
+	EXPECT_NEAR(0.005f, result.deadTime, 0.0021f);
+
+	// gains are handed to TunerStudio one after the other
+	etb.update();
+	EXPECT_EQ((uint8_t)TsCalMode::EtbKp, engine->outputChannels.calibrationMode);
+	EXPECT_EQ(result.pFactor, engine->outputChannels.calibrationValue);
+
+	for (int i = 0; i < ETB_LOOP_FREQUENCY / 2; i++) {
+		etb.update();
+	}
+	EXPECT_EQ((uint8_t)TsCalMode::EtbKi, engine->outputChannels.calibrationMode);
+	EXPECT_EQ(result.iFactor, engine->outputChannels.calibrationValue);
+
+	for (int i = 0; i < ETB_LOOP_FREQUENCY; i++) {
+		etb.update();
+	}
+	EXPECT_EQ((uint8_t)TsCalMode::None, engine->outputChannels.calibrationMode);
+}
+
+TEST(etb, systemIdentificationAbortedByEngine) {
+	EngineTestHelper eth(TEST_ENGINE);
+	NiceMock<MockMotor> motor;
+
+	engineConfiguration->disableEtbWhenEngineStopped = false;
+
+	// Must have TPS & PPS initialized for ETB setup
+	Sensor::setMockValue(SensorType::Tps1Primary, 0);
+	Sensor::setMockValue(SensorType::Tps1, 50.0f, true);
+	Sensor::setMockValue(SensorType::AcceleratorPedal, 0.0f, true);
+
+	EtbController etb;
+	etb.init(ETB_Throttle1, &motor, &engineConfiguration->etb, nullptr, true);
+	engine->etbAutoTune = false;
+
+	etb.startSystemIdentification(SysIdExcitation::Chirp);
+	etb.update();
+	EXPECT_TRUE(etb.getSystemIdentification().isRunning());
+
+	Sensor::setMockValue(SensorType::Rpm, 800);
+	etb.update();
+	EXPECT_EQ(SysIdFailure::Aborted, etb.getSystemIdentification().getResult().failure);
+}
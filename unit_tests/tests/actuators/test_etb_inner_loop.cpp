@@ -0,0 +1,234 @@
+/**
+ * @file test_etb_inner_loop.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "electronic_throttle_impl.h"
+#include "dc_motor.h"
+#include "mocks.h"
+
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::StrictMock;
+
+#define INNER_PERIOD 0.0004f
+
+static pid_s makePid(float p) {
+	pid_s pid = {};
+	pid.pFactor = p;
+	pid.minValue = -60;
+	pid.maxValue = 75;
+	return pid;
+}
+
+TEST(EtbInnerLoop, Position) {
+	pid_s pid = makePid(1);
+
+	EtbInnerLoop dut;
+	dut.configure(pid, INNER_PERIOD, -100, 100, 2000, 12000);
+
+	EXPECT_EQ(0, dut.getPosition(2000));
+	EXPECT_EQ(5000, dut.getPosition(7000));
+	EXPECT_EQ(10000, dut.getPosition(12000));
+	// outside the calibration is not clamped, the outer loop owns range checks
+	EXPECT_EQ(-1000, dut.getPosition(1000));
+
+	// inverted sensor
+	dut.configure(pid, INNER_PERIOD, -100, 100, 12000, 2000);
+	EXPECT_EQ(2500, dut.getPosition(9500));
+}
+
+TEST(EtbInnerLoop, Command) {
+	pid_s pid = makePid(2);
+
+	EtbInnerLoop dut;
+	dut.configure(pid, INNER_PERIOD, -100, 100, 0, 10000);
+
+	// nothing until the outer loop hands over
+	EXPECT_FALSE(dut.update(5000).Valid);
+
+	dut.setCommand(60, 10);
+	EXPECT_TRUE(dut.isRunning());
+	// 10% feed forward plus 2 * 10% error
+	EXPECT_NEAR(30, dut.update(5000).value_or(0), 1e-3);
+
+	dut.setCommand(40, -5);
+	EXPECT_NEAR(-25, dut.update(5000).value_or(0), 1e-3);
+
+	dut.stop();
+	EXPECT_FALSE(dut.update(5000).Valid);
+}
+
+TEST(EtbInnerLoop, IntegratorResetOnTakeover) {
+	pid_s pid = makePid(0);
+	pid.iFactor = 100;
+
+	EtbInnerLoop dut;
+	dut.configure(pid, INNER_PERIOD, -100, 100, 0, 10000);
+
+	dut.setCommand(60, 0);
+	for (int i = 0; i < 100; i++) {
+		dut.update(5000);
+	}
+	EXPECT_GT(dut.getPid().getIntegrator(), 0);
+
+	dut.stop();
+	dut.update(5000);
+	dut.setCommand(50, 0);
+	dut.update(5000);
+	EXPECT_EQ(0, dut.getPid().getIntegrator());
+}
+
+TEST(EtbInnerLoop, Uncalibrated) {
+	pid_s pid = makePid(1);
+
+	EtbInnerLoop dut;
+	dut.configure(pid, INNER_PERIOD, -100, 100, 4000, 4001);
+
+	dut.setCommand(50, 0);
+	EXPECT_FALSE(dut.update(4000).Valid);
+}
+
+TEST(EtbLoopStats, PeriodAndExec) {
+	EtbLoopStats stats;
+	stats.budgetUs = 10;
+
+	// first run only has execution time
+	stats.onRun(US2NT(1000), US2NT(1004));
+	EXPECT_EQ(0u, stats.count);
+	EXPECT_FLOAT_EQ(4, stats.maxExecUs);
+
+	stats.onRun(US2NT(1400), US2NT(1403));
+	stats.onRun(US2NT(1790), US2NT(1802));
+	stats.onRun(US2NT(2200), US2NT(2205));
+
+	EXPECT_EQ(3u, stats.count);
+	EXPECT_FLOAT_EQ(390, stats.minPeriodUs);
+	EXPECT_FLOAT_EQ(410, stats.maxPeriodUs);
+	EXPECT_FLOAT_EQ(10, stats.getJitterUs(400));
+	EXPECT_FLOAT_EQ(5, stats.lastExecUs);
+	EXPECT_FLOAT_EQ(12, stats.maxExecUs);
+	EXPECT_EQ(1u, stats.overBudgetCount);
+
+	// period across a reset is still measured
+	stats.reset();
+	stats.onRun(US2NT(2600), US2NT(2601));
+	EXPECT_EQ(1u, stats.count);
+	EXPECT_FLOAT_EQ(400, stats.minPeriodUs);
+	EXPECT_EQ(0u, stats.overBudgetCount);
+}
+
+TEST(etb, innerLoopOwnsMotor) {
+	EngineTestHelper eth(TEST_ENGINE);
+	StrictMock<MockMotor> motor;
+
+	engineConfiguration->etbFastInnerLoop = true;
+	engineConfiguration->disableEtbWhenEngineStopped = false;
+	engineConfiguration->etb.pFactor = 2;
+	engineConfiguration->etb.minValue = -60;
+	engineConfiguration->etb.maxValue = 75;
+	engineConfiguration->adcVcc = 5;
+	engineConfiguration->analogInputDividerCoefficient = 1;
+	// 0.5V to 4.5V
+	engineConfiguration->tpsMin = 100;
+	engineConfiguration->tpsMax = 900;
+
+	// Must have TPS & PPS initialized for ETB setup
+	Sensor::setMockValue(SensorType::Tps1Primary, 0);
+	Sensor::setMockValue(SensorType::Tps1, 30.0f, true);
+	Sensor::setMockValue(SensorType::AcceleratorPedal, 0.0f, true);
+
+	StrictMock<MockVp3d> pedalMap;
+	EXPECT_CALL(pedalMap, getValue(_, _)).WillRepeatedly(Return(40));
+
+	EtbController etb;
+	etb.init(ETB_Throttle1, &motor, &engineConfiguration->etb, &pedalMap, true);
+	engine->etbAutoTune = false;
+
+	// outer loop enables the motor but leaves the duty to the inner loop
+	EXPECT_CALL(motor, enable());
+	etb.update();
+	EXPECT_TRUE(etb.isInnerLoopActive());
+	EXPECT_TRUE(etb.getInnerLoop().isRunning());
+
+	// 2.5V is 50%: 10% error, no feed forward curve
+	uint32_t raw = ETB_INNER_LOOP_SAMPLES * voltsToAdc(2.5f);
+	float feedForward = interpolate2d(40, config->etbBiasBins, config->etbBiasValues);
+	EXPECT_CALL(motor, set(testing::FloatNear(0.01f * (feedForward - 20), 0.005f))).WillOnce(Return(false));
+	etb.updateInnerLoop(raw, 0);
+
+	// limp takes the motor back
+	engineConfiguration->pauseEtbControl = true;
+	EXPECT_CALL(motor, disable());
+	etb.update();
+	EXPECT_FALSE(etb.getInnerLoop().isRunning());
+
+	// no duty from a stopped inner loop
+	etb.updateInnerLoop(raw, 0);
+}
+
+static void setInnerLoopThrottle() {
+	engineConfiguration->disableEtbWhenEngineStopped = false;
+	engineConfiguration->etb.pFactor = 2;
+	engineConfiguration->etb.minValue = -60;
+	engineConfiguration->etb.maxValue = 75;
+	engineConfiguration->tpsMin = 100;
+	engineConfiguration->tpsMax = 900;
+
+	Sensor::setMockValue(SensorType::Tps1Primary, 0);
+	Sensor::setMockValue(SensorType::AcceleratorPedal, 0.0f, true);
+	engine->etbAutoTune = false;
+}
+
+TEST(etb, innerLoopLatchedAtInit) {
+	EngineTestHelper eth(TEST_ENGINE);
+	NiceMock<MockMotor> motor;
+	setInnerLoopThrottle();
+	Sensor::setMockValue(SensorType::Tps1, 30.0f, true);
+
+	StrictMock<MockVp3d> pedalMap;
+	EXPECT_CALL(pedalMap, getValue(_, _)).WillRepeatedly(Return(40));
+
+	engineConfiguration->etbFastInnerLoop = false;
+	EtbController etb;
+	etb.init(ETB_Throttle1, &motor, &engineConfiguration->etb, &pedalMap, true);
+
+	// TPS is not on the fast ADC until the next boot
+	engineConfiguration->etbFastInnerLoop = true;
+	etb.update();
+	EXPECT_FALSE(etb.isInnerLoopActive());
+	EXPECT_FALSE(etb.getInnerLoop().isRunning());
+}
+
+TEST(etb, innerLoopErrorLimp) {
+	EngineTestHelper eth(TEST_ENGINE);
+	NiceMock<MockMotor> motor;
+	setInnerLoopThrottle();
+	engineConfiguration->etbFastInnerLoop = true;
+	// throttle does not follow at all
+	Sensor::setMockValue(SensorType::Tps1, 0.0f, true);
+
+	StrictMock<MockVp3d> pedalMap;
+	EXPECT_CALL(pedalMap, getValue(_, _)).WillRepeatedly(Return(40));
+
+	EtbController etb;
+	etb.init(ETB_Throttle1, &motor, &engineConfiguration->etb, &pedalMap, true);
+
+	etb.update();
+	ASSERT_TRUE(etb.isInnerLoopActive());
+	ASSERT_TRUE(engine->limpManager.allowElectronicThrottle());
+
+	// 10 percent-seconds of error, a few seconds at the outer loop rate
+	for (int i = 0; i < 5 * ETB_LOOP_FREQUENCY && engine->limpManager.allowElectronicThrottle(); i++) {
+		etb.update();
+	}
+
+	EXPECT_FALSE(engine->limpManager.allowElectronicThrottle());
+
+	// and the motor is taken away from the inner loop
+	etb.update();
+	EXPECT_FALSE(etb.getInnerLoop().isRunning());
+}
@@ -0,0 +1,122 @@
+/**
+ * @file test_cylinder_trims.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "cylinder_trims.h"
+#include "fuel_math.h"
+#include "advance_map.h"
+
+#include <chrono>
+
+static void setTrimTables() {
+	static const uint16_t loadBins[] = { 20, 50, 80, 110 };
+	static const uint16_t rpmBins[] = { 1000, 3000, 5000, 7000 };
+
+	copyArray(config->fuelTrimLoadBins, loadBins);
+	copyArray(config->fuelTrimRpmBins, rpmBins);
+	copyArray(config->ignTrimLoadBins, loadBins);
+	copyArray(config->ignTrimRpmBins, rpmBins);
+
+	for (size_t i = 0; i < MAX_CYLINDER_COUNT; i++) {
+		for (size_t row = 0; row < TRIM_SIZE; row++) {
+			for (size_t col = 0; col < TRIM_SIZE; col++) {
+				config->fuelTrims[i].table[row][col] = ((i * 7 + row * 3 + col * 5) % 20) - 10;
+				config->ignTrims[i].table[row][col] = ((i * 3 + row * 5 + col * 7) % 12) - 6;
+			}
+		}
+	}
+}
+
+static void expectSameAsSingle(size_t cylinderCount, int rpm, float load) {
+	CylinderTrims trims;
+	getCylinderTrims(trims, cylinderCount, rpm, load, load);
+
+	for (size_t i = 0; i < cylinderCount; i++) {
+		EXPECT_NEAR(getCylinderFuelTrim(i, rpm, load), trims.fuel[i], EPS5D) << i << " at " << rpm << "/" << load;
+		EXPECT_NEAR(getCylinderIgnitionTrim(i, rpm, load), trims.ignition[i], EPS5D) << i << " at " << rpm << "/" << load;
+	}
+}
+
+TEST(CylinderTrims, SameAsSingleCylinder) {
+	EngineTestHelper eth(TEST_ENGINE);
+	setTrimTables();
+
+	// inside the table, on the bins, and clamped on each side
+	expectSameAsSingle(MAX_CYLINDER_COUNT, 2200, 63);
+	expectSameAsSingle(MAX_CYLINDER_COUNT, 3000, 50);
+	expectSameAsSingle(MAX_CYLINDER_COUNT, 500, 10);
+	expectSameAsSingle(MAX_CYLINDER_COUNT, 9000, 150);
+	expectSameAsSingle(MAX_CYLINDER_COUNT, 6999, 21);
+	expectSameAsSingle(4, 4000, 95);
+}
+
+TEST(CylinderTrims, PeriodicUsesBatch) {
+	EngineTestHelper eth(TEST_ENGINE);
+	setTrimTables();
+	engineConfiguration->specs.cylindersCount = 8;
+
+	engine->periodicFastCallback();
+
+	int rpm = Sensor::getOrZero(SensorType::Rpm);
+	float advance = engine->engineState.timingAdvance[0] - getCylinderIgnitionTrim(0, rpm, getIgnitionLoad());
+
+	for (size_t i = 0; i < 8; i++) {
+		EXPECT_NEAR(advance + getCylinderIgnitionTrim(i, rpm, getIgnitionLoad()), engine->engineState.timingAdvance[i], EPS4D) << i;
+	}
+}
+
+// best of a few runs, so that a single scheduler hiccup does not decide the comparison
+template <typename TFunc>
+static double timeIt(int count, TFunc func) {
+	double best = 1e9;
+
+	for (int run = 0; run < 5; run++) {
+		auto start = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < count; i++) {
+			func(i);
+		}
+
+		best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	return best;
+}
+
+TEST(CylinderTrims, Benchmark) {
+	EngineTestHelper eth(TEST_ENGINE);
+	setTrimTables();
+
+	const int count = 20000;
+	volatile float sink = 0;
+
+	for (size_t cylinderCount : { 4, 8, 12 }) {
+		double single = timeIt(count, [&](int i) {
+			int rpm = 1000 + (i & 0xFFF);
+			float load = 20 + (i & 0x3F);
+
+			for (size_t cyl = 0; cyl < cylinderCount; cyl++) {
+				sink = sink + getCylinderFuelTrim(cyl, rpm, load) + getCylinderIgnitionTrim(cyl, rpm, load);
+			}
+		});
+
+		double batched = timeIt(count, [&](int i) {
+			int rpm = 1000 + (i & 0xFFF);
+			float load = 20 + (i & 0x3F);
+
+			CylinderTrims trims;
+			getCylinderTrims(trims, cylinderCount, rpm, load, load);
+
+			for (size_t cyl = 0; cyl < cylinderCount; cyl++) {
+				sink = sink + trims.fuel[cyl] + trims.ignition[cyl];
+			}
+		});
+
+		// batched does four bin searches in total, one by one does four per cylinder
+		EXPECT_LT(batched, single) << cylinderCount << " cylinders";
+	}
+}
@@ -0,0 +1,181 @@
+/**
+ * @file test_event_sync_calc.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+using ::testing::_;
+
+static void setTrims() {
+	setTable(config->fuelTrims[0].table, -4);
+	setTable(config->fuelTrims[1].table, -2);
+	setTable(config->fuelTrims[2].table,  2);
+	setTable(config->fuelTrims[3].table,  4);
+
+	setTable(config->ignitionTable, 15);
+	setTable(config->ignTrims[0].table, -4);
+	setTable(config->ignTrims[1].table, -2);
+	setTable(config->ignTrims[2].table,  2);
+	setTable(config->ignTrims[3].table,  4);
+}
+
+static void clearCylinders() {
+	for (size_t i = 0; i < MAX_CYLINDER_COUNT; i++) {
+		engine->injectionMass[i] = 0;
+		engine->engineState.timingAdvance[i] = 0;
+	}
+}
+
+// one degree of advance per 100 rpm so that a changing RPM shows up in the table lookup
+static void setRpmDependentTiming() {
+	setLinearCurve(config->ignitionRpmBins, 1000, 8500, 1);
+	for (size_t load = 0; load < IGN_LOAD_COUNT; load++) {
+		for (size_t rpm = 0; rpm < IGN_RPM_COUNT; rpm++) {
+			config->ignitionTable[load][rpm] = config->ignitionRpmBins[rpm] / 100;
+		}
+	}
+}
+
+TEST(EventSyncCalc, SameResultAsPeriodic) {
+	EngineTestHelper eth(TEST_ENGINE);
+
+	EXPECT_CALL(*eth.mockAirmass, getAirmass(_))
+		.WillRepeatedly(Return(AirmassResult{1, 50.0f}));
+	setTrims();
+	engine->rpmCalculator.setRpmValue(1000);
+
+	// reference values from the regular 200Hz calculation
+	engine->periodicFastCallback();
+	float expectedMass[4];
+	float expectedAdvance[4];
+	for (size_t i = 0; i < 4; i++) {
+		expectedMass[i] = engine->injectionMass[i];
+		expectedAdvance[i] = engine->engineState.timingAdvance[i];
+	}
+	ASSERT_NE(expectedMass[0], expectedMass[3]);
+	EXPECT_NEAR(expectedAdvance[3], 15 + 4, EPS4D);
+
+	engineConfiguration->eventSyncFuelSpark = true;
+	ASSERT_TRUE(engine->engineState.isEventSyncActive());
+	clearCylinders();
+
+	// fuel stays periodic, timing is still filled in case the trigger path does not get to a cylinder
+	engine->periodicFastCallback();
+	for (size_t i = 0; i < 4; i++) {
+		EXPECT_NEAR(expectedMass[i], engine->injectionMass[i], EPS4D);
+		EXPECT_NEAR(expectedAdvance[i], engine->engineState.timingAdvance[i], EPS4D);
+	}
+
+	// only the cylinder which is about to fire gets refreshed
+	clearCylinders();
+	engine->engineState.eventSyncStats.reset();
+	engine->engineState.updateCylinderTiming(1);
+
+	EXPECT_NEAR(expectedAdvance[1], engine->engineState.timingAdvance[1], EPS4D);
+	EXPECT_EQ(0, engine->engineState.timingAdvance[2]);
+	EXPECT_EQ(0, engine->injectionMass[1]);
+
+	EXPECT_EQ(1u, engine->engineState.eventSyncStats.count);
+}
+
+TEST(EventSyncCalc, FollowsRpmBetweenPeriodicCalculations) {
+	EngineTestHelper eth(TEST_ENGINE);
+
+	EXPECT_CALL(*eth.mockAirmass, getAirmass(_))
+		.WillRepeatedly(Return(AirmassResult{1, 50.0f}));
+	setTrims();
+	setRpmDependentTiming();
+	engineConfiguration->eventSyncFuelSpark = true;
+
+	engine->rpmCalculator.setRpmValue(2000);
+	engine->periodicFastCallback();
+	float periodicAdvance = engine->engineState.timingAdvance[3];
+	float correction = periodicAdvance - 20;
+
+	// engine accelerates before the next periodic calculation
+	engine->rpmCalculator.setRpmValue(3000);
+	engine->engineState.updateCylinderTiming(3);
+
+	// new table value, same corrections and trim
+	EXPECT_NEAR(30 + correction, engine->engineState.timingAdvance[3], EPS4D);
+}
+
+TEST(EventSyncCalc, TimingEventDoesNotStepCorrections) {
+	EngineTestHelper eth(TEST_ENGINE);
+
+	EXPECT_CALL(*eth.mockAirmass, getAirmass(_))
+		.WillRepeatedly(Return(AirmassResult{1, 50.0f}));
+	setTrims();
+	engineConfiguration->eventSyncFuelSpark = true;
+	engine->rpmCalculator.setRpmValue(1000);
+	engine->periodicFastCallback();
+
+	// corrections and their outputs belong to the periodic calculation
+	engine->engineState.timingIatCorrection = 3;
+	engine->engineState.timingPidCorrection = -3;
+
+	for (size_t i = 0; i < 4; i++) {
+		engine->engineState.updateCylinderTiming(i);
+	}
+
+	EXPECT_NEAR(3, engine->engineState.timingIatCorrection, EPS4D);
+	EXPECT_NEAR(-3, engine->engineState.timingPidCorrection, EPS4D);
+}
+
+TEST(EventSyncCalc, WaitsForPeriodicSplit) {
+	EngineTestHelper eth(TEST_ENGINE);
+
+	EXPECT_CALL(*eth.mockAirmass, getAirmass(_))
+		.WillRepeatedly(Return(AirmassResult{1, 50.0f}));
+	setTrims();
+	engine->rpmCalculator.setRpmValue(1000);
+	engine->periodicFastCallback();
+	float expectedAdvance = engine->engineState.timingAdvance[0];
+
+	// enabled after the last periodic calculation, which did not split table and corrections
+	engineConfiguration->eventSyncFuelSpark = true;
+	engine->engineState.updateCylinderTiming(0);
+
+	EXPECT_NEAR(expectedAdvance, engine->engineState.timingAdvance[0], EPS4D);
+}
+
+TEST(EventSyncCalc, PeriodicUntilRunning) {
+	EngineTestHelper eth(TEST_ENGINE);
+
+	EXPECT_CALL(*eth.mockAirmass, getAirmass(_))
+		.WillRepeatedly(Return(AirmassResult{1, 50.0f}));
+	setTrims();
+	engineConfiguration->eventSyncFuelSpark = true;
+
+	// stopped and cranking engine has no trigger events to hook on to
+	engine->rpmCalculator.setRpmValue(0);
+	EXPECT_FALSE(engine->engineState.isEventSyncActive());
+	engine->periodicFastCallback();
+	EXPECT_NE(0, engine->injectionMass[0]);
+	EXPECT_NEAR(15 - 4, engine->engineState.timingAdvance[0], EPS4D);
+
+	engine->rpmCalculator.setRpmValue(1000);
+	EXPECT_TRUE(engine->engineState.isEventSyncActive());
+
+	engineConfiguration->eventSyncFuelSpark = false;
+	EXPECT_FALSE(engine->engineState.isEventSyncActive());
+}
+
+TEST(EventSyncCalc, Budget) {
+	EventSyncCalcStats stats;
+
+	stats.onCalculation(US2NT(EVENT_SYNC_CALC_BUDGET_US / 2));
+	stats.onCalculation(US2NT(EVENT_SYNC_CALC_BUDGET_US + 5));
+	stats.onCalculation(US2NT(1));
+
+	EXPECT_EQ(3u, stats.count);
+	EXPECT_EQ(1u, stats.lastUs);
+	EXPECT_EQ((uint32_t)EVENT_SYNC_CALC_BUDGET_US + 5, stats.maxUs);
+	EXPECT_EQ(1u, stats.overBudgetCount);
+
+	stats.reset();
+	EXPECT_EQ(0u, stats.count);
+	EXPECT_EQ(0u, stats.maxUs);
+}
@@ -0,0 +1,183 @@
+/**
+ * @file test_tooth_plan.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "tooth_plan.h"
+
+static void expectSameAsLookup(const event_trigger_position_s& actual, angle_t angle) {
+	event_trigger_position_s expected;
+	expected.setAngle(angle);
+
+	EXPECT_EQ(expected.triggerEventIndex, actual.triggerEventIndex) << angle;
+	EXPECT_NEAR(expected.angleOffsetFromTriggerEvent, actual.angleOffsetFromTriggerEvent, EPS4D) << angle;
+}
+
+TEST(ToothPlan, SameAsLookup) {
+	EngineTestHelper eth(TEST_ENGINE);
+	eth.setTriggerType(TT_TOOTHED_WHEEL_60_2);
+
+	ToothPlan plan;
+	event_trigger_position_s position;
+
+	// slow drift, like advance following RPM, goes across several teeth
+	for (angle_t angle = 100; angle < 160; angle += 0.37f) {
+		plan.place(0, ToothAction::Spark, angle, position);
+		expectSameAsLookup(position, angle);
+	}
+
+	// most of them did not need a lookup
+	EXPECT_GT(plan.getReuseCount(), plan.getLookupCount());
+
+	// big jump is looked up again
+	plan.place(0, ToothAction::Spark, 160, position);
+	uint32_t lookups = plan.getLookupCount();
+	plan.place(0, ToothAction::Spark, 160 - TOOTH_PLAN_REPLAN_ANGLE - 0.5f, position);
+	EXPECT_EQ(lookups + 1, plan.getLookupCount());
+	expectSameAsLookup(position, 160 - TOOTH_PLAN_REPLAN_ANGLE - 0.5f);
+
+	// close to the end of the cycle
+	for (angle_t angle = 700; angle < 719.9f; angle += 0.37f) {
+		plan.place(1, ToothAction::Spark, angle, position);
+		expectSameAsLookup(position, angle);
+	}
+}
+
+TEST(ToothPlan, DwellCylinders) {
+	EngineTestHelper eth(TEST_ENGINE);
+	eth.setTriggerType(TT_TOOTHED_WHEEL_60_2);
+
+	ToothPlan plan;
+	event_trigger_position_s position;
+
+	plan.place(0, ToothAction::Dwell, 100, position);
+	size_t firstTooth = position.triggerEventIndex;
+	plan.place(2, ToothAction::Dwell, 100, position);
+	ASSERT_EQ(firstTooth, position.triggerEventIndex);
+
+	EXPECT_EQ(0b101, plan.getDwellCylinders(firstTooth));
+
+	// spark positions do not show up
+	plan.place(1, ToothAction::Spark, 100, position);
+	EXPECT_EQ(0b101, plan.getDwellCylinders(firstTooth));
+
+	// cylinder moves to another tooth
+	plan.place(2, ToothAction::Dwell, 200, position);
+	EXPECT_EQ(0b001, plan.getDwellCylinders(firstTooth));
+	EXPECT_EQ(0b100, plan.getDwellCylinders(position.triggerEventIndex));
+
+	plan.reset();
+	EXPECT_EQ(0, plan.getDwellCylinders(firstTooth));
+	EXPECT_EQ(0, plan.getDwellCylinders(TOOTH_PLAN_MAX_TEETH));
+}
+
+TEST(ToothPlan, TriggerOffsetChange) {
+	EngineTestHelper eth(TEST_ENGINE);
+	eth.setTriggerType(TT_TOOTHED_WHEEL_60_2);
+
+	ToothPlan plan;
+	event_trigger_position_s position;
+
+	plan.place(0, ToothAction::Dwell, 100, position);
+	plan.place(0, ToothAction::Dwell, 100.1f, position);
+	uint32_t lookups = plan.getLookupCount();
+
+	engineConfiguration->globalTriggerAngleOffset += 3;
+	plan.place(0, ToothAction::Dwell, 100.1f, position);
+
+	EXPECT_EQ(lookups + 1, plan.getLookupCount());
+	expectSameAsLookup(position, 100.1f);
+	EXPECT_EQ(1, plan.getDwellCylinders(position.triggerEventIndex));
+}
+
+/**
+ * Trigger handler work for a 60-2 wheel and eight cylinders: find the cylinders whose dwell
+ * starts on the tooth, position their spark and, once it fired, the next dwell.
+ * Counted instead of timed: cylinders looked at per tooth and tooth searches, both paths.
+ */
+TEST(ToothPlan, Benchmark) {
+	EngineTestHelper eth(TEST_ENGINE);
+	eth.setTriggerType(TT_TOOTHED_WHEEL_60_2);
+
+	const size_t cylinders = 8;
+	const size_t teeth = engine->triggerCentral.triggerShape.getLength();
+	const int cycles = 2000;
+
+	event_trigger_position_s dwell[cylinders];
+	event_trigger_position_s spark[cylinders];
+
+	auto getSpark = [](size_t cylinder, int cycle) {
+		// a little advance change every cycle
+		return (angle_t)(cylinder * 90 + 10 + (cycle % 50) * 0.05f);
+	};
+	auto getDwell = [&](size_t cylinder, int cycle) {
+		angle_t angle = getSpark(cylinder, cycle) - 40;
+		return angle < 0 ? angle + 720 : angle;
+	};
+
+	for (size_t i = 0; i < cylinders; i++) {
+		dwell[i].setAngle(getDwell(i, 0));
+	}
+
+	uint32_t lookupChecks = 0;
+	uint32_t lookupSearches = 0;
+
+	for (int cycle = 0; cycle < cycles; cycle++) {
+		for (size_t tooth = 0; tooth < teeth; tooth++) {
+			for (size_t i = 0; i < cylinders; i++) {
+				lookupChecks++;
+				if (dwell[i].triggerEventIndex != tooth) {
+					continue;
+				}
+
+				spark[i].setAngle(getSpark(i, cycle));
+				dwell[i].setAngle(getDwell(i, cycle + 1));
+				lookupSearches += 2;
+			}
+		}
+	}
+
+	ToothPlan plan;
+	for (size_t i = 0; i < cylinders; i++) {
+		plan.place(i, ToothAction::Dwell, getDwell(i, 0), dwell[i]);
+	}
+	uint32_t initialSearches = plan.getLookupCount();
+
+	uint32_t planChecks = 0;
+
+	for (int cycle = 0; cycle < cycles; cycle++) {
+		for (size_t tooth = 0; tooth < teeth; tooth++) {
+			uint16_t due = plan.getDwellCylinders(tooth);
+
+			for (size_t i = 0; due != 0; i++, due >>= 1) {
+				planChecks++;
+				if (!(due & 1)) {
+					continue;
+				}
+
+				plan.place(i, ToothAction::Spark, getSpark(i, cycle), spark[i]);
+				plan.place(i, ToothAction::Dwell, getDwell(i, cycle + 1), dwell[i]);
+			}
+		}
+	}
+
+	// the plan did the same work
+	for (size_t i = 0; i < cylinders; i++) {
+		expectSameAsLookup(spark[i], getSpark(i, cycles - 1));
+		expectSameAsLookup(dwell[i], getDwell(i, cycles));
+	}
+
+	uint32_t planSearches = plan.getLookupCount() - initialSearches;
+	EXPECT_EQ(lookupSearches, planSearches + plan.getReuseCount());
+
+	// without the plan every spark and dwell is searched for, with it only when the advance sweep
+	// crosses a tooth or jumps back
+	EXPECT_LT(planSearches * 10, lookupSearches);
+
+	// without the plan every tooth looks at every cylinder, with it only the teeth with a dwell on them
+	EXPECT_EQ((uint32_t)cycles * teeth * cylinders, lookupChecks);
+	EXPECT_LT(planChecks * 10, lookupChecks);
+}
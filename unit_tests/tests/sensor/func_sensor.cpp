@@ -66,3 +66,29 @@ TEST_F(SensorConverted, TestInvalid) {
 		EXPECT_FALSE(s.Valid);
 	}
 }
+
+TEST(SensorTyped, ConvertsWithOwnFunction) {
+	Sensor::resetRegistry();
+
+	TypedFunctionalSensor<DoublerFunc> dut(SensorType::Clt, MS2NT(50));
+	ASSERT_TRUE(dut.Register());
+
+	dut.postRawValue(25, getTimeNowNt());
+
+	{
+		auto s = Sensor::get(SensorType::Clt);
+		EXPECT_TRUE(s.Valid);
+		EXPECT_FLOAT_EQ(s.Value, 50);
+		EXPECT_FLOAT_EQ(Sensor::getRaw(SensorType::Clt), 25);
+	}
+
+	dut.postRawValue(-25, getTimeNowNt());
+
+	{
+		auto s = Sensor::get(SensorType::Clt);
+		EXPECT_FALSE(s.Valid);
+		EXPECT_FLOAT_EQ(Sensor::getRaw(SensorType::Clt), -25);
+	}
+
+	Sensor::resetRegistry();
+}
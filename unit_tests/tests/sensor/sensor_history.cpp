@@ -0,0 +1,153 @@
+#include "pch.h"
+
+#include "sensor_history.h"
+
+TEST(SensorHistory, Empty) {
+	SensorHistoryBuffer<4> dut;
+
+	EXPECT_EQ(0u, dut.getCount());
+	EXPECT_EQ(4u, dut.getCapacity());
+	EXPECT_EQ(4 * sizeof(SensorHistorySample), dut.getMemoryUsage());
+
+	EXPECT_FALSE(dut.getValueAt(100));
+	EXPECT_FALSE(dut.getRateOfChange(100));
+	EXPECT_FALSE(dut.getMin(100, 100));
+	EXPECT_FALSE(dut.getMax(100, 100));
+}
+
+TEST(SensorHistory, ValueAt) {
+	SensorHistoryBuffer<8> dut;
+
+	dut.append(10, 1000);
+	dut.append(20, 2000);
+	dut.append(40, 3000);
+
+	// before the oldest sample
+	EXPECT_FALSE(dut.getValueAt(999));
+
+	// exact hits and interpolation
+	EXPECT_FLOAT_EQ(10, dut.getValueAt(1000).value_or(-1));
+	EXPECT_FLOAT_EQ(15, dut.getValueAt(1500).value_or(-1));
+	EXPECT_FLOAT_EQ(20, dut.getValueAt(2000).value_or(-1));
+	EXPECT_FLOAT_EQ(35, dut.getValueAt(2750).value_or(-1));
+
+	// newest value is held, not extrapolated
+	EXPECT_FLOAT_EQ(40, dut.getValueAt(3000).value_or(-1));
+	EXPECT_FLOAT_EQ(40, dut.getValueAt(99999).value_or(-1));
+}
+
+TEST(SensorHistory, Wraparound) {
+	SensorHistoryBuffer<4> dut;
+
+	for (int i = 0; i < 10; i++) {
+		dut.append(i, 1000 * i);
+	}
+
+	EXPECT_EQ(4u, dut.getCount());
+
+	// only 6..9 survived
+	EXPECT_FALSE(dut.getValueAt(5999));
+	EXPECT_FLOAT_EQ(6, dut.getValueAt(6000).value_or(-1));
+	EXPECT_FLOAT_EQ(7.5f, dut.getValueAt(7500).value_or(-1));
+	EXPECT_FLOAT_EQ(9, dut.getValueAt(9000).value_or(-1));
+
+	dut.clear();
+	EXPECT_EQ(0u, dut.getCount());
+	EXPECT_FALSE(dut.getValueAt(9000));
+}
+
+TEST(SensorHistory, RateOfChange) {
+	SensorHistoryBuffer<8> dut;
+
+	// 10 units every 100ms = 100 units per second
+	for (int i = 0; i < 5; i++) {
+		dut.append(10 * i, MS2NT(100 * i));
+	}
+
+	EXPECT_NEAR(100, dut.getRateOfChange(MS2NT(200)).value_or(0), 1e-3);
+	EXPECT_NEAR(100, dut.getRateOfChange(MS2NT(150)).value_or(0), 1e-3);
+
+	// window longer than history
+	EXPECT_FALSE(dut.getRateOfChange(MS2NT(500)));
+	EXPECT_FALSE(dut.getRateOfChange(0));
+}
+
+TEST(SensorHistory, MinMax) {
+	SensorHistoryBuffer<8> dut;
+
+	dut.append(5, 1000);
+	dut.append(-3, 2000);
+	dut.append(8, 3000);
+	dut.append(2, 4000);
+
+	EXPECT_FLOAT_EQ(-3, dut.getMin(3000, 4000).value_or(0));
+	EXPECT_FLOAT_EQ(8, dut.getMax(3000, 4000).value_or(0));
+
+	// only the last two samples
+	EXPECT_FLOAT_EQ(2, dut.getMin(1000, 4000).value_or(0));
+	EXPECT_FLOAT_EQ(8, dut.getMax(1000, 4000).value_or(0));
+
+	// nothing recent enough
+	EXPECT_FALSE(dut.getMin(1000, 10000));
+}
+
+class SensorHistoryRegistry : public ::testing::Test {
+protected:
+	void SetUp() override {
+		Sensor::resetRegistry();
+	}
+
+	void TearDown() override {
+		Sensor::resetRegistry();
+	}
+};
+
+TEST_F(SensorHistoryRegistry, RecordsValidValues) {
+	extern int timeNowUs;
+
+	MockSensor sensor(SensorType::Map);
+	ASSERT_TRUE(sensor.Register());
+
+	EXPECT_EQ(nullptr, Sensor::getHistory(SensorType::Map));
+	ASSERT_TRUE(Sensor::enableHistory(SensorType::Map));
+	auto history = Sensor::getHistory(SensorType::Map);
+	ASSERT_NE(nullptr, history);
+
+	// enabling again reuses the same history
+	EXPECT_TRUE(Sensor::enableHistory(SensorType::Map));
+	EXPECT_EQ(history, Sensor::getHistory(SensorType::Map));
+	EXPECT_EQ(1u, getSensorHistoryPoolUsed());
+
+	timeNowUs = 1000;
+	sensor.set(100);
+	timeNowUs = 2000;
+	sensor.set(110);
+
+	// invalid readings are not recorded
+	sensor.invalidate();
+	timeNowUs = 3000;
+	sensor.set(130);
+
+	EXPECT_EQ(3u, history->getCount());
+	EXPECT_FLOAT_EQ(105, history->getValueAt(US2NT(1500)).value_or(0));
+	EXPECT_FLOAT_EQ(120, history->getValueAt(US2NT(2500)).value_or(0));
+
+	// other sensors are not affected
+	EXPECT_EQ(nullptr, Sensor::getHistory(SensorType::Clt));
+}
+
+TEST_F(SensorHistoryRegistry, PoolExhausted) {
+	for (int i = 0; i < SENSOR_HISTORY_POOL_COUNT; i++) {
+		EXPECT_TRUE(Sensor::enableHistory(static_cast<SensorType>(i + 1)));
+	}
+
+	EXPECT_FALSE(Sensor::enableHistory(static_cast<SensorType>(SENSOR_HISTORY_POOL_COUNT + 1)));
+
+	// a statically allocated history is always accepted
+	static SensorHistoryBuffer<2> ownHistory;
+	Sensor::enableHistory(SensorType::Clt, &ownHistory);
+	EXPECT_EQ(&ownHistory, Sensor::getHistory(SensorType::Clt));
+
+	Sensor::enableHistory(SensorType::Clt, nullptr);
+	EXPECT_EQ(nullptr, Sensor::getHistory(SensorType::Clt));
+}
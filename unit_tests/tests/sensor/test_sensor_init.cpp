@@ -3,11 +3,16 @@
 #include "unit_test_framework.h"
 #include "init.h"
 #include "functional_sensor.h"
+#include "linear_func.h"
 
 static void postToFuncSensor(Sensor* s, float value) {
 	static_cast<FunctionalSensor*>(s)->postRawValue(value, getTimeNowNt());
 }
 
+static void postToFuncSensor(TypedFunctionalSensor<LinearFunc>* s, float value) {
+	s->postRawValue(value, getTimeNowNt());
+}
+
 #define EXPECT_POINT_VALID(s, raw, expect) \
 	{\
 		postToFuncSensor(s, raw); \
@@ -174,7 +179,7 @@ TEST(SensorInit, OilPressure) {
 	initOilPressure();
 
 	// Ensure the sensors were registered
-	auto s = const_cast<Sensor*>(Sensor::getSensorOfType(SensorType::OilPressure));
+	auto s = static_cast<TypedFunctionalSensor<LinearFunc>*>(const_cast<Sensor*>(Sensor::getSensorOfType(SensorType::OilPressure)));
 	ASSERT_NE(nullptr, s);
 
 	// Test in range
@@ -0,0 +1,95 @@
+/**
+ * @file test_typed_functional_sensor.cpp
+ *
+ * TypedFunctionalSensor against FunctionalSensor with a converter pointer, fed the same way
+ * AdcSubscription::UpdateSubscribers does: filter the volts, post them to every sensor.
+ */
+
+#include "pch.h"
+
+#include "functional_sensor.h"
+#include "func_chain.h"
+#include "linear_func.h"
+#include "resistance_func.h"
+#include "thermistor_func.h"
+#include "biquad.h"
+
+using ThermistorChain = FuncChain<ResistanceFunc, ThermistorFunc>;
+
+static void configureLinear(LinearFunc& func) {
+	func.configure(0.5, 0, 4.5, 100, -5, 105);
+}
+
+static void configureThermistor(ThermistorChain& func) {
+	thermistor_conf_s tc = {0, 30, 100, 32500, 7550, 700, 2700};
+	func.get<ResistanceFunc>().configure(5.0f, tc.bias_resistor);
+	func.get<ThermistorFunc>().configure(tc);
+}
+
+template <typename TFunc>
+struct Subscriber {
+	TFunc func;
+	FunctionalSensor sensor{SensorType::Invalid, MS2NT(50)};
+	TypedFunctionalSensor<TFunc> typed{SensorType::Invalid, MS2NT(50)};
+	Biquad filter;
+	Biquad typedFilter;
+
+	template <typename TConfigure>
+	void init(TConfigure configure) {
+		configure(func);
+		sensor.setFunction(func);
+		configure(typed.getFunction());
+
+		filter.configureLowpass(500, 10);
+		filter.cookSteadyState(2.5f);
+		typedFilter.configureLowpass(500, 10);
+		typedFilter.cookSteadyState(2.5f);
+	}
+
+	void update(float volts, efitick_t nowNt) {
+		sensor.postRawValue(filter.filter(volts), nowNt);
+		typed.postRawValue(typedFilter.filter(volts), nowNt);
+	}
+
+	void expectSame() const {
+		auto expected = sensor.get();
+		auto actual = typed.get();
+
+		EXPECT_EQ(expected.Valid, actual.Valid);
+		EXPECT_FLOAT_EQ(expected.Value, actual.Value);
+		EXPECT_FLOAT_EQ(sensor.getRaw(), typed.getRaw());
+	}
+};
+
+TEST(SensorTyped, MatchesConverterPointer) {
+	Subscriber<LinearFunc> linear;
+	Subscriber<ThermistorChain> therm;
+
+	linear.init(configureLinear);
+	therm.init(configureThermistor);
+
+	efitick_t nowNt = getTimeNowNt();
+	int validCount = 0;
+	int invalidCount = 0;
+
+	// sweep across the whole ADC range, including the out of range ends
+	for (int i = 0; i < 2000; i++) {
+		float volts = (i % 500) * 0.01f;
+
+		linear.update(volts, nowNt);
+		therm.update(volts, nowNt);
+
+		linear.expectSame();
+		therm.expectSame();
+
+		if (linear.typed.get().Valid) {
+			validCount++;
+		} else {
+			invalidCount++;
+		}
+	}
+
+	// both the valid and the error path were compared
+	EXPECT_GT(validCount, 0);
+	EXPECT_GT(invalidCount, 0);
+}
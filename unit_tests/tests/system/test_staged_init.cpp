@@ -0,0 +1,108 @@
+/*
+ * @file test_staged_init.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "staged_init.h"
+
+extern int timeNowUs;
+
+static int callOrder[DEFERRED_INIT_MAX + 2];
+static int callCount;
+
+static void recordCall(int id) {
+	callOrder[callCount++] = id;
+}
+
+static void initA() {
+	recordCall(1);
+	timeNowUs += 3000;
+}
+
+static void initB() {
+	recordCall(2);
+	timeNowUs += 7000;
+}
+
+static void initC() {
+	recordCall(3);
+}
+
+class StagedInit : public ::testing::Test {
+protected:
+	void SetUp() override {
+		resetStagedInit();
+		callCount = 0;
+		timeNowUs = 0;
+	}
+
+	void TearDown() override {
+		resetStagedInit();
+	}
+};
+
+TEST_F(StagedInit, bootPhases) {
+	EXPECT_EQ(0u, getBootPhaseUs(BootPhase::ConfigLoaded));
+
+	timeNowUs = 1000;
+	markBootPhase(BootPhase::ConfigLoaded);
+	timeNowUs = 5000;
+	markBootPhase(BootPhase::EngineReady);
+
+	EXPECT_EQ(1000u, getBootPhaseUs(BootPhase::ConfigLoaded));
+	EXPECT_EQ(5000u, getBootPhaseUs(BootPhase::EngineReady));
+	EXPECT_EQ(0u, getBootPhaseUs(BootPhase::MainLoop));
+	EXPECT_STREQ("engine ready", getBootPhaseName(BootPhase::EngineReady));
+
+	// zero means 'not reached' so a phase marked at power on still has to show up
+	timeNowUs = 0;
+	markBootPhase(BootPhase::Start);
+	EXPECT_NE(0u, getBootPhaseUs(BootPhase::Start));
+}
+
+TEST_F(StagedInit, deferredRunInOrder) {
+	deferInit("a", initA);
+	deferInit("b", initB);
+	deferInit("c", initC);
+
+	// nothing runs in line
+	EXPECT_EQ(0, callCount);
+	EXPECT_EQ(3u, getDeferredInitCount());
+
+	timeNowUs = 10000;
+	runDeferredInit();
+
+	ASSERT_EQ(3, callCount);
+	EXPECT_EQ(1, callOrder[0]);
+	EXPECT_EQ(2, callOrder[1]);
+	EXPECT_EQ(3, callOrder[2]);
+
+	EXPECT_EQ(7000u, getSlowestDeferredInitUs());
+	EXPECT_EQ(20000u, getBootPhaseUs(BootPhase::DeferredDone));
+}
+
+TEST_F(StagedInit, runInLineOnceDone) {
+	runDeferredInit();
+
+	deferInit("late", initC);
+
+	EXPECT_EQ(1, callCount);
+	EXPECT_EQ(0u, getDeferredInitCount());
+}
+
+TEST_F(StagedInit, runInLineWhenQueueFull) {
+	for (int i = 0; i < DEFERRED_INIT_MAX; i++) {
+		deferInit("a", initA);
+	}
+	EXPECT_EQ(0, callCount);
+
+	deferInit("overflow", initC);
+	ASSERT_EQ(1, callCount);
+	EXPECT_EQ(3, callOrder[0]);
+
+	runDeferredInit();
+	EXPECT_EQ(DEFERRED_INIT_MAX + 1, callCount);
+}
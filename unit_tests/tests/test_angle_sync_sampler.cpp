@@ -0,0 +1,116 @@
+/*
+ * @file test_angle_sync_sampler.cpp
+ */
+
+#include "pch.h"
+#include "rusefi_lua.h"
+
+// instead of voltage we sample current engine phase so that we can see where each sample was taken
+static float readEnginePhase(adc_channel_e) {
+	return engine->triggerCentral.getCurrentEnginePhase(getTimeNowNt()).value_or(-1);
+}
+
+static float angleDistance(float from, float to) {
+	float distance = to - from;
+	while (distance < 0) {
+		distance += 720;
+	}
+	return distance;
+}
+
+TEST(AngleSyncSampler, SamplesPerCylinderAtConfiguredAngles) {
+	EngineTestHelper eth(TEST_ENGINE);
+
+	engineConfiguration->specs.cylindersCount = 4;
+	engineConfiguration->trigger.customTotalToothCount = 16;
+	engineConfiguration->trigger.customSkippedToothCount = 0;
+	eth.setTriggerType(TT_TOOTHED_WHEEL);
+	setCamOperationMode();
+	engineConfiguration->isFasterEngineSpinUpEnabled = true;
+
+	auto & sampler = *engine->module<AngleSyncSampler>();
+	sampler.setReader(readEnginePhase);
+
+	// second point is deliberately in between two teeth
+	angle_t angles[] = { 0, 30 };
+	int slot = sampler.addChannel(EFI_ADC_0, angles, efi::size(angles));
+	ASSERT_EQ(0, slot);
+
+	eth.smartFireTriggerEvents2(/*count*/40, /*delay*/ 4);
+	ASSERT_EQ(937, round(Sensor::getOrZero(SensorType::Rpm)));
+	sampler.updatePositions();
+
+	uint32_t cyclesBefore = sampler.getCompletedCycles();
+	eth.smartFireTriggerEvents2(/*count*/16 * 3, /*delay*/ 4);
+	EXPECT_EQ(cyclesBefore + 3, sampler.getCompletedCycles());
+
+	const AngleSampleCycle *cycle = sampler.getCycle();
+	ASSERT_NE(nullptr, cycle);
+	EXPECT_EQ(sampler.getCompletedCycles(), cycle->cycleNumber);
+
+	float firstTdc = sampler.getSample(slot, getCylinderId(0) - 1, 0);
+	ASSERT_FALSE(cisnan(firstTdc));
+
+	for (size_t i = 0; i < 4; i++) {
+		size_t cylinderNumber = getCylinderId(i) - 1;
+		float tdc = sampler.getSample(slot, cylinderNumber, 0);
+		float afterTdc = sampler.getSample(slot, cylinderNumber, 1);
+
+		// TDC of each cylinder in firing order is 180 degrees apart
+		EXPECT_NEAR(180 * i, angleDistance(firstTdc, tdc), 1) << "cylinder " << cylinderNumber;
+		EXPECT_NEAR(30, angleDistance(tdc, afterTdc), 1) << "cylinder " << cylinderNumber;
+	}
+
+	// we have no samples for cylinders which do not exist
+	EXPECT_TRUE(cisnan(sampler.getSample(slot, 5, 0)));
+	EXPECT_TRUE(cisnan(sampler.getSample(slot + 1, 0, 0)));
+
+	// older cycles are still there, the one being filled is never exposed
+	EXPECT_NEAR(sampler.getSample(slot, 0, 1), sampler.getSample(slot, 0, 1, 1), 1);
+	EXPECT_EQ(nullptr, sampler.getCycle(ANGLE_SAMPLER_HISTORY - 1));
+	EXPECT_EQ(0u, sampler.getMissedSampleCount());
+}
+
+TEST(AngleSyncSampler, RejectsTooManyPoints) {
+	EngineTestHelper eth(TEST_ENGINE);
+	auto & sampler = *engine->module<AngleSyncSampler>();
+
+	angle_t angles[ANGLE_SAMPLER_POINTS + 1] = {};
+	EXPECT_EQ(-1, sampler.addChannel(EFI_ADC_0, angles, ANGLE_SAMPLER_POINTS + 1));
+	EXPECT_EQ(-1, sampler.addChannel(EFI_ADC_0, angles, 0));
+
+	for (int i = 0; i < ANGLE_SAMPLER_CHANNELS; i++) {
+		EXPECT_EQ(i, sampler.addChannel(EFI_ADC_0, angles, 1));
+	}
+	EXPECT_EQ(-1, sampler.addChannel(EFI_ADC_0, angles, 1));
+
+	sampler.clear();
+	EXPECT_EQ(0, sampler.addChannel(EFI_ADC_0, angles, 1));
+}
+
+static const char* angleSamplerScript = R"(
+
+function testFunc()
+	slot = addAngleSampler(1, -30, 0, 30)
+	if getAngleSample(slot, 0, 0) ~= nil then
+		return -1
+	end
+	return slot
+end
+
+)";
+
+TEST(AngleSyncSampler, LuaBinding) {
+	EngineTestHelper eth(TEST_ENGINE);
+	auto & sampler = *engine->module<AngleSyncSampler>();
+
+	EXPECT_EQ(0, testLuaReturnsNumberOrNil(angleSamplerScript).value_or(-2));
+	EXPECT_EQ(1, testLuaReturnsNumberOrNil(angleSamplerScript).value_or(-2));
+	// all slots are taken
+	EXPECT_FALSE(testLuaReturnsNumberOrNil(angleSamplerScript).Valid);
+
+	// script restart drops what the previous script has set up
+	engine->resetLua();
+	angle_t angles[] = { 0 };
+	EXPECT_EQ(0, sampler.addChannel(EFI_ADC_0, angles, 1));
+}
@@ -0,0 +1,138 @@
+/**
+ * @file test_cached_correction.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "cached_correction.h"
+
+static int computeCount;
+
+static float countingCorrection() {
+	computeCount++;
+	return Sensor::getOrZero(SensorType::AuxTemp1) * 2;
+}
+
+class CachedCorrectionTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		computeCount = 0;
+	}
+
+	EngineTestHelper eth{TEST_ENGINE};
+
+	CachedCorrection dut{"test", countingCorrection,
+		{ { SensorType::AuxTemp1, 0.5f } },
+		{ TABLE_CONFIG_RANGE(cltFuelCorr) }};
+};
+
+TEST_F(CachedCorrectionTest, Epsilon) {
+	Sensor::setMockValue(SensorType::AuxTemp1, 70);
+
+	EXPECT_FLOAT_EQ(140, dut.get());
+	EXPECT_FLOAT_EQ(140, dut.get());
+	EXPECT_EQ(1, computeCount);
+
+	// small move, keep the old result
+	Sensor::setMockValue(SensorType::AuxTemp1, 70.4f);
+	EXPECT_FLOAT_EQ(140, dut.get());
+	EXPECT_EQ(1, computeCount);
+
+	Sensor::setMockValue(SensorType::AuxTemp1, 71);
+	EXPECT_FLOAT_EQ(142, dut.get());
+	EXPECT_EQ(2, computeCount);
+
+	EXPECT_EQ(2u, dut.getHits());
+	EXPECT_EQ(2u, dut.getMisses());
+
+	dut.resetCounters();
+	EXPECT_EQ(0u, dut.getHits());
+}
+
+TEST_F(CachedCorrectionTest, Validity) {
+	Sensor::setMockValue(SensorType::AuxTemp1, 70);
+	dut.get();
+
+	Sensor::resetMockValue(SensorType::AuxTemp1);
+	EXPECT_FLOAT_EQ(0, dut.get());
+	EXPECT_EQ(2, computeCount);
+
+	// still invalid
+	dut.get();
+	EXPECT_EQ(2, computeCount);
+}
+
+TEST_F(CachedCorrectionTest, ConfigurationWrite) {
+	Sensor::setMockValue(SensorType::AuxTemp1, 70);
+	dut.get();
+
+	ConfigRange table = TABLE_CONFIG_RANGE(cltFuelCorr);
+
+	// right before and right after the table
+	EXPECT_FALSE(dut.dependsOn({ (uint16_t)(table.offset - 4), 4 }));
+	EXPECT_FALSE(dut.dependsOn({ (uint16_t)(table.offset + table.size), 4 }));
+	// overlapping either end
+	EXPECT_TRUE(dut.dependsOn({ (uint16_t)(table.offset - 2), 4 }));
+	EXPECT_TRUE(dut.dependsOn({ (uint16_t)(table.offset + table.size - 1), 4 }));
+
+	dut.invalidate();
+	dut.get();
+	EXPECT_EQ(2, computeCount);
+}
+
+static CachedCorrection* editedCorrection;
+
+static float editedWhileComputing() {
+	computeCount++;
+	// live edit lands while the old table is being interpolated
+	if (computeCount == 1) {
+		editedCorrection->invalidate();
+	}
+	return computeCount;
+}
+
+TEST(CachedCorrection, InvalidateWhileComputing) {
+	EngineTestHelper eth(TEST_ENGINE);
+	computeCount = 0;
+
+	CachedCorrection dut{"edited", editedWhileComputing,
+		{ { SensorType::AuxTemp1, 0.5f } },
+		{ TABLE_CONFIG_RANGE(cltFuelCorr) }};
+	editedCorrection = &dut;
+
+	EXPECT_FLOAT_EQ(1, dut.get());
+	// result of the old table is not kept
+	EXPECT_FLOAT_EQ(2, dut.get());
+	EXPECT_FLOAT_EQ(2, dut.get());
+	EXPECT_EQ(2, computeCount);
+}
+
+TEST(SlowCorrections, TableEdit) {
+	EngineTestHelper eth(TEST_ENGINE);
+	auto& corrections = engine->engineState.slowCorrections;
+
+	Sensor::setMockValue(SensorType::Clt, 70);
+	setArrayValues(config->cltFuelCorr, 1.1f);
+	engine->periodicFastCallback();
+	EXPECT_FLOAT_EQ(1.1f, engine->engineState.running.coolantTemperatureCoefficient);
+
+	uint32_t hits = corrections.cltFuel.getHits();
+	engine->periodicFastCallback();
+	EXPECT_EQ(hits + 1, corrections.cltFuel.getHits());
+
+	// live edit from TunerStudio
+	setArrayValues(config->cltFuelCorr, 1.2f);
+	corrections.onConfigurationWrite(TABLE_CONFIG_RANGE(cltFuelCorr));
+	engine->periodicFastCallback();
+	EXPECT_FLOAT_EQ(1.2f, engine->engineState.running.coolantTemperatureCoefficient);
+
+	// burn only invalidates what it changed
+	uint32_t baroMisses = corrections.baro.getMisses();
+	setArrayValues(config->cltFuelCorr, 1.3f);
+	incrementGlobalConfigurationVersion();
+	engine->periodicFastCallback();
+	EXPECT_FLOAT_EQ(1.3f, engine->engineState.running.coolantTemperatureCoefficient);
+	EXPECT_EQ(baroMisses, corrections.baro.getMisses());
+}
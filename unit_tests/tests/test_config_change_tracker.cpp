@@ -0,0 +1,124 @@
+/**
+ * @file test_config_change_tracker.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "config_change_tracker.h"
+
+static persistent_config_s current;
+static engine_configuration_s previous;
+
+class ConfigChangeTrackerTest : public ::testing::Test {
+protected:
+	void SetUp() override {
+		memset(&current, 0, sizeof(current));
+		memset(&previous, 0, sizeof(previous));
+		dut.remember(current);
+	}
+
+	ConfigChangeTracker dut;
+};
+
+TEST_F(ConfigChangeTrackerTest, NothingChanged) {
+	dut.update(current, previous);
+
+	EXPECT_FALSE(dut.isEngineConfigurationChanged());
+	EXPECT_FALSE(dut.isTableChanged());
+	EXPECT_EQ(0u, dut.getChangedBlockCount());
+	EXPECT_FALSE(dut.isChanged(ENGINE_CONFIG_RANGE(fanPin)));
+	EXPECT_FALSE(dut.isChanged(TABLE_CONFIG_RANGE(veTable)));
+}
+
+TEST_F(ConfigChangeTrackerTest, TableOnly) {
+	current.veTable[3][4] = 55;
+	dut.update(current, previous);
+
+	EXPECT_FALSE(dut.isEngineConfigurationChanged());
+	EXPECT_TRUE(dut.isTableChanged());
+	EXPECT_EQ(1u, dut.getChangedBlockCount());
+
+	EXPECT_TRUE(dut.isChanged(TABLE_CONFIG_RANGE(veTable)));
+	EXPECT_FALSE(dut.isChanged(TABLE_CONFIG_RANGE(ignitionTable)));
+	EXPECT_FALSE(dut.isChanged(ENGINE_CONFIG_RANGE(fanPin)));
+
+	// once remembered the same edit is not a change anymore
+	dut.remember(current);
+	dut.update(current, previous);
+	EXPECT_FALSE(dut.isTableChanged());
+}
+
+TEST_F(ConfigChangeTrackerTest, EngineConfiguration) {
+	current.engineConfiguration.fanPin = Gpio::A5;
+	dut.update(current, previous);
+
+	EXPECT_TRUE(dut.isEngineConfigurationChanged());
+	EXPECT_FALSE(dut.isTableChanged());
+	EXPECT_TRUE(dut.isChanged(ENGINE_CONFIG_RANGE(fanPin)));
+	EXPECT_FALSE(dut.isChanged(ENGINE_CONFIG_RANGE(gearRatio)));
+	EXPECT_FALSE(dut.isChanged(TABLE_CONFIG_RANGE(veTable)));
+
+	// compared against previous, not against the last update
+	previous.fanPin = Gpio::A5;
+	dut.update(current, previous);
+	EXPECT_FALSE(dut.isEngineConfigurationChanged());
+}
+
+TEST_F(ConfigChangeTrackerTest, NoBaseline) {
+	ConfigChangeTracker fresh;
+	fresh.update(current, previous);
+
+	// nothing to compare tables against
+	EXPECT_TRUE(fresh.isTableChanged());
+	EXPECT_FALSE(fresh.isEngineConfigurationChanged());
+
+	fresh.markAllChanged();
+	EXPECT_TRUE(fresh.isChanged(ENGINE_CONFIG_RANGE(fanPin)));
+}
+
+TEST_F(ConfigChangeTrackerTest, RangeAcrossBoundary) {
+	// last byte of engine configuration and first byte of tables
+	ConfigRange range = { (uint16_t)(sizeof(engine_configuration_s) - 1), 2 };
+
+	dut.update(current, previous);
+	EXPECT_FALSE(dut.isChanged(range));
+
+	reinterpret_cast<uint8_t*>(&current)[sizeof(engine_configuration_s)] = 1;
+	dut.update(current, previous);
+	EXPECT_TRUE(dut.isChanged(range));
+}
+
+TEST(ConfigChangeTracker, EveryBurnIsTracked) {
+	EngineTestHelper eth(TEST_ENGINE);
+
+	auto& changes = getConfigChangeTracker();
+
+	for (int i = 0; i < 20; i++) {
+		config->veTable[0][0] = 200 + i;
+		incrementGlobalConfigurationVersion();
+
+		// a table edit never looks like a pin change
+		EXPECT_TRUE(changes.isTableChanged()) << i;
+		EXPECT_FALSE(changes.isEngineConfigurationChanged()) << i;
+		EXPECT_FALSE(changes.isChanged(ENGINE_CONFIG_RANGE(fanPin))) << i;
+	}
+
+	engineConfiguration->fanPin = Gpio::Unassigned;
+	incrementGlobalConfigurationVersion();
+
+	for (int i = 0; i < 20; i++) {
+		engineConfiguration->fanPin = (i & 1) ? Gpio::A5 : Gpio::A6;
+		incrementGlobalConfigurationVersion();
+
+		EXPECT_TRUE(changes.isChanged(ENGINE_CONFIG_RANGE(fanPin))) << i;
+		EXPECT_FALSE(changes.isChanged(ENGINE_CONFIG_RANGE(vbattDividerCoeff))) << i;
+		EXPECT_FALSE(changes.isTableChanged()) << i;
+	}
+
+	// burning the same values again is not a change
+	incrementGlobalConfigurationVersion();
+	EXPECT_FALSE(changes.isEngineConfigurationChanged());
+	EXPECT_FALSE(changes.isTableChanged());
+}
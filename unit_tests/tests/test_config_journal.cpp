@@ -0,0 +1,423 @@
+#include "pch.h"
+
+#include "config_journal.h"
+
+#include <vector>
+
+/**
+ * RAM model of two flash banks. Programming a byte which is not erased fails the test,
+ * just like it would corrupt data on real NOR flash.
+ *
+ * Timing defaults are STM32F4 typical values for a 128K sector at x32 parallelism.
+ */
+class SimulatedFlash : public JournalFlash {
+public:
+	SimulatedFlash(size_t bankSize)
+		: m_bankSize(bankSize)
+	{
+		for (auto& bank : data) {
+			bank.assign(bankSize, 0xFF);
+		}
+	}
+
+	size_t getBankSize() const override {
+		return m_bankSize;
+	}
+
+	bool erase(size_t bank) override {
+		if (writeBudget == 0) {
+			return false;
+		}
+
+		std::fill(data[bank].begin(), data[bank].end(), 0xFF);
+		erases[bank]++;
+		timeUs += eraseUs;
+		return true;
+	}
+
+	bool write(size_t bank, size_t offset, const void* source, size_t size) override {
+		EXPECT_LE(offset + size, m_bankSize);
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(source);
+
+		for (size_t i = 0; i < size; i++) {
+			// power is lost in the middle of this write
+			if (writeBudget == 0) {
+				return false;
+			}
+			writeBudget--;
+
+			EXPECT_EQ(0xFF, data[bank][offset + i]) << "byte programmed twice at " << offset + i;
+			data[bank][offset + i] = bytes[i];
+		}
+
+		bytesWritten += size;
+		timeUs += (size + 3) / 4 * programUsPerWord;
+		return true;
+	}
+
+	bool read(size_t bank, size_t offset, void* target, size_t size) override {
+		memcpy(target, &data[bank][offset], size);
+		return true;
+	}
+
+	std::vector<uint8_t> data[2];
+	uint32_t erases[2] = {};
+	size_t bytesWritten = 0;
+	size_t writeBudget = SIZE_MAX;
+
+	double timeUs = 0;
+	double eraseUs = 1000000;
+	double programUsPerWord = 16;
+
+private:
+	const size_t m_bankSize;
+};
+
+#define TEST_IMAGE_SIZE 5000
+
+static void fillPattern(uint8_t* image, size_t size, uint8_t seed) {
+	for (size_t i = 0; i < size; i++) {
+		image[i] = static_cast<uint8_t>(i * 7 + seed);
+	}
+}
+
+TEST(ConfigJournal, BlankFlash) {
+	SimulatedFlash flash(32 * 1024);
+	uint8_t image[TEST_IMAGE_SIZE];
+	fillPattern(image, sizeof(image), 1);
+
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> dut(flash, image, 1);
+	ASSERT_TRUE(dut.fits());
+
+	EXPECT_EQ(JournalState::Blank, dut.mount());
+	EXPECT_FALSE(dut.isMounted());
+	// nothing was loaded
+	EXPECT_EQ(1, image[0]);
+
+	// first commit is a snapshot into the second bank, first one is kept
+	EXPECT_TRUE(dut.commit());
+	EXPECT_TRUE(dut.isMounted());
+	EXPECT_EQ(1u, dut.getActiveBank());
+	EXPECT_EQ(1u, dut.getGeneration());
+	EXPECT_EQ(0u, flash.erases[0]);
+	EXPECT_EQ(1u, flash.erases[1]);
+	EXPECT_EQ(dut.getSnapshotSize(), dut.getUsedBytes());
+
+	uint8_t loaded[TEST_IMAGE_SIZE] = {};
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> reader(flash, loaded, 1);
+	EXPECT_EQ(JournalState::Ok, reader.mount());
+	EXPECT_EQ(0, memcmp(image, loaded, sizeof(image)));
+	EXPECT_FALSE(reader.needsCompaction());
+}
+
+TEST(ConfigJournal, AppendsOnlyChangedPages) {
+	SimulatedFlash flash(32 * 1024);
+	uint8_t image[TEST_IMAGE_SIZE];
+	fillPattern(image, sizeof(image), 2);
+
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> dut(flash, image, 1);
+	dut.mount();
+	ASSERT_TRUE(dut.commit());
+
+	size_t written = flash.bytesWritten;
+
+	// nothing changed, nothing written
+	EXPECT_TRUE(dut.commit());
+	EXPECT_EQ(written, flash.bytesWritten);
+
+	// one full page and the short last page: 32 byte header each, last page padded to 160
+	image[300]++;
+	image[4900]++;
+	EXPECT_TRUE(dut.commit());
+	EXPECT_EQ(32u + 256 + 32 + 160, flash.bytesWritten - written);
+	EXPECT_EQ(flash.bytesWritten - written, dut.getStats().lastCommitBytes);
+	EXPECT_EQ(1u, flash.erases[1]);
+
+	// adjacent pages are merged into one record
+	uint32_t records = dut.getStats().records;
+	image[10]++;
+	image[260]++;
+	EXPECT_TRUE(dut.commit());
+	EXPECT_EQ(records + 1, dut.getStats().records);
+
+	uint8_t loaded[TEST_IMAGE_SIZE] = {};
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> reader(flash, loaded, 1);
+	EXPECT_EQ(JournalState::Ok, reader.mount());
+	EXPECT_EQ(0, memcmp(image, loaded, sizeof(image)));
+	EXPECT_EQ(dut.getUsedBytes(), reader.getUsedBytes());
+}
+
+TEST(ConfigJournal, CompactionAlternatesBanks) {
+	// snapshot takes 5120 bytes, room for a few appends only
+	SimulatedFlash flash(8 * 1024);
+	uint8_t image[TEST_IMAGE_SIZE];
+	fillPattern(image, sizeof(image), 3);
+
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> dut(flash, image, 1);
+	dut.mount();
+
+	for (int i = 0; i < 50; i++) {
+		image[(i * 997) % TEST_IMAGE_SIZE] = i;
+		ASSERT_TRUE(dut.commit()) << i;
+
+		uint8_t loaded[TEST_IMAGE_SIZE] = {};
+		ConfigJournalBuffer<TEST_IMAGE_SIZE> reader(flash, loaded, 1);
+		ASSERT_EQ(JournalState::Ok, reader.mount()) << i;
+		ASSERT_EQ(0, memcmp(image, loaded, sizeof(image))) << i;
+		ASSERT_EQ(dut.getActiveBank(), reader.getActiveBank()) << i;
+	}
+
+	// every 11th commit does not fit anymore
+	EXPECT_EQ(5u, dut.getStats().compactions);
+	EXPECT_EQ(2u, flash.erases[0]);
+	EXPECT_EQ(3u, flash.erases[1]);
+
+	// explicit compaction flips the bank
+	size_t bank = dut.getActiveBank();
+	uint32_t generation = dut.getGeneration();
+	EXPECT_TRUE(dut.compact());
+	EXPECT_NE(bank, dut.getActiveBank());
+	EXPECT_EQ(generation + 1, dut.getGeneration());
+	EXPECT_FALSE(dut.needsCompaction());
+}
+
+TEST(ConfigJournal, InterruptedAppend) {
+	SimulatedFlash flash(32 * 1024);
+	uint8_t image[TEST_IMAGE_SIZE];
+	fillPattern(image, sizeof(image), 4);
+
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> dut(flash, image, 1);
+	dut.mount();
+	ASSERT_TRUE(dut.commit());
+
+	uint8_t persisted[TEST_IMAGE_SIZE];
+	memcpy(persisted, image, sizeof(image));
+
+	// power goes away in the middle of the payload
+	image[1000] ^= 0xFF;
+	flash.writeBudget = 100;
+	EXPECT_FALSE(dut.commit());
+
+	// reboot
+	flash.writeBudget = SIZE_MAX;
+	uint8_t loaded[TEST_IMAGE_SIZE] = {};
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> reader(flash, loaded, 1);
+	EXPECT_EQ(JournalState::Ok, reader.mount());
+	EXPECT_EQ(0, memcmp(persisted, loaded, sizeof(loaded)));
+
+	// half written record can not be appended to, next commit has to go to the other bank
+	EXPECT_TRUE(reader.needsCompaction());
+	size_t bank = reader.getActiveBank();
+	loaded[1000] ^= 0xFF;
+	EXPECT_TRUE(reader.commit());
+	EXPECT_NE(bank, reader.getActiveBank());
+
+	uint8_t reloaded[TEST_IMAGE_SIZE] = {};
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> second(flash, reloaded, 1);
+	EXPECT_EQ(JournalState::Ok, second.mount());
+	EXPECT_EQ(0, memcmp(loaded, reloaded, sizeof(loaded)));
+}
+
+TEST(ConfigJournal, InterruptedCompaction) {
+	SimulatedFlash flash(32 * 1024);
+	uint8_t image[TEST_IMAGE_SIZE];
+	fillPattern(image, sizeof(image), 5);
+
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> dut(flash, image, 1);
+	dut.mount();
+	ASSERT_TRUE(dut.commit());
+	size_t bank = dut.getActiveBank();
+
+	uint8_t persisted[TEST_IMAGE_SIZE];
+	memcpy(persisted, image, sizeof(image));
+
+	// snapshot is almost complete but the bank header is missing
+	image[0]++;
+	flash.writeBudget = dut.getSnapshotSize() - 100;
+	EXPECT_FALSE(dut.compact());
+	EXPECT_EQ(1u, dut.getStats().failures);
+
+	flash.writeBudget = SIZE_MAX;
+	uint8_t loaded[TEST_IMAGE_SIZE] = {};
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> reader(flash, loaded, 1);
+	EXPECT_EQ(JournalState::Ok, reader.mount());
+	EXPECT_EQ(bank, reader.getActiveBank());
+	EXPECT_EQ(0, memcmp(persisted, loaded, sizeof(loaded)));
+}
+
+TEST(ConfigJournal, CorruptedRecordStopsReplay) {
+	SimulatedFlash flash(32 * 1024);
+	uint8_t image[TEST_IMAGE_SIZE];
+	fillPattern(image, sizeof(image), 6);
+
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> dut(flash, image, 1);
+	dut.mount();
+	ASSERT_TRUE(dut.commit());
+
+	image[100] = 0xA5;
+	ASSERT_TRUE(dut.commit());
+	uint8_t afterFirst[TEST_IMAGE_SIZE];
+	memcpy(afterFirst, image, sizeof(image));
+
+	size_t secondRecord = dut.getUsedBytes();
+	image[2000] = 0x5A;
+	ASSERT_TRUE(dut.commit());
+
+	// flip a bit in the payload of the second record
+	flash.data[dut.getActiveBank()][secondRecord + 32] ^= 0x01;
+
+	uint8_t loaded[TEST_IMAGE_SIZE] = {};
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> reader(flash, loaded, 1);
+	EXPECT_EQ(JournalState::Ok, reader.mount());
+	EXPECT_EQ(0, memcmp(afterFirst, loaded, sizeof(loaded)));
+	EXPECT_EQ(secondRecord, reader.getUsedBytes());
+	EXPECT_TRUE(reader.needsCompaction());
+}
+
+TEST(ConfigJournal, CorruptedSnapshotFallsBack) {
+	SimulatedFlash flash(32 * 1024);
+	uint8_t image[TEST_IMAGE_SIZE];
+	fillPattern(image, sizeof(image), 8);
+
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> dut(flash, image, 1);
+	dut.mount();
+	ASSERT_TRUE(dut.commit());
+	size_t olderBank = dut.getActiveBank();
+
+	uint8_t older[TEST_IMAGE_SIZE];
+	memcpy(older, image, sizeof(image));
+
+	image[3000]++;
+	ASSERT_TRUE(dut.compact());
+	ASSERT_NE(olderBank, dut.getActiveBank());
+
+	// flip a bit in the last snapshot record of the newer bank
+	flash.data[dut.getActiveBank()][dut.getSnapshotSize() - 100] ^= 0x01;
+
+	uint8_t loaded[TEST_IMAGE_SIZE] = {};
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> reader(flash, loaded, 1);
+	EXPECT_EQ(JournalState::Ok, reader.mount());
+	EXPECT_EQ(olderBank, reader.getActiveBank());
+	EXPECT_EQ(0, memcmp(older, loaded, sizeof(loaded)));
+	EXPECT_TRUE(reader.needsCompaction());
+
+	// both snapshots broken, nothing can be trusted
+	flash.data[olderBank][dut.getSnapshotSize() - 100] ^= 0x01;
+
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> broken(flash, loaded, 1);
+	EXPECT_EQ(JournalState::Corrupt, broken.mount());
+	EXPECT_FALSE(broken.isMounted());
+
+	// fresh snapshot wins over both broken banks
+	EXPECT_TRUE(broken.commit());
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> second(flash, image, 1);
+	EXPECT_EQ(JournalState::Ok, second.mount());
+	EXPECT_EQ(0, memcmp(loaded, image, sizeof(loaded)));
+}
+
+TEST(ConfigJournal, IncompatibleVersion) {
+	SimulatedFlash flash(32 * 1024);
+	uint8_t image[TEST_IMAGE_SIZE];
+	fillPattern(image, sizeof(image), 7);
+
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> dut(flash, image, 1);
+	dut.mount();
+	ASSERT_TRUE(dut.commit());
+
+	uint8_t loaded[TEST_IMAGE_SIZE] = {};
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> reader(flash, loaded, 2);
+	// old image is still loaded so that the caller can preserve what it wants
+	EXPECT_EQ(JournalState::IncompatibleVersion, reader.mount());
+	EXPECT_EQ(0, memcmp(image, loaded, sizeof(loaded)));
+
+	// even without changes the new version gets recorded
+	EXPECT_TRUE(reader.needsCompaction());
+	EXPECT_TRUE(reader.commit());
+
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> second(flash, loaded, 2);
+	EXPECT_EQ(JournalState::Ok, second.mount());
+}
+
+TEST(ConfigJournal, SnapshotDoesNotFit) {
+	SimulatedFlash flash(4 * 1024);
+	uint8_t image[TEST_IMAGE_SIZE] = {};
+
+	ConfigJournalBuffer<TEST_IMAGE_SIZE> dut(flash, image, 1);
+	EXPECT_FALSE(dut.fits());
+	EXPECT_EQ(JournalState::Blank, dut.mount());
+	EXPECT_FALSE(dut.commit());
+	EXPECT_EQ(0u, flash.bytesWritten);
+}
+
+/**
+ * Host side simulation of a tuning session on STM32F4 layout: two 128K sectors and
+ * a real size configuration, every burn changes a few bytes like editing a couple of table cells.
+ * Compares flash wear and modeled burn latency against writing two full copies.
+ */
+TEST(ConfigJournal, WearAndBurnLatencySimulation) {
+	constexpr size_t imageSize = sizeof(persistent_config_s);
+	constexpr int burns = 2000;
+
+	SimulatedFlash flash(128 * 1024);
+	static uint8_t image[imageSize];
+	fillPattern(image, imageSize, 8);
+
+	ConfigJournalBuffer<imageSize> dut(flash, image, 1);
+	dut.mount();
+	ASSERT_TRUE(dut.commit());
+
+	flash.erases[0] = flash.erases[1] = 0;
+	flash.bytesWritten = 0;
+
+	double burnUs = 0;
+	double maxBurnUs = 0;
+	double compactionUs = 0;
+
+	uint32_t random = 12345;
+	for (int i = 0; i < burns; i++) {
+		random = random * 1103515245 + 12345;
+		size_t offset = (random >> 8) % (imageSize - 4);
+		for (size_t j = 0; j < 4; j++) {
+			image[offset + j]++;
+		}
+
+		double startUs = flash.timeUs;
+		ASSERT_TRUE(dut.commit());
+		double elapsedUs = flash.timeUs - startUs;
+		burnUs += elapsedUs;
+		maxBurnUs = std::max(maxBurnUs, elapsedUs);
+
+		// what flash writer thread does once the burn is reported done
+		if (dut.needsCompaction()) {
+			startUs = flash.timeUs;
+			ASSERT_TRUE(dut.compact());
+			compactionUs += flash.timeUs - startUs;
+		}
+	}
+
+	uint8_t loaded[imageSize];
+	ConfigJournalBuffer<imageSize> reader(flash, loaded, 1);
+	ASSERT_EQ(JournalState::Ok, reader.mount());
+	ASSERT_EQ(0, memcmp(image, loaded, imageSize));
+
+	// two full copies on every burn
+	uint32_t legacyErasesPerSector = burns;
+	double legacyBytes = 2.0 * burns * imageSize;
+	double legacyBurnUs = 2 * (flash.eraseUs + imageSize / 4 * flash.programUsPerWord);
+
+	uint32_t maxErases = std::max(flash.erases[0], flash.erases[1]);
+
+	printf("Config journal simulation, %d burns of %d byte image into 2x%d byte banks\n",
+		burns, (int)imageSize, (int)flash.getBankSize());
+	printf("  dual copy: %u erases per sector, %.1f MB written, %.1f ms per burn\n",
+		legacyErasesPerSector, legacyBytes / 1e6, legacyBurnUs / 1000);
+	printf("  journal:   %u/%u erases per sector, %.1f MB written, %.2f ms per burn avg, %.2f ms max\n",
+		flash.erases[0], flash.erases[1], flash.bytesWritten / 1e6, burnUs / burns / 1000, maxBurnUs / 1000);
+	printf("  journal:   %u compactions in background, %.1f ms each\n",
+		dut.getStats().compactions - 1, compactionUs / std::max<uint32_t>(1, dut.getStats().compactions - 1) / 1000);
+
+	// at least two orders of magnitude less wear
+	EXPECT_LT(maxErases * 100, legacyErasesPerSector);
+	// a burn never waits for an erase, compaction is done in between
+	EXPECT_LT(maxBurnUs, 10000);
+}
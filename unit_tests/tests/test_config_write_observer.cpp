@@ -0,0 +1,147 @@
+/**
+ * @file test_config_write_observer.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "config_write_observer.h"
+#include "shadow_tables.h"
+
+#include <vector>
+
+static constexpr ConfigRange veRegions[] = {
+	TABLE_CONFIG_RANGE(veTable),
+	TABLE_CONFIG_RANGE(veRpmBins),
+};
+
+struct Notification {
+	size_t region;
+	uint16_t offset;
+	uint16_t size;
+};
+
+class RecordingConsumer : public ConfigWriteConsumer {
+public:
+	RecordingConsumer() : ConfigWriteConsumer(veRegions) { }
+
+	void onConfigWrite(size_t region, ConfigRange written) override {
+		notifications.push_back({ region, written.offset, written.size });
+	}
+
+	std::vector<Notification> notifications;
+};
+
+TEST(ConfigWriteObserver, Regions) {
+	ConfigWriteObservers dut;
+	RecordingConsumer consumer;
+	ASSERT_TRUE(dut.add(consumer));
+
+	ConfigRange veTable = TABLE_CONFIG_RANGE(veTable);
+	ConfigRange veRpmBins = TABLE_CONFIG_RANGE(veRpmBins);
+
+	// a single cell
+	dut.onWrite({ (uint16_t)(veTable.offset + 10), 2 });
+	ASSERT_EQ(1u, consumer.notifications.size());
+	EXPECT_EQ(0u, consumer.notifications[0].region);
+	EXPECT_EQ(veTable.offset + 10, consumer.notifications[0].offset);
+	EXPECT_EQ(2, consumer.notifications[0].size);
+
+	// chunk covering the end of the table, the load bins and the start of RPM bins
+	consumer.notifications.clear();
+	dut.onWrite({ (uint16_t)(veTable.offset + veTable.size - 4), 200 });
+	ASSERT_EQ(2u, consumer.notifications.size());
+	EXPECT_EQ(0u, consumer.notifications[0].region);
+	EXPECT_EQ(veTable.offset + veTable.size - 4, consumer.notifications[0].offset);
+	EXPECT_EQ(4, consumer.notifications[0].size);
+	EXPECT_EQ(1u, consumer.notifications[1].region);
+	EXPECT_EQ(veRpmBins.offset, consumer.notifications[1].offset);
+	EXPECT_EQ(veRpmBins.size, consumer.notifications[1].size);
+
+	// load bins alone are not declared
+	consumer.notifications.clear();
+	ConfigRange veLoadBins = TABLE_CONFIG_RANGE(veLoadBins);
+	dut.onWrite(veLoadBins);
+	EXPECT_EQ(0u, consumer.notifications.size());
+	EXPECT_EQ(3u, dut.getWriteCount());
+	EXPECT_EQ(3u, dut.getNotificationCount());
+}
+
+TEST(ConfigWriteObserver, NotObserved) {
+	ConfigWriteObservers dut;
+	RecordingConsumer consumer;
+	dut.add(consumer);
+
+	EXPECT_TRUE(dut.isObserved(TABLE_CONFIG_RANGE(veTable)));
+	EXPECT_FALSE(dut.isObserved(ENGINE_CONFIG_RANGE(cylindersCount)));
+	EXPECT_FALSE(dut.isObserved(TABLE_CONFIG_RANGE(boostTableOpenLoop)));
+	EXPECT_FALSE(dut.isObserved({ 100, 0 }));
+
+	dut.onWrite(ENGINE_CONFIG_RANGE(cylindersCount));
+	EXPECT_EQ(0u, consumer.notifications.size());
+
+	dut.clear();
+	EXPECT_FALSE(dut.isObserved(TABLE_CONFIG_RANGE(veTable)));
+	dut.onWrite(TABLE_CONFIG_RANGE(veTable));
+	EXPECT_EQ(0u, consumer.notifications.size());
+}
+
+TEST(ConfigWriteObserver, TooManyConsumers) {
+	ConfigWriteObservers dut;
+	RecordingConsumer consumers[CONFIG_WRITE_MAX_CONSUMERS];
+
+	for (auto& consumer : consumers) {
+		EXPECT_TRUE(dut.add(consumer));
+	}
+
+	RecordingConsumer extra;
+	EXPECT_FATAL_ERROR(dut.add(extra));
+
+	dut.onWrite(TABLE_CONFIG_RANGE(veRpmBins));
+	for (auto& consumer : consumers) {
+		EXPECT_EQ(1u, consumer.notifications.size());
+	}
+}
+
+TEST(ConfigWriteObserver, SlowCorrections) {
+	EngineTestHelper eth(TEST_ENGINE);
+
+	auto& correction = engine->engineState.slowCorrections.cltFuel;
+	correction.get();
+	correction.resetCounters();
+
+	// unrelated write keeps the cached value
+	getConfigWriteObservers().onWrite(TABLE_CONFIG_RANGE(veTable));
+	correction.get();
+	EXPECT_EQ(1u, correction.getHits());
+
+	// same as a TunerStudio edit of a single curve cell
+	ConfigRange cltFuelCorr = TABLE_CONFIG_RANGE(cltFuelCorr);
+	getConfigWriteObservers().onWrite({ (uint16_t)(cltFuelCorr.offset + 4), 4 });
+	correction.get();
+	EXPECT_EQ(1u, correction.getMisses());
+}
+
+TEST(ConfigWriteObserver, ShadowTablesOnlyTouchedTable) {
+	EngineTestHelper eth(TEST_ENGINE);
+
+	setLinearCurve(config->veTable[0], 50, 50, 1);
+	setLinearCurve(config->lambdaTable[0], 1, 1, 0.01f);
+
+	ShadowTables shadow;
+	shadow.init();
+
+	ConfigWriteObservers dut;
+	dut.add(shadow);
+
+	config->veTable[0][0] = 80;
+	config->lambdaTable[0][0] = 0.8f;
+
+	ConfigRange veTable = TABLE_CONFIG_RANGE(veTable);
+	dut.onWrite({ veTable.offset, 2 });
+
+	EXPECT_FLOAT_EQ(80, shadow.ve.getCell(0, 0));
+	// lambda was edited but nobody wrote it through TunerStudio
+	EXPECT_FLOAT_EQ(1, shadow.lambda.getCell(0, 0));
+}
@@ -7,6 +7,7 @@
 #include "pch.h"
 
 #include "gpio/gpio_ext.h"
+#include "smart_gpio.h"
 
 using ::testing::_;
 
@@ -115,4 +116,111 @@ TEST(gpioext, testGpioExt) {
 	EXPECT_TRUE(gpiochips_readPad((Gpio)(chip3_base + 16)) < 0);
 	EXPECT_TRUE(gpiochips_writePad((Gpio)(chip3_base + 16), 1) < 0);
 
+	/* leave chip slots free for other tests */
+	EXPECT_EQ(0, gpiochip_unregister((Gpio)chip1_base));
+	EXPECT_EQ(0, gpiochip_unregister((Gpio)chip2_base));
+	/* failed chip was already removed by init */
+	EXPECT_TRUE(gpiochip_unregister((Gpio)chip3_base) < 0);
+	EXPECT_EQ(0, gpiochips_get_total_pins());
+}
+
+class CountingChip : public GpioChip {
+public:
+	int init() override {
+		return 0;
+	}
+
+	int writePad(size_t pin, int value) override {
+		writes++;
+		lastPin = pin;
+		lastValue = value;
+		return 0;
+	}
+
+	int setPadMode(size_t, iomode_t) override {
+		return 0;
+	}
+
+	int writes = 0;
+	size_t lastPin = 0;
+	int lastValue = -1;
+};
+
+TEST(gpioext, writeCoalescing) {
+	CountingChip chip;
+	Gpio base = (Gpio)(BRAIN_PIN_ONCHIP_LAST + 1);
+
+	ASSERT_EQ((int)base, gpiochip_register(base, "counting", chip, 16));
+	Gpio pin = (Gpio)(base + 3);
+
+	/* first write always goes to the driver */
+	EXPECT_EQ(0, gpiochips_writePad(pin, 1));
+	EXPECT_EQ(1, chip.writes);
+	EXPECT_EQ(3u, chip.lastPin);
+	EXPECT_EQ(1, chip.lastValue);
+
+	/* same value again is dropped */
+	EXPECT_EQ(0, gpiochips_writePad(pin, 1));
+	EXPECT_EQ(1, chip.writes);
+
+	/* other pins of the same chip are tracked separately */
+	EXPECT_EQ(0, gpiochips_writePad((Gpio)(base + 4), 1));
+	EXPECT_EQ(2, chip.writes);
+
+	EXPECT_EQ(0, gpiochips_writePad(pin, 0));
+	EXPECT_EQ(3, chip.writes);
+	EXPECT_EQ(0, chip.lastValue);
+
+	/* mode change forgets last value */
+	gpiochips_setPadMode(pin, 0);
+	EXPECT_EQ(0, gpiochips_writePad(pin, 0));
+	EXPECT_EQ(4, chip.writes);
+
+	/* re-registration starts from unknown state */
+	EXPECT_EQ(0, gpiochip_unregister(base));
+	EXPECT_TRUE(gpiochips_writePad(pin, 0) < 0);
+	ASSERT_EQ((int)base, gpiochip_register(base, "counting", chip, 16));
+	EXPECT_EQ(0, gpiochips_writePad(pin, 0));
+	EXPECT_EQ(5, chip.writes);
+
+	EXPECT_EQ(0, gpiochip_unregister(base));
+}
+
+TEST(gpioext, writePadAllChips) {
+	CountingChip chips[BOARD_EXT_GPIOCHIPS];
+	Gpio base = (Gpio)(BRAIN_PIN_ONCHIP_LAST + 1);
+	const int chipSize = 32;
+
+	/* fill all slots, toggled pin lives on the last one - worst case for a linear scan */
+	for (int i = 0; i < BOARD_EXT_GPIOCHIPS; i++) {
+		ASSERT_EQ((int)base + i * chipSize, gpiochip_register((Gpio)(base + i * chipSize), "bench", chips[i], chipSize));
+	}
+
+	CountingChip& last = chips[BOARD_EXT_GPIOCHIPS - 1];
+	Gpio pin = (Gpio)(base + (BOARD_EXT_GPIOCHIPS - 1) * chipSize + 5);
+	const int count = 1000;
+
+	for (int i = 0; i < count; i++) {
+		gpiochips_writePad(pin, i & 1);
+	}
+
+	/* every toggle reaches the driver */
+	EXPECT_EQ(count, last.writes);
+	EXPECT_EQ(5u, last.lastPin);
+
+	for (int i = 0; i < count; i++) {
+		gpiochips_writePad(pin, 0);
+	}
+
+	/* one change, everything else coalesced */
+	EXPECT_EQ(count + 1, last.writes);
+
+	/* lookup never dispatched to a neighbour */
+	for (int i = 0; i < BOARD_EXT_GPIOCHIPS - 1; i++) {
+		EXPECT_EQ(0, chips[i].writes);
+	}
+
+	for (int i = 0; i < BOARD_EXT_GPIOCHIPS; i++) {
+		EXPECT_EQ(0, gpiochip_unregister((Gpio)(base + i * chipSize)));
+	}
 }
@@ -12,6 +12,7 @@
 #include "idle_thread.h"
 #include "electronic_throttle.h"
 
+using ::testing::NiceMock;
 using ::testing::StrictMock;
 using ::testing::_;
 
@@ -463,3 +464,72 @@ TEST(idle_v2, IntegrationClamping) {
 	// Result would be 75 + 75 = 150, but it should clamp to 100
 	EXPECT_EQ(100, dut.getIdlePosition());
 }
+
+TEST(idle_v2, IntegrationSystemIdentification) {
+	EngineTestHelper eth(TEST_ENGINE);
+	NiceMock<IntegrationIdleMock> dut;
+
+	engineConfiguration->idleMode = IM_AUTO;
+
+	Sensor::setMockValue(SensorType::DriverThrottleIntent, 0);
+	Sensor::setMockValue(SensorType::Clt, 80);
+
+	ON_CALL(dut, getTargetRpm(_)).WillByDefault(Return(800));
+	ON_CALL(dut, determinePhase(_, _, _, _, _)).WillByDefault(Return(ICP::Idling));
+	ON_CALL(dut, getOpenLoop(_, _, _, _)).WillByDefault(Return(20));
+
+	dut.startSystemIdentification(SysIdExcitation::Step);
+
+	// Engine: 25 rpm per % of idle valve, 800 rpm at 20%, 600ms time constant, three callbacks of dead time
+	float a = expf(-SLOW_CALLBACK_PERIOD_MS / 600.0f);
+	float delayed[3] = { 20, 20, 20 };
+	float rpm = 800;
+
+	for (int i = 0; i < 1000 && dut.getSystemIdentification().isRunning(); i++) {
+		Sensor::setMockValue(SensorType::Rpm, rpm);
+		float position = dut.getIdlePosition();
+
+		rpm = a * rpm + (1 - a) * (300 + 25 * delayed[2]);
+		delayed[2] = delayed[1];
+		delayed[1] = delayed[0];
+		delayed[0] = position;
+	}
+
+	const auto& sysId = dut.getSystemIdentification();
+	ASSERT_EQ(SysIdState::Done, sysId.getState()) << getSysIdFailureName(sysId.getResult().failure);
+
+	const auto& result = sysId.getResult();
+	EXPECT_NEAR(25, result.gain, 1);
+	EXPECT_NEAR(0.6f, result.timeConstant, 0.05f);
+	EXPECT_NEAR(0.175f, result.deadTime, 0.01f);
+	// PI only for idle
+	EXPECT_EQ(0, result.dFactor);
+	EXPECT_GT(result.pFactor, 0);
+	EXPECT_GT(result.iFactor, 0);
+
+	// regular idle position again
+	EXPECT_EQ(20, dut.getIdlePosition());
+}
+
+TEST(idle_v2, IntegrationSystemIdentificationAbort) {
+	EngineTestHelper eth(TEST_ENGINE);
+	NiceMock<IntegrationIdleMock> dut;
+
+	engineConfiguration->idleMode = IM_AUTO;
+
+	Sensor::setMockValue(SensorType::DriverThrottleIntent, 0);
+	Sensor::setMockValue(SensorType::Rpm, 800);
+
+	ON_CALL(dut, getTargetRpm(_)).WillByDefault(Return(800));
+	ON_CALL(dut, determinePhase(_, _, _, _, _)).WillByDefault(Return(ICP::Idling));
+	ON_CALL(dut, getOpenLoop(_, _, _, _)).WillByDefault(Return(20));
+
+	dut.startSystemIdentification(SysIdExcitation::Chirp);
+	dut.getIdlePosition();
+	EXPECT_TRUE(dut.getSystemIdentification().isRunning());
+
+	// driver touched the pedal
+	ON_CALL(dut, determinePhase(_, _, _, _, _)).WillByDefault(Return(ICP::Running));
+	dut.getIdlePosition();
+	EXPECT_EQ(SysIdFailure::Aborted, dut.getSystemIdentification().getResult().failure);
+}
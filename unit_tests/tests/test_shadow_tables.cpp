@@ -0,0 +1,269 @@
+/**
+ * @file test_shadow_tables.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "shadow_tables.h"
+
+#include <chrono>
+
+static void setTables() {
+	setLinearCurve(config->veLoadBins, 20, 250, 1);
+	setLinearCurve(config->veRpmBins, 500, 8000, 1);
+	setLinearCurve(config->lambdaLoadBins, 20, 250, 1);
+	setLinearCurve(config->lambdaRpmBins, 500, 8000, 1);
+	setLinearCurve(config->ignitionLoadBins, 20, 250, 1);
+	setLinearCurve(config->ignitionRpmBins, 500, 8000, 1);
+
+	for (size_t row = 0; row < FUEL_LOAD_COUNT; row++) {
+		for (size_t col = 0; col < FUEL_RPM_COUNT; col++) {
+			config->veTable[row][col] = 40 + ((row * 7 + col * 13) % 60) + 0.1f * col;
+			config->lambdaTable[row][col] = 0.75f + 0.01f * ((row * 3 + col * 5) % 25);
+		}
+	}
+
+	for (size_t row = 0; row < IGN_LOAD_COUNT; row++) {
+		for (size_t col = 0; col < IGN_RPM_COUNT; col++) {
+			config->ignitionTable[row][col] = -5 + ((row * 11 + col * 3) % 40) + 0.1f * row;
+		}
+	}
+}
+
+static float getIgnition(float rpm, float load) {
+	return interpolate3d(config->ignitionTable, config->ignitionLoadBins, load, config->ignitionRpmBins, rpm);
+}
+
+TEST(ShadowTables, SameAsPackedTables) {
+	EngineTestHelper eth(TEST_ENGINE);
+	setTables();
+
+	fuel_Map3D_t ve;
+	ve.init(config->veTable, config->veLoadBins, config->veRpmBins);
+	lambda_Map3D_t lambda;
+	lambda.init(config->lambdaTable, config->lambdaLoadBins, config->lambdaRpmBins);
+
+	ShadowTables dut;
+	dut.init();
+
+	// including both sides off the axes
+	for (float rpm = 0; rpm < 9000; rpm += 73) {
+		for (float load = 0; load < 280; load += 3.7f) {
+			EXPECT_NEAR(ve.getValue(rpm, load), dut.ve.getValue(rpm, load), EPS4D) << rpm << "/" << load;
+			EXPECT_NEAR(lambda.getValue(rpm, load), dut.lambda.getValue(rpm, load), EPS5D) << rpm << "/" << load;
+			EXPECT_NEAR(getIgnition(rpm, load), dut.ignition.getValue(rpm, load), EPS4D) << rpm << "/" << load;
+		}
+	}
+}
+
+TEST(ShadowTables, BuiltFromLoadedConfiguration) {
+	// the global copy is bound by commonInitEngineController, after the configuration is in place
+	EngineTestHelper eth(TEST_ENGINE);
+
+	fuel_Map3D_t ve;
+	ve.init(config->veTable, config->veLoadBins, config->veRpmBins);
+	lambda_Map3D_t lambda;
+	lambda.init(config->lambdaTable, config->lambdaLoadBins, config->lambdaRpmBins);
+
+	// default tables are not blank, a copy of a zeroed configuration would be
+	ASSERT_NE(0, ve.getValue(3000, 80));
+	ASSERT_NE(0, lambda.getValue(3000, 80));
+	ASSERT_NE(0, getIgnition(3000, 80));
+
+	for (float rpm = 500; rpm < 8000; rpm += 250) {
+		for (float load = 10; load < 250; load += 10) {
+			EXPECT_NEAR(ve.getValue(rpm, load), shadowTables.ve.getValue(rpm, load), EPS4D) << rpm << "/" << load;
+			EXPECT_NEAR(lambda.getValue(rpm, load), shadowTables.lambda.getValue(rpm, load), EPS5D) << rpm << "/" << load;
+			EXPECT_NEAR(getIgnition(rpm, load), shadowTables.ignition.getValue(rpm, load), EPS4D) << rpm << "/" << load;
+		}
+	}
+}
+
+TEST(ShadowTables, NotInitialized) {
+	ShadowTables dut;
+
+	EXPECT_EQ(0, dut.ve.getValue(3000, 50));
+	EXPECT_FALSE(dut.ve.onWrite(&dut, sizeof(dut)));
+}
+
+static ConfigRange getCellRange(const void* cell, uint16_t size) {
+	return { (uint16_t)(reinterpret_cast<const uint8_t*>(cell) - reinterpret_cast<const uint8_t*>(config)), size };
+}
+
+TEST(ShadowTables, OnlineEdit) {
+	EngineTestHelper eth(TEST_ENGINE);
+	setTables();
+
+	ShadowTables dut;
+	dut.init();
+
+	ConfigWriteObservers observers;
+	observers.add(dut);
+
+	// edits which nobody was told about stay invisible
+	config->veTable[3][4] = 99.5f;
+	config->veTable[3][6] = 77;
+	config->lambdaTable[0][0] = 1.2f;
+	EXPECT_NE(99.5f, dut.ve.getCell(3, 4));
+
+	// TunerStudio writes a single byte of a two byte cell
+	observers.onWrite(getCellRange(&config->veTable[3][4], 1));
+	EXPECT_FLOAT_EQ(99.5f, dut.ve.getCell(3, 4));
+	// only the written cell was converted
+	EXPECT_NE(77, dut.ve.getCell(3, 6));
+	EXPECT_NE(config->lambdaTable[0][0], dut.lambda.getCell(0, 0));
+
+	// a chunk across a cell boundary converts both cells
+	observers.onWrite(getCellRange(reinterpret_cast<const uint8_t*>(&config->veTable[3][5]) + 1, 2));
+	EXPECT_FLOAT_EQ(77, dut.ve.getCell(3, 6));
+
+	// axis edit moves the lookup
+	float before = dut.ignition.getValue(2000, 100);
+	config->ignitionRpmBins[3] += 200;
+	observers.onWrite(getCellRange(&config->ignitionRpmBins[3], 2));
+	EXPECT_NEAR(getIgnition(2000, 100), dut.ignition.getValue(2000, 100), EPS4D);
+	EXPECT_NE(before, dut.ignition.getValue(2000, 100));
+
+	// whole page write
+	observers.onWrite({ 0, (uint16_t)sizeof(persistent_config_s) });
+	EXPECT_FLOAT_EQ(config->lambdaTable[0][0], dut.lambda.getCell(0, 0));
+}
+
+TEST(ShadowTables, Burn) {
+	EngineTestHelper eth(TEST_ENGINE);
+	setTables();
+
+	ShadowTables dut;
+	dut.init();
+
+	ConfigChangeTracker changes;
+	changes.remember(*config);
+
+	config->ignitionTable[2][2] = 33;
+	changes.update(*config, *engineConfiguration);
+
+	// not part of the burn, only shows up if these tables get rebuilt
+	config->veTable[8][8] = 55;
+	config->lambdaTable[8][8] = 1.1f;
+
+	dut.onConfigurationChange(changes);
+
+	EXPECT_FLOAT_EQ(33, dut.ignition.getCell(2, 2));
+	EXPECT_NE(55, dut.ve.getCell(8, 8));
+	EXPECT_NE(config->lambdaTable[8][8], dut.lambda.getCell(8, 8));
+
+	// axis change alone rebuilds
+	changes.remember(*config);
+	config->veRpmBins[0] = 400;
+	changes.update(*config, *engineConfiguration);
+	dut.onConfigurationChange(changes);
+
+	ShadowTables expected;
+	expected.init();
+	EXPECT_FLOAT_EQ(expected.ve.getValue(450, 100), dut.ve.getValue(450, 100));
+	EXPECT_FLOAT_EQ(55, dut.ve.getCell(8, 8));
+}
+
+TEST(ShadowTables, MemoryBudget) {
+	// three 16x16 tables and their axes, as floats
+	EXPECT_EQ(3u * (16 * 16 + 16 + 16) * sizeof(float), ShadowTables::getShadowSize());
+	EXPECT_EQ(16u * 16 * 2 + 64, ve_shadow_t::getSourceSize());
+	EXPECT_EQ(16u * 16 * 1 + 64, lambda_shadow_t::getSourceSize());
+
+	// rows start on cache lines
+	EXPECT_EQ(32u, alignof(ve_shadow_t));
+}
+
+// best of a few runs, seconds per call
+template <typename TFunc>
+static double timeIt(int count, TFunc func) {
+	double best = 1e9;
+
+	for (int run = 0; run < 5; run++) {
+		auto start = std::chrono::steady_clock::now();
+
+		for (int i = 0; i < count; i++) {
+			func(i);
+		}
+
+		double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		best = std::min(best, elapsed);
+	}
+
+	return best / count;
+}
+
+TEST(ShadowTables, Benchmark) {
+	EngineTestHelper eth(TEST_ENGINE);
+	setTables();
+
+	fuel_Map3D_t ve;
+	ve.init(config->veTable, config->veLoadBins, config->veRpmBins);
+	lambda_Map3D_t lambda;
+	lambda.init(config->lambdaTable, config->lambdaLoadBins, config->lambdaRpmBins);
+
+	ShadowTables dut;
+	dut.init();
+
+	const int count = 20000;
+	float packedSum = 0;
+	float shadowSum = 0;
+
+	// through the interface, same as the airmass models
+	const ValueProvider3D& packedVe = ve;
+	const ValueProvider3D& packedLambda = lambda;
+	const ValueProvider3D& shadowVe = dut.ve;
+	const ValueProvider3D& shadowLambda = dut.lambda;
+
+	double packed = timeIt(count, [&](int i) {
+		float rpm = 600 + (i & 0x1FFF);
+		float load = 25 + (i & 0xFF) * 0.8f;
+
+		packedSum += packedVe.getValue(rpm, load) + packedLambda.getValue(rpm, load) + getIgnition(rpm, load);
+	});
+
+	double shadow = timeIt(count, [&](int i) {
+		float rpm = 600 + (i & 0x1FFF);
+		float load = 25 + (i & 0xFF) * 0.8f;
+
+		shadowSum += shadowVe.getValue(rpm, load) + shadowLambda.getValue(rpm, load) + dut.ignition.getValue(rpm, load);
+	});
+
+	double rebuild = timeIt(100, [&](int) {
+		dut.ve.rebuild();
+		dut.lambda.rebuild();
+		dut.ignition.rebuild();
+	});
+
+	// same answers, only cheaper to get
+	EXPECT_NEAR(packedSum, shadowSum, packedSum * 1e-5f);
+	EXPECT_LT(shadow, packed);
+	// converting every cell once costs less than looking each of them up in the packed tables
+	EXPECT_LT(rebuild, packed * FUEL_RPM_COUNT * FUEL_LOAD_COUNT);
+}
+
+TEST(ShadowTables, Rebuild) {
+	EngineTestHelper eth(TEST_ENGINE);
+	setTables();
+
+	ShadowTables dut;
+	dut.init();
+
+	// through the interface, same as the airmass models
+	const ValueProvider3D& shadowVe = dut.ve;
+	const ValueProvider3D& shadowLambda = dut.lambda;
+
+	float ve = shadowVe.getValue(3000, 80);
+	float lambda = shadowLambda.getValue(3000, 80);
+	float ignition = dut.ignition.getValue(3000, 80);
+
+	dut.ve.rebuild();
+	dut.lambda.rebuild();
+	dut.ignition.rebuild();
+
+	EXPECT_FLOAT_EQ(ve, shadowVe.getValue(3000, 80));
+	EXPECT_FLOAT_EQ(lambda, shadowLambda.getValue(3000, 80));
+	EXPECT_FLOAT_EQ(ignition, dut.ignition.getValue(3000, 80));
+}
@@ -2,6 +2,7 @@
 
 #include "closed_loop_fuel_cell.h"
 #include "closed_loop_fuel.h"
+#include "long_term_fuel_trim.h"
 
 using ::testing::_;
 using ::testing::Return;
@@ -91,3 +92,142 @@ TEST(ClosedLoopFuel, afrLimits) {
 	Sensor::setMockValue(SensorType::Lambda1, 2.0f);
 	EXPECT_FALSE(shouldUpdateCorrection(SensorType::Lambda1));
 }
+
+static void setLtftAxes() {
+	for (size_t i = 0; i < FUEL_LOAD_COUNT; i++) {
+		config->veLoadBins[i] = 10 * (i + 1);
+	}
+
+	for (size_t i = 0; i < FUEL_RPM_COUNT; i++) {
+		config->veRpmBins[i] = 500 * (i + 1);
+	}
+}
+
+TEST(LongTermFuelTrim, ConvergesToConstantError) {
+	EngineTestHelper eth(TEST_ENGINE);
+	setLtftAxes();
+
+	LongTermFuelTrim dut;
+	dut.reset();
+
+	// exactly on a cell: 3000 rpm, 60 kPa
+	float rpm = 3000;
+	float load = 60;
+
+	// engine needs 10% more fuel than the VE table gives
+	float stft = 0;
+	float dt = FAST_CALLBACK_PERIOD_MS * 0.001f;
+
+	// 5 minutes
+	for (int i = 0; i < 60000; i++) {
+		float lambda = 1.1f / ((1 + stft) * dut.getTrim(0, rpm, load));
+
+		// short term integrator with a 1 second time constant
+		stft = clampF(-0.25f, stft + (lambda - 1) * dt, 0.25f);
+
+		dut.learn(0, rpm, load, stft, dt);
+	}
+
+	EXPECT_NEAR(1.1f, dut.getTrim(0, rpm, load), 0.002f);
+	// short term has handed the whole error over
+	EXPECT_NEAR(0, stft, 0.002f);
+
+	EXPECT_NEAR(0.1f, dut.getTable().trims[0][5][5], 0.002f);
+	// nothing learned next to it, or on the other bank
+	EXPECT_EQ(0, dut.getTable().trims[0][5][6]);
+	EXPECT_EQ(0, dut.getTable().trims[0][6][5]);
+	EXPECT_EQ(1, dut.getTrim(1, rpm, load));
+	EXPECT_TRUE(dut.isDirty());
+}
+
+TEST(LongTermFuelTrim, Weights) {
+	EngineTestHelper eth(TEST_ENGINE);
+	setLtftAxes();
+
+	LongTermFuelTrim dut;
+	dut.reset();
+
+	// middle of four cells, each takes a quarter of 10% * 3s / LTFT_TIME_CONSTANT
+	dut.learn(0, 3250, 65, 0.1f, 3);
+
+	const auto& trims = dut.getTable().trims[0];
+	float quarter = 0.25f * 0.1f * 3 / LTFT_TIME_CONSTANT;
+	EXPECT_FLOAT_EQ(quarter, trims[5][5]);
+	EXPECT_FLOAT_EQ(quarter, trims[5][6]);
+	EXPECT_FLOAT_EQ(quarter, trims[6][5]);
+	EXPECT_FLOAT_EQ(quarter, trims[6][6]);
+
+	EXPECT_FLOAT_EQ(1 + quarter, dut.getTrim(0, 3250, 65));
+	// a corner only sees its own cell
+	EXPECT_FLOAT_EQ(1 + quarter, dut.getTrim(0, 3000, 60));
+	EXPECT_FLOAT_EQ(1, dut.getTrim(0, 2500, 60));
+
+	// off the axes is clamped to the edge cells
+	dut.learn(0, 20000, 500, -0.2f, 1000);
+	EXPECT_FLOAT_EQ(-LTFT_MAX_TRIM, trims[FUEL_LOAD_COUNT - 1][FUEL_RPM_COUNT - 1]);
+	EXPECT_FLOAT_EQ(1 - LTFT_MAX_TRIM, dut.getTrim(0, 20000, 500));
+}
+
+TEST(LongTermFuelTrim, Storage) {
+	EngineTestHelper eth(TEST_ENGINE);
+	setLtftAxes();
+
+	LongTermFuelTrim learned;
+	learned.reset();
+	learned.learn(0, 3000, 60, 0.1f, 60);
+	learned.learn(1, 1000, 20, -0.05f, 60);
+
+	LtftStorage storage;
+	learned.save(storage);
+	EXPECT_FALSE(learned.isDirty());
+
+	LongTermFuelTrim dut;
+	EXPECT_TRUE(dut.load(storage));
+	EXPECT_FALSE(dut.isDirty());
+	EXPECT_EQ(0, memcmp(&learned.getTable(), &dut.getTable(), sizeof(LtftTable)));
+	EXPECT_FLOAT_EQ(learned.getTrim(1, 1000, 20), dut.getTrim(1, 1000, 20));
+
+	// a flipped bit is not loaded, the table starts over
+	LtftStorage corrupt = storage;
+	corrupt.table.trims[1][2][3] += 0.01f;
+	EXPECT_FALSE(dut.load(corrupt));
+	EXPECT_EQ(1, dut.getTrim(0, 3000, 60));
+	EXPECT_TRUE(dut.isDirty());
+
+	LtftStorage otherVersion = storage;
+	otherVersion.version++;
+	EXPECT_FALSE(dut.load(otherVersion));
+
+	// garbage which happens to carry a good CRC
+	LtftStorage outOfRange = storage;
+	outOfRange.table.trims[0][0][0] = 2 * LTFT_MAX_TRIM;
+	outOfRange.crc = crc32(&outOfRange, offsetof(LtftStorage, crc));
+	EXPECT_FALSE(dut.load(outOfRange));
+	EXPECT_EQ(1, dut.getTrim(0, 3000, 60));
+
+	LtftStorage notANumber = storage;
+	notANumber.table.trims[1][0][0] = NAN;
+	notANumber.crc = crc32(&notANumber, offsetof(LtftStorage, crc));
+	EXPECT_FALSE(dut.load(notANumber));
+
+	// learned on other axes
+	config->veRpmBins[3] += 10;
+	EXPECT_FALSE(dut.load(storage));
+}
+
+TEST(LongTermFuelTrim, AxesChange) {
+	EngineTestHelper eth(TEST_ENGINE);
+	setLtftAxes();
+
+	LongTermFuelTrim dut;
+	dut.reset();
+	dut.learn(0, 3000, 60, 0.1f, 60);
+
+	// an unrelated burn keeps the table
+	dut.onConfigurationChange(engineConfiguration);
+	EXPECT_NE(1, dut.getTrim(0, 3000, 60));
+
+	config->veLoadBins[0] = 5;
+	dut.onConfigurationChange(engineConfiguration);
+	EXPECT_EQ(1, dut.getTrim(0, 3000, 60));
+}
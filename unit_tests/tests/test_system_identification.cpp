@@ -0,0 +1,300 @@
+/**
+ * @file test_system_identification.cpp
+ *
+ * @date Oct 19, 2026
+ */
+
+#include "pch.h"
+
+#include "system_identification.h"
+#include "efi_pid.h"
+
+/**
+ * First order plus dead time plant, integrated in substeps of the loop period
+ */
+class FopdtPlant {
+public:
+	FopdtPlant(float gain, float timeConstant, float deadTime, float periodSeconds, float offset)
+		: m_gain(gain)
+		, m_timeConstant(timeConstant)
+		, m_period(periodSeconds)
+		, m_offset(offset)
+		, m_y(offset)
+	{
+		m_delaySubsteps = deadTime / (periodSeconds / SUBSTEPS) + 0.5f;
+	}
+
+	// output is held for one loop period
+	float step(float u) {
+		float dt = m_period / SUBSTEPS;
+
+		for (int i = 0; i < SUBSTEPS; i++) {
+			m_delayLine[m_delayIndex] = u;
+			int delayed = (m_delayIndex + MAX_DELAY - m_delaySubsteps) % MAX_DELAY;
+			m_delayIndex = (m_delayIndex + 1) % MAX_DELAY;
+
+			float target = m_offset + m_gain * m_delayLine[delayed];
+			m_y += (target - m_y) * dt / m_timeConstant;
+		}
+
+		return observe();
+	}
+
+	float observe() {
+		// deterministic noise, +-m_noise
+		m_seed = m_seed * 1103515245 + 12345;
+		float unit = ((m_seed >> 16) & 0x7FFF) / (float)0x7FFF;
+		return m_y + m_noise * (2 * unit - 1);
+	}
+
+	float m_noise = 0;
+
+private:
+	static constexpr int SUBSTEPS = 10;
+	static constexpr int MAX_DELAY = 1000;
+
+	float m_gain;
+	float m_timeConstant;
+	float m_period;
+	float m_offset;
+	float m_y;
+
+	float m_delayLine[MAX_DELAY] = {};
+	int m_delayIndex = 0;
+	int m_delaySubsteps;
+	uint32_t m_seed = 1;
+};
+
+TEST(SystemIdentification, LeastSquares) {
+	RecursiveLeastSquares dut;
+	dut.reset(1000);
+
+	float previous = 0;
+	for (int i = 0; i < 200; i++) {
+		float u = (i / 10) % 2 ? 5 : -5;
+		float y = 0.9f * previous + 0.3f * u + 2;
+
+		float regressor[RecursiveLeastSquares::Size] = { previous, u, 1 };
+		dut.update(regressor, y, 1);
+
+		previous = y;
+	}
+
+	EXPECT_NEAR(0.9f, dut.getParameter(0), 1e-3);
+	EXPECT_NEAR(0.3f, dut.getParameter(1), 1e-3);
+	EXPECT_NEAR(2, dut.getParameter(2), 1e-2);
+}
+
+static SysIdSettings makeThrottleSettings() {
+	SysIdSettings settings;
+	settings.periodSeconds = 0.002f;
+	settings.excitation = SysIdExcitation::Step;
+	settings.tuning = SysIdTuning::Pid;
+	settings.amplitude = 8;
+	settings.settleSeconds = 0.5f;
+	settings.exciteSeconds = 3;
+	settings.stepHoldSeconds = 0.15f;
+	settings.chirpStartHz = 0.5f;
+	settings.chirpEndHz = 20;
+	settings.maxDeviation = 30;
+	settings.closedLoopSeconds = 0.02f;
+	return settings;
+}
+
+// Runs a whole identification, the loop holds the plant with a PID until the excitation starts
+static void runIdentification(SystemIdentification& dut, FopdtPlant& plant, Pid& pid, float target, float periodSeconds) {
+	float y = plant.observe();
+
+	for (int i = 0; i < 100000 && dut.isRunning(); i++) {
+		float base = pid.getOutput(target, y, periodSeconds);
+		float u = dut.update(y, base);
+		y = plant.step(u);
+	}
+}
+
+static void expectGains(const SysIdResult& result, float k, float tau, float theta, float lambda, float tolerance) {
+	float kc = (2 * tau + theta) / (k * (2 * lambda + theta));
+	float ti = tau + 0.5f * theta;
+	float td = tau * theta / (2 * tau + theta);
+
+	EXPECT_NEAR(kc, result.pFactor, tolerance * kc);
+	EXPECT_NEAR(kc / ti, result.iFactor, tolerance * kc / ti);
+	EXPECT_NEAR(kc * td, result.dFactor, tolerance * kc * td);
+}
+
+TEST(SystemIdentification, ThrottleStep) {
+	SysIdSettings settings = makeThrottleSettings();
+
+	// % position per % duty around the spring, 40ms, 6ms
+	FopdtPlant plant(1.5f, 0.04f, 0.006f, settings.periodSeconds, 10);
+	plant.m_noise = 0.5f;
+
+	pid_s parameters = {};
+	parameters.pFactor = 2;
+	parameters.iFactor = 40;
+	parameters.minValue = -90;
+	parameters.maxValue = 90;
+	Pid pid(&parameters);
+
+	SystemIdentification dut;
+	dut.start(settings);
+	EXPECT_EQ(SysIdState::Settle, dut.getState());
+
+	runIdentification(dut, plant, pid, 50, settings.periodSeconds);
+
+	ASSERT_EQ(SysIdState::Done, dut.getState()) << getSysIdFailureName(dut.getResult().failure);
+
+	// operating point is where the PID held the plant
+	EXPECT_NEAR(50, dut.getOperatingObservation(), 0.5f);
+	EXPECT_NEAR(40 / 1.5f, dut.getOperatingOutput(), 1);
+
+	const auto& result = dut.getResult();
+	EXPECT_NEAR(1.5f, result.gain, 0.1f);
+	EXPECT_NEAR(0.04f, result.timeConstant, 0.004f);
+	EXPECT_NEAR(0.006f, result.deadTime, settings.periodSeconds);
+	EXPECT_GT(result.fit, 0.95f);
+
+	expectGains(result, 1.5f, 0.04f, 0.006f, 0.02f, 0.15f);
+}
+
+TEST(SystemIdentification, IdleChirp) {
+	SysIdSettings settings;
+	settings.periodSeconds = SLOW_CALLBACK_PERIOD_MS * 0.001f;
+	settings.excitation = SysIdExcitation::Chirp;
+	settings.tuning = SysIdTuning::Pi;
+	settings.amplitude = 3;
+	settings.settleSeconds = 5;
+	settings.exciteSeconds = 30;
+	settings.chirpStartHz = 0.05f;
+	settings.chirpEndHz = 1;
+	settings.maxDeviation = 300;
+	settings.closedLoopSeconds = 1;
+
+	// rpm per % valve, 600ms, 150ms, idling at 800 with 20%
+	FopdtPlant plant(25, 0.6f, 0.15f, settings.periodSeconds, 300);
+	plant.m_noise = 10;
+
+	pid_s parameters = {};
+	parameters.pFactor = 0.01f;
+	parameters.iFactor = 0.05f;
+	parameters.offset = 20;
+	parameters.minValue = 0;
+	parameters.maxValue = 100;
+	Pid pid(&parameters);
+
+	SystemIdentification dut;
+	dut.start(settings);
+	runIdentification(dut, plant, pid, 800, settings.periodSeconds);
+
+	ASSERT_EQ(SysIdState::Done, dut.getState()) << getSysIdFailureName(dut.getResult().failure);
+
+	const auto& result = dut.getResult();
+	EXPECT_NEAR(25, result.gain, 2.5f);
+	EXPECT_NEAR(0.6f, result.timeConstant, 0.1f);
+	EXPECT_NEAR(0.15f, result.deadTime, settings.periodSeconds);
+	EXPECT_EQ(0, result.dFactor);
+
+	// SIMC PI
+	float kc = 0.6f / (25 * (1 + 0.15f));
+	EXPECT_NEAR(kc, result.pFactor, 0.15f * kc);
+	EXPECT_NEAR(kc / 0.6f, result.iFactor, 0.2f * kc / 0.6f);
+
+	// and the new gains hold a step without oscillating
+	parameters.pFactor = result.pFactor;
+	parameters.iFactor = result.iFactor;
+	Pid tuned(&parameters);
+
+	float y = plant.observe();
+	float peak = 0;
+	for (int i = 0; i < 400; i++) {
+		y = plant.step(tuned.getOutput(900, y, settings.periodSeconds));
+		peak = maxF(peak, y);
+	}
+	EXPECT_NEAR(900, y, 15);
+	EXPECT_LT(peak, 940);
+}
+
+TEST(SystemIdentification, Deviation) {
+	SysIdSettings settings = makeThrottleSettings();
+	settings.maxDeviation = 5;
+
+	FopdtPlant plant(1.5f, 0.04f, 0.006f, settings.periodSeconds, 10);
+
+	pid_s parameters = {};
+	parameters.pFactor = 2;
+	parameters.iFactor = 40;
+	parameters.minValue = -90;
+	parameters.maxValue = 90;
+	Pid pid(&parameters);
+
+	SystemIdentification dut;
+	dut.start(settings);
+	runIdentification(dut, plant, pid, 50, settings.periodSeconds);
+
+	EXPECT_EQ(SysIdState::Failed, dut.getState());
+	EXPECT_EQ(SysIdFailure::Deviation, dut.getResult().failure);
+
+	// back to the regular loop output
+	EXPECT_EQ(12.5f, dut.update(50, 12.5f));
+}
+
+TEST(SystemIdentification, NoResponse) {
+	SysIdSettings settings = makeThrottleSettings();
+
+	// plant does not see the output, only noise
+	FopdtPlant plant(0, 0.04f, 0, settings.periodSeconds, 50);
+	plant.m_noise = 1;
+
+	pid_s parameters = {};
+	Pid pid(&parameters);
+
+	SystemIdentification dut;
+	dut.start(settings);
+	runIdentification(dut, plant, pid, 50, settings.periodSeconds);
+
+	EXPECT_EQ(SysIdFailure::PoorFit, dut.getResult().failure);
+}
+
+TEST(SystemIdentification, Abort) {
+	SystemIdentification dut;
+
+	// nothing to abort
+	dut.abort();
+	EXPECT_EQ(SysIdState::Idle, dut.getState());
+	EXPECT_EQ(3, dut.update(0, 3));
+
+	dut.start(makeThrottleSettings());
+	dut.update(0, 3);
+	dut.abort();
+	EXPECT_FALSE(dut.isRunning());
+	EXPECT_EQ(SysIdFailure::Aborted, dut.getResult().failure);
+}
+
+TEST(SystemIdentification, Excitation) {
+	SysIdSettings settings = makeThrottleSettings();
+
+	SystemIdentification dut;
+	dut.start(settings);
+
+	// 0.15s per level at 2ms
+	EXPECT_EQ(8, dut.getExcitation(0));
+	EXPECT_EQ(8, dut.getExcitation(74));
+	EXPECT_EQ(-8, dut.getExcitation(75));
+	EXPECT_EQ(8, dut.getExcitation(150));
+
+	settings.excitation = SysIdExcitation::Chirp;
+	dut.start(settings);
+	EXPECT_EQ(0, dut.getExcitation(0));
+
+	// 0.5Hz to 20Hz over 3s is 30.75 periods
+	int zeroCrossings = 0;
+	for (int i = 1; i < 1500; i++) {
+		float value = dut.getExcitation(i);
+		EXPECT_LE(absF(value), 8);
+
+		if ((value < 0) != (dut.getExcitation(i - 1) < 0)) {
+			zeroCrossings++;
+		}
+	}
+	EXPECT_NEAR(61, zeroCrossings, 2);
+}
@@ -0,0 +1,192 @@
+#include "pch.h"
+
+#include "traction_control.h"
+
+TEST(TractionControl, CutPatternRatio) {
+	RotatingCutPattern dut;
+
+	int cuts = 0;
+	int cutsPerCylinder[4] = {0};
+
+	// 100 engine cycles of a 4 cylinder engine
+	for (int cycle = 0; cycle < 100; cycle++) {
+		for (size_t i = 0; i < 4; i++) {
+			if (dut.shouldCut(0.25f, i)) {
+				cuts++;
+				cutsPerCylinder[i]++;
+			}
+		}
+	}
+
+	// burned slots hit cuts no more often than used slots, so the overall ratio holds
+	EXPECT_NEAR(cuts, 100 * 4 * 0.25f, 2);
+
+	// pattern rotates: every cylinder takes its share of cuts
+	for (size_t i = 0; i < 4; i++) {
+		EXPECT_GT(cutsPerCylinder[i], 10);
+	}
+}
+
+TEST(TractionControl, CutPatternDeterministic) {
+	RotatingCutPattern a;
+	RotatingCutPattern b;
+
+	for (int event = 0; event < 1000; event++) {
+		size_t index = event % 6;
+		EXPECT_EQ(a.shouldCut(0.37f, index), b.shouldCut(0.37f, index));
+	}
+}
+
+TEST(TractionControl, ZeroRatioNeverCuts) {
+	RotatingCutPattern dut;
+
+	for (int event = 0; event < 100; event++) {
+		EXPECT_FALSE(dut.shouldCut(0, event % 4));
+	}
+}
+
+TEST(TractionControl, SlipToCutRatio) {
+	EngineTestHelper eth(TEST_ENGINE);
+
+	TractionController dut;
+	dut.setSlipTargets(0.1f, 0.3f);
+
+	Sensor::setMockValue(SensorType::AuxSpeed2, 1000);
+
+	// Below target slip: no cut
+	Sensor::setMockValue(SensorType::AuxSpeed1, 1050);
+	dut.onWheelSpeedEdge(getTimeNowNt());
+	EXPECT_NEAR(dut.getSlip(), 0.05f, 1e-4);
+	EXPECT_EQ(dut.getCutRatio(), 0);
+
+	// Half way between target and full cut
+	Sensor::setMockValue(SensorType::AuxSpeed1, 1200);
+	dut.onWheelSpeedEdge(getTimeNowNt());
+	EXPECT_NEAR(dut.getCutRatio(), 0.5f, 1e-4);
+
+	// Way above full cut, limited by max cut ratio
+	dut.setMaxCutRatio(0.8f);
+	Sensor::setMockValue(SensorType::AuxSpeed1, 2000);
+	dut.onWheelSpeedEdge(getTimeNowNt());
+	EXPECT_NEAR(dut.getCutRatio(), 0.8f, 1e-4);
+
+	// Stationary car: no slip reported
+	Sensor::setMockValue(SensorType::AuxSpeed2, 10);
+	dut.onWheelSpeedEdge(getTimeNowNt());
+	EXPECT_EQ(dut.getCutRatio(), 0);
+}
+
+TEST(TractionControl, SlipToCutLatency) {
+	EngineTestHelper eth(TEST_ENGINE);
+
+	TractionController dut;
+	dut.setSlipTargets(0.05f, 0.1f);
+
+	Sensor::setMockValue(SensorType::AuxSpeed1, 1000);
+	Sensor::setMockValue(SensorType::AuxSpeed2, 1000);
+	dut.onWheelSpeedEdge(getTimeNowNt());
+
+	// No slip, nothing is cut
+	for (size_t i = 0; i < 8; i++) {
+		EXPECT_FALSE(dut.shouldSkipSpark(i % 4));
+	}
+
+	// Driven wheel breaks loose on a single wheel speed edge
+	Sensor::setMockValue(SensorType::AuxSpeed1, 1500);
+	dut.onWheelSpeedEdge(getTimeNowNt());
+	EXPECT_EQ(dut.slipDetectedNt, getTimeNowNt());
+
+	// Intervention happens on the very next firing event
+	int eventsUntilCut = 0;
+	while (!dut.shouldSkipSpark(1 + eventsUntilCut % 3)) {
+		eventsUntilCut++;
+		ASSERT_LT(eventsUntilCut, 10);
+	}
+	EXPECT_EQ(eventsUntilCut, 0);
+	EXPECT_EQ(dut.sparkCutCounter, 1u);
+
+	// Fuel mode cuts fuel instead of spark
+	dut.setUseFuelCut(true);
+	EXPECT_FALSE(dut.shouldSkipSpark(2));
+	EXPECT_TRUE(dut.shouldSkipFuel(3));
+}
+
+TEST(TractionControl, DisabledByDefault) {
+	EngineTestHelper eth(TEST_ENGINE);
+
+	TractionController dut;
+	EXPECT_FALSE(dut.isEnabled());
+
+	Sensor::setMockValue(SensorType::AuxSpeed1, 3000);
+	Sensor::setMockValue(SensorType::AuxSpeed2, 1000);
+	dut.onWheelSpeedEdge(getTimeNowNt());
+
+	EXPECT_EQ(dut.getCutRatio(), 0);
+	EXPECT_FALSE(dut.shouldSkipSpark(0));
+}
+
+TEST(TractionControl, FirstEventCutsForAnyRatio) {
+	for (float ratio : { 0.05f, 0.1f, 0.25f, 0.37f, 0.5f, 0.9f }) {
+		RotatingCutPattern dut;
+
+		// no burned slots here, index 0 is never used
+		EXPECT_TRUE(dut.shouldCut(ratio, 1)) << ratio;
+
+		// and from then on within one cut of ratio * events
+		int cuts = 1;
+		for (int event = 2; event <= 200; event++) {
+			if (dut.shouldCut(ratio, 1 + event % 3)) {
+				cuts++;
+			}
+
+			EXPECT_LE(std::abs(cuts - ratio * event), 1 + 1e-4f) << ratio << " at " << event;
+		}
+	}
+}
+
+TEST(TractionControl, CutRestartsImmediately) {
+	RotatingCutPattern dut;
+
+	EXPECT_TRUE(dut.shouldCut(0.2f, 1));
+	EXPECT_FALSE(dut.shouldCut(0.2f, 2));
+
+	// slip went away and came back
+	EXPECT_FALSE(dut.shouldCut(0, 3));
+	EXPECT_TRUE(dut.shouldCut(0.2f, 1));
+}
+
+struct MockTractionWallController : public IWallFuelController {
+	MOCK_METHOD(bool, getEnable, (), (const, override));
+	MOCK_METHOD(float, getAlpha, (), (const, override));
+	MOCK_METHOD(float, getBeta, (), (const, override));
+};
+
+TEST(TractionControl, FuelCutKeepsWallWetting) {
+	EngineTestHelper eth(TEST_ENGINE);
+
+	MockTractionWallController wallController;
+	EXPECT_CALL(wallController, getEnable()).WillRepeatedly(Return(true));
+	EXPECT_CALL(wallController, getAlpha()).WillRepeatedly(Return(0.5f));
+	EXPECT_CALL(wallController, getBeta()).WillRepeatedly(Return(0.25f));
+	engine->engineModules.get<WallFuelController>().set(&wallController);
+
+	auto& tc = engine->tractionController;
+	tc.setSlipTargets(0.05f, 0.1f);
+	tc.setUseFuelCut(true);
+	Sensor::setMockValue(SensorType::AuxSpeed1, 1500);
+	Sensor::setMockValue(SensorType::AuxSpeed2, 1000);
+	tc.onWheelSpeedEdge(getTimeNowNt());
+
+	InjectionEvent& event = engine->injectionEvents.elements[0];
+	event.injectionStartAngle = 100;
+	event.wallFuel.wallFuel = 1;
+
+	event.onTriggerTooth(1200, getTimeNowNt(), 90, 110);
+
+	EXPECT_EQ(1u, tc.fuelCutCounter);
+	// nothing injected, half of the film evaporated in to the cylinder
+	EXPECT_EQ(1, event.wallFuel.invocationCounter);
+	EXPECT_NEAR(0.5f, event.wallFuel.getWallFuel(), EPS4D);
+
+	tc.setSlipTargets(0, 0);
+}
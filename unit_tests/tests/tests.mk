@@ -1,5 +1,7 @@
 TESTS_SRC_CPP = \
 	tests/trigger/test_all_triggers.cpp \
+	tests/trigger/test_trigger_benchmark.cpp \
+	tests/trigger/test_gap_signature_sync.cpp \
 	tests/trigger/test_symmetrical_crank.cpp \
 	tests/trigger/test_trigger_decoder.cpp \
 	tests/trigger/test_trigger_decoder_2.cpp \
@@ -17,6 +19,8 @@ TESTS_SRC_CPP = \
 	tests/trigger/test_real_nb2_cranking.cpp \
 	tests/trigger/test_real_gm_24x.cpp \
 	tests/trigger/test_real_k24a2.cpp \
+	tests/trigger/test_predictive_rpm.cpp \
+	tests/trigger/test_binary_capture.cpp \
 	tests/trigger/test_map_cam.cpp \
 	tests/trigger/test_rpm_multiplier.cpp \
 	tests/trigger/test_quad_cam.cpp \
@@ -27,6 +31,9 @@ TESTS_SRC_CPP = \
 	tests/ignition_injection/test_startOfCrankingPrimingPulse.cpp \
 	tests/ignition_injection/test_multispark.cpp \
 	tests/ignition_injection/test_ignition_scheduling.cpp \
+	tests/ignition_injection/test_event_sync_calc.cpp \
+	tests/ignition_injection/test_tooth_plan.cpp \
+	tests/ignition_injection/test_cylinder_trims.cpp \
 	tests/ignition_injection/test_fuelCut.cpp \
 	tests/ignition_injection/test_fuel_computer.cpp \
 	tests/ignition_injection/test_injector_model.cpp \
@@ -42,10 +49,18 @@ TESTS_SRC_CPP = \
 	tests/test_change_engine_type.cpp \
 	tests/util/test_scaled_channel.cpp \
 	tests/util/test_timer.cpp \
+	tests/util/test_cic_decimator.cpp \
+	tests/util/test_integer_pid.cpp \
 	tests/system/test_periodic_thread_controller.cpp \
+	tests/system/test_staged_init.cpp \
 	tests/test_util.cpp \
 	tests/test_start_stop.cpp \
 	tests/test_hardware_reinit.cpp \
+	tests/test_config_journal.cpp \
+	tests/test_config_change_tracker.cpp \
+	tests/test_config_write_observer.cpp \
+	tests/test_shadow_tables.cpp \
+	tests/test_cached_correction.cpp \
 	tests/test_ion.cpp \
 	tests/test_hip9011.cpp \
 	tests/test_engine_math.cpp \
@@ -54,6 +69,7 @@ TESTS_SRC_CPP = \
 	tests/test_idle_controller.cpp \
 	tests/test_issue_898.cpp \
 	tests/test_launch.cpp \
+	tests/test_traction_control.cpp \
 	tests/test_fuel_map.cpp \
 	tests/test_gear_detector.cpp \
 	tests/ignition_injection/test_fuel_wall_wetting.cpp \
@@ -64,13 +80,16 @@ TESTS_SRC_CPP = \
 	tests/test_signal_executor.cpp \
 	tests/test_cpp_memory_layout.cpp \
 	tests/test_pid_auto.cpp \
+	tests/test_system_identification.cpp \
 	tests/test_pid.cpp \
 	tests/test_accel_enrichment.cpp \
 	tests/test_gpiochip.cpp \
 	tests/test_deadband.cpp \
 	tests/test_knock.cpp \
 	tests/sensor/basic_sensor.cpp \
+	tests/sensor/sensor_history.cpp \
 	tests/sensor/func_sensor.cpp \
+	tests/sensor/test_typed_functional_sensor.cpp \
 	tests/sensor/function_pointer_sensor.cpp \
 	tests/sensor/mock_sensor.cpp \
 	tests/sensor/sensor_reader.cpp \
@@ -85,6 +104,7 @@ TESTS_SRC_CPP = \
 	tests/test_stft.cpp \
 	tests/test_hpfp.cpp \
 	tests/test_hpfp_integrated.cpp \
+	tests/test_angle_sync_sampler.cpp \
 	tests/test_fuel_math.cpp \
 	tests/test_binary_log.cpp \
 	tests/test_dynoview.cpp \
@@ -101,6 +121,7 @@ TESTS_SRC_CPP = \
 	tests/actuators/test_boost.cpp \
 	tests/actuators/test_dc_motor.cpp \
 	tests/actuators/test_etb.cpp \
+	tests/actuators/test_etb_inner_loop.cpp \
 	tests/actuators/test_fan_control.cpp \
 	tests/actuators/test_fuel_pump.cpp \
 	tests/actuators/test_gppwm.cpp \
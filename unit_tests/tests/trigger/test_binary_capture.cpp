@@ -0,0 +1,137 @@
+#include "pch.h"
+
+#include "logicdata_csv_reader.h"
+#include "logicdata_binary.h"
+
+#define K24_CAPTURE "tests/trigger/resources/cranking_honda_k24a2_no_plugs.csv"
+
+static void setupK24(EngineTestHelper& eth) {
+	engineConfiguration->isFasterEngineSpinUpEnabled = true;
+	engineConfiguration->alwaysInstantRpm = true;
+
+	eth.setTriggerType(TT_HONDA_K_12_1);
+}
+
+TEST(binaryCapture, roundTripMatchesCsv) {
+	int indeces[1] = {0};
+	const char *binaryFile = "unittest_k24a2.rcb";
+
+	int64_t edgeCount = convertCsvToBinaryCapture(K24_CAPTURE, binaryFile, 1, 0, indeces);
+	ASSERT_GT(edgeCount, 0);
+
+	// decode CSV the slow way to compare edge by edge
+	CsvReader csv(1, 0);
+	csv.open(K24_CAPTURE, indeces);
+
+	BinaryCaptureReader reader;
+	ASSERT_TRUE(reader.open(binaryFile));
+	EXPECT_EQ(reader.header().edgeCount, (uint64_t)edgeCount);
+
+	bool state = false;
+	while (csv.haveMore()) {
+		double timeStamp;
+		bool newState[TRIGGER_INPUT_PIN_COUNT];
+		ASSERT_TRUE(csv.parseLine(&timeStamp, newState, nullptr));
+		if (newState[0] == state) {
+			continue;
+		}
+		state = newState[0];
+
+		CaptureEdge edge;
+		ASSERT_TRUE(reader.readEdge(&edge));
+		EXPECT_EQ(edge.channel, 0);
+		EXPECT_EQ(edge.state, state);
+		EXPECT_EQ(edge.timeNs, std::llround(timeStamp * 1e9));
+	}
+
+	EXPECT_FALSE(reader.haveMore());
+}
+
+TEST(binaryCapture, replayK24) {
+	int indeces[1] = {0};
+	const char *binaryFile = "unittest_k24a2_replay.rcb";
+	ASSERT_GT(convertCsvToBinaryCapture(K24_CAPTURE, binaryFile, 1, 0, indeces), 0);
+
+	BinaryCaptureReader reader;
+	ASSERT_TRUE(reader.open(binaryFile));
+
+	EngineTestHelper eth(TEST_ENGINE);
+	setupK24(eth);
+
+	while (reader.haveMore()) {
+		reader.processEdge(&eth);
+
+		engine->rpmCalculator.onSlowCallback();
+	}
+
+	// same expectation as realk24.crankingNoPlugs1 which replays the CSV, edge timestamps
+	// may differ from CSV replay by sub-microsecond rounding
+	ASSERT_EQ(0, eth.recentWarnings()->getCount());
+	ASSERT_NEAR(188, Sensor::getOrZero(SensorType::Rpm), 1);
+}
+
+TEST(binaryCapture, rejectsGarbage) {
+	uint8_t garbage[64] = {1, 2, 3};
+
+	BinaryCaptureReader reader;
+	EXPECT_FALSE(reader.open(garbage, sizeof(garbage)));
+	EXPECT_FALSE(reader.open("tests/trigger/resources/does_not_exist.rcb"));
+}
+
+TEST(binaryCapture, rejectsTimeGoingBackwards) {
+	const char *csvFile = "unittest_backwards.csv";
+	FILE *fp = fopen(csvFile, "w");
+	ASSERT_TRUE(fp != nullptr);
+	fprintf(fp, "Time [s],Channel 0\n");
+	fprintf(fp, "0.001,1\n");
+	fprintf(fp, "0.002,0\n");
+	fprintf(fp, "0.0015,1\n");
+	fprintf(fp, "0.003,0\n");
+	fclose(fp);
+
+	int indeces[1] = {0};
+	EXPECT_EQ(-1, convertCsvToBinaryCapture(csvFile, "unittest_backwards.rcb", 1, 0, indeces));
+}
+
+TEST(binaryCapture, decodeLongCapture) {
+	// synthetic multi-minute 60-2 capture at 6000 rpm: 100 revolutions per second
+	std::vector<uint8_t> data(sizeof(capture_header_s));
+	capture_header_s header{};
+	header.magic = CAPTURE_MAGIC;
+	header.version = CAPTURE_VERSION;
+	header.triggerCount = 1;
+
+	int seconds = 180;
+	int64_t totalNs = 0;
+	for (int rev = 0; rev < 100 * seconds; rev++) {
+		for (int tooth = 0; tooth < 58 * 2; tooth++) {
+			uint64_t deltaNs = tooth == 0 ? 3 * 83333 : 83333;
+			totalNs += deltaNs;
+			uint64_t value = deltaNs << CAPTURE_CHANNEL_BITS;
+			while (value >= 0x80) {
+				data.push_back((uint8_t)(value | 0x80));
+				value >>= 7;
+			}
+			data.push_back((uint8_t)value);
+			header.edgeCount++;
+		}
+	}
+	memcpy(data.data(), &header, sizeof(header));
+
+	// three bytes per edge at most, a CSV line is five times that
+	EXPECT_LE(data.size() - sizeof(header), 3 * header.edgeCount);
+
+	BinaryCaptureReader reader;
+	ASSERT_TRUE(reader.open(data.data(), data.size()));
+
+	CaptureEdge edge;
+	uint64_t decoded = 0;
+	while (reader.readEdge(&edge)) {
+		decoded++;
+	}
+
+	EXPECT_EQ(decoded, header.edgeCount);
+	EXPECT_EQ(totalNs, edge.timeNs);
+	// even number of toggles on the only channel
+	EXPECT_FALSE(edge.state);
+}
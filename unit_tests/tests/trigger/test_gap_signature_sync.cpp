@@ -0,0 +1,136 @@
+/**
+ * @file test_gap_signature_sync.cpp
+ */
+#include "pch.h"
+
+#include "trigger_benchmark.h"
+
+TEST(GapSignatureSync, signature60_2) {
+	EngineTestHelper eth(TEST_ENGINE);
+	eth.setTriggerType(TT_TOOTHED_WHEEL_60_2);
+
+	const TriggerGapSignature& signature = engine->triggerCentral.triggerShapeGapSignature;
+	ASSERT_EQ(58u, signature.length);
+
+	int syncPosition = -1;
+	for (size_t i = 0; i < signature.length; i++) {
+		if (signature.index[i] == 0) {
+			EXPECT_EQ(-1, syncPosition) << "single sync point expected";
+			syncPosition = i;
+		}
+	}
+	ASSERT_EQ(57, syncPosition);
+	EXPECT_NEAR(3, signature.ratio[syncPosition], 0.01);
+	// the tooth right after the gap
+	EXPECT_NEAR(1.0 / 3, signature.ratio[0], 0.01);
+	EXPECT_NEAR(1, signature.ratio[10], 0.01);
+}
+
+TEST(GapSignatureSync, match60_2) {
+	EngineTestHelper eth(TEST_ENGINE);
+	eth.setTriggerType(TT_TOOTHED_WHEEL_60_2);
+
+	const TriggerWaveform& shape = engine->triggerCentral.triggerShape;
+
+	// most recent first: gap tooth then two regular teeth
+	uint32_t atGap[] = { 3000, 1000, 1000 };
+	EXPECT_EQ(57, shape.matchGapSignature(atGap, efi::size(atGap)));
+
+	// first tooth after the gap
+	uint32_t afterGap[] = { 1000, 3000, 1000 };
+	EXPECT_EQ(0, shape.matchGapSignature(afterGap, efi::size(afterGap)));
+
+	// regular teeth only: ambiguous
+	uint32_t regular[] = { 1000, 1000, 1000, 1000 };
+	EXPECT_EQ(-1, shape.matchGapSignature(regular, efi::size(regular)));
+
+	// nothing in 60-2 looks like this
+	uint32_t noise[] = { 1000, 5000, 1000 };
+	EXPECT_EQ(-1, shape.matchGapSignature(noise, efi::size(noise)));
+}
+
+TEST(GapSignatureSync, noSignatureWithoutSyncNeeded) {
+	EngineTestHelper eth(TEST_ENGINE);
+	eth.setTriggerType(TT_ONE);
+
+	EXPECT_EQ(0u, engine->triggerCentral.triggerShape.getGapSignatureLength());
+}
+
+TEST(GapSignatureSync, onlyPrimaryShape) {
+	EngineTestHelper eth(TEST_ENGINE);
+
+	EXPECT_EQ(&engine->triggerCentral.triggerShapeGapSignature, engine->triggerCentral.triggerShape.gapSignature);
+	for (auto& vvtShape : engine->triggerCentral.vvtShape) {
+		EXPECT_EQ(nullptr, vvtShape.gapSignature);
+	}
+}
+
+TEST(GapSignatureSync, historyCoversWholeSignature) {
+	EngineTestHelper eth(TEST_ENGINE);
+	eth.setTriggerType(TT_TOOTHED_WHEEL_60_2);
+	engine->primaryTriggerConfiguration.UseGapSignatureSync = true;
+
+	auto& state = engine->triggerCentral.triggerState;
+	size_t signatureLength = engine->triggerCentral.triggerShape.getGapSignatureLength();
+
+	// regular teeth only, ambiguous however long the history is
+	eth.fireTriggerEvents2(40, 1);
+	ASSERT_FALSE(state.getShaftSynchronized());
+	// far more than the gaps isSyncPoint looks at
+	EXPECT_GT(state.gapSignatureHistoryCount, (size_t)GAP_TRACKING_LENGTH + 1);
+
+	eth.fireTriggerEvents2(40, 1);
+	ASSERT_FALSE(state.getShaftSynchronized());
+	EXPECT_EQ(signatureLength + 1, state.gapSignatureHistoryCount);
+}
+
+/**
+ * Compares sync acquisition latency with and without gap signature matching, starting from
+ * random positions within the wheel
+ */
+TEST(GapSignatureSync, acquisitionLatency) {
+	uint64_t legacyTeethTotal = 0;
+	uint64_t signatureTeethTotal = 0;
+
+	for (int type = 1; type < TT_UNUSED; type++) {
+		auto tt = (trigger_type_e)type;
+
+		int legacyTeeth = 0;
+		int signatureTeeth = 0;
+		bool isValid = true;
+
+		for (uint32_t seed = 0; seed < 8; seed++) {
+			TriggerBenchmarkConfig config;
+			config.rpmStart = 300;
+			config.rpmEnd = 300;
+			config.cycles = 6;
+			config.seed = seed;
+
+			auto legacy = runTriggerBenchmark(tt, config);
+			config.useGapSignatureSync = true;
+			auto signature = runTriggerBenchmark(tt, config);
+
+			if (!legacy.isValidShape || legacy.syncAcquisitionTeeth < 0) {
+				isValid = false;
+				break;
+			}
+
+			ASSERT_GE(signature.syncAcquisitionTeeth, 1) << getTrigger_type_e(tt);
+			EXPECT_LE(signature.syncAcquisitionTeeth, legacy.syncAcquisitionTeeth) << getTrigger_type_e(tt);
+			EXPECT_EQ(0u, signature.syncLossCount) << getTrigger_type_e(tt);
+			EXPECT_EQ(0u, signature.triggerErrorCount) << getTrigger_type_e(tt);
+
+			legacyTeeth += legacy.syncAcquisitionTeeth;
+			signatureTeeth += signature.syncAcquisitionTeeth;
+		}
+
+		if (!isValid) {
+			continue;
+		}
+
+		legacyTeethTotal += legacyTeeth;
+		signatureTeethTotal += signatureTeeth;
+	}
+
+	EXPECT_LT(signatureTeethTotal, legacyTeethTotal);
+}
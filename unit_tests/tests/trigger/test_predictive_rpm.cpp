@@ -0,0 +1,186 @@
+/*
+ * @file test_predictive_rpm.cpp
+ *
+ * Angle to time conversion: constant 'oneDegreeUs' versus per-tooth ToothSpeedEstimator
+ */
+
+#include "pch.h"
+
+#include "logicdata_csv_reader.h"
+
+#include <vector>
+
+TEST(predictiveRpm, constantAcceleration) {
+	// 200 RPM plus 2000 RPM per second, 6 degree teeth
+	double speed = 1200e-6; // degrees per us
+	double acceleration = 12000e-12; // degrees per us^2
+	auto toothTimeUs = [&](double angle) {
+		return (-speed + sqrt(speed * speed + 2 * acceleration * angle)) / acceleration;
+	};
+
+	ToothSpeedEstimator estimator;
+	ASSERT_FALSE(estimator.isValid());
+
+	int toothCount = 120;
+	for (int i = 0; i <= toothCount; i++) {
+		estimator.onToothEvent(fmod(6 * i, 360), 360, (efitick_t)(toothTimeUs(6 * i) * US_TO_NT_MULTIPLIER));
+	}
+	ASSERT_TRUE(estimator.isValid());
+
+	double lastToothUs = toothTimeUs(6 * toothCount);
+	double exactUs = toothTimeUs(6 * (toothCount + 2)) - lastToothUs;
+	// what we get assuming the speed measured over the last gap does not change
+	double constantSpeedUs = 2 * (lastToothUs - toothTimeUs(6 * (toothCount - 1)));
+
+	EXPECT_NEAR(exactUs, estimator.getAngleDelayUs(estimator.getLastToothNt(), 12), 0.5);
+	EXPECT_GT(constantSpeedUs - exactUs, 5);
+	EXPECT_NEAR(acceleration, estimator.getDegreesPerUs2(), acceleration * 0.01);
+
+	estimator.reset();
+	EXPECT_FALSE(estimator.isValid());
+	EXPECT_TRUE(cisnan(estimator.getAngleDelayUs(0, 10)));
+}
+
+/**
+ * Engine catches at 200 RPM, revs up at 3000 RPM per second and settles at 1000 RPM. Right after the
+ * speed levels off the last teeth still report acceleration, which must not be carried over the whole
+ * distance to a spark or injection event.
+ */
+TEST(predictiveRpm, sparkAndInjectionHorizon) {
+	const int cycles = 12;
+	std::vector<double> angleTimeUs(720 * cycles + 1);
+	double speed = 1200e-6; // degrees per us
+	for (size_t angle = 1; angle < angleTimeUs.size(); angle++) {
+		double stepUs = 1 / speed;
+		angleTimeUs[angle] = angleTimeUs[angle - 1] + stepUs;
+		speed = std::min(6000e-6, speed + 18000e-12 * stepUs);
+	}
+
+	// spark is scheduled up to a couple of teeth ahead, injection up to a whole cycle
+	for (int horizon : { 60, 360, 720 }) {
+		ToothSpeedEstimator estimator;
+		double predictiveMaxDegrees = 0;
+		double legacyMaxDegrees = 0;
+
+		for (int angle = 0; angle + horizon < (int)angleTimeUs.size(); angle += 10) {
+			estimator.onToothEvent(angle % 720, 720, (efitick_t)(angleTimeUs[angle] * US_TO_NT_MULTIPLIER));
+			if (angle < 720) {
+				continue;
+			}
+
+			double actualUs = angleTimeUs[angle + horizon] - angleTimeUs[angle];
+			// oneDegreeUs is an average over the last engine cycle
+			double legacyUs = (angleTimeUs[angle] - angleTimeUs[angle - 720]) / 720 * horizon;
+			double predictedUs = estimator.getAngleDelayUs(estimator.getLastToothNt(), horizon);
+			ASSERT_FALSE(cisnan(predictedUs));
+
+			predictiveMaxDegrees = std::max(predictiveMaxDegrees, std::abs(predictedUs - actualUs) / actualUs * horizon);
+			legacyMaxDegrees = std::max(legacyMaxDegrees, std::abs(legacyUs - actualUs) / actualUs * horizon);
+		}
+
+		EXPECT_LT(predictiveMaxDegrees, legacyMaxDegrees / 5) << horizon;
+		// acceleration extrapolated over the whole horizon is off by almost twice as much
+		EXPECT_LT(predictiveMaxDegrees, horizon / 14.0) << horizon;
+	}
+}
+
+struct AngleErrorStats {
+	int count = 0;
+	double legacyDegrees = 0;
+	double predictiveDegrees = 0;
+};
+
+/**
+ * For each tooth predict when the next one would happen, once using 'oneDegreeUs' as scheduleByAngle() does today
+ * and once using ToothSpeedEstimator. Timing error is converted into crank angle error at the actual speed.
+ */
+static AngleErrorStats replayK24(const char *fileName) {
+	CsvReader reader(1, /* vvtCount */ 0);
+	int indeces[1] = {0};
+
+	reader.open(fileName, indeces);
+	EngineTestHelper eth(TEST_ENGINE);
+	engineConfiguration->isFasterEngineSpinUpEnabled = true;
+	engineConfiguration->alwaysInstantRpm = true;
+	// for VR we only handle rises
+	engineConfiguration->useOnlyRisingEdgeForTrigger = true;
+	eth.setTriggerType(TT_HONDA_K_12_1);
+
+	angle_t engineCycle = getEngineCycle(engine->getOperationMode());
+	const ToothSpeedEstimator& estimator = engine->rpmCalculator.toothSpeed;
+
+	AngleErrorStats stats;
+	ToothSpeedEstimator previous;
+	float previousOneDegreeUs = NAN;
+
+	while (reader.haveMore()) {
+		reader.processLine(&eth);
+		engine->rpmCalculator.onSlowCallback();
+
+		if (estimator.getLastToothNt() == previous.getLastToothNt()) {
+			// not a tooth we are scheduling from
+			continue;
+		}
+
+		if (previous.isValid() && previousOneDegreeUs > 0) {
+			angle_t angle = estimator.getLastToothAngle() - previous.getLastToothAngle();
+			if (angle < 0) {
+				angle += engineCycle;
+			}
+			floatus_t actualUs = NT2USF(estimator.getLastToothNt() - previous.getLastToothNt());
+			floatus_t legacyUs = previousOneDegreeUs * angle;
+			floatus_t predictedUs = previous.getAngleDelayUs(previous.getLastToothNt(), angle);
+
+			stats.legacyDegrees += absF(legacyUs - actualUs) / actualUs * angle;
+			stats.predictiveDegrees += absF(predictedUs - actualUs) / actualUs * angle;
+			stats.count++;
+		}
+
+		previous = estimator;
+		previousOneDegreeUs = engine->rpmCalculator.oneDegreeUs;
+	}
+
+	stats.legacyDegrees /= stats.count;
+	stats.predictiveDegrees /= stats.count;
+	return stats;
+}
+
+TEST(predictiveRpm, realCrankingK24) {
+	for (auto fileName : { "tests/trigger/resources/cranking_honda_k24a2_no_plugs.csv",
+			"tests/trigger/resources/cranking_honda_k24a2_no_plugs_2.csv" }) {
+		AngleErrorStats stats = replayK24(fileName);
+
+		ASSERT_GT(stats.count, 100) << fileName;
+		EXPECT_LT(stats.predictiveDegrees, stats.legacyDegrees) << fileName;
+	}
+}
+
+TEST(predictiveRpm, scheduleByAngleUsesPrediction) {
+	EngineTestHelper eth(TEST_ENGINE);
+	engine->rpmCalculator.oneDegreeUs = 100;
+
+	// accelerating crank: every 10 degree tooth gap is 2% shorter than the previous one
+	ToothSpeedEstimator& estimator = engine->rpmCalculator.toothSpeed;
+	efitick_t toothNt = 0;
+	float gapUs = 2000;
+	for (int i = 1; i < 30; i++) {
+		toothNt += USF2NT(gapUs);
+		estimator.onToothEvent(fmod(10 * i, 720), 720, toothNt);
+		gapUs *= 0.98;
+	}
+	ASSERT_TRUE(estimator.isValid());
+
+	scheduling_s legacy;
+	scheduling_s predictive;
+
+	efitick_t legacyNt = scheduleByAngle(&legacy, toothNt, 30, action_s());
+	EXPECT_EQ(toothNt + US2NT(3000), legacyNt);
+
+	engineConfiguration->predictiveAngleScheduling = true;
+	efitick_t predictiveNt = scheduleByAngle(&predictive, toothNt, 30, action_s());
+	EXPECT_EQ(toothNt + (int32_t)USF2NT(estimator.getAngleDelayUs(toothNt, 30)), predictiveNt);
+	// three more teeth, each shorter than the last one
+	EXPECT_LT(predictiveNt - toothNt, USF2NT(3 * gapUs / 0.98));
+
+	eth.clearQueue();
+}
@@ -0,0 +1,56 @@
+/**
+ * @file test_trigger_benchmark.cpp
+ *
+ * Regression guard on top of trigger_benchmark: clean signal has to sync within two cycles
+ * and never lose sync, noisy signal must not crash the decoder.
+ */
+#include "pch.h"
+
+#include "trigger_benchmark.h"
+
+class TriggerBenchmarkFixture : public ::testing::TestWithParam<trigger_type_e> {
+};
+
+INSTANTIATE_TEST_SUITE_P(
+	Triggers,
+	TriggerBenchmarkFixture,
+	::testing::Range((trigger_type_e)1, TT_UNUSED)
+);
+
+TEST_P(TriggerBenchmarkFixture, CleanSignalConstantRpm) {
+	TriggerBenchmarkConfig config;
+	config.rpmStart = 3000;
+	config.rpmEnd = 3000;
+	config.cycles = 20;
+
+	auto result = runTriggerBenchmark(GetParam(), config);
+	if (!result.isValidShape) {
+		return;
+	}
+
+	EXPECT_GT(result.edges, 0u);
+	EXPECT_GE(result.syncAcquisitionTeeth, 1);
+	EXPECT_LE((uint32_t)result.syncAcquisitionTeeth, 2 * result.edges / config.cycles + 1);
+	EXPECT_EQ(result.syncLossCount, 0u);
+}
+
+TEST_P(TriggerBenchmarkFixture, NoisySweepDoesNotCrash) {
+	TriggerBenchmarkConfig config;
+	config.rpmStart = 100;
+	config.rpmEnd = 9000;
+	config.cycles = 10;
+	config.jitter = 0.1;
+	config.noiseProbability = 0.05;
+	config.seed = 12345;
+
+	auto result = runTriggerBenchmark(GetParam(), config);
+	if (!result.isValidShape) {
+		return;
+	}
+
+	EXPECT_GT(result.edges, 0u);
+}
+
+TEST(TriggerBenchmark, Fuzz) {
+	EXPECT_EQ(0, runTriggerFuzz(50, 2022));
+}
@@ -0,0 +1,75 @@
+#include "pch.h"
+
+#include "cic_decimator.h"
+
+TEST(CicDecimator, PassThrough) {
+	CicDecimator dut;
+	dut.configure(1);
+
+	EXPECT_TRUE(dut.feed(1234));
+	EXPECT_EQ(1234, dut.get());
+}
+
+TEST(CicDecimator, ConstantInput) {
+	CicDecimator dut;
+	dut.configure(16);
+
+	int outputs = 0;
+	for (int i = 0; i < 16 * 20; i++) {
+		if (dut.feed(4095)) {
+			outputs++;
+			// full scale input must not overflow the integrators
+			EXPECT_NEAR(4095, dut.get(), 1e-3);
+		}
+	}
+	// first CIC_ORDER outputs are swallowed while the combs fill
+	EXPECT_EQ(20 - CIC_ORDER, outputs);
+}
+
+TEST(CicDecimator, FractionalResolution) {
+	CicDecimator dut;
+	dut.configure(16);
+
+	// one sample of four reads one count higher: true value is 2000.25 which a 12 bit sample cannot represent
+	for (int i = 0; i < 16 * 20; i++) {
+		dut.feed(i % 4 == 0 ? 2001 : 2000);
+	}
+	EXPECT_NEAR(2000.25, dut.get(), 1e-3);
+}
+
+TEST(CicDecimator, NoiseReduction) {
+	CicDecimator dut;
+	dut.configure(32);
+
+	// +-4 counts of uniform noise around 1000.5
+	uint32_t seed = 12345;
+	float inputVariance = 0;
+	float outputVariance = 0;
+	int outputs = 0;
+	for (int i = 0; i < 32 * 400; i++) {
+		seed = seed * 1103515245 + 12345;
+		int noise = (int)((seed >> 16) % 9) - 4;
+		int input = 1000 + noise + (i % 2);
+		inputVariance += (input - 1000.5f) * (input - 1000.5f);
+
+		if (dut.feed(input)) {
+			outputVariance += (dut.get() - 1000.5f) * (dut.get() - 1000.5f);
+			outputs++;
+		}
+	}
+	inputVariance /= 32 * 400;
+	outputVariance /= outputs;
+
+	// decimation by 32 buys more than two bits
+	EXPECT_LT(outputVariance * 16, inputVariance);
+}
+
+TEST(CicDecimator, ConfigureLimits) {
+	CicDecimator dut;
+
+	dut.configure(0);
+	EXPECT_EQ(1, dut.getDecimation());
+
+	dut.configure(1000);
+	EXPECT_EQ(CIC_MAX_DECIMATION, dut.getDecimation());
+}
@@ -0,0 +1,88 @@
+#include "pch.h"
+
+#include "integer_pid.h"
+#include "efi_pid.h"
+
+#define SCALE 100
+
+static pid_s makePid(float p, float i, float d) {
+	pid_s pid = {};
+	pid.pFactor = p;
+	pid.iFactor = i;
+	pid.dFactor = d;
+	pid.minValue = -60;
+	pid.maxValue = 75;
+	return pid;
+}
+
+TEST(IntegerPid, Proportional) {
+	pid_s parameters = makePid(5, 0, 0);
+
+	IntegerPid dut;
+	dut.configure(parameters, 0.0004f, SCALE, -1000, 1000);
+
+	EXPECT_EQ(50 * SCALE, dut.update(50 * SCALE, 40 * SCALE));
+	EXPECT_EQ(-10 * SCALE, dut.update(50 * SCALE, 52 * SCALE));
+
+	// limited same as the float PID
+	EXPECT_EQ(-60 * SCALE, dut.update(50 * SCALE, 70 * SCALE));
+	EXPECT_EQ(75 * SCALE, dut.update(50 * SCALE, 30 * SCALE));
+}
+
+TEST(IntegerPid, SameAsFloatPid) {
+	const float period = 0.0004f;
+	pid_s parameters = makePid(3, 8, 0.02f);
+	parameters.offset = 2;
+
+	Pid reference(&parameters);
+	reference.iTermMin = -30;
+	reference.iTermMax = 30;
+
+	IntegerPid dut;
+	dut.configure(parameters, period, SCALE, -30, 30);
+
+	for (int i = 0; i < 2000; i++) {
+		// a slow target sweep with a step in the middle, in hundredths of a percent
+		int32_t target = 2000 + 8 * (i % 500) + (i > 1000 ? 1500 : 0);
+		int32_t input = target - 500 + (i % 7) * 30;
+
+		float expected = reference.getOutput(target / (float)SCALE, input / (float)SCALE, period);
+		int32_t actual = dut.update(target, input);
+
+		// I gain is rounded to Q16, output is truncated to a hundredth of a percent
+		ASSERT_NEAR(expected, actual / (float)SCALE, 0.1f) << i;
+	}
+}
+
+TEST(IntegerPid, IntegratorLimit) {
+	pid_s parameters = makePid(0, 100, 0);
+
+	IntegerPid dut;
+	dut.configure(parameters, 0.01f, SCALE, -5, 5);
+
+	for (int i = 0; i < 100; i++) {
+		dut.update(10 * SCALE, 0);
+	}
+	EXPECT_EQ(5 * SCALE, dut.getIntegrator());
+
+	for (int i = 0; i < 100; i++) {
+		dut.update(0, 10 * SCALE);
+	}
+	EXPECT_EQ(-5 * SCALE, dut.getIntegrator());
+
+	dut.reset();
+	EXPECT_EQ(0, dut.getIntegrator());
+	EXPECT_EQ(0, dut.getPreviousError());
+}
+
+TEST(IntegerPid, LargeDerivative) {
+	// D gain over a short period does not fit 16 bits, products must not overflow
+	pid_s parameters = makePid(0, 0, 0.5f);
+
+	IntegerPid dut;
+	dut.configure(parameters, 0.0004f, SCALE, -1000, 1000);
+
+	dut.update(0, 0);
+	EXPECT_EQ(75 * SCALE, dut.update(100 * SCALE, 0));
+	EXPECT_EQ(-60 * SCALE, dut.update(0, 0));
+}
@@ -0,0 +1,58 @@
+#include "pch.h"
+
+#include "log_ring_buffer.h"
+
+static const char* testBuffer = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+TEST(LogRingBuffer, WriteRead) {
+	LogRingBuffer<16> dut;
+
+	EXPECT_EQ(10, dut.write(testBuffer, 10));
+	EXPECT_EQ(10, dut.getUsed());
+	EXPECT_EQ(6, dut.getFree());
+
+	const char* ptr;
+	ASSERT_EQ(10, dut.getReadable(&ptr));
+	EXPECT_EQ(0, memcmp(ptr, testBuffer, 10));
+
+	dut.consume(4);
+	ASSERT_EQ(6, dut.getReadable(&ptr));
+	EXPECT_EQ('e', ptr[0]);
+}
+
+TEST(LogRingBuffer, RecordNotSplitOnOverflow) {
+	LogRingBuffer<16> dut;
+
+	EXPECT_EQ(12, dut.write(testBuffer, 12));
+	// does not fit: the whole record is dropped
+	EXPECT_EQ(0, dut.write(testBuffer, 5));
+	EXPECT_EQ(1, dut.getOverflowCount());
+	EXPECT_EQ(5, dut.getDroppedBytes());
+	EXPECT_EQ(12, dut.getUsed());
+
+	// this one fits exactly
+	EXPECT_EQ(4, dut.write(testBuffer, 4));
+	EXPECT_EQ(16, dut.getHighWatermark());
+	EXPECT_EQ(0, dut.getFree());
+}
+
+TEST(LogRingBuffer, Wrap) {
+	LogRingBuffer<16> dut;
+
+	const char* ptr;
+	dut.write(testBuffer, 12);
+	dut.consume(12);
+
+	// 4 bytes at the end of the storage, 6 bytes at the beginning
+	EXPECT_EQ(10, dut.write(testBuffer + 20, 10));
+	ASSERT_EQ(4, dut.getReadable(&ptr));
+	EXPECT_EQ(0, memcmp(ptr, testBuffer + 20, 4));
+	dut.consume(4);
+
+	ASSERT_EQ(6, dut.getReadable(&ptr));
+	EXPECT_EQ(0, memcmp(ptr, testBuffer + 24, 6));
+	dut.consume(6);
+
+	EXPECT_EQ(0, dut.getUsed());
+	EXPECT_EQ(0, dut.getReadable(&ptr));
+}
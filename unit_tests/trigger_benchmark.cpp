@@ -0,0 +1,221 @@
+/*
+ * @file trigger_benchmark.cpp
+ */
+
+#include "pch.h"
+
+#include "trigger_benchmark.h"
+#include "trigger_emulator_algo.h"
+#include "trigger_simulator.h"
+
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+struct SimulatedEdge {
+	efitick_t timestamp;
+	trigger_event_e signal;
+};
+
+static void generateEdges(std::vector<SimulatedEdge>& edges, const TriggerWaveform& shape,
+		const TriggerConfiguration& triggerConfiguration, const TriggerBenchmarkConfig& config) {
+	constexpr trigger_event_e riseEvents[] = { SHAFT_PRIMARY_RISING, SHAFT_SECONDARY_RISING };
+	constexpr trigger_event_e fallEvents[] = { SHAFT_PRIMARY_FALLING, SHAFT_SECONDARY_FALLING };
+
+	std::mt19937 rng(config.seed);
+	std::uniform_real_distribution<float> unit(0, 1);
+
+	const auto& wave = shape.wave;
+	const int size = shape.getSize();
+	const int totalEvents = config.cycles * size;
+
+	// start from a random position within the wheel so that sync acquisition latency is meaningful
+	int startIndex = rng() % size;
+
+	// keep far from zero, the decoder treats a > 1 second pause as engine stop
+	double nominalUs = 1'000'000;
+	double previousUs = nominalUs;
+
+	for (int i = startIndex; i < startIndex + totalEvents; i++) {
+		int stateIndex = i % size;
+
+		float progress = (float)(i - startIndex) / totalEvents;
+		float rpm = interpolateClamped(0, config.rpmStart, 1, config.rpmEnd, progress);
+		double cycleUs = 60'000'000.0 / rpm * shape.getCycleDuration() / 360;
+
+		// advance by the angular distance from the previous state, integrated at current RPM
+		double toothUs = 0;
+		if (i != startIndex) {
+			float fraction = wave.getSwitchTime(stateIndex) - wave.getSwitchTime(getPreviousIndex(stateIndex, size));
+			if (fraction <= 0) {
+				fraction += 1;
+			}
+			toothUs = cycleUs * fraction;
+		}
+		nominalUs += toothUs;
+
+		double us = nominalUs;
+		if (config.jitter > 0) {
+			us += toothUs * config.jitter * (2 * unit(rng) - 1);
+		}
+		// never go back in time
+		us = std::max(us, previousUs + 1);
+
+		for (size_t channel = 0; channel < PWM_PHASE_MAX_WAVE_PER_PWM; channel++) {
+			if (!needEvent(stateIndex, wave, channel)) {
+				continue;
+			}
+
+			pin_state_t value = wave.getChannelState(channel, stateIndex);
+			trigger_event_e event = (value ? riseEvents : fallEvents)[channel];
+			if (isUsefulSignal(event, triggerConfiguration)) {
+				edges.push_back({ (efitick_t)USF2NT(us), event });
+			}
+		}
+
+		if (config.noiseProbability > 0 && unit(rng) < config.noiseProbability) {
+			// short glitch on primary channel somewhere between this tooth and the next one
+			double glitchUs = us + std::max(2.0, toothUs * unit(rng) * 0.5);
+			edges.push_back({ (efitick_t)USF2NT(glitchUs), SHAFT_PRIMARY_RISING });
+			if (!triggerConfiguration.UseOnlyRisingEdgeForTrigger) {
+				edges.push_back({ (efitick_t)USF2NT(glitchUs + 1), SHAFT_PRIMARY_FALLING });
+			}
+			us = std::max(us, glitchUs + 2);
+		}
+
+		previousUs = us;
+	}
+}
+
+TriggerBenchmarkResult runTriggerBenchmark(trigger_type_e type, const TriggerBenchmarkConfig& config) {
+	TriggerBenchmarkResult result;
+
+	persistent_config_s pc;
+	memset(&pc, 0, sizeof(pc));
+	Engine e;
+	Engine* engine = &e;
+	EngineTestHelperBase base(engine, &pc.engineConfiguration, &pc);
+
+	engineConfiguration->trigger.type = type;
+	setCamOperationMode();
+	engine->updateTriggerWaveform();
+
+	const TriggerWaveform& shape = engine->triggerCentral.triggerShape;
+	if (shape.shapeDefinitionError || shape.getSize() == 0) {
+		return result;
+	}
+	result.isValidShape = true;
+
+	engine->primaryTriggerConfiguration.UseGapSignatureSync = config.useGapSignatureSync;
+	const TriggerConfiguration& triggerConfiguration = engine->primaryTriggerConfiguration;
+
+	std::vector<SimulatedEdge> edges;
+	edges.reserve(config.cycles * shape.getSize() * 2);
+	generateEdges(edges, shape, triggerConfiguration, config);
+
+	TriggerDecoderBase decoder("bench");
+	decoder.resetTriggerState();
+
+	bool wasSynchronized = false;
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < edges.size(); i++) {
+		auto decodeResult = decoder.decodeTriggerEvent("bench", shape, nullptr, triggerConfiguration, edges[i].signal, edges[i].timestamp);
+
+		if ((decodeResult && decodeResult.Value.CurrentIndex >= shape.getSize())
+				|| cisnan((float)decoder.triggerSyncGapRatio)) {
+			result.invalidStateCount++;
+		}
+
+		bool isSynchronized = decoder.getShaftSynchronized();
+		if (isSynchronized && result.syncAcquisitionTeeth < 0) {
+			result.syncAcquisitionTeeth = i + 1;
+		}
+		// the first revolution after acquisition may legitimately be short if we started mid-wheel,
+		// its sync point has already bumped the revolution counter to 1
+		if (wasSynchronized && !isSynchronized && decoder.getTotalRevolutionCounter() >= 2) {
+			result.syncLossCount++;
+		}
+		wasSynchronized = isSynchronized;
+	}
+
+	auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+	result.edges = edges.size();
+	result.nsPerEdge = edges.empty() ? 0 : elapsed / edges.size();
+	result.triggerErrorCount = decoder.totalTriggerErrorCounter;
+	result.orderingErrorCount = decoder.orderingErrorCounter;
+	result.gapSignatureSyncCount = decoder.gapSignatureSyncCounter;
+
+	return result;
+}
+
+void printTriggerBenchmarkReport(const TriggerBenchmarkConfig& config) {
+	printf("trigger benchmark: rpm %.0f..%.0f cycles=%d jitter=%.3f noise=%.3f seed=%u\n",
+			config.rpmStart, config.rpmEnd, config.cycles, config.jitter, config.noiseProbability, config.seed);
+	printf("%-40s %10s %10s %10s %10s %10s\n", "trigger", "edges", "ns/edge", "syncTeeth", "syncLoss", "errors");
+
+	for (int type = 1; type < TT_UNUSED; type++) {
+		auto tt = (trigger_type_e)type;
+		auto result = runTriggerBenchmark(tt, config);
+		if (!result.isValidShape) {
+			continue;
+		}
+
+		printf("%-40s %10u %10.1f %10d %10u %10u\n", getTrigger_type_e(tt),
+				result.edges, result.nsPerEdge, result.syncAcquisitionTeeth,
+				result.syncLossCount, result.triggerErrorCount);
+	}
+}
+
+bool runTriggerFuzzInput(const uint8_t *data, size_t size) {
+	if (size < 8) {
+		return true;
+	}
+
+	TriggerBenchmarkConfig config;
+	trigger_type_e type = (trigger_type_e)(1 + data[0] % (TT_UNUSED - 1));
+	config.rpmStart = 50 + data[1] * 40;
+	config.rpmEnd = 50 + data[2] * 40;
+	config.cycles = 2 + data[3] % 30;
+	config.jitter = data[4] / 512.0f;
+	config.noiseProbability = data[5] / 1024.0f;
+	config.seed = data[6] | (data[7] << 8);
+
+	// sync quality does not matter here, we are looking for firmware errors and broken decoder state
+	TriggerBenchmarkResult result;
+	try {
+		result = runTriggerBenchmark(type, config);
+	} catch (std::logic_error& e) {
+		printf("trigger fuzz: %s firmware error: %s\n", getTrigger_type_e(type), e.what());
+		return false;
+	}
+
+	if (result.invalidStateCount != 0) {
+		printf("trigger fuzz: %s %u edges with invalid decoder state, seed=%u\n",
+				getTrigger_type_e(type), result.invalidStateCount, config.seed);
+		return false;
+	}
+
+	return true;
+}
+
+int runTriggerFuzz(int iterations, uint32_t seed) {
+	std::mt19937 rng(seed);
+	int failures = 0;
+
+	for (int i = 0; i < iterations; i++) {
+		uint8_t input[8];
+		for (size_t j = 0; j < sizeof(input); j++) {
+			input[j] = rng();
+		}
+		if (!runTriggerFuzzInput(input, sizeof(input))) {
+			failures++;
+		}
+	}
+
+	printf("trigger fuzz: %d iterations done, %d failed, seed=%u\n", iterations, failures, seed);
+	return failures;
+}
@@ -0,0 +1,61 @@
+/*
+ * @file trigger_benchmark.h
+ *
+ * Throughput and robustness harness for TriggerDecoderBase::decodeTriggerEvent: feeds trigger
+ * waveforms through the decoder at simulated RPM sweeps with injected jitter and noise.
+ *
+ * Run "rusefi_test --trigger-benchmark" for the report over all trigger types,
+ * "rusefi_test --trigger-fuzz [iterations] [seed]" for randomized runs.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+struct TriggerBenchmarkConfig {
+	float rpmStart = 200;
+	float rpmEnd = 8000;
+	int cycles = 200;
+	// tooth period jitter as a fraction of tooth period, uniformly distributed
+	float jitter = 0;
+	// probability of a spurious edge pair after each tooth
+	float noiseProbability = 0;
+	uint32_t seed = 0;
+	// see TriggerConfiguration::UseGapSignatureSync
+	bool useGapSignatureSync = false;
+};
+
+struct TriggerBenchmarkResult {
+	bool isValidShape = false;
+	uint32_t edges = 0;
+	double nsPerEdge = 0;
+	// number of times synchronization was lost once past the first revolution after acquisition
+	uint32_t syncLossCount = 0;
+	// number of decoded edges until the first sync point, -1 if never synchronized
+	int syncAcquisitionTeeth = -1;
+	uint32_t triggerErrorCount = 0;
+	uint32_t orderingErrorCount = 0;
+	uint32_t gapSignatureSyncCount = 0;
+	// edges which left the decoder in a state consumers can not use: a synchronized index past
+	// the end of the shape, or a NaN gap ratio
+	uint32_t invalidStateCount = 0;
+};
+
+TriggerBenchmarkResult runTriggerBenchmark(trigger_type_e type, const TriggerBenchmarkConfig& config);
+
+/**
+ * Prints ns/edge, sync loss and sync acquisition latency for every trigger type
+ */
+void printTriggerBenchmarkReport(const TriggerBenchmarkConfig& config);
+
+/**
+ * Fuzz entry point: derives trigger type, RPM sweep, jitter and noise from arbitrary bytes
+ * @return false on firmware error or invalid decoder state
+ */
+bool runTriggerFuzzInput(const uint8_t *data, size_t size);
+
+/**
+ * @return number of failed iterations
+ */
+int runTriggerFuzz(int iterations, uint32_t seed);